@@ -22,7 +22,7 @@ use resources::{
     ScopeState, ViewerData, VulkanInteropState,
 };
 #[cfg(feature = "ocio")]
-use systems::bake_ocio_luts;
+use systems::{bake_ocio_luts, collect_ocio_perf_stats};
 use systems::{
     consume_gpu_results, detect_param_changes, handle_grading_commands, submit_gpu_work,
     upload_scope_mask,
@@ -65,9 +65,12 @@ impl Plugin for CrispenPlugin {
         #[cfg(feature = "ocio")]
         app.add_systems(
             Update,
-            bake_ocio_luts
-                .after(handle_grading_commands)
-                .before(submit_gpu_work),
+            (
+                bake_ocio_luts
+                    .after(handle_grading_commands)
+                    .before(submit_gpu_work),
+                collect_ocio_perf_stats.after(bake_ocio_luts),
+            ),
         );
     }
 }
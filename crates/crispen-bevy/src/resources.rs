@@ -158,6 +158,19 @@ pub struct ScopeMaskData {
     pub dirty: bool,
 }
 
+/// Cumulative totals for one instrumented stage of a native library,
+/// mirrored from the OCIO / OIIO C API perf counters.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct NativeStageStats {
+    /// Library the stage belongs to, e.g. `"ocio"`.
+    pub library: &'static str,
+    /// Stage name, e.g. `"cpu_apply"` or `"decode"`.
+    pub stage: &'static str,
+    pub calls: u64,
+    pub time: Duration,
+    pub bytes: u64,
+}
+
 /// Runtime timings for the grading pipeline.
 #[derive(Resource)]
 pub struct PipelinePerfStats {
@@ -168,6 +181,23 @@ pub struct PipelinePerfStats {
     pub total_time: Duration,
     pub slow_update_threshold: Duration,
     pub last_log_at: Instant,
+    /// Native OCIO / OIIO stage totals. Empty unless the libraries'
+    /// instrumentation is enabled (it is opt-in).
+    pub native_stages: Vec<NativeStageStats>,
+}
+
+impl PipelinePerfStats {
+    /// Insert or replace the totals for `stats.library` / `stats.stage`.
+    pub fn record_native_stage(&mut self, stats: NativeStageStats) {
+        match self
+            .native_stages
+            .iter_mut()
+            .find(|s| s.library == stats.library && s.stage == stats.stage)
+        {
+            Some(existing) => *existing = stats,
+            None => self.native_stages.push(stats),
+        }
+    }
 }
 
 impl Default for PipelinePerfStats {
@@ -180,6 +210,7 @@ impl Default for PipelinePerfStats {
             total_time: Duration::ZERO,
             slow_update_threshold: Duration::from_millis(10),
             last_log_at: Instant::now(),
+            native_stages: Vec::new(),
         }
     }
 }
@@ -10,6 +10,8 @@ use std::time::Instant;
 use crispen_core::grading::auto_balance;
 use crispen_core::transform::params::GradingParams;
 use crispen_gpu::ScopeResults;
+#[cfg(feature = "ocio")]
+use crispen_ocio::OcioCpuOptions;
 
 use crate::events::{
     ColorGradingCommand, ImageLoadedEvent, ParamsUpdatedEvent, ScopeDataReadyEvent,
@@ -17,8 +19,8 @@ use crate::events::{
 #[cfg(feature = "ocio")]
 use crate::resources::OcioColorManagement;
 use crate::resources::{
-    GpuPipelineState, GradingState, ImageState, PipelinePerfStats, ScopeConfig, ScopeMaskData,
-    ScopeState, ViewerData,
+    GpuPipelineState, GradingState, ImageState, NativeStageStats, PipelinePerfStats, ScopeConfig,
+    ScopeMaskData, ScopeState, ViewerData,
 };
 
 /// Process inbound grading commands from the UI.
@@ -124,6 +126,11 @@ pub fn detect_param_changes(state: Res<GradingState>) {
 }
 
 /// Re-bake OCIO IDT/ODT LUTs when OCIO display/input selection changes.
+///
+/// The bakes use lossless processors: they run once per selection change, and
+/// the 65³ LUTs then stand in for OCIO on every frame. Bakes go through the
+/// OCIO LUT disk cache, so relaunching or switching back to a known view maps
+/// the stored LUT instead of re-baking it.
 #[cfg(feature = "ocio")]
 pub fn bake_ocio_luts(
     ocio: Option<ResMut<OcioColorManagement>>,
@@ -140,10 +147,12 @@ pub fn bake_ocio_luts(
     match ocio
         .config
         .processor(&ocio.input_space, &ocio.working_space)
-        .and_then(|p| p.cpu_f32())
+        .and_then(|p| p.cpu_f32_with(OcioCpuOptions::lossless()))
+        .and_then(|cpu| cpu.bake_3d_lut_cached(65))
+        .map(|lut| lut.as_slice().to_vec())
     {
-        Ok(cpu) => {
-            idt_lut = Some(cpu.bake_3d_lut(65));
+        Ok(lut) => {
+            idt_lut = Some(lut);
         }
         Err(err) => {
             tracing::warn!(
@@ -157,10 +166,12 @@ pub fn bake_ocio_luts(
     match ocio
         .config
         .display_view_processor(&ocio.working_space, &ocio.display, &ocio.view)
-        .and_then(|p| p.cpu_f32())
+        .and_then(|p| p.cpu_f32_with(OcioCpuOptions::lossless()))
+        .and_then(|cpu| cpu.bake_3d_lut_cached(65))
+        .map(|lut| lut.as_slice().to_vec())
     {
-        Ok(cpu) => {
-            odt_lut = Some(cpu.bake_3d_lut(65));
+        Ok(lut) => {
+            odt_lut = Some(lut);
         }
         Err(err) => {
             tracing::warn!(
@@ -178,6 +189,25 @@ pub fn bake_ocio_luts(
     grading.dirty = true;
 }
 
+/// Mirror the OCIO C API perf counters into [`PipelinePerfStats`] so they
+/// sit alongside the GPU timings. Does nothing unless OCIO instrumentation
+/// was enabled with `crispen_ocio::set_perf_enabled`.
+#[cfg(feature = "ocio")]
+pub fn collect_ocio_perf_stats(mut perf: ResMut<PipelinePerfStats>) {
+    if !crispen_ocio::perf_enabled() {
+        return;
+    }
+    for (stage, counter) in crispen_ocio::perf_stats().iter() {
+        perf.record_native_stage(NativeStageStats {
+            library: "ocio",
+            stage: stage.name(),
+            calls: counter.calls,
+            time: counter.time,
+            bytes: counter.bytes,
+        });
+    }
+}
+
 /// Submit GPU work (bake + apply + scopes) when params are dirty. Non-blocking.
 ///
 /// The actual results are consumed by [`consume_gpu_results`] on a subsequent frame.
@@ -250,12 +280,34 @@ pub fn submit_gpu_work(
             submit_time.as_secs_f64() * 1000.0,
             perf.updates
         );
+        if let Some(native) = format_native_stages(&perf.native_stages) {
+            tracing::info!("native stages: {native}");
+        }
         perf.last_log_at = Instant::now();
     }
 
     state.dirty = false;
 }
 
+/// One-line summary of the native stages that have run, e.g.
+/// `ocio/cpu_apply 12x 3.40ms`, or `None` when none have.
+fn format_native_stages(stages: &[NativeStageStats]) -> Option<String> {
+    let summary: Vec<String> = stages
+        .iter()
+        .filter(|s| s.calls > 0)
+        .map(|s| {
+            format!(
+                "{}/{} {}x {:.2}ms",
+                s.library,
+                s.stage,
+                s.calls,
+                s.time.as_secs_f64() * 1000.0
+            )
+        })
+        .collect();
+    (!summary.is_empty()).then(|| summary.join(", "))
+}
+
 /// Non-blocking: poll for async GPU readback results and update viewer + scopes.
 ///
 /// Runs every frame. If no results are ready yet, returns immediately.
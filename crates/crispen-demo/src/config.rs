@@ -41,6 +41,8 @@ pub struct AppConfig {
     pub dev_mode: bool,
     /// Which frontend stack to run.
     pub frontend_mode: FrontendMode,
+    /// Enable the OCIO/OIIO native perf counters (`CRISPEN_NATIVE_PERF`).
+    pub native_perf: bool,
 }
 
 impl Default for AppConfig {
@@ -54,6 +56,7 @@ impl Default for AppConfig {
             height: DEFAULT_HEIGHT,
             dev_mode: std::env::var("CRISPEN_DEV").is_ok(),
             frontend_mode: FrontendMode::from_env(),
+            native_perf: std::env::var("CRISPEN_NATIVE_PERF").is_ok(),
         }
     }
 }
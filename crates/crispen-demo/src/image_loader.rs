@@ -28,6 +28,9 @@ pub fn load_image(path: &Path) -> Result<LoadedImage, ImageLoadError> {
 ///
 /// OIIO supports 100+ formats and auto-detects the color space from file
 /// metadata. The detected color space string matches OCIO config names.
+/// Downscaling to `max_display_size` happens at decode time in OIIO, picking
+/// the closest MIP level when the file has one, so the full-resolution float
+/// frame is never materialised.
 #[cfg(feature = "ocio")]
 pub fn load_image_oiio(
     path: &Path,
@@ -37,21 +40,18 @@ pub fn load_image_oiio(
 
     let color_space = input.color_space();
     let bit_depth = input.bit_depth();
-    let pixels = input.read_rgba_f32().map_err(ImageLoadError::Oiio)?;
-    let width = input.width();
-    let height = input.height();
-
-    let image = GradingImage {
-        width,
-        height,
-        pixels,
-        source_bit_depth: bit_depth,
-    };
-
-    let image = maybe_resize_grading_image(image, max_display_size);
+    let (max_w, max_h) = max_display_size.unwrap_or((0, 0));
+    let (width, height, pixels) = input
+        .read_rgba_f32_fit(max_w, max_h)
+        .map_err(ImageLoadError::Oiio)?;
 
     Ok(LoadedImage {
-        image,
+        image: GradingImage {
+            width,
+            height,
+            pixels,
+            source_bit_depth: bit_depth,
+        },
         detected_color_space: color_space,
     })
 }
@@ -119,66 +119,6 @@ fn maybe_resize_to_fit(
     image.resize_exact(dst_w, dst_h, FilterType::Triangle)
 }
 
-/// Downscale a `GradingImage` if it exceeds the given display bounds.
-///
-/// Uses simple bilinear interpolation on the f32 pixel data.
-#[cfg_attr(not(feature = "ocio"), allow(dead_code))]
-fn maybe_resize_grading_image(
-    image: GradingImage,
-    max_display_size: Option<(u32, u32)>,
-) -> GradingImage {
-    let Some((max_w, max_h)) = max_display_size else {
-        return image;
-    };
-    if max_w == 0 || max_h == 0 || (image.width <= max_w && image.height <= max_h) {
-        return image;
-    }
-
-    let scale_w = max_w as f32 / image.width as f32;
-    let scale_h = max_h as f32 / image.height as f32;
-    let scale = scale_w.min(scale_h);
-    let dst_w = (image.width as f32 * scale).round().max(1.0) as u32;
-    let dst_h = (image.height as f32 * scale).round().max(1.0) as u32;
-
-    let src_w = image.width as usize;
-    let mut dst_pixels = Vec::with_capacity(dst_w as usize * dst_h as usize);
-
-    for y in 0..dst_h {
-        for x in 0..dst_w {
-            let src_x = (x as f32 + 0.5) / scale - 0.5;
-            let src_y = (y as f32 + 0.5) / scale - 0.5;
-
-            let x0 = (src_x.floor() as i32).clamp(0, image.width as i32 - 1) as usize;
-            let y0 = (src_y.floor() as i32).clamp(0, image.height as i32 - 1) as usize;
-            let x1 = (x0 + 1).min(image.width as usize - 1);
-            let y1 = (y0 + 1).min(image.height as usize - 1);
-
-            let fx = src_x - src_x.floor();
-            let fy = src_y - src_y.floor();
-
-            let p00 = image.pixels[y0 * src_w + x0];
-            let p10 = image.pixels[y0 * src_w + x1];
-            let p01 = image.pixels[y1 * src_w + x0];
-            let p11 = image.pixels[y1 * src_w + x1];
-
-            let mut pixel = [0.0f32; 4];
-            for c in 0..4 {
-                let top = p00[c] * (1.0 - fx) + p10[c] * fx;
-                let bot = p01[c] * (1.0 - fx) + p11[c] * fx;
-                pixel[c] = top * (1.0 - fy) + bot * fy;
-            }
-            dst_pixels.push(pixel);
-        }
-    }
-
-    GradingImage {
-        width: dst_w,
-        height: dst_h,
-        pixels: dst_pixels,
-        source_bit_depth: image.source_bit_depth,
-    }
-}
-
 /// Map an OIIO-detected color space string to a [`ColorSpaceId`].
 ///
 /// Falls back to inferring from bit depth when the string is unrecognised.
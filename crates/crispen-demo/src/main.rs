@@ -25,10 +25,14 @@ use config::{AppConfig, FrontendMode};
 use crispen_bevy::CrispenPlugin;
 use crispen_bevy::events::{ImageLoadedEvent, ParamsUpdatedEvent};
 #[cfg(feature = "ocio")]
-use crispen_bevy::resources::OcioColorManagement;
+use crispen_bevy::resources::{NativeStageStats, OcioColorManagement, PipelinePerfStats};
 use crispen_bevy::resources::GradingState;
 #[cfg(feature = "ocio")]
-use crispen_ocio::OcioConfig;
+use crispen_ocio::{OcioConfig, OcioConfigLoad, OcioConfigSource, OcioPrewarm};
+
+/// Input space assumed for loaded images until the UI picks another one.
+#[cfg(feature = "ocio")]
+const DEFAULT_INPUT_SPACE: &str = "sRGB - Texture";
 
 fn main() {
     let config = AppConfig::default();
@@ -40,6 +44,11 @@ fn main() {
         config.frontend_mode
     );
 
+    // Parse the OCIO config and build the viewer's IDT/ODT processors while
+    // the window, renderer and UI start up.
+    #[cfg(feature = "ocio")]
+    let ocio_load = start_ocio_config_load();
+
     let window = Window {
         title: "Crispen".into(),
         resolution: WindowResolution::new(config.width as u32, config.height as u32)
@@ -126,16 +135,61 @@ fn main() {
     }
 
     #[cfg(feature = "ocio")]
-    try_insert_ocio_resource(&mut app);
+    {
+        try_insert_ocio_resource(&mut app, ocio_load);
+        if app.world().resource::<AppConfig>().native_perf {
+            crispen_ocio::set_perf_enabled(true);
+            crispen_oiio::set_perf_enabled(true);
+            app.add_systems(Update, collect_oiio_perf_stats);
+            tracing::info!("native OCIO/OIIO perf counters enabled");
+        }
+    }
 
     app.run();
 }
 
+/// Mirror the OIIO C API perf counters into [`PipelinePerfStats`]; the
+/// OCIO side is collected by `CrispenPlugin`.
 #[cfg(feature = "ocio")]
-fn try_insert_ocio_resource(app: &mut App) {
-    let ocio_config = OcioConfig::from_env()
-        .or_else(|_| OcioConfig::builtin("studio-config-v4.0.0_aces-v2.0_ocio-v2.5"))
-        .or_else(|_| OcioConfig::builtin("studio-config-v2.2.0_aces-v1.3_ocio-v2.4"));
+fn collect_oiio_perf_stats(mut perf: ResMut<PipelinePerfStats>) {
+    for (stage, counter) in crispen_oiio::perf_stats().iter() {
+        perf.record_native_stage(NativeStageStats {
+            library: "oiio",
+            stage: stage.name(),
+            calls: counter.calls,
+            time: counter.time,
+            bytes: counter.bytes,
+        });
+    }
+}
+
+#[cfg(feature = "ocio")]
+fn start_ocio_config_load() -> Option<OcioConfigLoad> {
+    let source = if std::env::var_os("OCIO").is_some() {
+        OcioConfigSource::Env
+    } else {
+        OcioConfigSource::Builtin("studio-config-v4.0.0_aces-v2.0_ocio-v2.5".to_string())
+    };
+    let prewarm = OcioPrewarm {
+        display_view: true,
+        input_space: Some(DEFAULT_INPUT_SPACE.to_string()),
+        ..Default::default()
+    };
+    OcioConfigLoad::start(&source, &prewarm)
+        .inspect_err(|err| tracing::warn!("async OCIO config load not started: {err}"))
+        .ok()
+}
+
+#[cfg(feature = "ocio")]
+fn try_insert_ocio_resource(app: &mut App, load: Option<OcioConfigLoad>) {
+    // Fall back to the synchronous chain when the async load failed, e.g.
+    // an invalid $OCIO or an OCIO build without the v4 built-in config.
+    let ocio_config = match load.as_ref().map(OcioConfigLoad::wait) {
+        Some(Ok(config)) => Ok(config),
+        _ => OcioConfig::from_env()
+            .or_else(|_| OcioConfig::builtin("studio-config-v4.0.0_aces-v2.0_ocio-v2.5"))
+            .or_else(|_| OcioConfig::builtin("studio-config-v2.2.0_aces-v1.3_ocio-v2.4")),
+    };
 
     let Ok(config) = ocio_config else {
         tracing::warn!("OCIO config unavailable; using native color management");
@@ -172,7 +226,7 @@ fn try_insert_ocio_resource(app: &mut App) {
 
     app.insert_resource(OcioColorManagement {
         config,
-        input_space: "sRGB - Texture".to_string(),
+        input_space: DEFAULT_INPUT_SPACE.to_string(),
         working_space,
         display,
         view,
@@ -182,6 +236,25 @@ fn try_insert_ocio_resource(app: &mut App) {
         dirty: true,
     });
     tracing::info!("OCIO enabled");
+
+    // Baked IDT/ODT LUTs persist across launches; without a cache directory
+    // every launch simply re-bakes them.
+    if let Some(dir) = lut_cache_dir()
+        && let Err(err) = crispen_ocio::set_lut_cache_directory(Some(&dir))
+    {
+        tracing::warn!("OCIO LUT cache disabled: {err}");
+    }
+}
+
+#[cfg(feature = "ocio")]
+fn lut_cache_dir() -> Option<std::path::PathBuf> {
+    if let Ok(xdg) = std::env::var("XDG_CACHE_HOME") {
+        Some(std::path::PathBuf::from(xdg).join("crispen/luts"))
+    } else if let Ok(home) = std::env::var("HOME") {
+        Some(std::path::PathBuf::from(home).join(".cache/crispen/luts"))
+    } else {
+        None
+    }
 }
 
 #[cfg(feature = "ocio")]
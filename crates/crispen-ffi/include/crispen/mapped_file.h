@@ -0,0 +1,117 @@
+#pragma once
+
+// Read-only memory mapping of a whole file. Used by the OCIO LUT disk cache
+// and the OIIO raw-file fast path.
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace crispen
+{
+
+// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    static std::unique_ptr<MappedFile> open(const std::filesystem::path & path)
+    {
+        std::unique_ptr<MappedFile> file(new MappedFile);
+#ifdef _WIN32
+        HANDLE handle = CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_DELETE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+        LARGE_INTEGER len;
+        if (!GetFileSizeEx(handle, &len) || len.QuadPart <= 0)
+        {
+            CloseHandle(handle);
+            return nullptr;
+        }
+        HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(handle);
+        if (!mapping)
+        {
+            return nullptr;
+        }
+        void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+        {
+            return nullptr;
+        }
+        file->m_data = static_cast<const unsigned char *>(view);
+        file->m_size = static_cast<std::size_t>(len.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        const std::size_t len = static_cast<std::size_t>(st.st_size);
+        void * view = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps the file referenced after the descriptor closes.
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        file->m_data = static_cast<const unsigned char *>(view);
+        file->m_size = len;
+#endif
+        return file;
+    }
+
+    ~MappedFile()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    const unsigned char * data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    MappedFile() = default;
+
+    const unsigned char * m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+} // namespace crispen
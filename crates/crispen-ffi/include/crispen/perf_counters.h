@@ -0,0 +1,223 @@
+#pragma once
+
+// Opt-in per-stage call counters, cumulative wall time and bytes processed.
+//
+// Disabled by default: an instrumented call then costs one relaxed atomic
+// load and reads no clock. When enabled, each call adds to lock-free
+// counters and, if a callback is registered, reports its own timing so
+// hosts can attribute a slow frame to a specific stage.
+//
+// Shared by the crispen-ocio and crispen-oiio C ABIs; the Rust side of the
+// snapshot and callback plumbing is crispen_ffi::perf.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace crispen
+{
+
+// Matches the OcioPerfCallback / OiioPerfCallback C typedefs.
+using PerfCallback = void (*)(void * user,
+                              int stage,
+                              unsigned long long nanoseconds,
+                              unsigned long long bytes);
+
+template <int Stages>
+class PerfCounters
+{
+public:
+    struct Snapshot
+    {
+        unsigned long long calls = 0;
+        unsigned long long nanoseconds = 0;
+        unsigned long long bytes = 0;
+    };
+
+    void set_enabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Once this returns, the previous callback is no longer running on any
+    // other thread. It may be called from inside the callback itself; that
+    // call (and any other this thread is in) is still running afterwards.
+    void set_callback(PerfCallback callback, void * user)
+    {
+        std::unique_lock<std::mutex> lock(m_callback_mutex);
+        m_callback = callback;
+        m_user = user;
+        m_has_callback.store(callback != nullptr, std::memory_order_release);
+
+        // Calls this thread is making cannot finish before it returns, so
+        // they are not waited for; nor are those of other threads waiting
+        // here inside their own callbacks.
+        const int own = callbacks_on_this_thread();
+        m_parked += own;
+        if (own > 0)
+        {
+            m_idle.notify_all();
+        }
+        m_idle.wait(lock, [this] { return m_active == m_parked; });
+        m_parked -= own;
+    }
+
+    void record(int stage, std::uint64_t nanoseconds, std::uint64_t bytes)
+    {
+        if (stage < 0 || stage >= Stages)
+        {
+            return;
+        }
+        Counter & c = m_counters[static_cast<std::size_t>(stage)];
+        c.calls.fetch_add(1, std::memory_order_relaxed);
+        c.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        if (!m_has_callback.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        // The callback runs without the lock held, so it may re-register or
+        // take as long as it likes; set_callback waits for it instead.
+        PerfCallback callback = nullptr;
+        void * user = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            if (!m_callback)
+            {
+                return;
+            }
+            callback = m_callback;
+            user = m_user;
+            ++m_active;
+        }
+        CallbackFrame frame{this, callback_frames()};
+        callback_frames() = &frame;
+        callback(user, stage, nanoseconds, bytes);
+        callback_frames() = frame.prev;
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            --m_active;
+            if (m_active == m_parked)
+            {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    Snapshot snapshot(int stage) const
+    {
+        Snapshot s;
+        if (stage < 0 || stage >= Stages)
+        {
+            return s;
+        }
+        const Counter & c = m_counters[static_cast<std::size_t>(stage)];
+        s.calls = c.calls.load(std::memory_order_relaxed);
+        s.nanoseconds = c.nanoseconds.load(std::memory_order_relaxed);
+        s.bytes = c.bytes.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset()
+    {
+        for (Counter & c : m_counters)
+        {
+            c.calls.store(0, std::memory_order_relaxed);
+            c.nanoseconds.store(0, std::memory_order_relaxed);
+            c.bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // Callback calls in progress on the current thread, innermost first.
+    struct CallbackFrame
+    {
+        const PerfCounters * owner;
+        CallbackFrame * prev;
+    };
+
+    static CallbackFrame *& callback_frames()
+    {
+        static thread_local CallbackFrame * head = nullptr;
+        return head;
+    }
+
+    int callbacks_on_this_thread() const
+    {
+        int n = 0;
+        for (const CallbackFrame * f = callback_frames(); f; f = f->prev)
+        {
+            n += f->owner == this ? 1 : 0;
+        }
+        return n;
+    }
+
+    struct Counter
+    {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    std::array<Counter, Stages> m_counters;
+    std::atomic<bool> m_enabled{false};
+    std::atomic<bool> m_has_callback{false};
+    std::mutex m_callback_mutex;
+    std::condition_variable m_idle;
+    PerfCallback m_callback = nullptr;
+    void * m_user = nullptr;
+    // Calls in progress, and how many of them belong to threads waiting in
+    // set_callback.
+    int m_active = 0;
+    int m_parked = 0;
+};
+
+// Times one instrumented call from construction to destruction. `bytes`
+// may be filled in once the amount processed is known.
+template <int Stages>
+class PerfScope
+{
+public:
+    PerfScope(PerfCounters<Stages> & counters, int stage, std::uint64_t bytes = 0)
+        : m_counters(counters.enabled() ? &counters : nullptr), m_stage(stage), m_bytes(bytes)
+    {
+        if (m_counters)
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PerfScope() { finish(); }
+
+    PerfScope(const PerfScope &) = delete;
+    PerfScope & operator=(const PerfScope &) = delete;
+
+    void set_bytes(std::uint64_t bytes) { m_bytes = bytes; }
+    // Drop this call, e.g. when it turned out to be handled by another
+    // instrumented stage.
+    void cancel() { m_counters = nullptr; }
+
+    // Record now instead of at destruction, so work after the timed section
+    // in the same scope is not included.
+    void finish()
+    {
+        if (!m_counters)
+        {
+            return;
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        m_counters->record(m_stage, static_cast<std::uint64_t>(ns), m_bytes);
+        m_counters = nullptr;
+    }
+
+private:
+    PerfCounters<Stages> * m_counters;
+    int m_stage;
+    std::uint64_t m_bytes;
+    std::chrono::steady_clock::time_point m_start{};
+};
+
+} // namespace crispen
@@ -0,0 +1,233 @@
+#pragma once
+
+// Small persistent worker pool shared by the OCIO threaded apply paths and
+// the OIIO thumbnail batch.
+//
+// Workers are spawned lazily and kept alive for the life of the process so
+// repeated per-frame applies do not pay thread start-up costs. The calling
+// thread always participates, so a request for N threads uses N - 1 workers.
+// Any number of threads may call run() at once; each call only waits for
+// its own batch.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace crispen
+{
+
+class WorkerPool
+{
+public:
+    static WorkerPool & instance()
+    {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    // Resolve a requested thread count: <= 0 means all hardware threads.
+    static int resolve_threads(int requested)
+    {
+        if (requested > 0)
+        {
+            return std::min(requested, k_max_threads);
+        }
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 0 ? static_cast<int>(hw) : 1;
+    }
+
+    // Run fn(i) for every i in [0, count) on up to max_threads threads and
+    // block until all items are done. Returns false if any item threw; the
+    // first exception message is stored in `error`. `fn` may call run()
+    // itself: a call only waits on threads already running its own items,
+    // and its unclaimed queue entries are withdrawn, so nesting cannot
+    // deadlock.
+    bool run(int count, int max_threads, const std::function<void(int)> & fn, std::string & error)
+    {
+        if (count <= 0)
+        {
+            return true;
+        }
+
+        auto batch = std::make_shared<Batch>();
+        batch->fn = &fn;
+        batch->count = count;
+
+        const int helpers = std::min(resolve_threads(max_threads), count) - 1;
+        if (helpers > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ensure_workers(helpers);
+            for (int i = 0; i < helpers; ++i)
+            {
+                batch->active.fetch_add(1);
+                m_queue.push_back(batch);
+            }
+        }
+        m_cv.notify_all();
+
+        drain(*batch);
+        if (helpers > 0)
+        {
+            withdraw(batch);
+        }
+
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done_cv.wait(lock, [&] { return batch->active.load() == 0; });
+        if (batch->failed)
+        {
+            error = batch->error;
+            return false;
+        }
+        return true;
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto & t : m_workers)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+private:
+    static constexpr int k_max_threads = 256;
+
+    struct Batch
+    {
+        const std::function<void(int)> * fn = nullptr;
+        int count = 0;
+        std::atomic<int> next{0};
+        std::atomic<int> active{0};
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        bool failed = false;
+        std::string error;
+    };
+
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool & operator=(const WorkerPool &) = delete;
+
+    // Caller must hold m_mutex.
+    void ensure_workers(int wanted)
+    {
+        while (static_cast<int>(m_workers.size()) < wanted)
+        {
+            m_workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    // Drop the queue entries of a drained batch that no worker has picked
+    // up. With several threads applying at once, the workers may still be
+    // busy with other callers' batches; the entries have nothing left to
+    // do, so waiting for a worker to reach them would only add latency.
+    void withdraw(const std::shared_ptr<Batch> & batch)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto end = std::remove(m_queue.begin(), m_queue.end(), batch);
+        const int unclaimed = static_cast<int>(m_queue.end() - end);
+        m_queue.erase(end, m_queue.end());
+        if (unclaimed > 0)
+        {
+            std::lock_guard<std::mutex> batch_lock(batch->mutex);
+            batch->active.fetch_sub(unclaimed);
+        }
+    }
+
+    static void drain(Batch & batch)
+    {
+        for (;;)
+        {
+            const int i = batch.next.fetch_add(1);
+            if (i >= batch.count)
+            {
+                return;
+            }
+            try
+            {
+                (*batch.fn)(i);
+            }
+            catch (const std::exception & e)
+            {
+                record_failure(batch, e.what());
+            }
+            catch (...)
+            {
+                record_failure(batch, "unknown error in worker");
+            }
+        }
+    }
+
+    static void record_failure(Batch & batch, const char * what)
+    {
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        if (!batch.failed)
+        {
+            batch.failed = true;
+            batch.error = what ? what : "unknown error in worker";
+        }
+    }
+
+    void worker_loop()
+    {
+        for (;;)
+        {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                if (m_stop && m_queue.empty())
+                {
+                    return;
+                }
+                batch = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            drain(*batch);
+
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (batch->active.fetch_sub(1) == 1)
+            {
+                batch->done_cv.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<Batch>> m_queue;
+    std::vector<std::thread> m_workers;
+    bool m_stop = false;
+};
+
+// Split `rows` into contiguous bands sized for `threads` workers. Several
+// bands per thread keep the load balanced when rows differ in cost.
+inline int band_count(int rows, int threads, int min_rows_per_band = 16)
+{
+    if (rows <= 0)
+    {
+        return 0;
+    }
+    const int by_size = std::max(1, rows / std::max(1, min_rows_per_band));
+    return std::max(1, std::min(by_size, threads * 4));
+}
+
+} // namespace crispen
@@ -0,0 +1,63 @@
+//! Minimal timing harness for the `harness = false` benches of the FFI
+//! crates, so their numbers share one format. Enabled by the `bench`
+//! feature; pulled in as a dev-dependency only.
+
+use std::time::{Duration, Instant};
+
+/// Bytes of one RGBA f32 pixel, the unit of the reported bytes/s.
+pub const RGBA_F32_BYTES: u64 = 16;
+
+pub struct Bench {
+    filter: Option<String>,
+    budget: Duration,
+}
+
+impl Bench {
+    pub fn from_args() -> Self {
+        // `cargo bench` passes `--bench`; the first free argument filters.
+        let filter = std::env::args().skip(1).find(|arg| !arg.starts_with('-'));
+        Self {
+            filter,
+            budget: Duration::from_millis(800),
+        }
+    }
+
+    /// Time `f`, which processes `pixels` pixels per call, until the time
+    /// budget is spent (at least 3 and at most 200 iterations).
+    pub fn run(&self, name: &str, pixels: u64, mut f: impl FnMut()) {
+        if self
+            .filter
+            .as_deref()
+            .is_some_and(|filter| !name.contains(filter))
+        {
+            return;
+        }
+
+        f();
+        let mut samples = Vec::new();
+        let start = Instant::now();
+        while samples.len() < 3 || (start.elapsed() < self.budget && samples.len() < 200) {
+            let t = Instant::now();
+            f();
+            samples.push(t.elapsed());
+        }
+        samples.sort_unstable();
+        report(name, samples[samples.len() / 2], samples.len(), pixels);
+    }
+}
+
+/// Print one result line. `pixels == 0` reports time only.
+pub fn report(name: &str, median: Duration, iterations: usize, pixels: u64) {
+    let secs = median.as_secs_f64().max(f64::MIN_POSITIVE);
+    let throughput = if pixels == 0 {
+        String::new()
+    } else {
+        let mpix = pixels as f64 / secs / 1e6;
+        let gib = (pixels * RGBA_F32_BYTES) as f64 / secs / (1u64 << 30) as f64;
+        format!("{mpix:>10.1} Mpix/s {gib:>8.2} GiB/s")
+    };
+    println!(
+        "{name:<44} {:>10.3} ms {throughput:<30} ({iterations} iters)",
+        secs * 1e3
+    );
+}
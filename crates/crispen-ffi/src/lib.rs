@@ -0,0 +1,12 @@
+//! Pieces shared by the crispen-ocio and crispen-oiio C ABI layers.
+//!
+//! Both crates build their own C++ wrapper, but include the same native
+//! helpers from this crate's `include/` directory (passed to their build
+//! scripts as `DEP_CRISPEN_FFI_INCLUDE`), and wrap them with the Rust code
+//! here so each only declares its externs and stage names.
+#![allow(unsafe_code)]
+// The perf callback trampoline is called from C++.
+
+#[cfg(feature = "bench")]
+pub mod bench;
+pub mod perf;
@@ -0,0 +1,272 @@
+//! Rust side of `crispen/perf_counters.h`.
+//!
+//! Each C API exposes the same counters under its own prefix and stage
+//! enum. [`PerfStats`] and [`PerfCallbackSlot`] hold the snapshot and
+//! callback plumbing once; the crates only supply a [`PerfStage`] and their
+//! `*_perf_*` externs.
+
+use std::cell::Cell;
+use std::ffi::{c_int, c_void};
+use std::marker::PhantomData;
+use std::panic::{AssertUnwindSafe, catch_unwind};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Mutex, MutexGuard, PoisonError, TryLockError};
+use std::time::Duration;
+
+/// Stage enum of one C API.
+pub trait PerfStage: Copy + Send + Sync + 'static {
+    /// Every stage, in C enum order.
+    const ALL: &'static [Self];
+
+    fn to_raw(self) -> c_int;
+
+    fn from_raw(raw: c_int) -> Option<Self> {
+        Self::ALL
+            .iter()
+            .copied()
+            .find(|stage| stage.to_raw() == raw)
+    }
+}
+
+/// `*PerfCounter` as laid out by the C APIs.
+#[repr(C)]
+#[derive(Default, Clone, Copy)]
+pub struct RawPerfCounter {
+    pub calls: u64,
+    pub nanoseconds: u64,
+    pub bytes: u64,
+}
+
+/// `*PerfStats` as laid out by the C APIs.
+#[repr(C)]
+pub struct RawPerfStats<const N: usize> {
+    pub stages: [RawPerfCounter; N],
+}
+
+impl<const N: usize> Default for RawPerfStats<N> {
+    fn default() -> Self {
+        Self {
+            stages: [RawPerfCounter::default(); N],
+        }
+    }
+}
+
+/// `*PerfCallback` as declared by the C APIs.
+pub type RawPerfCallback =
+    Option<unsafe extern "C" fn(user: *mut c_void, stage: c_int, nanoseconds: u64, bytes: u64)>;
+
+/// Cumulative totals for one stage.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct PerfCounter {
+    pub calls: u64,
+    pub time: Duration,
+    pub bytes: u64,
+}
+
+/// Snapshot of every stage's counters.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct PerfStats<S, const N: usize> {
+    stages: [PerfCounter; N],
+    _stage: PhantomData<S>,
+}
+
+impl<S, const N: usize> Default for PerfStats<S, N> {
+    fn default() -> Self {
+        Self {
+            stages: [PerfCounter::default(); N],
+            _stage: PhantomData,
+        }
+    }
+}
+
+impl<S: PerfStage, const N: usize> PerfStats<S, N> {
+    pub fn from_raw(raw: &RawPerfStats<N>) -> Self {
+        Self {
+            stages: raw.stages.map(|counter| PerfCounter {
+                calls: counter.calls,
+                time: Duration::from_nanos(counter.nanoseconds),
+                bytes: counter.bytes,
+            }),
+            _stage: PhantomData,
+        }
+    }
+
+    pub fn get(&self, stage: S) -> PerfCounter {
+        usize::try_from(stage.to_raw())
+            .ok()
+            .and_then(|i| self.stages.get(i))
+            .copied()
+            .unwrap_or_default()
+    }
+
+    pub fn iter(&self) -> impl Iterator<Item = (S, PerfCounter)> + '_ {
+        S::ALL.iter().map(|&stage| (stage, self.get(stage)))
+    }
+}
+
+/// Per-call callback: stage, wall time and bytes processed.
+pub type PerfCallback<S> = Box<dyn Fn(S, Duration, u64) + Send + Sync>;
+
+/// The callback registered with one C API, kept alive here while the C
+/// side may call it.
+///
+/// Callbacks may replace the callback themselves. A replaced callback is
+/// only dropped once no call of any callback of this slot is running, since
+/// the call that replaced it may still be on the stack.
+pub struct PerfCallbackSlot<S: 'static> {
+    current: Mutex<Option<Box<SlotEntry<S>>>>,
+    // Set from inside a callback while another thread holds `current`
+    // (which may be waiting for that callback to return); applied by that
+    // thread before it releases `current`.
+    pending: Mutex<Option<Option<PerfCallback<S>>>>,
+    active: AtomicUsize,
+    // Boxed so entries keep the address the C side was given.
+    #[allow(clippy::vec_box)]
+    retired: Mutex<Vec<Box<SlotEntry<S>>>>,
+}
+
+struct SlotEntry<S: 'static> {
+    slot: &'static PerfCallbackSlot<S>,
+    callback: PerfCallback<S>,
+}
+
+thread_local! {
+    // Perf callbacks this thread is currently running.
+    static CALLBACK_DEPTH: Cell<u32> = const { Cell::new(0) };
+}
+
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+impl<S: PerfStage> PerfCallbackSlot<S> {
+    pub const fn new() -> Self {
+        Self {
+            current: Mutex::new(None),
+            pending: Mutex::new(None),
+            active: AtomicUsize::new(0),
+            retired: Mutex::new(Vec::new()),
+        }
+    }
+
+    /// Replace the registered callback; `None` unregisters.
+    ///
+    /// Called from inside a callback while another thread is replacing the
+    /// callback too, the change is handed to that thread and applied before
+    /// its own call returns.
+    ///
+    /// # Safety
+    ///
+    /// `register` must install `(callback, user)` with the C API's
+    /// `*_perf_set_callback`, which guarantees that once it returns no call
+    /// of the previously installed callback is still running on another
+    /// thread.
+    pub unsafe fn set(
+        &'static self,
+        callback: Option<PerfCallback<S>>,
+        register: impl Fn(RawPerfCallback, *mut c_void),
+    ) {
+        let mut current = if CALLBACK_DEPTH.get() == 0 {
+            lock(&self.current)
+        } else {
+            match self.current.try_lock() {
+                Ok(current) => current,
+                Err(TryLockError::Poisoned(e)) => e.into_inner(),
+                Err(TryLockError::WouldBlock) => {
+                    // The holder checks `pending` under this lock before
+                    // releasing `current`, so retry once while holding it.
+                    let mut pending = lock(&self.pending);
+                    match self.current.try_lock() {
+                        Ok(current) => {
+                            drop(pending);
+                            current
+                        }
+                        Err(TryLockError::Poisoned(e)) => {
+                            drop(pending);
+                            e.into_inner()
+                        }
+                        Err(TryLockError::WouldBlock) => {
+                            *pending = Some(callback);
+                            return;
+                        }
+                    }
+                }
+            }
+        };
+
+        let mut callback = callback;
+        loop {
+            let entry = callback.map(|callback| {
+                Box::new(SlotEntry {
+                    slot: self,
+                    callback,
+                })
+            });
+            match &entry {
+                // The boxed entry stays at a stable address until it is
+                // replaced and retired.
+                Some(entry) => register(
+                    Some(trampoline::<S>),
+                    std::ptr::from_ref::<SlotEntry<S>>(entry).cast_mut().cast(),
+                ),
+                None => register(None, std::ptr::null_mut()),
+            }
+            if let Some(old) = std::mem::replace(&mut *current, entry) {
+                self.retire(old);
+            }
+
+            let mut pending = lock(&self.pending);
+            match pending.take() {
+                Some(next) => callback = next,
+                None => {
+                    drop(current);
+                    drop(pending);
+                    return;
+                }
+            }
+        }
+    }
+
+    fn retire(&self, entry: Box<SlotEntry<S>>) {
+        let mut retired = lock(&self.retired);
+        if self.active.load(Ordering::SeqCst) == 0 {
+            drop(retired);
+            drop(entry);
+        } else {
+            retired.push(entry);
+        }
+    }
+}
+
+impl<S: PerfStage> Default for PerfCallbackSlot<S> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+unsafe extern "C" fn trampoline<S: PerfStage>(
+    user: *mut c_void,
+    stage: c_int,
+    nanoseconds: u64,
+    bytes: u64,
+) {
+    let Some(stage) = S::from_raw(stage) else {
+        return;
+    };
+    // SAFETY: `user` is an entry installed by `PerfCallbackSlot::set`. The
+    // C side stops calling an entry before `set` retires it, and retired
+    // entries are only dropped once `active` is back to zero.
+    let entry = unsafe { &*user.cast::<SlotEntry<S>>() };
+    let slot = entry.slot;
+    slot.active.fetch_add(1, Ordering::SeqCst);
+    CALLBACK_DEPTH.set(CALLBACK_DEPTH.get() + 1);
+    // A panic must not unwind into C++.
+    let _ = catch_unwind(AssertUnwindSafe(|| {
+        (entry.callback)(stage, Duration::from_nanos(nanoseconds), bytes)
+    }));
+    CALLBACK_DEPTH.set(CALLBACK_DEPTH.get() - 1);
+    if slot.active.fetch_sub(1, Ordering::SeqCst) == 1 {
+        let retired = std::mem::take(&mut *lock(&slot.retired));
+        drop(retired);
+    }
+}
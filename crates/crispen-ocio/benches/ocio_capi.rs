@@ -0,0 +1,209 @@
+//! Throughput benchmarks for the ocio_capi hot paths.
+//!
+//! Run with `cargo bench -p crispen-ocio [-- <filter>]`. Each case reports
+//! the median time per iteration plus pixels/s and bytes/s (RGBA f32 bytes
+//! transformed), so runs can be compared across commits and machines.
+//!
+//! Needs an OCIO config: a built-in studio config (OCIO 2.2+) or `$OCIO`.
+
+use std::hint::black_box;
+
+use crispen_ffi::bench::Bench;
+use crispen_ocio::{
+    OcioConfig, OcioCpuProcessor, OcioLutInterpolation, apply_lut3d_rgba, clear_processor_cache,
+    lut3d_kernel_name, set_lut_cache_directory,
+};
+
+fn load_config() -> Option<OcioConfig> {
+    [
+        "ocio://studio-config-latest",
+        "studio-config-v4.0.0_aces-v2.0_ocio-v2.5",
+        "studio-config-v2.2.0_aces-v1.3_ocio-v2.4",
+        "ocio://default",
+    ]
+    .into_iter()
+    .find_map(|uri| OcioConfig::builtin(uri).ok())
+    .or_else(|| OcioConfig::from_env().ok())
+}
+
+/// Scene-linear -> default display/view: the ODT the viewer bakes and the
+/// heaviest transform in a typical session.
+struct Transform {
+    src: String,
+    display: String,
+    view: String,
+}
+
+impl Transform {
+    fn pick(config: &OcioConfig) -> Self {
+        let display = config.default_display();
+        let view = config.default_view(&display);
+        let src = config
+            .role("scene_linear")
+            .unwrap_or_else(|| "ACEScg".to_string());
+        Self { src, display, view }
+    }
+
+    fn cpu(&self, config: &OcioConfig) -> OcioCpuProcessor {
+        config
+            .display_view_processor(&self.src, &self.display, &self.view)
+            .and_then(|p| p.cpu_f32())
+            .expect("display/view processor should build")
+    }
+}
+
+fn test_pattern(width: u32, height: u32) -> Vec<[f32; 4]> {
+    (0..width as usize * height as usize)
+        .map(|i| {
+            let x = (i % width as usize) as f32 / width as f32;
+            let y = (i / width as usize) as f32 / height as f32;
+            [x * 4.0, y, (x + y) * 0.5, 1.0]
+        })
+        .collect()
+}
+
+fn bench_apply(bench: &Bench, cpu: &OcioCpuProcessor) {
+    let lut_size = 65_u32;
+    let lut = cpu.bake_3d_lut(lut_size).expect("LUT bake should succeed");
+    for (label, width, height) in [
+        ("1080p", 1920, 1080),
+        ("4k", 3840, 2160),
+        ("8k", 7680, 4320),
+    ] {
+        let source = test_pattern(width, height);
+        let mut pixels = source.clone();
+        let count = u64::from(width) * u64::from(height);
+
+        bench.run(&format!("apply_rgba/{label}"), count, || {
+            pixels.copy_from_slice(&source);
+            cpu.apply_rgba(black_box(&mut pixels), width, height)
+                .expect("apply should succeed");
+        });
+        bench.run(&format!("apply_rgba_threaded/{label}"), count, || {
+            pixels.copy_from_slice(&source);
+            cpu.apply_rgba_threaded(black_box(&mut pixels), width, height, 0)
+                .expect("apply should succeed");
+        });
+        // The same transform through its baked 65^3 LUT.
+        for (interp, interpolation) in [
+            ("trilinear", OcioLutInterpolation::Trilinear),
+            ("tetrahedral", OcioLutInterpolation::Tetrahedral),
+        ] {
+            bench.run(&format!("lut3d_apply_{interp}/{label}"), count, || {
+                pixels.copy_from_slice(&source);
+                apply_lut3d_rgba(
+                    &lut,
+                    lut_size,
+                    black_box(&mut pixels),
+                    width,
+                    height,
+                    interpolation,
+                    0,
+                )
+                .expect("LUT apply should succeed");
+            });
+        }
+    }
+}
+
+fn bench_lut_bake(bench: &Bench, cpu: &OcioCpuProcessor) {
+    for size in [33_u32, 65] {
+        let count = u64::from(size).pow(3);
+        let denom = (size - 1) as f32;
+
+        bench.run(&format!("lut_bake/per_pixel/{size}"), count, || {
+            let mut lut = Vec::with_capacity(count as usize);
+            for b in 0..size {
+                for g in 0..size {
+                    for r in 0..size {
+                        let mut rgb = [r as f32 / denom, g as f32 / denom, b as f32 / denom];
+                        cpu.apply_pixel(&mut rgb)
+                            .expect("pixel apply should succeed");
+                        lut.push([rgb[0], rgb[1], rgb[2], 1.0]);
+                    }
+                }
+            }
+            black_box(lut);
+        });
+        bench.run(&format!("lut_bake/batched/{size}"), count, || {
+            black_box(cpu.bake_3d_lut(size).expect("LUT bake should succeed"));
+        });
+    }
+
+    let dir = std::env::temp_dir().join(format!("crispen-lut-bench-{}", std::process::id()));
+    if set_lut_cache_directory(Some(&dir)).is_ok() {
+        for size in [33_u32, 65] {
+            bench.run(
+                &format!("lut_bake/disk_cache_hit/{size}"),
+                u64::from(size).pow(3),
+                || {
+                    let lut = cpu
+                        .bake_3d_lut_cached(size)
+                        .expect("LUT bake should succeed");
+                    black_box(lut.as_slice()[0]);
+                },
+            );
+        }
+        let _ = set_lut_cache_directory(None);
+        let _ = std::fs::remove_dir_all(&dir);
+    }
+}
+
+/// Sparse sampling as done by scope overlays and auto-balance.
+fn bench_points(bench: &Bench, cpu: &OcioCpuProcessor) {
+    let count = 4096_usize;
+    let source: Vec<[f32; 3]> = (0..count)
+        .map(|i| {
+            let t = i as f32 / count as f32;
+            [t, (t * 7.0).fract(), 1.0 - t]
+        })
+        .collect();
+    let mut points = source.clone();
+
+    bench.run(&format!("points/per_pixel/{count}"), count as u64, || {
+        points.copy_from_slice(&source);
+        for rgb in &mut points {
+            cpu.apply_pixel(black_box(rgb))
+                .expect("pixel apply should succeed");
+        }
+    });
+    bench.run(&format!("points/batched/{count}"), count as u64, || {
+        points.copy_from_slice(&source);
+        cpu.apply_rgb_points(black_box(&mut points))
+            .expect("batched apply should succeed");
+    });
+}
+
+/// "Cold" drops Crispen's processor caches before each build; OCIO's own
+/// per-config processor cache still applies, as it does in the app.
+fn bench_processor_creation(bench: &Bench, config: &OcioConfig, transform: &Transform) {
+    bench.run("processor_create/cold", 0, || {
+        clear_processor_cache();
+        black_box(transform.cpu(config));
+    });
+    bench.run("processor_create/warm", 0, || {
+        black_box(transform.cpu(config));
+    });
+}
+
+fn main() {
+    let Some(config) = load_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let bench = Bench::from_args();
+    let transform = Transform::pick(&config);
+    let cpu = transform.cpu(&config);
+    println!(
+        "transform: {} -> {} / {} (LUT kernel: {})",
+        transform.src,
+        transform.display,
+        transform.view,
+        lut3d_kernel_name()
+    );
+
+    bench_apply(&bench, &cpu);
+    bench_lut_bake(&bench, &cpu);
+    bench_points(&bench, &cpu);
+    bench_processor_creation(&bench, &config, &transform);
+}
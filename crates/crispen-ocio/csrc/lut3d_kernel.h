@@ -0,0 +1,507 @@
+#pragma once
+
+// CPU apply of baked RGBA f32 3D LUTs.
+//
+// Lattices use the ocio_cpu_processor_bake_lut3d layout: size^3 RGBA
+// entries, red fastest, covering [0, 1] per axis. Inputs are clamped to
+// that domain (NaN maps to 0), alpha passes through untouched, and the LUT
+// alpha is ignored.
+//
+// Both interpolations use the same weight formulation in every kernel so
+// the scalar tail of a row matches its vector body. Trilinear is the
+// filtering a GPU applies when sampling the same lattice as a 3D texture;
+// tetrahedral is smoother along the neutral axis and touches 4 entries
+// instead of 8.
+//
+// Kernels: AVX-512F and AVX2+FMA gathers (8/16 pixels per step) chosen at
+// runtime on x86 GCC/Clang builds, NEON (one RGBA entry per register) on
+// AArch64, and a portable scalar fallback.
+
+#include <algorithm>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CRISPEN_LUT3D_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CRISPEN_LUT3D_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace crispen
+{
+
+enum class Lut3dInterp
+{
+    Trilinear,
+    Tetrahedral
+};
+
+// Largest lattice whose float offsets fit the 32-bit gather indices.
+constexpr int k_lut3d_max_size = 256;
+
+namespace lut3d_detail
+{
+
+inline float clamp01(float v)
+{
+    return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+}
+
+// Lattice cell and fraction along one axis; `scale` is size - 1.
+inline int cell(float v, float scale, int max_cell, float & frac)
+{
+    const float x = clamp01(v) * scale;
+    const int i = std::min(static_cast<int>(x), max_cell);
+    frac = x - static_cast<float>(i);
+    return i;
+}
+
+// Strides in floats between neighbouring entries along r, g, b.
+struct Strides
+{
+    int r;
+    int g;
+    int b;
+
+    explicit Strides(int size) : r(4), g(4 * size), b(4 * size * size) {}
+};
+
+// Tetrahedral corners for fractions (fr, fg, fb). The walk from (0,0,0)
+// to (1,1,1) steps along the largest fraction first (`o1`) and the
+// smallest last (`o2` is the opposite corner minus that axis). Ties pick
+// any valid tetrahedron since the tied weight is zero.
+inline void tetra_offsets(float fr, float fg, float fb, const Strides & s, int & o1, int & o2)
+{
+    const bool r_ge_g = fr >= fg;
+    const bool r_ge_b = fr >= fb;
+    const bool g_ge_b = fg >= fb;
+    o1 = (r_ge_g && r_ge_b) ? s.r : (g_ge_b ? s.g : s.b);
+    const int omin = (g_ge_b && r_ge_b) ? s.b : (r_ge_g ? s.g : s.r);
+    o2 = s.r + s.g + s.b - omin;
+}
+
+inline void apply_scalar(const float * lut, int size, float * px, long count, Lut3dInterp interp)
+{
+    const float scale = static_cast<float>(size - 1);
+    const int max_cell = size - 2;
+    const Strides s(size);
+
+    for (long n = 0; n < count; ++n, px += 4)
+    {
+        float fr;
+        float fg;
+        float fb;
+        const int base = cell(px[0], scale, max_cell, fr) * s.r
+                         + cell(px[1], scale, max_cell, fg) * s.g
+                         + cell(px[2], scale, max_cell, fb) * s.b;
+        const float * c0 = lut + base;
+
+        if (interp == Lut3dInterp::Tetrahedral)
+        {
+            int o1;
+            int o2;
+            tetra_offsets(fr, fg, fb, s, o1, o2);
+            const float f1 = std::max(std::max(fr, fg), fb);
+            const float f3 = std::min(std::min(fr, fg), fb);
+            const float f2 = fr + fg + fb - f1 - f3;
+            const float * c1 = c0 + o1;
+            const float * c2 = c0 + o2;
+            const float * c3 = c0 + s.r + s.g + s.b;
+            for (int c = 0; c < 3; ++c)
+            {
+                px[c] = c0[c] * (1.0f - f1) + c1[c] * (f1 - f2) + c2[c] * (f2 - f3) + c3[c] * f3;
+            }
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const float * e = c0 + c;
+                const float x00 = e[0] + fr * (e[s.r] - e[0]);
+                const float x10 = e[s.g] + fr * (e[s.g + s.r] - e[s.g]);
+                const float x01 = e[s.b] + fr * (e[s.b + s.r] - e[s.b]);
+                const float x11 = e[s.b + s.g] + fr * (e[s.b + s.g + s.r] - e[s.b + s.g]);
+                const float y0 = x00 + fg * (x10 - x00);
+                const float y1 = x01 + fg * (x11 - x01);
+                px[c] = y0 + fb * (y1 - y0);
+            }
+        }
+    }
+}
+
+#if CRISPEN_LUT3D_X86
+
+// Lambdas do not inherit a function's target attribute, so the per-ISA
+// helpers are free functions carrying it themselves.
+#define CRISPEN_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CRISPEN_TARGET_AVX512 __attribute__((target("avx512f")))
+
+CRISPEN_TARGET_AVX2 inline __m256i avx2_cell(
+    __m256 v,
+    __m256 scale,
+    __m256i max_cell,
+    __m256 & frac
+)
+{
+    // max(v, 0) returns 0 for NaN, like clamp01.
+    const __m256 x = _mm256_mul_ps(
+        _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f)), scale
+    );
+    const __m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(x), max_cell);
+    frac = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+    return i;
+}
+
+// `b` where `mask` is set, else `a`.
+CRISPEN_TARGET_AVX2 inline __m256i avx2_pick(__m256i a, __m256i b, __m256 mask)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_castps_si256(mask));
+}
+
+CRISPEN_TARGET_AVX2 inline __m256 avx2_lerp(__m256 a, __m256 b, __m256 f)
+{
+    return _mm256_fmadd_ps(f, _mm256_sub_ps(b, a), a);
+}
+
+CRISPEN_TARGET_AVX2 inline void apply_avx2(
+    const float * lut,
+    int size,
+    float * px,
+    long count,
+    Lut3dInterp interp
+)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(size - 1));
+    const __m256i max_cell = _mm256_set1_epi32(size - 2);
+    const Strides st(size);
+    const __m256i sr = _mm256_set1_epi32(st.r);
+    const __m256i sg = _mm256_set1_epi32(st.g);
+    const __m256i sb = _mm256_set1_epi32(st.b);
+    const __m256i s111 = _mm256_set1_epi32(st.r + st.g + st.b);
+    const __m256i lanes = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    const bool tetra = interp == Lut3dInterp::Tetrahedral;
+
+    long n = 0;
+    for (; n + 8 <= count; n += 8)
+    {
+        float * p = px + n * 4;
+        __m256 fr;
+        __m256 fg;
+        __m256 fb;
+        const __m256i ir = avx2_cell(_mm256_i32gather_ps(p, lanes, 4), scale, max_cell, fr);
+        const __m256i ig = avx2_cell(_mm256_i32gather_ps(p + 1, lanes, 4), scale, max_cell, fg);
+        const __m256i ib = avx2_cell(_mm256_i32gather_ps(p + 2, lanes, 4), scale, max_cell, fb);
+        const __m256i base = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_mullo_epi32(ir, sr), _mm256_mullo_epi32(ig, sg)),
+            _mm256_mullo_epi32(ib, sb)
+        );
+
+        alignas(32) float out[3][8];
+        if (tetra)
+        {
+            const __m256 r_ge_g = _mm256_cmp_ps(fr, fg, _CMP_GE_OQ);
+            const __m256 r_ge_b = _mm256_cmp_ps(fr, fb, _CMP_GE_OQ);
+            const __m256 g_ge_b = _mm256_cmp_ps(fg, fb, _CMP_GE_OQ);
+            const __m256i o1 =
+                avx2_pick(avx2_pick(sb, sg, g_ge_b), sr, _mm256_and_ps(r_ge_g, r_ge_b));
+            const __m256i omin =
+                avx2_pick(avx2_pick(sr, sg, r_ge_g), sb, _mm256_and_ps(g_ge_b, r_ge_b));
+            const __m256i i1 = _mm256_add_epi32(base, o1);
+            const __m256i i2 = _mm256_add_epi32(base, _mm256_sub_epi32(s111, omin));
+            const __m256i i3 = _mm256_add_epi32(base, s111);
+
+            const __m256 f1 = _mm256_max_ps(_mm256_max_ps(fr, fg), fb);
+            const __m256 f3 = _mm256_min_ps(_mm256_min_ps(fr, fg), fb);
+            const __m256 f2 =
+                _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(fr, fg), fb), f1), f3);
+            const __m256 w0 = _mm256_sub_ps(one, f1);
+            const __m256 w1 = _mm256_sub_ps(f1, f2);
+            const __m256 w2 = _mm256_sub_ps(f2, f3);
+
+            for (int c = 0; c < 3; ++c)
+            {
+                const float * e = lut + c;
+                __m256 v = _mm256_mul_ps(_mm256_i32gather_ps(e, base, 4), w0);
+                v = _mm256_fmadd_ps(_mm256_i32gather_ps(e, i1, 4), w1, v);
+                v = _mm256_fmadd_ps(_mm256_i32gather_ps(e, i2, 4), w2, v);
+                v = _mm256_fmadd_ps(_mm256_i32gather_ps(e, i3, 4), f3, v);
+                _mm256_store_ps(out[c], v);
+            }
+        }
+        else
+        {
+            const __m256i i_g = _mm256_add_epi32(base, sg);
+            const __m256i i_b = _mm256_add_epi32(base, sb);
+            const __m256i i_bg = _mm256_add_epi32(i_b, sg);
+            for (int c = 0; c < 3; ++c)
+            {
+                const float * e = lut + c;
+                const float * er = e + st.r;
+                const __m256 x00 = avx2_lerp(
+                    _mm256_i32gather_ps(e, base, 4), _mm256_i32gather_ps(er, base, 4), fr
+                );
+                const __m256 x10 = avx2_lerp(
+                    _mm256_i32gather_ps(e, i_g, 4), _mm256_i32gather_ps(er, i_g, 4), fr
+                );
+                const __m256 x01 = avx2_lerp(
+                    _mm256_i32gather_ps(e, i_b, 4), _mm256_i32gather_ps(er, i_b, 4), fr
+                );
+                const __m256 x11 = avx2_lerp(
+                    _mm256_i32gather_ps(e, i_bg, 4), _mm256_i32gather_ps(er, i_bg, 4), fr
+                );
+                _mm256_store_ps(
+                    out[c], avx2_lerp(avx2_lerp(x00, x10, fg), avx2_lerp(x01, x11, fg), fb)
+                );
+            }
+        }
+
+        for (int k = 0; k < 8; ++k)
+        {
+            p[k * 4 + 0] = out[0][k];
+            p[k * 4 + 1] = out[1][k];
+            p[k * 4 + 2] = out[2][k];
+        }
+    }
+    apply_scalar(lut, size, px + n * 4, count - n, interp);
+}
+
+// GCC 12's AVX-512 gather/convert intrinsics trip -Wmaybe-uninitialized on
+// their own placeholder operands.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+CRISPEN_TARGET_AVX512 inline __m512i avx512_cell(
+    __m512 v,
+    __m512 scale,
+    __m512i max_cell,
+    __m512 & frac
+)
+{
+    const __m512 x = _mm512_mul_ps(
+        _mm512_min_ps(_mm512_max_ps(v, _mm512_setzero_ps()), _mm512_set1_ps(1.0f)), scale
+    );
+    const __m512i i = _mm512_min_epi32(_mm512_cvttps_epi32(x), max_cell);
+    frac = _mm512_sub_ps(x, _mm512_cvtepi32_ps(i));
+    return i;
+}
+
+CRISPEN_TARGET_AVX512 inline __m512 avx512_lerp(__m512 a, __m512 b, __m512 f)
+{
+    return _mm512_fmadd_ps(f, _mm512_sub_ps(b, a), a);
+}
+
+CRISPEN_TARGET_AVX512 inline void apply_avx512(
+    const float * lut,
+    int size,
+    float * px,
+    long count,
+    Lut3dInterp interp
+)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 scale = _mm512_set1_ps(static_cast<float>(size - 1));
+    const __m512i max_cell = _mm512_set1_epi32(size - 2);
+    const Strides st(size);
+    const __m512i sr = _mm512_set1_epi32(st.r);
+    const __m512i sg = _mm512_set1_epi32(st.g);
+    const __m512i sb = _mm512_set1_epi32(st.b);
+    const __m512i s111 = _mm512_set1_epi32(st.r + st.g + st.b);
+    const __m512i lanes =
+        _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60);
+    const bool tetra = interp == Lut3dInterp::Tetrahedral;
+
+    long n = 0;
+    for (; n + 16 <= count; n += 16)
+    {
+        float * p = px + n * 4;
+        __m512 fr;
+        __m512 fg;
+        __m512 fb;
+        const __m512i ir = avx512_cell(_mm512_i32gather_ps(lanes, p, 4), scale, max_cell, fr);
+        const __m512i ig = avx512_cell(_mm512_i32gather_ps(lanes, p + 1, 4), scale, max_cell, fg);
+        const __m512i ib = avx512_cell(_mm512_i32gather_ps(lanes, p + 2, 4), scale, max_cell, fb);
+        const __m512i base = _mm512_add_epi32(
+            _mm512_add_epi32(_mm512_mullo_epi32(ir, sr), _mm512_mullo_epi32(ig, sg)),
+            _mm512_mullo_epi32(ib, sb)
+        );
+
+        __m512 out[3];
+        if (tetra)
+        {
+            const __mmask16 r_ge_g = _mm512_cmp_ps_mask(fr, fg, _CMP_GE_OQ);
+            const __mmask16 r_ge_b = _mm512_cmp_ps_mask(fr, fb, _CMP_GE_OQ);
+            const __mmask16 g_ge_b = _mm512_cmp_ps_mask(fg, fb, _CMP_GE_OQ);
+            const __m512i o1 = _mm512_mask_blend_epi32(
+                r_ge_g & r_ge_b, _mm512_mask_blend_epi32(g_ge_b, sb, sg), sr
+            );
+            const __m512i omin = _mm512_mask_blend_epi32(
+                g_ge_b & r_ge_b, _mm512_mask_blend_epi32(r_ge_g, sr, sg), sb
+            );
+            const __m512i i1 = _mm512_add_epi32(base, o1);
+            const __m512i i2 = _mm512_add_epi32(base, _mm512_sub_epi32(s111, omin));
+            const __m512i i3 = _mm512_add_epi32(base, s111);
+
+            const __m512 f1 = _mm512_max_ps(_mm512_max_ps(fr, fg), fb);
+            const __m512 f3 = _mm512_min_ps(_mm512_min_ps(fr, fg), fb);
+            const __m512 f2 =
+                _mm512_sub_ps(_mm512_sub_ps(_mm512_add_ps(_mm512_add_ps(fr, fg), fb), f1), f3);
+            const __m512 w0 = _mm512_sub_ps(one, f1);
+            const __m512 w1 = _mm512_sub_ps(f1, f2);
+            const __m512 w2 = _mm512_sub_ps(f2, f3);
+
+            for (int c = 0; c < 3; ++c)
+            {
+                const float * e = lut + c;
+                __m512 v = _mm512_mul_ps(_mm512_i32gather_ps(base, e, 4), w0);
+                v = _mm512_fmadd_ps(_mm512_i32gather_ps(i1, e, 4), w1, v);
+                v = _mm512_fmadd_ps(_mm512_i32gather_ps(i2, e, 4), w2, v);
+                out[c] = _mm512_fmadd_ps(_mm512_i32gather_ps(i3, e, 4), f3, v);
+            }
+        }
+        else
+        {
+            const __m512i i_g = _mm512_add_epi32(base, sg);
+            const __m512i i_b = _mm512_add_epi32(base, sb);
+            const __m512i i_bg = _mm512_add_epi32(i_b, sg);
+            for (int c = 0; c < 3; ++c)
+            {
+                const float * e = lut + c;
+                const float * er = e + st.r;
+                const __m512 x00 = avx512_lerp(
+                    _mm512_i32gather_ps(base, e, 4), _mm512_i32gather_ps(base, er, 4), fr
+                );
+                const __m512 x10 = avx512_lerp(
+                    _mm512_i32gather_ps(i_g, e, 4), _mm512_i32gather_ps(i_g, er, 4), fr
+                );
+                const __m512 x01 = avx512_lerp(
+                    _mm512_i32gather_ps(i_b, e, 4), _mm512_i32gather_ps(i_b, er, 4), fr
+                );
+                const __m512 x11 = avx512_lerp(
+                    _mm512_i32gather_ps(i_bg, e, 4), _mm512_i32gather_ps(i_bg, er, 4), fr
+                );
+                out[c] = avx512_lerp(avx512_lerp(x00, x10, fg), avx512_lerp(x01, x11, fg), fb);
+            }
+        }
+
+        // Scatter back over R, G and B only so alpha is left untouched.
+        _mm512_i32scatter_ps(p, lanes, out[0], 4);
+        _mm512_i32scatter_ps(p + 1, lanes, out[1], 4);
+        _mm512_i32scatter_ps(p + 2, lanes, out[2], 4);
+    }
+    apply_scalar(lut, size, px + n * 4, count - n, interp);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#undef CRISPEN_TARGET_AVX2
+#undef CRISPEN_TARGET_AVX512
+
+#endif // CRISPEN_LUT3D_X86
+
+#if CRISPEN_LUT3D_NEON
+
+// Each lattice entry is one RGBA register, so a pixel is a handful of
+// vector multiply-adds over 4 (tetrahedral) or 8 (trilinear) loads.
+inline void apply_neon(const float * lut, int size, float * px, long count, Lut3dInterp interp)
+{
+    const float scale = static_cast<float>(size - 1);
+    const int max_cell = size - 2;
+    const Strides s(size);
+    const int s111 = s.r + s.g + s.b;
+
+    for (long n = 0; n < count; ++n, px += 4)
+    {
+        float fr;
+        float fg;
+        float fb;
+        const int base = cell(px[0], scale, max_cell, fr) * s.r
+                         + cell(px[1], scale, max_cell, fg) * s.g
+                         + cell(px[2], scale, max_cell, fb) * s.b;
+        const float * c0 = lut + base;
+        float32x4_t v;
+
+        if (interp == Lut3dInterp::Tetrahedral)
+        {
+            int o1;
+            int o2;
+            tetra_offsets(fr, fg, fb, s, o1, o2);
+            const float f1 = std::max(std::max(fr, fg), fb);
+            const float f3 = std::min(std::min(fr, fg), fb);
+            const float f2 = fr + fg + fb - f1 - f3;
+            v = vmulq_n_f32(vld1q_f32(c0), 1.0f - f1);
+            v = vfmaq_n_f32(v, vld1q_f32(c0 + o1), f1 - f2);
+            v = vfmaq_n_f32(v, vld1q_f32(c0 + o2), f2 - f3);
+            v = vfmaq_n_f32(v, vld1q_f32(c0 + s111), f3);
+        }
+        else
+        {
+            const auto lerp = [](float32x4_t a, float32x4_t b, float f) {
+                return vfmaq_n_f32(a, vsubq_f32(b, a), f);
+            };
+            const float32x4_t x00 = lerp(vld1q_f32(c0), vld1q_f32(c0 + s.r), fr);
+            const float32x4_t x10 = lerp(vld1q_f32(c0 + s.g), vld1q_f32(c0 + s.g + s.r), fr);
+            const float32x4_t x01 = lerp(vld1q_f32(c0 + s.b), vld1q_f32(c0 + s.b + s.r), fr);
+            const float32x4_t x11 =
+                lerp(vld1q_f32(c0 + s.b + s.g), vld1q_f32(c0 + s111), fr);
+            v = lerp(lerp(x00, x10, fg), lerp(x01, x11, fg), fb);
+        }
+        vst1q_f32(px, vsetq_lane_f32(px[3], v, 3));
+    }
+}
+
+#endif // CRISPEN_LUT3D_NEON
+
+using Kernel = void (*)(const float *, int, float *, long, Lut3dInterp);
+
+struct Dispatch
+{
+    Kernel kernel;
+    const char * name;
+};
+
+inline Dispatch select()
+{
+#if CRISPEN_LUT3D_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return {apply_avx512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return {apply_avx2, "avx2"};
+    }
+#elif CRISPEN_LUT3D_NEON
+    return {apply_neon, "neon"};
+#endif
+    return {apply_scalar, "scalar"};
+}
+
+inline const Dispatch & dispatch()
+{
+    static const Dispatch d = select();
+    return d;
+}
+
+} // namespace lut3d_detail
+
+// Apply `lut` in place to `count` packed RGBA f32 pixels with the best
+// kernel for this CPU. `size` must be in [2, k_lut3d_max_size].
+inline void apply_lut3d(const float * lut, int size, float * pixels, long count, Lut3dInterp interp)
+{
+    lut3d_detail::dispatch().kernel(lut, size, pixels, count, interp);
+}
+
+// "avx512", "avx2", "neon" or "scalar".
+inline const char * lut3d_kernel_name()
+{
+    return lut3d_detail::dispatch().name;
+}
+
+} // namespace crispen
@@ -0,0 +1,202 @@
+#pragma once
+
+// Persistent on-disk cache for baked 3D LUTs.
+//
+// Baking a 65^3 LUT through a heavy ACES display transform takes long
+// enough to show up at startup and on every view switch. Baked lattices are
+// written to `<dir>/lut3d_<hash>_<size>.bin`, keyed by the CPU processor
+// cache ID (stable across launches for the same config contents) and the
+// lattice size, and later opened with a read-only memory mapping so a hit
+// costs no compute and no copy.
+//
+// File layout: a 64-byte aligned header (magic, size, key length, key
+// bytes) followed by size^3 RGBA f32 entries. The full key is stored so a
+// hash collision is detected instead of returning the wrong LUT.
+
+#include "crispen/mapped_file.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace crispen
+{
+
+class LutDiskCache
+{
+public:
+    static LutDiskCache & instance()
+    {
+        static LutDiskCache cache;
+        return cache;
+    }
+
+    // Empty disables the cache. The directory is created on first write.
+    void set_directory(std::string dir)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dir = std::move(dir);
+    }
+
+    std::string directory() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_dir;
+    }
+
+    // Map a previously stored LUT; null on a miss or a stale/corrupt file.
+    // `out_data` points at the size^3 RGBA f32 entries inside the mapping.
+    std::unique_ptr<MappedFile> load(const std::string & key, int size, const float *& out_data)
+    {
+        const std::string dir = directory();
+        if (dir.empty())
+        {
+            return nullptr;
+        }
+        auto file = MappedFile::open(file_path(dir, key, size));
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        const std::size_t offset = data_offset(key);
+        const std::size_t expected = offset + lut_bytes(size);
+        const unsigned char * p = file->data();
+        std::uint32_t stored_size = 0;
+        std::uint32_t key_len = 0;
+        if (file->size() != expected || std::memcmp(p, k_magic, sizeof(k_magic)) != 0)
+        {
+            return nullptr;
+        }
+        std::memcpy(&stored_size, p + 8, sizeof(stored_size));
+        std::memcpy(&key_len, p + 12, sizeof(key_len));
+        if (stored_size != static_cast<std::uint32_t>(size) || key_len != key.size()
+            || std::memcmp(p + k_fixed_header, key.data(), key.size()) != 0)
+        {
+            return nullptr;
+        }
+        out_data = reinterpret_cast<const float *>(p + offset);
+        return file;
+    }
+
+    // Write a baked LUT. The file is written under a temporary name and
+    // renamed into place, so concurrent readers never see a partial file.
+    // Failures are not fatal to the caller: the LUT is simply re-baked next
+    // time.
+    bool store(const std::string & key, int size, const float * data)
+    {
+        const std::string dir = directory();
+        if (dir.empty())
+        {
+            return false;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        const std::filesystem::path path = file_path(dir, key, size);
+        std::filesystem::path tmp = path;
+        tmp += temp_suffix();
+
+        std::string header(data_offset(key), '\0');
+        std::memcpy(&header[0], k_magic, sizeof(k_magic));
+        const std::uint32_t stored_size = static_cast<std::uint32_t>(size);
+        const std::uint32_t key_len = static_cast<std::uint32_t>(key.size());
+        std::memcpy(&header[8], &stored_size, sizeof(stored_size));
+        std::memcpy(&header[12], &key_len, sizeof(key_len));
+        std::memcpy(&header[k_fixed_header], key.data(), key.size());
+
+        std::FILE * f = std::fopen(tmp.string().c_str(), "wb");
+        if (!f)
+        {
+            return false;
+        }
+        const bool written = std::fwrite(header.data(), 1, header.size(), f) == header.size()
+                             && std::fwrite(data, 1, lut_bytes(size), f) == lut_bytes(size);
+        const bool closed = std::fclose(f) == 0;
+        if (!written || !closed)
+        {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        std::filesystem::rename(tmp, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // Unique per store across threads and processes sharing the directory,
+    // so two writers of the same LUT never write into the same file.
+    static std::string temp_suffix()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+#ifdef _WIN32
+        const long pid = static_cast<long>(_getpid());
+#else
+        const long pid = static_cast<long>(getpid());
+#endif
+        return ".tmp" + std::to_string(pid) + "_" + std::to_string(counter.fetch_add(1));
+    }
+
+    static constexpr char k_magic[8] = {'C', 'R', 'S', 'P', 'L', 'U', 'T', '1'};
+    // Magic (8) + size (4) + key length (4).
+    static constexpr std::size_t k_fixed_header = 16;
+    static constexpr std::size_t k_alignment = 64;
+
+    static std::size_t lut_bytes(int size)
+    {
+        return static_cast<std::size_t>(size) * size * size * 4 * sizeof(float);
+    }
+
+    static std::size_t data_offset(const std::string & key)
+    {
+        const std::size_t header = k_fixed_header + key.size();
+        return (header + k_alignment - 1) / k_alignment * k_alignment;
+    }
+
+    // FNV-1a; only used to name files, collisions are caught by the stored key.
+    static std::uint64_t hash_key(const std::string & key)
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : key)
+        {
+            h = (h ^ c) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    static std::filesystem::path file_path(
+        const std::string & dir,
+        const std::string & key,
+        int size)
+    {
+        char name[64];
+        std::snprintf(
+            name,
+            sizeof(name),
+            "lut3d_%016llx_%d.bin",
+            static_cast<unsigned long long>(hash_key(key)),
+            size);
+        return std::filesystem::path(dir) / name;
+    }
+
+    mutable std::mutex m_mutex;
+    std::string m_dir;
+};
+
+} // namespace crispen
@@ -1,11 +1,26 @@
 #include "ocio_capi.h"
+#include "lut3d_kernel.h"
+#include "lut_disk_cache.h"
+#include "processor_cache.h"
+
+#include "crispen/perf_counters.h"
+#include "crispen/worker_pool.h"
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace OCIO = OCIO_NAMESPACE;
 
@@ -24,10 +39,63 @@ struct OcioCpuProcessor
     OCIO::ConstCPUProcessorRcPtr cpu;
 };
 
+struct OcioGpuShader
+{
+    OCIO::ConstGPUProcessorRcPtr gpu;
+    OCIO::GpuShaderDescRcPtr desc;
+};
+
+struct OcioTileTracker
+{
+    int width = 0;
+    int height = 0;
+    int tile_size = 0;
+    int tiles_x = 0;
+    int tiles_y = 0;
+    // Cache ID of the processor whose output the valid tiles hold.
+    std::string processor_id;
+    std::vector<unsigned char> valid;
+};
+
+struct OcioMappedLut
+{
+    int size = 0;
+    bool from_disk = false;
+    const float * data = nullptr;
+    // Exactly one of these backs `data`.
+    std::unique_ptr<crispen::MappedFile> file;
+    std::vector<float> owned;
+};
+
+struct OcioConfigLoad
+{
+    mutable std::mutex mutex;
+    std::condition_variable done;
+    int status = OCIO_CONFIG_LOAD_PENDING;
+    OCIO::ConstConfigRcPtr config;
+    std::string error;
+    std::thread worker;
+};
+
 namespace
 {
 thread_local std::string g_last_error;
 
+using PerfCounters = crispen::PerfCounters<OCIO_PERF_STAGE_COUNT>;
+using PerfScope = crispen::PerfScope<OCIO_PERF_STAGE_COUNT>;
+
+PerfCounters & perf()
+{
+    static PerfCounters counters;
+    return counters;
+}
+
+std::uint64_t rgba_f32_bytes(long width, long height)
+{
+    return static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) * 4
+           * sizeof(float);
+}
+
 const char * empty_to_null(const char * v)
 {
     if (!v || !v[0])
@@ -47,6 +115,442 @@ void clear_error()
     g_last_error.clear();
 }
 
+bool to_ocio_language(int language, OCIO::GpuLanguage & out)
+{
+    switch (language)
+    {
+    case OCIO_GPU_LANGUAGE_GLSL_4_0:
+        out = OCIO::GPU_LANGUAGE_GLSL_4_0;
+        return true;
+    case OCIO_GPU_LANGUAGE_GLSL_ES_3_0:
+        out = OCIO::GPU_LANGUAGE_GLSL_ES_3_0;
+        return true;
+    case OCIO_GPU_LANGUAGE_HLSL_DX11:
+        out = OCIO::GPU_LANGUAGE_HLSL_DX11;
+        return true;
+#if OCIO_VERSION_MAJOR > 2 || (OCIO_VERSION_MAJOR == 2 && OCIO_VERSION_MINOR >= 2)
+    case OCIO_GPU_LANGUAGE_MSL_2_0:
+        out = OCIO::GPU_LANGUAGE_MSL_2_0;
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+bool to_ocio_channel_order(int channel_order, OCIO::ChannelOrdering & out)
+{
+    switch (channel_order)
+    {
+    case OCIO_CHANNEL_ORDER_RGB:
+        out = OCIO::CHANNEL_ORDERING_RGB;
+        return true;
+    case OCIO_CHANNEL_ORDER_RGBA:
+        out = OCIO::CHANNEL_ORDERING_RGBA;
+        return true;
+    case OCIO_CHANNEL_ORDER_BGRA:
+        out = OCIO::CHANNEL_ORDERING_BGRA;
+        return true;
+    default:
+        return false;
+    }
+}
+
+int channel_order_count(int channel_order)
+{
+    return channel_order == OCIO_CHANNEL_ORDER_RGB ? 3 : 4;
+}
+
+int bit_depth_bytes(OCIO::BitDepth depth)
+{
+    switch (depth)
+    {
+    case OCIO::BIT_DEPTH_UINT8:
+        return 1;
+    case OCIO::BIT_DEPTH_UINT10:
+    case OCIO::BIT_DEPTH_UINT12:
+    case OCIO::BIT_DEPTH_UINT16:
+    case OCIO::BIT_DEPTH_F16:
+        return 2;
+    case OCIO::BIT_DEPTH_F32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool to_ocio_bit_depth(int depth, OCIO::BitDepth & out)
+{
+    switch (depth)
+    {
+    case OCIO_BIT_DEPTH_UINT8:
+        out = OCIO::BIT_DEPTH_UINT8;
+        return true;
+    case OCIO_BIT_DEPTH_UINT10:
+        out = OCIO::BIT_DEPTH_UINT10;
+        return true;
+    case OCIO_BIT_DEPTH_UINT12:
+        out = OCIO::BIT_DEPTH_UINT12;
+        return true;
+    case OCIO_BIT_DEPTH_UINT16:
+        out = OCIO::BIT_DEPTH_UINT16;
+        return true;
+    case OCIO_BIT_DEPTH_F16:
+        out = OCIO::BIT_DEPTH_F16;
+        return true;
+    case OCIO_BIT_DEPTH_F32:
+        out = OCIO::BIT_DEPTH_F32;
+        return true;
+    default:
+        return false;
+    }
+}
+
+int from_ocio_bit_depth(OCIO::BitDepth depth)
+{
+    switch (depth)
+    {
+    case OCIO::BIT_DEPTH_UINT8:
+        return OCIO_BIT_DEPTH_UINT8;
+    case OCIO::BIT_DEPTH_UINT10:
+        return OCIO_BIT_DEPTH_UINT10;
+    case OCIO::BIT_DEPTH_UINT12:
+        return OCIO_BIT_DEPTH_UINT12;
+    case OCIO::BIT_DEPTH_UINT16:
+        return OCIO_BIT_DEPTH_UINT16;
+    case OCIO::BIT_DEPTH_F16:
+        return OCIO_BIT_DEPTH_F16;
+    case OCIO::BIT_DEPTH_F32:
+        return OCIO_BIT_DEPTH_F32;
+    default:
+        return -1;
+    }
+}
+
+// Combine a preset with OCIO_FAST_PATH_* bits. Unknown bits are rejected so
+// a newer caller cannot silently get a slower processor.
+bool with_fast_paths(OCIO::OptimizationFlags preset, int fast_paths, OCIO::OptimizationFlags & out)
+{
+    if (fast_paths & ~OCIO_FAST_PATH_LOG_EXP_POW)
+    {
+        return false;
+    }
+    unsigned long long flags = static_cast<unsigned long long>(preset);
+    if (fast_paths & OCIO_FAST_PATH_LOG_EXP_POW)
+    {
+        flags |= static_cast<unsigned long long>(OCIO::OPTIMIZATION_FAST_LOG_EXP_POW);
+    }
+    out = static_cast<OCIO::OptimizationFlags>(flags);
+    return true;
+}
+
+bool to_ocio_optimization(int optimization, OCIO::OptimizationFlags & out)
+{
+    switch (optimization)
+    {
+    case OCIO_OPTIMIZATION_DEFAULT:
+        out = OCIO::OPTIMIZATION_DEFAULT;
+        return true;
+    case OCIO_OPTIMIZATION_LOSSLESS:
+        out = OCIO::OPTIMIZATION_LOSSLESS;
+        return true;
+    case OCIO_OPTIMIZATION_VERY_GOOD:
+        out = OCIO::OPTIMIZATION_VERY_GOOD;
+        return true;
+    case OCIO_OPTIMIZATION_GOOD:
+        out = OCIO::OPTIMIZATION_GOOD;
+        return true;
+    case OCIO_OPTIMIZATION_DRAFT:
+        out = OCIO::OPTIMIZATION_DRAFT;
+        return true;
+    default:
+        return false;
+    }
+}
+
+constexpr int k_max_grade_lut_size = 129;
+
+bool valid_grade(const OcioGradeDesc * grade)
+{
+    if (!grade || !grade->lut3d)
+    {
+        return true;
+    }
+    return grade->lut3d_size >= 2 && grade->lut3d_size <= k_max_grade_lut_size
+           && (grade->lut3d_interpolation == OCIO_LUT3D_INTERP_TRILINEAR
+               || grade->lut3d_interpolation == OCIO_LUT3D_INTERP_TETRAHEDRAL);
+}
+
+// FNV-1a over the grade contents, so an unchanged grade reuses the cached
+// fused processor and any edit builds a new one.
+std::string grade_key(const OcioGradeDesc * grade)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    const auto mix = [&](const void * data, std::size_t bytes) {
+        const auto * p = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < bytes; ++i)
+        {
+            h = (h ^ p[i]) * 1099511628211ull;
+        }
+    };
+    const auto mix_part = [&](char tag, const float * values, std::size_t count) {
+        mix(&tag, 1);
+        if (values)
+        {
+            mix(values, count * sizeof(float));
+        }
+    };
+
+    if (grade)
+    {
+        const std::size_t lut_entries =
+            grade->lut3d ? static_cast<std::size_t>(grade->lut3d_size) * grade->lut3d_size
+                               * grade->lut3d_size * 4
+                         : 0;
+        mix_part('m', grade->matrix, 16);
+        mix_part('o', grade->offset, 4);
+        mix_part('l', grade->lut3d, lut_entries);
+        mix(&grade->lut3d_size, sizeof(grade->lut3d_size));
+        mix(&grade->lut3d_interpolation, sizeof(grade->lut3d_interpolation));
+    }
+    return std::to_string(h);
+}
+
+// Append the grade's matrix/offset and LUT stages to `group`.
+void append_grade(OCIO::GroupTransform & group, const OcioGradeDesc & grade)
+{
+    if (grade.matrix || grade.offset)
+    {
+        double m44[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        double offset4[4] = {0, 0, 0, 0};
+        if (grade.matrix)
+        {
+            std::copy(grade.matrix, grade.matrix + 16, m44);
+        }
+        if (grade.offset)
+        {
+            std::copy(grade.offset, grade.offset + 4, offset4);
+        }
+        auto matrix = OCIO::MatrixTransform::Create();
+        matrix->setMatrix(m44);
+        matrix->setOffset(offset4);
+        group.appendTransform(matrix);
+    }
+
+    if (grade.lut3d)
+    {
+        const unsigned long size = static_cast<unsigned long>(grade.lut3d_size);
+        auto lut = OCIO::Lut3DTransform::Create(size);
+        lut->setInterpolation(
+            grade.lut3d_interpolation == OCIO_LUT3D_INTERP_TETRAHEDRAL ? OCIO::INTERP_TETRAHEDRAL
+                                                                       : OCIO::INTERP_LINEAR
+        );
+        const float * e = grade.lut3d;
+        for (unsigned long b = 0; b < size; ++b)
+        {
+            for (unsigned long g = 0; g < size; ++g)
+            {
+                for (unsigned long r = 0; r < size; ++r, e += 4)
+                {
+                    lut->setValue(r, g, b, e[0], e[1], e[2]);
+                }
+            }
+        }
+        group.appendTransform(lut);
+    }
+}
+
+// One side (source or destination) of a strided apply.
+struct BandImage
+{
+    unsigned char * data;
+    OCIO::BitDepth depth;
+    std::ptrdiff_t x_stride;
+    std::ptrdiff_t y_stride;
+
+    OCIO::PackedImageDesc rows(long y0, long width, long rows, OCIO::ChannelOrdering order) const
+    {
+        return OCIO::PackedImageDesc(
+            data + y0 * y_stride,
+            width,
+            rows,
+            order,
+            depth,
+            static_cast<std::ptrdiff_t>(bit_depth_bytes(depth)),
+            x_stride,
+            y_stride
+        );
+    }
+};
+
+// Run apply_rows(y0, rows) over `height` rows, split into bands on the
+// worker pool. Throws on failure.
+void for_each_band(
+    long height,
+    int num_threads,
+    const std::function<void(long, long)> & apply_rows
+)
+{
+    const int threads = crispen::WorkerPool::resolve_threads(num_threads);
+    const int bands = crispen::band_count(static_cast<int>(height), threads);
+    if (threads <= 1 || bands <= 1)
+    {
+        apply_rows(0, height);
+        return;
+    }
+
+    const long rows_per_band = (height + bands - 1) / bands;
+    const std::function<void(int)> apply_band = [&](int band) {
+        const long y0 = band * rows_per_band;
+        const long rows = std::min(rows_per_band, height - y0);
+        if (rows > 0)
+        {
+            apply_rows(y0, rows);
+        }
+    };
+
+    std::string err;
+    if (!crispen::WorkerPool::instance().run(bands, threads, apply_band, err))
+    {
+        throw std::runtime_error(err);
+    }
+}
+
+// Apply `cpu` from `src` into `dst` (which may alias for in-place applies),
+// split into row bands on the worker pool. Throws on failure.
+void apply_in_bands(
+    const OCIO::CPUProcessor & cpu,
+    const BandImage & src,
+    const BandImage & dst,
+    long width,
+    long height,
+    OCIO::ChannelOrdering order,
+    int num_threads
+)
+{
+    const bool in_place = src.data == dst.data;
+    for_each_band(height, num_threads, [&](long y0, long rows) {
+        // CPUProcessor::apply is const and safe to call concurrently.
+        if (in_place)
+        {
+            OCIO::PackedImageDesc img = dst.rows(y0, width, rows, order);
+            cpu.apply(img);
+        }
+        else
+        {
+            const OCIO::PackedImageDesc in = src.rows(y0, width, rows, order);
+            OCIO::PackedImageDesc out = dst.rows(y0, width, rows, order);
+            cpu.apply(in, out);
+        }
+    });
+}
+
+constexpr int k_default_tile_size = 128;
+
+// Inclusive-exclusive tile index range covered by a clipped rectangle.
+struct TileSpan
+{
+    int tx0;
+    int ty0;
+    int tx1;
+    int ty1;
+};
+
+bool tile_span(const OcioRect & r, int width, int height, int tile, TileSpan & out)
+{
+    const long x0 = std::max(0L, static_cast<long>(r.x));
+    const long y0 = std::max(0L, static_cast<long>(r.y));
+    const long x1 = std::min(static_cast<long>(width), static_cast<long>(r.x) + r.width);
+    const long y1 = std::min(static_cast<long>(height), static_cast<long>(r.y) + r.height);
+    if (r.width <= 0 || r.height <= 0 || x0 >= x1 || y0 >= y1)
+    {
+        return false;
+    }
+    out.tx0 = static_cast<int>(x0 / tile);
+    out.ty0 = static_cast<int>(y0 / tile);
+    out.tx1 = static_cast<int>((x1 + tile - 1) / tile);
+    out.ty1 = static_cast<int>((y1 + tile - 1) / tile);
+    return true;
+}
+
+// Flag every tile of a tiles_x x tiles_y grid that touches one of `rects`
+// (all tiles when there are none).
+void mark_tiles(
+    const OcioRect * rects,
+    int count,
+    int width,
+    int height,
+    int tile,
+    int tiles_x,
+    std::vector<unsigned char> & marked
+)
+{
+    if (!rects || count <= 0)
+    {
+        std::fill(marked.begin(), marked.end(), 1);
+        return;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        TileSpan span;
+        if (!tile_span(rects[i], width, height, tile, span))
+        {
+            continue;
+        }
+        for (int ty = span.ty0; ty < span.ty1; ++ty)
+        {
+            for (int tx = span.tx0; tx < span.tx1; ++tx)
+            {
+                marked[static_cast<std::size_t>(ty) * tiles_x + tx] = 1;
+            }
+        }
+    }
+}
+
+constexpr std::size_t k_default_cache_capacity = 32;
+
+crispen::LruCache<const OCIO::Processor> & processor_cache()
+{
+    static crispen::LruCache<const OCIO::Processor> cache(k_default_cache_capacity);
+    return cache;
+}
+
+crispen::LruCache<const OCIO::CPUProcessor> & cpu_processor_cache()
+{
+    static crispen::LruCache<const OCIO::CPUProcessor> cache(k_default_cache_capacity);
+    return cache;
+}
+
+std::string config_key(const OcioConfig * config, const char * kind)
+{
+    std::string key = config->config->getCacheID();
+    crispen::append_key(key, kind);
+    return key;
+}
+
+std::string cpu_key(const OcioProcessor * proc, const char * kind)
+{
+    std::string key = proc->processor->getCacheID();
+    crispen::append_key(key, kind);
+    return key;
+}
+
+bool fetch_uniform(
+    const OcioGpuShader * shader,
+    int index,
+    const char *& name,
+    OCIO::GpuShaderDesc::UniformData & data
+)
+{
+    if (!shader || index < 0
+        || static_cast<unsigned>(index) >= shader->desc->getNumUniforms())
+    {
+        return false;
+    }
+    name = shader->desc->getUniform(static_cast<unsigned>(index), data);
+    return true;
+}
+
 } // namespace
 
 extern "C" const char * ocio_get_last_error(void)
@@ -88,50 +592,1587 @@ extern "C" OcioConfig * ocio_config_create_from_env(void)
     const char * ocio_env = std::getenv("OCIO");
     if (!ocio_env || !ocio_env[0])
     {
-        set_error("OCIO environment variable is not set");
-        return nullptr;
+        set_error("OCIO environment variable is not set");
+        return nullptr;
+    }
+
+    try
+    {
+        auto out = new OcioConfig;
+        out->config = OCIO::Config::CreateFromEnv();
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioConfig * ocio_config_create_builtin(const char * uri)
+{
+    clear_error();
+    if (!uri || !uri[0])
+    {
+        set_error("ocio_config_create_builtin: empty config URI");
+        return nullptr;
+    }
+
+    try
+    {
+#if OCIO_VERSION_MAJOR > 2 || (OCIO_VERSION_MAJOR == 2 && OCIO_VERSION_MINOR >= 2)
+        auto out = new OcioConfig;
+        out->config = OCIO::Config::CreateFromBuiltinConfig(uri);
+        return out;
+#else
+        set_error(
+            "Built-in OCIO configs require OpenColorIO 2.2+. "
+            "Use ocio_config_create_from_file() or ocio_config_create_from_env() instead."
+        );
+        return nullptr;
+#endif
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void ocio_config_destroy(OcioConfig * config)
+{
+    delete config;
+}
+
+namespace
+{
+// Build through the public entry points so the cache keys are exactly the
+// ones later synchronous calls will look up.
+// Takes ownership of `proc`; a null processor (failed build) is skipped.
+void prewarm_cpu(OcioProcessor * proc)
+{
+    if (!proc)
+    {
+        return;
+    }
+    ocio_cpu_processor_destroy(
+        ocio_processor_get_cpu_f32_with(proc, OCIO_OPTIMIZATION_LOSSLESS, OCIO_FAST_PATH_NONE)
+    );
+    ocio_processor_destroy(proc);
+}
+
+void prewarm_names(const OcioConfig * config, const char * src, const char * dst)
+{
+    if (src && std::strcmp(src, dst) != 0)
+    {
+        prewarm_cpu(ocio_config_get_processor_by_names(config, src, dst));
+    }
+}
+
+void prewarm_processors(const OcioConfig * config, const char * input_space, int prewarm)
+{
+    const char * scene_linear = ocio_config_get_role(config, "scene_linear");
+    if (!scene_linear)
+    {
+        return;
+    }
+
+    if (prewarm & OCIO_PREWARM_DISPLAY_VIEW)
+    {
+        const char * display = ocio_config_get_default_display(config);
+        const char * view = display ? ocio_config_get_default_view(config, display) : nullptr;
+        if (view)
+        {
+            prewarm_cpu(ocio_config_get_display_view_processor(config, scene_linear, display, view));
+        }
+        prewarm_names(config, empty_to_null(input_space), scene_linear);
+    }
+
+    if (prewarm & OCIO_PREWARM_ROLES)
+    {
+        const int num = config->config->getNumRoles();
+        for (int i = 0; i < num; i++)
+        {
+            prewarm_names(config, empty_to_null(config->config->getRoleColorSpace(i)), scene_linear);
+        }
+    }
+}
+
+void run_config_load(
+    OcioConfigLoad * load,
+    int source,
+    const std::string & path_or_uri,
+    const std::string & input_space,
+    int prewarm
+)
+{
+    OcioConfig * config = nullptr;
+    switch (source)
+    {
+    case OCIO_CONFIG_SOURCE_FILE:
+        config = ocio_config_create_from_file(path_or_uri.c_str());
+        break;
+    case OCIO_CONFIG_SOURCE_BUILTIN:
+        config = ocio_config_create_builtin(path_or_uri.c_str());
+        break;
+    default:
+        config = ocio_config_create_from_env();
+        break;
+    }
+
+    std::string error;
+    if (config)
+    {
+        try
+        {
+            config->config->validate();
+            prewarm_processors(config, input_space.c_str(), prewarm);
+        }
+        catch (const std::exception & e)
+        {
+            error = e.what();
+        }
+    }
+    else
+    {
+        const char * message = ocio_get_last_error();
+        error = message ? message : "config load failed";
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(load->mutex);
+        if (error.empty())
+        {
+            load->config = config->config;
+            load->status = OCIO_CONFIG_LOAD_READY;
+        }
+        else
+        {
+            load->error = std::move(error);
+            load->status = OCIO_CONFIG_LOAD_FAILED;
+        }
+    }
+    load->done.notify_all();
+    delete config;
+}
+} // namespace
+
+extern "C" OcioConfigLoad * ocio_config_load_async(
+    int source,
+    const char * path_or_uri,
+    const char * input_space,
+    int prewarm
+)
+{
+    clear_error();
+    const bool needs_path = source == OCIO_CONFIG_SOURCE_FILE || source == OCIO_CONFIG_SOURCE_BUILTIN;
+    if (source < OCIO_CONFIG_SOURCE_FILE || source > OCIO_CONFIG_SOURCE_ENV
+        || (needs_path && (!path_or_uri || !path_or_uri[0])))
+    {
+        set_error("ocio_config_load_async: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        auto load = std::make_unique<OcioConfigLoad>();
+        load->worker = std::thread(
+            run_config_load,
+            load.get(),
+            source,
+            std::string(path_or_uri ? path_or_uri : ""),
+            std::string(input_space ? input_space : ""),
+            prewarm
+        );
+        return load.release();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int ocio_config_load_status(const OcioConfigLoad * load)
+{
+    if (!load)
+    {
+        return OCIO_CONFIG_LOAD_FAILED;
+    }
+    std::lock_guard<std::mutex> lock(load->mutex);
+    return load->status;
+}
+
+extern "C" int ocio_config_load_wait(OcioConfigLoad * load, int timeout_ms)
+{
+    if (!load)
+    {
+        return OCIO_CONFIG_LOAD_FAILED;
+    }
+    std::unique_lock<std::mutex> lock(load->mutex);
+    const auto finished = [&] { return load->status != OCIO_CONFIG_LOAD_PENDING; };
+    if (timeout_ms < 0)
+    {
+        load->done.wait(lock, finished);
+    }
+    else
+    {
+        load->done.wait_for(lock, std::chrono::milliseconds(timeout_ms), finished);
+    }
+    return load->status;
+}
+
+extern "C" OcioConfig * ocio_config_load_get_config(const OcioConfigLoad * load)
+{
+    clear_error();
+    if (!load)
+    {
+        set_error("ocio_config_load_get_config: null load");
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(load->mutex);
+    if (load->status == OCIO_CONFIG_LOAD_PENDING)
+    {
+        set_error("ocio_config_load_get_config: load still pending");
+        return nullptr;
+    }
+    if (load->status == OCIO_CONFIG_LOAD_FAILED)
+    {
+        set_error(load->error.c_str());
+        return nullptr;
+    }
+
+    try
+    {
+        auto out = new OcioConfig;
+        out->config = load->config;
+        return out;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" const char * ocio_config_load_get_error(const OcioConfigLoad * load)
+{
+    if (!load)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(load->mutex);
+    return load->status == OCIO_CONFIG_LOAD_FAILED ? load->error.c_str() : nullptr;
+}
+
+extern "C" void ocio_config_load_destroy(OcioConfigLoad * load)
+{
+    if (!load)
+    {
+        return;
+    }
+    if (load->worker.joinable())
+    {
+        load->worker.join();
+    }
+    delete load;
+}
+
+extern "C" int ocio_config_get_num_color_spaces(const OcioConfig * config)
+{
+    if (!config)
+    {
+        return -1;
+    }
+
+    try
+    {
+        return config->config->getNumColorSpaces();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" const char * ocio_config_get_color_space_name(const OcioConfig * config, int index)
+{
+    if (!config)
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return empty_to_null(config->config->getColorSpaceNameByIndex(index));
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" const char * ocio_config_get_role(const OcioConfig * config, const char * role)
+{
+    if (!config || !role || !role[0])
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        // Iterate roles for compatibility with OCIO 2.1 (no string overload).
+        int num = config->config->getNumRoles();
+        for (int i = 0; i < num; i++)
+        {
+            const char * name = config->config->getRoleName(i);
+            if (name && std::strcmp(name, role) == 0)
+            {
+                return empty_to_null(config->config->getRoleColorSpace(i));
+            }
+        }
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int ocio_config_get_num_displays(const OcioConfig * config)
+{
+    if (!config)
+    {
+        return -1;
+    }
+
+    try
+    {
+        return config->config->getNumDisplays();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" const char * ocio_config_get_display(const OcioConfig * config, int index)
+{
+    if (!config)
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return empty_to_null(config->config->getDisplay(index));
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" const char * ocio_config_get_default_display(const OcioConfig * config)
+{
+    if (!config)
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return empty_to_null(config->config->getDefaultDisplay());
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int ocio_config_get_num_views(const OcioConfig * config, const char * display)
+{
+    if (!config || !display || !display[0])
+    {
+        return -1;
+    }
+
+    try
+    {
+        return config->config->getNumViews(display);
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" const char * ocio_config_get_view(
+    const OcioConfig * config,
+    const char * display,
+    int index
+)
+{
+    if (!config || !display || !display[0])
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return empty_to_null(config->config->getView(display, index));
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" const char * ocio_config_get_default_view(
+    const OcioConfig * config,
+    const char * display
+)
+{
+    if (!config || !display || !display[0])
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return empty_to_null(config->config->getDefaultView(display));
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioProcessor * ocio_config_get_processor_by_names(
+    const OcioConfig * config,
+    const char * src,
+    const char * dst
+)
+{
+    clear_error();
+    if (!config || !src || !src[0] || !dst || !dst[0])
+    {
+        set_error("ocio_config_get_processor_by_names: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_PROCESSOR_BUILD);
+        std::string key = config_key(config, "names");
+        crispen::append_key(key, src);
+        crispen::append_key(key, dst);
+        auto processor = processor_cache().get_or_build(
+            key, [&] { return config->config->getProcessor(src, dst); }
+        );
+
+        auto out = new OcioProcessor;
+        out->processor = std::move(processor);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioProcessor * ocio_config_get_display_view_processor(
+    const OcioConfig * config,
+    const char * src,
+    const char * display,
+    const char * view
+)
+{
+    clear_error();
+    if (!config || !src || !src[0] || !display || !display[0] || !view || !view[0])
+    {
+        set_error("ocio_config_get_display_view_processor: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_PROCESSOR_BUILD);
+        std::string key = config_key(config, "display_view");
+        crispen::append_key(key, src);
+        crispen::append_key(key, display);
+        crispen::append_key(key, view);
+        auto processor = processor_cache().get_or_build(key, [&] {
+            return config->config->getProcessor(src, display, view, OCIO::TRANSFORM_DIR_FORWARD);
+        });
+
+        auto out = new OcioProcessor;
+        out->processor = std::move(processor);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioProcessor * ocio_config_get_look_processor(
+    const OcioConfig * config,
+    const char * src,
+    const char * dst,
+    const char * looks
+)
+{
+    clear_error();
+    if (!config || !src || !src[0] || !dst || !dst[0] || !looks)
+    {
+        set_error("ocio_config_get_look_processor: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_PROCESSOR_BUILD);
+        std::string key = config_key(config, "looks");
+        crispen::append_key(key, src);
+        crispen::append_key(key, dst);
+        crispen::append_key(key, looks);
+        auto processor = processor_cache().get_or_build(key, [&] {
+            auto transform = OCIO::LookTransform::Create();
+            transform->setSrc(src);
+            transform->setDst(dst);
+            transform->setLooks(looks);
+            return config->config->getProcessor(transform);
+        });
+
+        auto out = new OcioProcessor;
+        out->processor = std::move(processor);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioProcessor * ocio_config_get_fused_processor(
+    const OcioConfig * config,
+    const char * src,
+    const char * working,
+    const char * display,
+    const char * view,
+    const OcioGradeDesc * grade,
+    int optimization
+)
+{
+    clear_error();
+    OCIO::OptimizationFlags flags;
+    if (!config || !src || !src[0] || !working || !working[0] || !display || !display[0]
+        || !view || !view[0] || !valid_grade(grade) || !to_ocio_optimization(optimization, flags))
+    {
+        set_error("ocio_config_get_fused_processor: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_PROCESSOR_BUILD);
+        std::string key = config_key(config, "fused");
+        crispen::append_key(key, src);
+        crispen::append_key(key, working);
+        crispen::append_key(key, display);
+        crispen::append_key(key, view);
+        crispen::append_key(key, grade_key(grade).c_str());
+        crispen::append_key(key, std::to_string(optimization).c_str());
+        auto processor = processor_cache().get_or_build(key, [&] {
+            auto group = OCIO::GroupTransform::Create();
+
+            auto idt = OCIO::ColorSpaceTransform::Create();
+            idt->setSrc(src);
+            idt->setDst(working);
+            group->appendTransform(idt);
+
+            if (grade)
+            {
+                append_grade(*group, *grade);
+            }
+
+            auto odt = OCIO::DisplayViewTransform::Create();
+            odt->setSrc(working);
+            odt->setDisplay(display);
+            odt->setView(view);
+            group->appendTransform(odt);
+
+            return config->config->getProcessor(group)->getOptimizedProcessor(flags);
+        });
+
+        auto out = new OcioProcessor;
+        out->processor = std::move(processor);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void ocio_processor_destroy(OcioProcessor * proc)
+{
+    delete proc;
+}
+
+extern "C" const char * ocio_processor_get_cache_id(const OcioProcessor * proc)
+{
+    clear_error();
+    if (!proc)
+    {
+        set_error("ocio_processor_get_cache_id: null processor");
+        return nullptr;
+    }
+
+    try
+    {
+        return proc->processor->getCacheID();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioCpuProcessor * ocio_processor_get_cpu_f32(const OcioProcessor * proc)
+{
+    clear_error();
+    if (!proc)
+    {
+        set_error("ocio_processor_get_cpu_f32: null processor");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_PROCESSOR_BUILD);
+        auto cpu = cpu_processor_cache().get_or_build(
+            cpu_key(proc, "default"), [&] { return proc->processor->getDefaultCPUProcessor(); }
+        );
+
+        auto out = new OcioCpuProcessor;
+        out->cpu = std::move(cpu);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioCpuProcessor * ocio_processor_get_cpu_f32_with(
+    const OcioProcessor * proc,
+    int optimization,
+    int fast_paths
+)
+{
+    clear_error();
+    OCIO::OptimizationFlags preset;
+    OCIO::OptimizationFlags flags;
+    if (!proc || !to_ocio_optimization(optimization, preset)
+        || !with_fast_paths(preset, fast_paths, flags))
+    {
+        set_error("ocio_processor_get_cpu_f32_with: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_PROCESSOR_BUILD);
+        std::string key = cpu_key(proc, "f32");
+        crispen::append_key(key, std::to_string(optimization).c_str());
+        crispen::append_key(key, std::to_string(fast_paths).c_str());
+        auto cpu = cpu_processor_cache().get_or_build(
+            key, [&] { return proc->processor->getOptimizedCPUProcessor(flags); }
+        );
+
+        auto out = new OcioCpuProcessor;
+        out->cpu = std::move(cpu);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OcioCpuProcessor * ocio_processor_get_cpu(
+    const OcioProcessor * proc,
+    int in_depth,
+    int out_depth,
+    int optimization
+)
+{
+    clear_error();
+    OCIO::BitDepth in_bd;
+    OCIO::BitDepth out_bd;
+    OCIO::OptimizationFlags flags;
+    if (!proc || !to_ocio_bit_depth(in_depth, in_bd) || !to_ocio_bit_depth(out_depth, out_bd)
+        || !to_ocio_optimization(optimization, flags))
+    {
+        set_error("ocio_processor_get_cpu: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_PROCESSOR_BUILD);
+        std::string key = cpu_key(proc, "optimized");
+        crispen::append_key(key, std::to_string(in_depth).c_str());
+        crispen::append_key(key, std::to_string(out_depth).c_str());
+        crispen::append_key(key, std::to_string(optimization).c_str());
+        auto cpu = cpu_processor_cache().get_or_build(key, [&] {
+            return proc->processor->getOptimizedCPUProcessor(in_bd, out_bd, flags);
+        });
+
+        auto out = new OcioCpuProcessor;
+        out->cpu = std::move(cpu);
+        return out;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void ocio_cpu_processor_destroy(OcioCpuProcessor * cpu)
+{
+    delete cpu;
+}
+
+extern "C" const char * ocio_cpu_processor_get_cache_id(const OcioCpuProcessor * cpu)
+{
+    clear_error();
+    if (!cpu)
+    {
+        set_error("ocio_cpu_processor_get_cache_id: null processor");
+        return nullptr;
+    }
+
+    try
+    {
+        return cpu->cpu->getCacheID();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_rgba(
+    const OcioCpuProcessor * cpu,
+    float * pixels,
+    int width,
+    int height
+)
+{
+    clear_error();
+    if (!cpu || !pixels || width <= 0 || height <= 0)
+    {
+        set_error("ocio_cpu_processor_apply_rgba: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_APPLY, rgba_f32_bytes(width, height));
+        OCIO::PackedImageDesc img(
+            pixels,
+            width,
+            height,
+            4,
+            OCIO::BIT_DEPTH_F32,
+            static_cast<std::ptrdiff_t>(sizeof(float)),
+            static_cast<std::ptrdiff_t>(4 * sizeof(float)),
+            static_cast<std::ptrdiff_t>(width) * 4 * static_cast<std::ptrdiff_t>(sizeof(float))
+        );
+        cpu->cpu->apply(img);
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_rgba_threaded(
+    const OcioCpuProcessor * cpu,
+    float * pixels,
+    int width,
+    int height,
+    int num_threads
+)
+{
+    clear_error();
+    if (!cpu || !pixels || width <= 0 || height <= 0)
+    {
+        set_error("ocio_cpu_processor_apply_rgba_threaded: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_APPLY, rgba_f32_bytes(width, height));
+        const std::ptrdiff_t x_stride = static_cast<std::ptrdiff_t>(4 * sizeof(float));
+        const BandImage img{
+            reinterpret_cast<unsigned char *>(pixels),
+            OCIO::BIT_DEPTH_F32,
+            x_stride,
+            x_stride * width
+        };
+        apply_in_bands(
+            *cpu->cpu, img, img, width, height, OCIO::CHANNEL_ORDERING_RGBA, num_threads
+        );
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_strided(
+    const OcioCpuProcessor * cpu,
+    float * pixels,
+    int width,
+    int height,
+    int channel_order,
+    ptrdiff_t x_stride_bytes,
+    ptrdiff_t y_stride_bytes,
+    int num_threads
+)
+{
+    clear_error();
+    OCIO::ChannelOrdering order;
+    if (!cpu || !pixels || width <= 0 || height <= 0
+        || !to_ocio_channel_order(channel_order, order))
+    {
+        set_error("ocio_cpu_processor_apply_strided: invalid args");
+        return 0;
+    }
+
+    const std::ptrdiff_t pixel_bytes =
+        static_cast<std::ptrdiff_t>(channel_order_count(channel_order) * sizeof(float));
+    const std::ptrdiff_t x_stride = x_stride_bytes > 0 ? x_stride_bytes : pixel_bytes;
+    const std::ptrdiff_t y_stride = y_stride_bytes > 0 ? y_stride_bytes : x_stride * width;
+    if (x_stride < pixel_bytes || y_stride < x_stride * width)
+    {
+        set_error("ocio_cpu_processor_apply_strided: strides overlap pixels");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(
+            perf(),
+            OCIO_PERF_CPU_APPLY,
+            static_cast<std::uint64_t>(pixel_bytes) * static_cast<std::uint64_t>(width) * height
+        );
+        const BandImage img{
+            reinterpret_cast<unsigned char *>(pixels), OCIO::BIT_DEPTH_F32, x_stride, y_stride
+        };
+        apply_in_bands(*cpu->cpu, img, img, width, height, order, num_threads);
+        return 1;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int ocio_cpu_processor_get_input_bit_depth(const OcioCpuProcessor * cpu)
+{
+    if (!cpu)
+    {
+        return -1;
+    }
+
+    try
+    {
+        return from_ocio_bit_depth(cpu->cpu->getInputBitDepth());
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" int ocio_cpu_processor_get_output_bit_depth(const OcioCpuProcessor * cpu)
+{
+    if (!cpu)
+    {
+        return -1;
+    }
+
+    try
+    {
+        return from_ocio_bit_depth(cpu->cpu->getOutputBitDepth());
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_typed(
+    const OcioCpuProcessor * cpu,
+    const void * src,
+    void * dst,
+    int width,
+    int height,
+    int channel_order,
+    ptrdiff_t src_x_stride_bytes,
+    ptrdiff_t src_y_stride_bytes,
+    ptrdiff_t dst_x_stride_bytes,
+    ptrdiff_t dst_y_stride_bytes,
+    int num_threads
+)
+{
+    clear_error();
+    OCIO::ChannelOrdering order;
+    if (!cpu || !src || !dst || width <= 0 || height <= 0
+        || !to_ocio_channel_order(channel_order, order))
+    {
+        set_error("ocio_cpu_processor_apply_typed: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_APPLY);
+        const OCIO::BitDepth in_bd = cpu->cpu->getInputBitDepth();
+        const OCIO::BitDepth out_bd = cpu->cpu->getOutputBitDepth();
+        if (src == dst && bit_depth_bytes(in_bd) != bit_depth_bytes(out_bd))
+        {
+            set_error("ocio_cpu_processor_apply_typed: in-place apply needs matching bit depths");
+            return 0;
+        }
+
+        const int channels = channel_order_count(channel_order);
+        scope.set_bytes(
+            static_cast<std::uint64_t>(bit_depth_bytes(in_bd)) * channels
+            * static_cast<std::uint64_t>(width) * height
+        );
+        auto resolve = [&](OCIO::BitDepth depth,
+                           std::ptrdiff_t xs,
+                           std::ptrdiff_t ys,
+                           void * data) {
+            const std::ptrdiff_t pixel_bytes =
+                static_cast<std::ptrdiff_t>(bit_depth_bytes(depth)) * channels;
+            const std::ptrdiff_t x_stride = xs > 0 ? xs : pixel_bytes;
+            const std::ptrdiff_t y_stride = ys > 0 ? ys : x_stride * width;
+            if (pixel_bytes == 0 || x_stride < pixel_bytes || y_stride < x_stride * width)
+            {
+                throw std::runtime_error("ocio_cpu_processor_apply_typed: invalid strides");
+            }
+            return BandImage{static_cast<unsigned char *>(data), depth, x_stride, y_stride};
+        };
+
+        // OCIO never writes through the source descriptor.
+        const BandImage in =
+            resolve(in_bd, src_x_stride_bytes, src_y_stride_bytes, const_cast<void *>(src));
+        const BandImage out = resolve(out_bd, dst_x_stride_bytes, dst_y_stride_bytes, dst);
+        apply_in_bands(*cpu->cpu, in, out, width, height, order, num_threads);
+        return 1;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_rgb_pixel(const OcioCpuProcessor * cpu, float * pixel)
+{
+    clear_error();
+    if (!cpu || !pixel)
+    {
+        set_error("ocio_cpu_processor_apply_rgb_pixel: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        cpu->cpu->applyRGB(pixel);
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int ocio_cpu_processor_apply_rgb_points(
+    const OcioCpuProcessor * cpu,
+    float * xyz,
+    long count,
+    ptrdiff_t stride_bytes
+)
+{
+    clear_error();
+    const std::ptrdiff_t point_bytes = static_cast<std::ptrdiff_t>(3 * sizeof(float));
+    const std::ptrdiff_t stride = stride_bytes != 0 ? stride_bytes : point_bytes;
+    if (!cpu || !xyz || count < 0 || stride < point_bytes)
+    {
+        set_error("ocio_cpu_processor_apply_rgb_points: invalid args");
+        return 0;
+    }
+    if (count == 0)
+    {
+        return 1;
+    }
+
+    try
+    {
+        PerfScope scope(
+            perf(), OCIO_PERF_CPU_APPLY, static_cast<std::uint64_t>(count) * point_bytes
+        );
+        // The samples form a single `count` x 1 row, so OCIO processes them
+        // in its vectorized chunks with one call and one exception guard.
+        OCIO::PackedImageDesc img(
+            xyz,
+            count,
+            1,
+            OCIO::CHANNEL_ORDERING_RGB,
+            OCIO::BIT_DEPTH_F32,
+            static_cast<std::ptrdiff_t>(sizeof(float)),
+            stride,
+            stride * count
+        );
+        cpu->cpu->apply(img);
+        return 1;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" OcioTileTracker * ocio_tile_tracker_create(int width, int height, int tile_size)
+{
+    clear_error();
+    if (width <= 0 || height <= 0)
+    {
+        set_error("ocio_tile_tracker_create: invalid dimensions");
+        return nullptr;
+    }
+
+    try
+    {
+        auto tracker = new OcioTileTracker;
+        tracker->width = width;
+        tracker->height = height;
+        tracker->tile_size = tile_size > 0 ? tile_size : k_default_tile_size;
+        tracker->tiles_x = (width + tracker->tile_size - 1) / tracker->tile_size;
+        tracker->tiles_y = (height + tracker->tile_size - 1) / tracker->tile_size;
+        tracker->valid.assign(static_cast<std::size_t>(tracker->tiles_x) * tracker->tiles_y, 0);
+        return tracker;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void ocio_tile_tracker_destroy(OcioTileTracker * tracker)
+{
+    delete tracker;
+}
+
+extern "C" void ocio_tile_tracker_invalidate(
+    OcioTileTracker * tracker,
+    const OcioRect * rects,
+    int count
+)
+{
+    if (!tracker)
+    {
+        return;
+    }
+    if (!rects || count <= 0)
+    {
+        std::fill(tracker->valid.begin(), tracker->valid.end(), 0);
+        return;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        TileSpan span;
+        if (!tile_span(rects[i], tracker->width, tracker->height, tracker->tile_size, span))
+        {
+            continue;
+        }
+        for (int ty = span.ty0; ty < span.ty1; ++ty)
+        {
+            for (int tx = span.tx0; tx < span.tx1; ++tx)
+            {
+                tracker->valid[static_cast<std::size_t>(ty) * tracker->tiles_x + tx] = 0;
+            }
+        }
+    }
+}
+
+extern "C" int ocio_tile_tracker_num_valid(const OcioTileTracker * tracker)
+{
+    if (!tracker)
+    {
+        return 0;
+    }
+    return static_cast<int>(std::count(tracker->valid.begin(), tracker->valid.end(), 1));
+}
+
+extern "C" int ocio_cpu_processor_apply_rgba_rects(
+    const OcioCpuProcessor * cpu,
+    const float * src,
+    float * dst,
+    int width,
+    int height,
+    const OcioRect * rects,
+    int count,
+    OcioTileTracker * tracker,
+    int num_threads
+)
+{
+    clear_error();
+    if (!cpu || !src || !dst || width <= 0 || height <= 0 || (count > 0 && !rects))
+    {
+        set_error("ocio_cpu_processor_apply_rgba_rects: invalid args");
+        return -1;
+    }
+    if (tracker && (tracker->width != width || tracker->height != height || src == dst))
+    {
+        set_error("ocio_cpu_processor_apply_rgba_rects: tracker size mismatch or src == dst");
+        return -1;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_APPLY);
+        const int tile = tracker ? tracker->tile_size : k_default_tile_size;
+        const int tiles_x = (width + tile - 1) / tile;
+        const int tiles_y = (height + tile - 1) / tile;
+        std::vector<unsigned char> marked(static_cast<std::size_t>(tiles_x) * tiles_y, 0);
+        mark_tiles(rects, count, width, height, tile, tiles_x, marked);
+
+        if (tracker)
+        {
+            const char * id = cpu->cpu->getCacheID();
+            if (tracker->processor_id != (id ? id : ""))
+            {
+                tracker->processor_id = id ? id : "";
+                std::fill(tracker->valid.begin(), tracker->valid.end(), 0);
+            }
+        }
+
+        std::vector<int> pending;
+        for (std::size_t i = 0; i < marked.size(); ++i)
+        {
+            if (marked[i] && !(tracker && tracker->valid[i]))
+            {
+                pending.push_back(static_cast<int>(i));
+            }
+        }
+
+        const std::ptrdiff_t pixel_bytes = static_cast<std::ptrdiff_t>(4 * sizeof(float));
+        const std::ptrdiff_t row_bytes = pixel_bytes * width;
+        const BandImage in{
+            reinterpret_cast<unsigned char *>(const_cast<float *>(src)),
+            OCIO::BIT_DEPTH_F32,
+            pixel_bytes,
+            row_bytes
+        };
+        const BandImage out{
+            reinterpret_cast<unsigned char *>(dst), OCIO::BIT_DEPTH_F32, pixel_bytes, row_bytes
+        };
+        const OCIO::CPUProcessor & proc = *cpu->cpu;
+        const std::function<void(int)> apply_tile = [&](int item) {
+            const int index = pending[static_cast<std::size_t>(item)];
+            const long x0 = static_cast<long>(index % tiles_x) * tile;
+            const long y0 = static_cast<long>(index / tiles_x) * tile;
+            const long w = std::min(static_cast<long>(tile), width - x0);
+            const long h = std::min(static_cast<long>(tile), height - y0);
+            const BandImage tile_in{in.data + x0 * pixel_bytes, in.depth, pixel_bytes, row_bytes};
+            const BandImage tile_out{
+                out.data + x0 * pixel_bytes, out.depth, pixel_bytes, row_bytes
+            };
+            OCIO::PackedImageDesc img_out = tile_out.rows(y0, w, h, OCIO::CHANNEL_ORDERING_RGBA);
+            if (src == dst)
+            {
+                proc.apply(img_out);
+            }
+            else
+            {
+                const OCIO::PackedImageDesc img_in =
+                    tile_in.rows(y0, w, h, OCIO::CHANNEL_ORDERING_RGBA);
+                proc.apply(img_in, img_out);
+            }
+        };
+
+        std::string err;
+        if (!crispen::WorkerPool::instance().run(
+                static_cast<int>(pending.size()), num_threads, apply_tile, err
+            ))
+        {
+            // Tiles that did finish are not recorded, so a retry redoes them.
+            set_error(err.c_str());
+            return -1;
+        }
+        if (tracker)
+        {
+            for (int index : pending)
+            {
+                tracker->valid[static_cast<std::size_t>(index)] = 1;
+            }
+        }
+        std::uint64_t applied_bytes = 0;
+        for (int index : pending)
+        {
+            const long x0 = static_cast<long>(index % tiles_x) * tile;
+            const long y0 = static_cast<long>(index / tiles_x) * tile;
+            applied_bytes += rgba_f32_bytes(
+                std::min(static_cast<long>(tile), width - x0),
+                std::min(static_cast<long>(tile), height - y0)
+            );
+        }
+        scope.set_bytes(applied_bytes);
+        return static_cast<int>(pending.size());
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" int ocio_cpu_processor_bake_lut3d(
+    const OcioCpuProcessor * cpu,
+    int size,
+    float * out_rgba
+)
+{
+    clear_error();
+    if (!cpu || !out_rgba || size < 2)
+    {
+        set_error("ocio_cpu_processor_bake_lut3d: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_LUT_BAKE, rgba_f32_bytes(size, size * size));
+        const float denom = static_cast<float>(size - 1);
+        float * px = out_rgba;
+        for (int b = 0; b < size; ++b)
+        {
+            for (int g = 0; g < size; ++g)
+            {
+                for (int r = 0; r < size; ++r)
+                {
+                    px[0] = static_cast<float>(r) / denom;
+                    px[1] = static_cast<float>(g) / denom;
+                    px[2] = static_cast<float>(b) / denom;
+                    px[3] = 1.0f;
+                    px += 4;
+                }
+            }
+        }
+
+        // Treat the lattice as a size x (size * size) image so OCIO can use
+        // its vectorized packed path instead of one applyRGB per point.
+        OCIO::PackedImageDesc img(
+            out_rgba,
+            size,
+            static_cast<long>(size) * size,
+            4,
+            OCIO::BIT_DEPTH_F32,
+            static_cast<std::ptrdiff_t>(sizeof(float)),
+            static_cast<std::ptrdiff_t>(4 * sizeof(float)),
+            static_cast<std::ptrdiff_t>(size) * 4 * static_cast<std::ptrdiff_t>(sizeof(float))
+        );
+        cpu->cpu->apply(img);
+        return 1;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" OcioMappedLut * ocio_cpu_processor_bake_lut3d_cached(
+    const OcioCpuProcessor * cpu,
+    int size
+)
+{
+    clear_error();
+    if (!cpu || size < 2)
+    {
+        set_error("ocio_cpu_processor_bake_lut3d_cached: invalid args");
+        return nullptr;
+    }
+
+    try
+    {
+        // The library version is part of the key so an OCIO upgrade that
+        // changes op math never serves LUTs baked by the old one.
+        std::string key = "lut3d";
+        crispen::append_key(key, OCIO::GetVersion());
+        crispen::append_key(key, cpu->cpu->getCacheID());
+
+        auto & disk = crispen::LutDiskCache::instance();
+        auto lut = std::make_unique<OcioMappedLut>();
+        lut->size = size;
+
+        PerfScope scope(perf(), OCIO_PERF_LUT_CACHE_LOAD, rgba_f32_bytes(size, size * size));
+        const float * mapped = nullptr;
+        lut->file = disk.load(key, size, mapped);
+        if (lut->file)
+        {
+            lut->data = mapped;
+            lut->from_disk = true;
+            return lut.release();
+        }
+        // The bake below reports itself as OCIO_PERF_LUT_BAKE.
+        scope.cancel();
+
+        lut->owned.resize(static_cast<std::size_t>(size) * size * size * 4);
+        if (!ocio_cpu_processor_bake_lut3d(cpu, size, lut->owned.data()))
+        {
+            return nullptr;
+        }
+        // A failed store only costs a re-bake on the next launch.
+        disk.store(key, size, lut->owned.data());
+        lut->data = lut->owned.data();
+        return lut.release();
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void ocio_mapped_lut_destroy(OcioMappedLut * lut)
+{
+    delete lut;
+}
+
+extern "C" const float * ocio_mapped_lut_data(const OcioMappedLut * lut)
+{
+    return lut ? lut->data : nullptr;
+}
+
+extern "C" int ocio_mapped_lut_size(const OcioMappedLut * lut)
+{
+    return lut ? lut->size : 0;
+}
+
+extern "C" int ocio_mapped_lut_from_disk(const OcioMappedLut * lut)
+{
+    return lut && lut->from_disk ? 1 : 0;
+}
+
+extern "C" int ocio_lut3d_apply_rgba(
+    const float * lut,
+    int size,
+    float * pixels,
+    int width,
+    int height,
+    int interpolation,
+    int num_threads
+)
+{
+    clear_error();
+    if (!lut || !pixels || size < 2 || size > crispen::k_lut3d_max_size || width <= 0
+        || height <= 0
+        || (interpolation != OCIO_LUT3D_INTERP_TRILINEAR
+            && interpolation != OCIO_LUT3D_INTERP_TETRAHEDRAL))
+    {
+        set_error("ocio_lut3d_apply_rgba: invalid args");
+        return 0;
+    }
+
+    try
+    {
+        PerfScope scope(perf(), OCIO_PERF_CPU_APPLY, rgba_f32_bytes(width, height));
+        const crispen::Lut3dInterp interp = interpolation == OCIO_LUT3D_INTERP_TETRAHEDRAL
+                                                ? crispen::Lut3dInterp::Tetrahedral
+                                                : crispen::Lut3dInterp::Trilinear;
+        const long row_floats = static_cast<long>(width) * 4;
+        for_each_band(height, num_threads, [&](long y0, long rows) {
+            crispen::apply_lut3d(lut, size, pixels + y0 * row_floats, rows * width, interp);
+        });
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" const char * ocio_lut3d_kernel_name(void)
+{
+    return crispen::lut3d_kernel_name();
+}
+
+extern "C" int ocio_cpu_processor_is_noop(const OcioCpuProcessor * cpu)
+{
+    if (!cpu)
+    {
+        return 1;
     }
 
     try
     {
-        auto out = new OcioConfig;
-        out->config = OCIO::Config::CreateFromEnv();
-        return out;
-    }
-    catch (const OCIO::Exception & e)
-    {
-        set_error(e.what());
-        return nullptr;
+        return cpu->cpu->isNoOp() ? 1 : 0;
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return 1;
     }
 }
 
-extern "C" OcioConfig * ocio_config_create_builtin(const char * uri)
+extern "C" OcioGpuShader * ocio_processor_get_gpu_shader(
+    const OcioProcessor * proc,
+    int language,
+    const char * function_name,
+    const char * resource_prefix
+)
 {
     clear_error();
-    if (!uri || !uri[0])
+    OCIO::GpuLanguage lang;
+    if (!proc || !to_ocio_language(language, lang))
     {
-        set_error("ocio_config_create_builtin: empty config URI");
+        set_error("ocio_processor_get_gpu_shader: invalid args");
         return nullptr;
     }
 
     try
     {
-#if OCIO_VERSION_MAJOR > 2 || (OCIO_VERSION_MAJOR == 2 && OCIO_VERSION_MINOR >= 2)
-        auto out = new OcioConfig;
-        out->config = OCIO::Config::CreateFromBuiltinConfig(uri);
+        PerfScope scope(perf(), OCIO_PERF_GPU_SHADER);
+        auto out = new OcioGpuShader;
+        out->gpu = proc->processor->getDefaultGPUProcessor();
+        out->desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        out->desc->setLanguage(lang);
+        if (function_name && function_name[0])
+        {
+            out->desc->setFunctionName(function_name);
+        }
+        if (resource_prefix && resource_prefix[0])
+        {
+            out->desc->setResourcePrefix(resource_prefix);
+        }
+        out->gpu->extractGpuShaderInfo(out->desc);
         return out;
-#else
-        set_error(
-            "Built-in OCIO configs require OpenColorIO 2.2+. "
-            "Use ocio_config_create_from_file() or ocio_config_create_from_env() instead."
-        );
-        return nullptr;
-#endif
     }
     catch (const OCIO::Exception & e)
     {
@@ -145,39 +2186,39 @@ extern "C" OcioConfig * ocio_config_create_builtin(const char * uri)
     }
 }
 
-extern "C" void ocio_config_destroy(OcioConfig * config)
+extern "C" void ocio_gpu_shader_destroy(OcioGpuShader * shader)
 {
-    delete config;
+    delete shader;
 }
 
-extern "C" int ocio_config_get_num_color_spaces(const OcioConfig * config)
+extern "C" const char * ocio_gpu_shader_get_text(const OcioGpuShader * shader)
 {
-    if (!config)
+    if (!shader)
     {
-        return -1;
+        return nullptr;
     }
 
     try
     {
-        return config->config->getNumColorSpaces();
+        return empty_to_null(shader->desc->getShaderText());
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return -1;
+        return nullptr;
     }
 }
 
-extern "C" const char * ocio_config_get_color_space_name(const OcioConfig * config, int index)
+extern "C" const char * ocio_gpu_shader_get_function_name(const OcioGpuShader * shader)
 {
-    if (!config)
+    if (!shader)
     {
         return nullptr;
     }
 
     try
     {
-        return empty_to_null(config->config->getColorSpaceNameByIndex(index));
+        return empty_to_null(shader->desc->getFunctionName());
     }
     catch (const std::exception & e)
     {
@@ -186,98 +2227,161 @@ extern "C" const char * ocio_config_get_color_space_name(const OcioConfig * conf
     }
 }
 
-extern "C" const char * ocio_config_get_role(const OcioConfig * config, const char * role)
+extern "C" int ocio_gpu_shader_get_num_uniforms(const OcioGpuShader * shader)
 {
-    if (!config || !role || !role[0])
+    if (!shader)
     {
-        return nullptr;
+        return -1;
     }
 
     try
     {
-        // Iterate roles for compatibility with OCIO 2.1 (no string overload).
-        int num = config->config->getNumRoles();
-        for (int i = 0; i < num; i++)
-        {
-            const char * name = config->config->getRoleName(i);
-            if (name && std::strcmp(name, role) == 0)
-            {
-                return empty_to_null(config->config->getRoleColorSpace(i));
-            }
-        }
-        return nullptr;
+        return static_cast<int>(shader->desc->getNumUniforms());
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return -1;
     }
 }
 
-extern "C" int ocio_config_get_num_displays(const OcioConfig * config)
+extern "C" const char * ocio_gpu_shader_get_uniform_name(const OcioGpuShader * shader, int index)
 {
-    if (!config)
-    {
-        return -1;
-    }
-
     try
     {
-        return config->config->getNumDisplays();
+        const char * name = nullptr;
+        OCIO::GpuShaderDesc::UniformData data;
+        if (!fetch_uniform(shader, index, name, data))
+        {
+            return nullptr;
+        }
+        return empty_to_null(name);
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return -1;
+        return nullptr;
     }
 }
 
-extern "C" const char * ocio_config_get_display(const OcioConfig * config, int index)
+extern "C" int ocio_gpu_shader_get_uniform_type(const OcioGpuShader * shader, int index)
 {
-    if (!config)
-    {
-        return nullptr;
-    }
-
     try
     {
-        return empty_to_null(config->config->getDisplay(index));
+        const char * name = nullptr;
+        OCIO::GpuShaderDesc::UniformData data;
+        if (!fetch_uniform(shader, index, name, data))
+        {
+            return OCIO_GPU_UNIFORM_UNKNOWN;
+        }
+        switch (data.m_type)
+        {
+        case OCIO::UNIFORM_DOUBLE:
+            return OCIO_GPU_UNIFORM_DOUBLE;
+        case OCIO::UNIFORM_BOOL:
+            return OCIO_GPU_UNIFORM_BOOL;
+        case OCIO::UNIFORM_FLOAT3:
+            return OCIO_GPU_UNIFORM_FLOAT3;
+        case OCIO::UNIFORM_VECTOR_FLOAT:
+            return OCIO_GPU_UNIFORM_VECTOR_FLOAT;
+        case OCIO::UNIFORM_VECTOR_INT:
+            return OCIO_GPU_UNIFORM_VECTOR_INT;
+        default:
+            return OCIO_GPU_UNIFORM_UNKNOWN;
+        }
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return OCIO_GPU_UNIFORM_UNKNOWN;
     }
 }
 
-extern "C" const char * ocio_config_get_default_display(const OcioConfig * config)
+extern "C" int ocio_gpu_shader_get_uniform_values(
+    const OcioGpuShader * shader,
+    int index,
+    float * out_values,
+    int max_values
+)
 {
-    if (!config)
-    {
-        return nullptr;
-    }
-
+    clear_error();
     try
     {
-        return empty_to_null(config->config->getDefaultDisplay());
+        const char * name = nullptr;
+        OCIO::GpuShaderDesc::UniformData data;
+        if (!fetch_uniform(shader, index, name, data))
+        {
+            set_error("ocio_gpu_shader_get_uniform_values: invalid args");
+            return -1;
+        }
+
+        int count = 0;
+        auto emit = [&](float v) {
+            if (out_values && count < max_values)
+            {
+                out_values[count] = v;
+            }
+            ++count;
+        };
+
+        switch (data.m_type)
+        {
+        case OCIO::UNIFORM_DOUBLE:
+            emit(static_cast<float>(data.m_getDouble()));
+            break;
+        case OCIO::UNIFORM_BOOL:
+            emit(data.m_getBool() ? 1.0f : 0.0f);
+            break;
+        case OCIO::UNIFORM_FLOAT3:
+        {
+            const auto & v = data.m_getFloat3();
+            emit(v[0]);
+            emit(v[1]);
+            emit(v[2]);
+            break;
+        }
+        case OCIO::UNIFORM_VECTOR_FLOAT:
+        {
+            const int n = data.m_vectorFloat.m_getSize();
+            const float * v = data.m_vectorFloat.m_getVector();
+            for (int i = 0; i < n; ++i)
+            {
+                emit(v[i]);
+            }
+            break;
+        }
+        case OCIO::UNIFORM_VECTOR_INT:
+        {
+            const int n = data.m_vectorInt.m_getSize();
+            const int * v = data.m_vectorInt.m_getVector();
+            for (int i = 0; i < n; ++i)
+            {
+                emit(static_cast<float>(v[i]));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        return count;
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return -1;
     }
 }
 
-extern "C" int ocio_config_get_num_views(const OcioConfig * config, const char * display)
+extern "C" int ocio_gpu_shader_get_num_textures(const OcioGpuShader * shader)
 {
-    if (!config || !display || !display[0])
+    if (!shader)
     {
         return -1;
     }
 
     try
     {
-        return config->config->getNumViews(display);
+        return static_cast<int>(shader->desc->getNumTextures());
     }
     catch (const std::exception & e)
     {
@@ -286,41 +2390,88 @@ extern "C" int ocio_config_get_num_views(const OcioConfig * config, const char *
     }
 }
 
-extern "C" const char * ocio_config_get_view(
-    const OcioConfig * config,
-    const char * display,
-    int index
+extern "C" int ocio_gpu_shader_get_texture(
+    const OcioGpuShader * shader,
+    int index,
+    OcioGpuTextureInfo * out
 )
 {
-    if (!config || !display || !display[0])
+    clear_error();
+    if (!shader || !out || index < 0)
     {
-        return nullptr;
+        set_error("ocio_gpu_shader_get_texture: invalid args");
+        return 0;
     }
 
     try
     {
-        return empty_to_null(config->config->getView(display, index));
+        const char * texture_name = nullptr;
+        const char * sampler_name = nullptr;
+        unsigned width = 0;
+        unsigned height = 0;
+        OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+        OCIO::Interpolation interpolation = OCIO::INTERP_LINEAR;
+#if OCIO_VERSION_MAJOR > 2 || (OCIO_VERSION_MAJOR == 2 && OCIO_VERSION_MINOR >= 3)
+        OCIO::GpuShaderDesc::TextureDimensions dimensions = OCIO::GpuShaderDesc::TEXTURE_2D;
+        shader->desc->getTexture(
+            static_cast<unsigned>(index),
+            texture_name,
+            sampler_name,
+            width,
+            height,
+            channel,
+            dimensions,
+            interpolation
+        );
+        out->dimensions = dimensions == OCIO::GpuShaderDesc::TEXTURE_1D ? 1 : 2;
+#else
+        shader->desc->getTexture(
+            static_cast<unsigned>(index),
+            texture_name,
+            sampler_name,
+            width,
+            height,
+            channel,
+            interpolation
+        );
+        out->dimensions = height > 1 ? 2 : 1;
+#endif
+        out->texture_name = texture_name;
+        out->sampler_name = sampler_name;
+        out->width = static_cast<int>(width);
+        out->height = static_cast<int>(height);
+        out->depth = 1;
+        out->channels = channel == OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL ? 1 : 3;
+        out->linear_filter = interpolation == OCIO::INTERP_NEAREST ? 0 : 1;
+        return 1;
+    }
+    catch (const OCIO::Exception & e)
+    {
+        set_error(e.what());
+        return 0;
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return 0;
     }
 }
 
-extern "C" const char * ocio_config_get_default_view(
-    const OcioConfig * config,
-    const char * display
+extern "C" const float * ocio_gpu_shader_get_texture_values(
+    const OcioGpuShader * shader,
+    int index
 )
 {
-    if (!config || !display || !display[0])
+    if (!shader || index < 0)
     {
         return nullptr;
     }
 
     try
     {
-        return empty_to_null(config->config->getDefaultView(display));
+        const float * values = nullptr;
+        shader->desc->getTextureValues(static_cast<unsigned>(index), values);
+        return values;
     }
     catch (const std::exception & e)
     {
@@ -329,93 +2480,87 @@ extern "C" const char * ocio_config_get_default_view(
     }
 }
 
-extern "C" OcioProcessor * ocio_config_get_processor_by_names(
-    const OcioConfig * config,
-    const char * src,
-    const char * dst
-)
+extern "C" int ocio_gpu_shader_get_num_textures_3d(const OcioGpuShader * shader)
 {
-    clear_error();
-    if (!config || !src || !src[0] || !dst || !dst[0])
+    if (!shader)
     {
-        set_error("ocio_config_get_processor_by_names: invalid args");
-        return nullptr;
+        return -1;
     }
 
     try
     {
-        auto out = new OcioProcessor;
-        out->processor = config->config->getProcessor(src, dst);
-        return out;
-    }
-    catch (const OCIO::Exception & e)
-    {
-        set_error(e.what());
-        return nullptr;
+        return static_cast<int>(shader->desc->getNumTextures3D());
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return -1;
     }
 }
 
-extern "C" OcioProcessor * ocio_config_get_display_view_processor(
-    const OcioConfig * config,
-    const char * src,
-    const char * display,
-    const char * view
+extern "C" int ocio_gpu_shader_get_texture_3d(
+    const OcioGpuShader * shader,
+    int index,
+    OcioGpuTextureInfo * out
 )
 {
     clear_error();
-    if (!config || !src || !src[0] || !display || !display[0] || !view || !view[0])
+    if (!shader || !out || index < 0)
     {
-        set_error("ocio_config_get_display_view_processor: invalid args");
-        return nullptr;
+        set_error("ocio_gpu_shader_get_texture_3d: invalid args");
+        return 0;
     }
 
     try
     {
-        auto out = new OcioProcessor;
-        out->processor = config->config->getProcessor(src, display, view, OCIO::TRANSFORM_DIR_FORWARD);
-        return out;
+        const char * texture_name = nullptr;
+        const char * sampler_name = nullptr;
+        unsigned edge_len = 0;
+        OCIO::Interpolation interpolation = OCIO::INTERP_LINEAR;
+        shader->desc->getTexture3D(
+            static_cast<unsigned>(index),
+            texture_name,
+            sampler_name,
+            edge_len,
+            interpolation
+        );
+        out->texture_name = texture_name;
+        out->sampler_name = sampler_name;
+        out->width = static_cast<int>(edge_len);
+        out->height = static_cast<int>(edge_len);
+        out->depth = static_cast<int>(edge_len);
+        out->channels = 3;
+        out->dimensions = 3;
+        out->linear_filter = interpolation == OCIO::INTERP_NEAREST ? 0 : 1;
+        return 1;
     }
     catch (const OCIO::Exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return 0;
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
-        return nullptr;
+        return 0;
     }
 }
 
-extern "C" void ocio_processor_destroy(OcioProcessor * proc)
-{
-    delete proc;
-}
-
-extern "C" OcioCpuProcessor * ocio_processor_get_cpu_f32(const OcioProcessor * proc)
+extern "C" const float * ocio_gpu_shader_get_texture_3d_values(
+    const OcioGpuShader * shader,
+    int index
+)
 {
-    clear_error();
-    if (!proc)
+    if (!shader || index < 0)
     {
-        set_error("ocio_processor_get_cpu_f32: null processor");
         return nullptr;
     }
 
     try
     {
-        auto out = new OcioCpuProcessor;
-        out->cpu = proc->processor->getDefaultCPUProcessor();
-        return out;
-    }
-    catch (const OCIO::Exception & e)
-    {
-        set_error(e.what());
-        return nullptr;
+        const float * values = nullptr;
+        shader->desc->getTexture3DValues(static_cast<unsigned>(index), values);
+        return values;
     }
     catch (const std::exception & e)
     {
@@ -424,74 +2569,107 @@ extern "C" OcioCpuProcessor * ocio_processor_get_cpu_f32(const OcioProcessor * p
     }
 }
 
-extern "C" void ocio_cpu_processor_destroy(OcioCpuProcessor * cpu)
+extern "C" void ocio_processor_cache_set_capacity(int max_entries)
 {
-    delete cpu;
+    const std::size_t capacity = max_entries > 0 ? static_cast<std::size_t>(max_entries) : 0;
+    processor_cache().set_capacity(capacity);
+    cpu_processor_cache().set_capacity(capacity);
 }
 
-extern "C" void ocio_cpu_processor_apply_rgba(
-    const OcioCpuProcessor * cpu,
-    float * pixels,
-    int width,
-    int height
-)
+extern "C" void ocio_processor_cache_clear(void)
 {
-    if (!cpu || !pixels || width <= 0 || height <= 0)
-    {
-        return;
-    }
+    processor_cache().clear();
+    cpu_processor_cache().clear();
+    processor_cache().reset_counters();
+    cpu_processor_cache().reset_counters();
+}
 
+extern "C" int ocio_lut_cache_set_directory(const char * dir)
+{
+    clear_error();
     try
     {
-        OCIO::PackedImageDesc img(
-            pixels,
-            width,
-            height,
-            4,
-            OCIO::BIT_DEPTH_F32,
-            static_cast<std::ptrdiff_t>(sizeof(float)),
-            static_cast<std::ptrdiff_t>(4 * sizeof(float)),
-            static_cast<std::ptrdiff_t>(width) * 4 * static_cast<std::ptrdiff_t>(sizeof(float))
-        );
-        cpu->cpu->apply(img);
+        crispen::LutDiskCache::instance().set_directory(dir ? dir : "");
+        return 1;
     }
     catch (const std::exception & e)
     {
         set_error(e.what());
+        return 0;
     }
 }
 
-extern "C" void ocio_cpu_processor_apply_rgb_pixel(const OcioCpuProcessor * cpu, float * pixel)
+extern "C" void ocio_perf_set_enabled(int enabled)
 {
-    if (!cpu || !pixel)
+    perf().set_enabled(enabled != 0);
+}
+
+extern "C" int ocio_perf_is_enabled(void)
+{
+    return perf().enabled() ? 1 : 0;
+}
+
+extern "C" void ocio_perf_set_callback(OcioPerfCallback callback, void * user)
+{
+    perf().set_callback(callback, user);
+}
+
+extern "C" void ocio_perf_get_stats(OcioPerfStats * out)
+{
+    if (!out)
     {
         return;
     }
 
-    try
-    {
-        cpu->cpu->applyRGB(pixel);
-    }
-    catch (const std::exception & e)
+    for (int stage = 0; stage < OCIO_PERF_STAGE_COUNT; ++stage)
     {
-        set_error(e.what());
+        const auto snapshot = perf().snapshot(stage);
+        out->stages[stage].calls = snapshot.calls;
+        out->stages[stage].nanoseconds = snapshot.nanoseconds;
+        out->stages[stage].bytes = snapshot.bytes;
     }
 }
 
-extern "C" int ocio_cpu_processor_is_noop(const OcioCpuProcessor * cpu)
+extern "C" void ocio_perf_reset(void)
 {
-    if (!cpu)
-    {
-        return 1;
-    }
+    perf().reset();
+}
 
-    try
+extern "C" const char * ocio_perf_stage_name(int stage)
+{
+    switch (stage)
     {
-        return cpu->cpu->isNoOp() ? 1 : 0;
+    case OCIO_PERF_PROCESSOR_BUILD:
+        return "processor_build";
+    case OCIO_PERF_CPU_PROCESSOR_BUILD:
+        return "cpu_processor_build";
+    case OCIO_PERF_CPU_APPLY:
+        return "cpu_apply";
+    case OCIO_PERF_LUT_BAKE:
+        return "lut_bake";
+    case OCIO_PERF_LUT_CACHE_LOAD:
+        return "lut_cache_load";
+    case OCIO_PERF_GPU_SHADER:
+        return "gpu_shader";
+    default:
+        return nullptr;
     }
-    catch (const std::exception & e)
+}
+
+extern "C" void ocio_processor_cache_get_stats(OcioProcessorCacheStats * out)
+{
+    if (!out)
     {
-        set_error(e.what());
-        return 1;
+        return;
     }
+
+    const auto & procs = processor_cache();
+    const auto & cpus = cpu_processor_cache();
+    out->processor_hits = procs.counters().hits.load(std::memory_order_relaxed);
+    out->processor_misses = procs.counters().misses.load(std::memory_order_relaxed);
+    out->cpu_hits = cpus.counters().hits.load(std::memory_order_relaxed);
+    out->cpu_misses = cpus.counters().misses.load(std::memory_order_relaxed);
+    out->processor_entries = static_cast<int>(procs.size());
+    out->cpu_entries = static_cast<int>(cpus.size());
+    out->capacity = static_cast<int>(procs.capacity());
 }
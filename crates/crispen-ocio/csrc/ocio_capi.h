@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -7,6 +9,203 @@ extern "C" {
 typedef struct OcioConfig OcioConfig;
 typedef struct OcioProcessor OcioProcessor;
 typedef struct OcioCpuProcessor OcioCpuProcessor;
+typedef struct OcioGpuShader OcioGpuShader;
+typedef struct OcioTileTracker OcioTileTracker;
+typedef struct OcioMappedLut OcioMappedLut;
+typedef struct OcioConfigLoad OcioConfigLoad;
+
+// GPU shader languages accepted by ocio_processor_get_gpu_shader.
+enum
+{
+    OCIO_GPU_LANGUAGE_GLSL_4_0 = 0,
+    OCIO_GPU_LANGUAGE_GLSL_ES_3_0 = 1,
+    OCIO_GPU_LANGUAGE_HLSL_DX11 = 2,
+    OCIO_GPU_LANGUAGE_MSL_2_0 = 3
+};
+
+// Channel orders accepted by ocio_cpu_processor_apply_strided.
+enum
+{
+    OCIO_CHANNEL_ORDER_RGB = 0,
+    OCIO_CHANNEL_ORDER_RGBA = 1,
+    OCIO_CHANNEL_ORDER_BGRA = 2
+};
+
+// Pixel bit depths accepted by ocio_processor_get_cpu.
+enum
+{
+    OCIO_BIT_DEPTH_UINT8 = 0,
+    OCIO_BIT_DEPTH_UINT10 = 1,
+    OCIO_BIT_DEPTH_UINT12 = 2,
+    OCIO_BIT_DEPTH_UINT16 = 3,
+    OCIO_BIT_DEPTH_F16 = 4,
+    OCIO_BIT_DEPTH_F32 = 5
+};
+
+// Processor optimization levels (OCIO::OptimizationFlags presets).
+enum
+{
+    OCIO_OPTIMIZATION_DEFAULT = 0,
+    OCIO_OPTIMIZATION_LOSSLESS = 1,
+    OCIO_OPTIMIZATION_VERY_GOOD = 2,
+    OCIO_OPTIMIZATION_GOOD = 3,
+    OCIO_OPTIMIZATION_DRAFT = 4
+};
+
+// Fast-path bits OR'd into an optimization preset.
+enum
+{
+    OCIO_FAST_PATH_NONE = 0,
+    // Approximate log/exp/pow (OCIO::OPTIMIZATION_FAST_LOG_EXP_POW); already
+    // part of the DRAFT preset.
+    OCIO_FAST_PATH_LOG_EXP_POW = 1
+};
+
+// Interpolation modes accepted by ocio_lut3d_apply_rgba.
+enum
+{
+    // Matches sampling the lattice as a linearly filtered 3D texture.
+    OCIO_LUT3D_INTERP_TRILINEAR = 0,
+    OCIO_LUT3D_INTERP_TETRAHEDRAL = 1
+};
+
+// Instrumented stages reported by ocio_perf_get_stats and the perf callback.
+enum
+{
+    // Processor lookup/build (ocio_config_get_*_processor).
+    OCIO_PERF_PROCESSOR_BUILD = 0,
+    // CPU processor lookup/build (ocio_processor_get_cpu*).
+    OCIO_PERF_CPU_PROCESSOR_BUILD = 1,
+    // Buffer applies; per-pixel ocio_cpu_processor_apply_rgb_pixel is not
+    // instrumented.
+    OCIO_PERF_CPU_APPLY = 2,
+    OCIO_PERF_LUT_BAKE = 3,
+    // LUTs served from the disk cache by ocio_cpu_processor_bake_lut3d_cached.
+    OCIO_PERF_LUT_CACHE_LOAD = 4,
+    OCIO_PERF_GPU_SHADER = 5,
+    OCIO_PERF_STAGE_COUNT = 6
+};
+
+// Config sources accepted by ocio_config_load_async.
+enum
+{
+    // `path_or_uri` is a config file path.
+    OCIO_CONFIG_SOURCE_FILE = 0,
+    // `path_or_uri` is a built-in config URI (OCIO 2.2+).
+    OCIO_CONFIG_SOURCE_BUILTIN = 1,
+    // $OCIO; `path_or_uri` is ignored.
+    OCIO_CONFIG_SOURCE_ENV = 2
+};
+
+// Processors ocio_config_load_async builds into the processor cache before
+// the load reports ready. All CPU processors are F32 with the LOSSLESS
+// preset and no fast paths.
+enum
+{
+    OCIO_PREWARM_NONE = 0,
+    // scene_linear -> default display / default view (the viewer ODT), and
+    // `input_space` -> scene_linear (the IDT) when an input space is given.
+    OCIO_PREWARM_DISPLAY_VIEW = 1,
+    // Every role's color space -> scene_linear.
+    OCIO_PREWARM_ROLES = 2
+};
+
+// States reported by ocio_config_load_status and ocio_config_load_wait.
+enum
+{
+    OCIO_CONFIG_LOAD_PENDING = 0,
+    OCIO_CONFIG_LOAD_READY = 1,
+    OCIO_CONFIG_LOAD_FAILED = 2
+};
+
+// GPU uniform types reported by ocio_gpu_shader_get_uniform_type.
+enum
+{
+    OCIO_GPU_UNIFORM_DOUBLE = 0,
+    OCIO_GPU_UNIFORM_BOOL = 1,
+    OCIO_GPU_UNIFORM_FLOAT3 = 2,
+    OCIO_GPU_UNIFORM_VECTOR_FLOAT = 3,
+    OCIO_GPU_UNIFORM_VECTOR_INT = 4,
+    OCIO_GPU_UNIFORM_UNKNOWN = 5
+};
+
+// Counters for the internal processor / CPU processor caches.
+typedef struct OcioProcessorCacheStats
+{
+    unsigned long long processor_hits;
+    unsigned long long processor_misses;
+    unsigned long long cpu_hits;
+    unsigned long long cpu_misses;
+    int processor_entries;
+    int cpu_entries;
+    int capacity;
+} OcioProcessorCacheStats;
+
+// Cumulative totals for one instrumented stage. `bytes` counts source pixel
+// bytes for applies and output bytes for LUT bakes; 0 for builds.
+typedef struct OcioPerfCounter
+{
+    unsigned long long calls;
+    unsigned long long nanoseconds;
+    unsigned long long bytes;
+} OcioPerfCounter;
+
+typedef struct OcioPerfStats
+{
+    OcioPerfCounter stages[OCIO_PERF_STAGE_COUNT];
+} OcioPerfStats;
+
+// Called after every instrumented call while instrumentation is enabled, on
+// the thread that made the call. Calls may run concurrently; the callback
+// may call ocio_perf_set_callback.
+typedef void (*OcioPerfCallback)(
+    void * user,
+    int stage,
+    unsigned long long nanoseconds,
+    unsigned long long bytes
+);
+
+// Working-space grade folded into ocio_config_get_fused_processor. Any part
+// may be NULL; the matrix and offset apply before the LUT.
+typedef struct OcioGradeDesc
+{
+    // Row-major 4x4 matrix on RGBA.
+    const float * matrix;
+    // RGBA offset added after the matrix.
+    const float * offset;
+    // size^3 RGBA f32 lattice in the ocio_cpu_processor_bake_lut3d layout,
+    // covering [0, 1] of the working space. LUT alpha is ignored.
+    const float * lut3d;
+    int lut3d_size;
+    // OCIO_LUT3D_INTERP_*.
+    int lut3d_interpolation;
+} OcioGradeDesc;
+
+// Pixel rectangle within a frame, in pixels from the top-left corner.
+typedef struct OcioRect
+{
+    int x;
+    int y;
+    int width;
+    int height;
+} OcioRect;
+
+// Description of a LUT texture required by a generated GPU shader.
+// Strings are owned by the OcioGpuShader and live as long as it does.
+typedef struct OcioGpuTextureInfo
+{
+    const char * texture_name;
+    const char * sampler_name;
+    int width;
+    int height;
+    int depth;
+    // 1 (red only) or 3 (RGB) float channels per texel.
+    int channels;
+    // 1, 2 or 3 texture dimensions.
+    int dimensions;
+    // 1 when the sampler should filter linearly, 0 for nearest.
+    int linear_filter;
+} OcioGpuTextureInfo;
 
 // Error handling
 const char * ocio_get_last_error(void);
@@ -17,6 +216,28 @@ OcioConfig * ocio_config_create_from_env(void);
 OcioConfig * ocio_config_create_builtin(const char * uri);
 void ocio_config_destroy(OcioConfig * config);
 
+// Async config loading
+// Returns immediately; the config is parsed, validated and the requested
+// processors pre-built on a background thread. Prewarm failures (e.g. a
+// missing role) do not fail the load. Returns NULL only on invalid args.
+OcioConfigLoad * ocio_config_load_async(
+    int source,
+    const char * path_or_uri,
+    const char * input_space,
+    int prewarm
+);
+int ocio_config_load_status(const OcioConfigLoad * load);
+// Block until the load finishes or timeout_ms elapses (< 0 waits forever).
+// Returns the status at that point.
+int ocio_config_load_wait(OcioConfigLoad * load, int timeout_ms);
+// New config handle sharing the loaded config, or NULL while pending or
+// after a failure (check ocio_get_last_error). May be called repeatedly.
+OcioConfig * ocio_config_load_get_config(const OcioConfigLoad * load);
+// Error message of a failed load, owned by the handle; NULL otherwise.
+const char * ocio_config_load_get_error(const OcioConfigLoad * load);
+// Waits for the background thread before freeing.
+void ocio_config_load_destroy(OcioConfigLoad * load);
+
 // Config queries
 int ocio_config_get_num_color_spaces(const OcioConfig * config);
 const char * ocio_config_get_color_space_name(const OcioConfig * config, int index);
@@ -42,20 +263,267 @@ OcioProcessor * ocio_config_get_display_view_processor(
     const char * display,
     const char * view
 );
+// Processor for src -> dst with an explicit look list (e.g. "+grade, -shot").
+OcioProcessor * ocio_config_get_look_processor(
+    const OcioConfig * config,
+    const char * src,
+    const char * dst,
+    const char * looks
+);
+// Processor for src -> working -> grade -> display/view, built as one
+// GroupTransform and optimized with an OCIO_OPTIMIZATION_* preset so the
+// stages fold into a single op chain. Its CPU processor transforms a frame
+// in one pass over memory instead of one pass per stage. grade may be NULL.
+// The grade contents are part of the cache key.
+OcioProcessor * ocio_config_get_fused_processor(
+    const OcioConfig * config,
+    const char * src,
+    const char * working,
+    const char * display,
+    const char * view,
+    const OcioGradeDesc * grade,
+    int optimization
+);
 void ocio_processor_destroy(OcioProcessor * proc);
+// OCIO cache ID of the processor. Identical transforms from the same config
+// contents share an ID, including across launches. The string is owned by
+// the processor.
+const char * ocio_processor_get_cache_id(const OcioProcessor * proc);
+
+// Processor cache
+// Processors and CPU processors are cached process-wide, keyed by the
+// config cache ID and the transform arguments, evicting least recently used
+// entries beyond the capacity (default 32 each; 0 disables caching).
+void ocio_processor_cache_set_capacity(int max_entries);
+// Drop all cached entries and reset the counters.
+void ocio_processor_cache_clear(void);
+void ocio_processor_cache_get_stats(OcioProcessorCacheStats * out);
+
+// LUT disk cache
+// Directory where ocio_cpu_processor_bake_lut3d_cached stores baked LUTs.
+// NULL or "" disables the disk cache (the default). The directory is created
+// on first write. Returns 1 on success, 0 on error.
+int ocio_lut_cache_set_directory(const char * dir);
+
+// Instrumentation
+// Opt-in per-stage call counts, wall time and bytes processed, off by
+// default. While disabled nothing is timed and the counters do not change.
+void ocio_perf_set_enabled(int enabled);
+int ocio_perf_is_enabled(void);
+// NULL callback unregisters; once this returns the old callback is not
+// running on any other thread (it may still be on the stack of this one,
+// when called from inside it).
+void ocio_perf_set_callback(OcioPerfCallback callback, void * user);
+void ocio_perf_get_stats(OcioPerfStats * out);
+void ocio_perf_reset(void);
+// Short snake_case stage name, or NULL for an unknown stage.
+const char * ocio_perf_stage_name(int stage);
 
 // CPU processor
+// A CPU processor is immutable once built: every ocio_cpu_processor_*
+// apply and bake function is reentrant, so any number of threads may share
+// one handle without locking (threaded applies from several callers share
+// the worker pool). Each call reports its own result; after a failure,
+// ocio_get_last_error returns that call's message on the calling thread
+// until the thread's next ocio_* call.
 OcioCpuProcessor * ocio_processor_get_cpu_f32(const OcioProcessor * proc);
+// F32 RGBA CPU processor built with an explicit optimization preset and
+// OCIO_FAST_PATH_* bits, e.g. DRAFT for interactive scrubbing and LOSSLESS
+// for final bakes and exports.
+OcioCpuProcessor * ocio_processor_get_cpu_f32_with(
+    const OcioProcessor * proc,
+    int optimization,
+    int fast_paths
+);
+// Build an optimized CPU processor for the given input/output bit depths so
+// 8/10/12/16-bit and half buffers can be processed without widening to f32.
+OcioCpuProcessor * ocio_processor_get_cpu(
+    const OcioProcessor * proc,
+    int in_depth,
+    int out_depth,
+    int optimization
+);
 void ocio_cpu_processor_destroy(OcioCpuProcessor * cpu);
-void ocio_cpu_processor_apply_rgba(
+// OCIO cache ID of the CPU processor; also covers bit depths and
+// optimization flags. The string is owned by the CPU processor.
+const char * ocio_cpu_processor_get_cache_id(const OcioCpuProcessor * cpu);
+int ocio_cpu_processor_get_input_bit_depth(const OcioCpuProcessor * cpu);
+int ocio_cpu_processor_get_output_bit_depth(const OcioCpuProcessor * cpu);
+// Apply in place to packed RGBA f32 pixels.
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_apply_rgba(
     const OcioCpuProcessor * cpu,
     float * pixels,
     int width,
     int height
 );
-void ocio_cpu_processor_apply_rgb_pixel(const OcioCpuProcessor * cpu, float * pixel);
+// Same as ocio_cpu_processor_apply_rgba, but splits the image into row bands
+// processed on an internal worker pool. num_threads <= 0 uses all hardware
+// threads; 1 applies on the calling thread only.
+int ocio_cpu_processor_apply_rgba_threaded(
+    const OcioCpuProcessor * cpu,
+    float * pixels,
+    int width,
+    int height,
+    int num_threads
+);
+// Apply in place to f32 pixels with explicit layout, e.g. a sub-rectangle of
+// a larger image or a buffer with padded rows. `pixels` points at the first
+// pixel of the region. Strides are in bytes; pass 0 for tightly packed.
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_apply_strided(
+    const OcioCpuProcessor * cpu,
+    float * pixels,
+    int width,
+    int height,
+    int channel_order,
+    ptrdiff_t x_stride_bytes,
+    ptrdiff_t y_stride_bytes,
+    int num_threads
+);
+// Apply between buffers in the processor's own input/output bit depths.
+// dst may equal src when both depths have the same size. Channels within a
+// pixel are contiguous; strides are in bytes (0 = tightly packed). 10/12/16
+// bit and half samples are 16-bit words.
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_apply_typed(
+    const OcioCpuProcessor * cpu,
+    const void * src,
+    void * dst,
+    int width,
+    int height,
+    int channel_order,
+    ptrdiff_t src_x_stride_bytes,
+    ptrdiff_t src_y_stride_bytes,
+    ptrdiff_t dst_x_stride_bytes,
+    ptrdiff_t dst_y_stride_bytes,
+    int num_threads
+);
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_apply_rgb_pixel(const OcioCpuProcessor * cpu, float * pixel);
+// Apply in place to `count` RGB f32 samples in one packed apply, e.g. the
+// sparse points behind a scope overlay or an eyedropper. Each sample is
+// three floats; consecutive samples are stride_bytes apart (0 for tightly
+// packed xyz triplets), so the RGB of RGBA or larger records can be passed
+// directly; a negative or overlapping stride is rejected. Returns 1 on
+// success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_apply_rgb_points(
+    const OcioCpuProcessor * cpu,
+    float * xyz,
+    long count,
+    ptrdiff_t stride_bytes
+);
+
+// Dirty-rectangle tracking for incremental applies. A tracker divides a
+// width x height frame into tile_size square tiles (<= 0 uses 128) and
+// remembers which tiles of the destination already hold the output of a
+// given processor (matched by CPU processor cache ID). Not thread-safe.
+OcioTileTracker * ocio_tile_tracker_create(int width, int height, int tile_size);
+void ocio_tile_tracker_destroy(OcioTileTracker * tracker);
+// Mark the tiles touching `rects` stale, e.g. after the source pixels under
+// them changed. rects == NULL or count == 0 marks every tile stale.
+void ocio_tile_tracker_invalidate(OcioTileTracker * tracker, const OcioRect * rects, int count);
+// Number of tiles currently holding up-to-date output.
+int ocio_tile_tracker_num_valid(const OcioTileTracker * tracker);
+
+// Apply to the tiles of a packed RGBA f32 frame that touch `rects`
+// (rects == NULL or count == 0 means the whole frame), reading `src` and
+// writing `dst`. Rectangles are rounded out to the tile grid and overlaps
+// are applied once. With a tracker, tiles already transformed by an
+// equivalent processor are skipped and applied tiles are recorded; a
+// different processor makes every tile stale. dst may equal src only
+// without a tracker. Tiles run on the worker pool (num_threads as in
+// ocio_cpu_processor_apply_rgba_threaded).
+// Returns the number of tiles applied, or -1 on error.
+int ocio_cpu_processor_apply_rgba_rects(
+    const OcioCpuProcessor * cpu,
+    const float * src,
+    float * dst,
+    int width,
+    int height,
+    const OcioRect * rects,
+    int count,
+    OcioTileTracker * tracker,
+    int num_threads
+);
+
+// Bake a size^3 RGBA f32 3D LUT (red fastest, then green, then blue) into
+// out_rgba, which must hold size * size * size * 4 floats. The identity
+// lattice is transformed with a single packed apply.
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_cpu_processor_bake_lut3d(const OcioCpuProcessor * cpu, int size, float * out_rgba);
+// Same lattice as ocio_cpu_processor_bake_lut3d, looked up in the LUT disk
+// cache by CPU processor cache ID and size. On a hit the file is memory
+// mapped read-only; on a miss the LUT is baked and stored before returning.
+// Without a cache directory this bakes into heap memory.
+// Returns NULL on error (check ocio_get_last_error).
+OcioMappedLut * ocio_cpu_processor_bake_lut3d_cached(const OcioCpuProcessor * cpu, int size);
+void ocio_mapped_lut_destroy(OcioMappedLut * lut);
+// size * size * size * 4 floats, valid until the LUT is destroyed.
+const float * ocio_mapped_lut_data(const OcioMappedLut * lut);
+int ocio_mapped_lut_size(const OcioMappedLut * lut);
+// 1 when the data was mapped from an existing cache file, 0 when baked.
+int ocio_mapped_lut_from_disk(const OcioMappedLut * lut);
+// Apply a baked LUT in the ocio_cpu_processor_bake_lut3d layout in place to
+// packed RGBA f32 pixels instead of re-evaluating the processor's op chain.
+// Inputs are clamped to the [0, 1] lattice domain and alpha is left
+// unchanged. Rows are split over the worker pool as in
+// ocio_cpu_processor_apply_rgba_threaded. size must be in [2, 256].
+// Returns 1 on success, 0 on error (check ocio_get_last_error).
+int ocio_lut3d_apply_rgba(
+    const float * lut,
+    int size,
+    float * pixels,
+    int width,
+    int height,
+    int interpolation,
+    int num_threads
+);
+// SIMD kernel ocio_lut3d_apply_rgba uses on this CPU: "avx512", "avx2",
+// "neon" or "scalar".
+const char * ocio_lut3d_kernel_name(void);
 int ocio_cpu_processor_is_noop(const OcioCpuProcessor * cpu);
 
+// GPU shader extraction
+OcioGpuShader * ocio_processor_get_gpu_shader(
+    const OcioProcessor * proc,
+    int language,
+    const char * function_name,
+    const char * resource_prefix
+);
+void ocio_gpu_shader_destroy(OcioGpuShader * shader);
+const char * ocio_gpu_shader_get_text(const OcioGpuShader * shader);
+const char * ocio_gpu_shader_get_function_name(const OcioGpuShader * shader);
+
+// Uniform values are written as floats (bools as 0/1, ints converted).
+// ocio_gpu_shader_get_uniform_values returns the total value count, which
+// may exceed max_values; at most max_values floats are written.
+int ocio_gpu_shader_get_num_uniforms(const OcioGpuShader * shader);
+const char * ocio_gpu_shader_get_uniform_name(const OcioGpuShader * shader, int index);
+int ocio_gpu_shader_get_uniform_type(const OcioGpuShader * shader, int index);
+int ocio_gpu_shader_get_uniform_values(
+    const OcioGpuShader * shader,
+    int index,
+    float * out_values,
+    int max_values
+);
+
+// 1D/2D LUT textures. Values hold width * height * channels floats.
+// Returns 1 on success, 0 on error.
+int ocio_gpu_shader_get_num_textures(const OcioGpuShader * shader);
+int ocio_gpu_shader_get_texture(const OcioGpuShader * shader, int index, OcioGpuTextureInfo * out);
+const float * ocio_gpu_shader_get_texture_values(const OcioGpuShader * shader, int index);
+
+// 3D LUT textures (RGB). Values hold width * height * depth * 3 floats.
+// Returns 1 on success, 0 on error.
+int ocio_gpu_shader_get_num_textures_3d(const OcioGpuShader * shader);
+int ocio_gpu_shader_get_texture_3d(
+    const OcioGpuShader * shader,
+    int index,
+    OcioGpuTextureInfo * out
+);
+const float * ocio_gpu_shader_get_texture_3d_values(const OcioGpuShader * shader, int index);
+
 #ifdef __cplusplus
 }
 #endif
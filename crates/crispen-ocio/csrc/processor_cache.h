@@ -0,0 +1,141 @@
+#pragma once
+
+// Bounded, thread-safe LRU cache for OCIO processors.
+//
+// Building a processor on a large ACES config costs milliseconds to tens of
+// milliseconds, and review sessions flip between the same few views
+// constantly. Entries are keyed by the config's cache ID plus the transform
+// arguments, so configs loaded twice from the same file share entries.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace crispen
+{
+
+// Simple counters readable without taking the cache lock.
+struct CacheCounters
+{
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+template <typename Value>
+class LruCache
+{
+public:
+    explicit LruCache(std::size_t capacity) : m_capacity(capacity) {}
+
+    // Look up `key`; on a miss, call `build()` outside the lock and insert
+    // the result. `build` returns a null pointer on failure, which is not
+    // cached.
+    template <typename Build>
+    std::shared_ptr<Value> get_or_build(const std::string & key, Build && build)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_index.find(key);
+            if (it != m_index.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                m_counters.hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second->second;
+            }
+        }
+
+        m_counters.misses.fetch_add(1, std::memory_order_relaxed);
+        std::shared_ptr<Value> value = build();
+        if (!value)
+        {
+            return value;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capacity == 0)
+        {
+            return value;
+        }
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            // Another thread built the same entry concurrently; keep theirs.
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+        m_entries.emplace_front(key, value);
+        m_index[key] = m_entries.begin();
+        evict_locked();
+        return value;
+    }
+
+    void set_capacity(std::size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        evict_locked();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    std::size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+    const CacheCounters & counters() const { return m_counters; }
+
+    void reset_counters()
+    {
+        m_counters.hits.store(0, std::memory_order_relaxed);
+        m_counters.misses.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<Value>>;
+
+    void evict_locked()
+    {
+        while (m_entries.size() > m_capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::size_t m_capacity;
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> m_index;
+    CacheCounters m_counters;
+};
+
+// Join cache key fields with a separator that cannot appear in OCIO names.
+inline void append_key(std::string & key, const char * field)
+{
+    key.push_back('\x1f');
+    if (field)
+    {
+        key.append(field);
+    }
+}
+
+} // namespace crispen
@@ -0,0 +1,49 @@
+//! Process-wide processor cache controls.
+//!
+//! Every `OcioConfig::processor*` call and every CPU processor build goes
+//! through a bounded LRU cache on the C++ side, keyed by the config cache ID
+//! and the transform arguments. Flipping back to a recently used view reuses
+//! the already-built processor instead of rebuilding it.
+
+use crate::sys;
+
+/// Snapshot of the processor cache counters.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct OcioProcessorCacheStats {
+    pub processor_hits: u64,
+    pub processor_misses: u64,
+    pub cpu_hits: u64,
+    pub cpu_misses: u64,
+    pub processor_entries: u32,
+    pub cpu_entries: u32,
+    pub capacity: u32,
+}
+
+/// Read the current cache counters.
+pub fn processor_cache_stats() -> OcioProcessorCacheStats {
+    let mut raw = sys::OcioProcessorCacheStats::default();
+    // SAFETY: `raw` is a valid out-parameter for the duration of the call.
+    unsafe { sys::ocio_processor_cache_get_stats(&mut raw) };
+    OcioProcessorCacheStats {
+        processor_hits: raw.processor_hits,
+        processor_misses: raw.processor_misses,
+        cpu_hits: raw.cpu_hits,
+        cpu_misses: raw.cpu_misses,
+        processor_entries: raw.processor_entries.max(0) as u32,
+        cpu_entries: raw.cpu_entries.max(0) as u32,
+        capacity: raw.capacity.max(0) as u32,
+    }
+}
+
+/// Set the maximum number of cached processors (and, separately, CPU
+/// processors). `0` disables caching.
+pub fn set_processor_cache_capacity(max_entries: u32) {
+    // SAFETY: plain value call with no pointer arguments.
+    unsafe { sys::ocio_processor_cache_set_capacity(max_entries.min(i32::MAX as u32) as i32) };
+}
+
+/// Drop every cached processor and reset the counters.
+pub fn clear_processor_cache() {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::ocio_processor_cache_clear() };
+}
@@ -3,7 +3,8 @@ use std::path::Path;
 use std::ptr::NonNull;
 
 use crate::error::{OcioError, ffi_error};
-use crate::processor::OcioProcessor;
+use crate::grade::OcioGrade;
+use crate::processor::{OcioOptimization, OcioProcessor};
 use crate::sys;
 
 pub struct OcioConfig {
@@ -156,6 +157,74 @@ impl OcioConfig {
 
         OcioProcessor::from_raw(ptr)
     }
+
+    /// Processor for `src` -> `dst` applying `looks` (OCIO look syntax, e.g.
+    /// `"+grade, -shot"`) in between.
+    pub fn look_processor(
+        &self,
+        src: &str,
+        dst: &str,
+        looks: &str,
+    ) -> Result<OcioProcessor, OcioError> {
+        let src = CString::new(src)?;
+        let dst = CString::new(dst)?;
+        let looks = CString::new(looks)?;
+
+        // SAFETY: pointers are valid while called.
+        let ptr = unsafe {
+            sys::ocio_config_get_look_processor(
+                self.ptr.as_ptr(),
+                src.as_ptr(),
+                dst.as_ptr(),
+                looks.as_ptr(),
+            )
+        };
+
+        OcioProcessor::from_raw(ptr)
+    }
+
+    /// Processor for `src` -> `working` -> `grade` -> `display` / `view`
+    /// as one OCIO group, optimized with `optimization` so the stages fold
+    /// into a single op chain. Its CPU processor transforms a frame in one
+    /// pass instead of one pass per stage.
+    pub fn fused_processor(
+        &self,
+        src: &str,
+        working: &str,
+        display: &str,
+        view: &str,
+        grade: &OcioGrade<'_>,
+        optimization: OcioOptimization,
+    ) -> Result<OcioProcessor, OcioError> {
+        if let Some(lut) = grade.lut3d
+            && (lut.size < 2 || lut.entries.len() != (lut.size as usize).pow(3))
+        {
+            return Err(OcioError::InvalidArgument(
+                "grade LUT must hold size^3 entries with size >= 2",
+            ));
+        }
+        let src = CString::new(src)?;
+        let working = CString::new(working)?;
+        let display = CString::new(display)?;
+        let view = CString::new(view)?;
+        let raw_grade = grade.as_raw();
+
+        // SAFETY: pointers are valid while called; `raw_grade` borrows from
+        // `grade`, which outlives the call.
+        let ptr = unsafe {
+            sys::ocio_config_get_fused_processor(
+                self.ptr.as_ptr(),
+                src.as_ptr(),
+                working.as_ptr(),
+                display.as_ptr(),
+                view.as_ptr(),
+                &raw_grade,
+                optimization.to_raw(),
+            )
+        };
+
+        OcioProcessor::from_raw(ptr)
+    }
 }
 
 impl Drop for OcioConfig {
@@ -165,7 +234,7 @@ impl Drop for OcioConfig {
     }
 }
 
-fn cstr_to_string(ptr: *const std::ffi::c_char) -> Option<String> {
+pub(crate) fn cstr_to_string(ptr: *const std::ffi::c_char) -> Option<String> {
     if ptr.is_null() {
         return None;
     }
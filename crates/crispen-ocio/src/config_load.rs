@@ -0,0 +1,168 @@
+//! Background config loading.
+//!
+//! Parsing a large studio config and building its first display processor
+//! can take long enough to stall startup. [`OcioConfigLoad::start`] returns
+//! immediately and does that work on a background thread, optionally
+//! pre-building the processors named by [`OcioPrewarm`] into the processor
+//! cache so the first synchronous request for them is a cache hit.
+
+use std::ffi::{CStr, CString};
+use std::path::PathBuf;
+use std::ptr::NonNull;
+use std::time::Duration;
+
+use crate::config::OcioConfig;
+use crate::error::{OcioError, ffi_error};
+use crate::sys;
+
+/// Where an [`OcioConfigLoad`] reads its config from.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum OcioConfigSource {
+    File(PathBuf),
+    /// Built-in config URI (OCIO 2.2+).
+    Builtin(String),
+    /// The `$OCIO` environment variable.
+    Env,
+}
+
+/// Processors to build while the config loads. CPU processors are F32 with
+/// [`OcioCpuOptions::lossless`](crate::OcioCpuOptions::lossless), the
+/// settings the viewer bakes its LUTs with.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct OcioPrewarm {
+    /// `scene_linear` -> default display / default view, plus
+    /// `input_space` -> `scene_linear` when an input space is set.
+    pub display_view: bool,
+    /// Every role's color space -> `scene_linear`.
+    pub roles: bool,
+    pub input_space: Option<String>,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OcioConfigLoadStatus {
+    Pending,
+    Ready,
+    Failed,
+}
+
+impl OcioConfigLoadStatus {
+    fn from_raw(raw: i32) -> Self {
+        match raw {
+            sys::OCIO_CONFIG_LOAD_PENDING => Self::Pending,
+            sys::OCIO_CONFIG_LOAD_READY => Self::Ready,
+            _ => Self::Failed,
+        }
+    }
+}
+
+/// An in-flight or finished config load. Dropping it waits for the
+/// background thread.
+pub struct OcioConfigLoad {
+    ptr: NonNull<sys::OcioConfigLoad>,
+}
+
+// SAFETY: The C side guards all load state with a mutex; the handle is only
+// freed by `Drop`.
+unsafe impl Send for OcioConfigLoad {}
+// SAFETY: See `Send` safety note above.
+unsafe impl Sync for OcioConfigLoad {}
+
+impl OcioConfigLoad {
+    pub fn start(source: &OcioConfigSource, prewarm: &OcioPrewarm) -> Result<Self, OcioError> {
+        let (raw_source, path_or_uri) = match source {
+            OcioConfigSource::File(path) => (
+                sys::OCIO_CONFIG_SOURCE_FILE,
+                Some(CString::new(path.to_string_lossy().as_bytes())?),
+            ),
+            OcioConfigSource::Builtin(uri) => (
+                sys::OCIO_CONFIG_SOURCE_BUILTIN,
+                Some(CString::new(uri.as_str())?),
+            ),
+            OcioConfigSource::Env => (sys::OCIO_CONFIG_SOURCE_ENV, None),
+        };
+        let input_space = prewarm
+            .input_space
+            .as_deref()
+            .map(CString::new)
+            .transpose()?;
+        let mut flags = 0;
+        if prewarm.display_view {
+            flags |= sys::OCIO_PREWARM_DISPLAY_VIEW;
+        }
+        if prewarm.roles {
+            flags |= sys::OCIO_PREWARM_ROLES;
+        }
+
+        let path_ptr = path_or_uri
+            .as_ref()
+            .map_or(std::ptr::null(), |s| s.as_ptr());
+        let input_ptr = input_space
+            .as_ref()
+            .map_or(std::ptr::null(), |s| s.as_ptr());
+        // SAFETY: string arguments are null or NUL-terminated and alive for the
+        // call; the C side copies them before returning.
+        let ptr = unsafe { sys::ocio_config_load_async(raw_source, path_ptr, input_ptr, flags) };
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    pub fn status(&self) -> OcioConfigLoadStatus {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        OcioConfigLoadStatus::from_raw(unsafe { sys::ocio_config_load_status(self.ptr.as_ptr()) })
+    }
+
+    /// Block for at most `timeout`, returning the status at that point.
+    pub fn wait_timeout(&self, timeout: Duration) -> OcioConfigLoadStatus {
+        let ms = timeout.as_millis().min(i32::MAX as u128) as i32;
+        // SAFETY: `self.ptr` is valid while `self` is alive; waiting only
+        // touches mutex-guarded state.
+        OcioConfigLoadStatus::from_raw(unsafe { sys::ocio_config_load_wait(self.ptr.as_ptr(), ms) })
+    }
+
+    /// Block until the load finishes and return the config.
+    pub fn wait(&self) -> Result<OcioConfig, OcioError> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        unsafe { sys::ocio_config_load_wait(self.ptr.as_ptr(), -1) };
+        self.config()
+    }
+
+    /// The config once the load finished, `None` while it is still pending.
+    pub fn try_config(&self) -> Option<Result<OcioConfig, OcioError>> {
+        match self.status() {
+            OcioConfigLoadStatus::Pending => None,
+            _ => Some(self.config()),
+        }
+    }
+
+    /// Error message of a failed load.
+    pub fn error(&self) -> Option<String> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let ptr = unsafe { sys::ocio_config_load_get_error(self.ptr.as_ptr()) };
+        if ptr.is_null() {
+            return None;
+        }
+        // SAFETY: the message is NUL-terminated and owned by the handle, and a
+        // failed load never changes state again.
+        Some(
+            unsafe { CStr::from_ptr(ptr) }
+                .to_string_lossy()
+                .into_owned(),
+        )
+    }
+
+    fn config(&self) -> Result<OcioConfig, OcioError> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let ptr = unsafe { sys::ocio_config_load_get_config(self.ptr.as_ptr()) };
+        NonNull::new(ptr)
+            .map(|ptr| OcioConfig { ptr })
+            .ok_or_else(ffi_error)
+    }
+}
+
+impl Drop for OcioConfigLoad {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::ocio_config_load_destroy(self.ptr.as_ptr()) };
+    }
+}
@@ -0,0 +1,259 @@
+use std::ffi::CString;
+use std::ptr::NonNull;
+
+use crate::config::cstr_to_string;
+use crate::error::{OcioError, ffi_error};
+use crate::sys;
+
+/// Shading language targeted by a generated OCIO GPU shader.
+///
+/// wgpu consumers typically request GLSL 4.0 and cross-compile it through
+/// naga's GLSL front end.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OcioGpuLanguage {
+    Glsl4_0,
+    GlslEs3_0,
+    HlslDx11,
+    /// Requires OpenColorIO 2.2+.
+    Msl2_0,
+}
+
+impl OcioGpuLanguage {
+    fn to_raw(self) -> i32 {
+        match self {
+            Self::Glsl4_0 => sys::OCIO_GPU_LANGUAGE_GLSL_4_0,
+            Self::GlslEs3_0 => sys::OCIO_GPU_LANGUAGE_GLSL_ES_3_0,
+            Self::HlslDx11 => sys::OCIO_GPU_LANGUAGE_HLSL_DX11,
+            Self::Msl2_0 => sys::OCIO_GPU_LANGUAGE_MSL_2_0,
+        }
+    }
+}
+
+/// Value type of a uniform declared by a generated shader.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OcioGpuUniformKind {
+    Double,
+    Bool,
+    Float3,
+    VectorFloat,
+    VectorInt,
+    Unknown,
+}
+
+/// A uniform declared by a generated shader, with its current value.
+///
+/// Values are widened/narrowed to f32: bools become 0/1 and ints are
+/// converted, matching how they are uploaded into a uniform buffer.
+#[derive(Debug, Clone, PartialEq)]
+pub struct OcioGpuUniform {
+    pub name: String,
+    pub kind: OcioGpuUniformKind,
+    pub values: Vec<f32>,
+}
+
+/// A LUT texture required by a generated shader.
+#[derive(Debug, Clone, PartialEq)]
+pub struct OcioGpuTexture {
+    pub texture_name: String,
+    pub sampler_name: String,
+    pub width: u32,
+    pub height: u32,
+    pub depth: u32,
+    /// 1 (red only) or 3 (RGB) f32 channels per texel.
+    pub channels: u32,
+    /// 1, 2 or 3.
+    pub dimensions: u32,
+    /// Whether the sampler should filter linearly (otherwise nearest).
+    pub linear_filter: bool,
+    /// Texel data, `width * height * depth * channels` floats.
+    pub values: Vec<f32>,
+}
+
+/// Shader text and resources extracted from an OCIO GPU processor.
+pub struct OcioGpuShader {
+    ptr: NonNull<sys::OcioGpuShader>,
+}
+
+// SAFETY: The extracted shader description is immutable after creation and
+// only exposed through `&self` queries.
+unsafe impl Send for OcioGpuShader {}
+// SAFETY: See `Send` safety note above.
+unsafe impl Sync for OcioGpuShader {}
+
+impl OcioGpuShader {
+    pub(crate) fn create(
+        proc: *const sys::OcioProcessor,
+        language: OcioGpuLanguage,
+        function_name: &str,
+        resource_prefix: &str,
+    ) -> Result<Self, OcioError> {
+        let function_name = CString::new(function_name)?;
+        let resource_prefix = CString::new(resource_prefix)?;
+
+        // SAFETY: `proc` is a live processor and strings outlive the call.
+        let raw = unsafe {
+            sys::ocio_processor_get_gpu_shader(
+                proc,
+                language.to_raw(),
+                function_name.as_ptr(),
+                resource_prefix.as_ptr(),
+            )
+        };
+        NonNull::new(raw)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Generated shader source declaring the OCIO transform function.
+    pub fn shader_text(&self) -> String {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let ptr = unsafe { sys::ocio_gpu_shader_get_text(self.ptr.as_ptr()) };
+        cstr_to_string(ptr).unwrap_or_default()
+    }
+
+    /// Name of the transform function inside [`shader_text`](Self::shader_text).
+    pub fn function_name(&self) -> String {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let ptr = unsafe { sys::ocio_gpu_shader_get_function_name(self.ptr.as_ptr()) };
+        cstr_to_string(ptr).unwrap_or_default()
+    }
+
+    /// Uniforms declared by the shader, with their current values.
+    pub fn uniforms(&self) -> Vec<OcioGpuUniform> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let count = unsafe { sys::ocio_gpu_shader_get_num_uniforms(self.ptr.as_ptr()) };
+        if count <= 0 {
+            return Vec::new();
+        }
+
+        (0..count)
+            .filter_map(|i| {
+                // SAFETY: index in range and `self` alive.
+                let name = unsafe { sys::ocio_gpu_shader_get_uniform_name(self.ptr.as_ptr(), i) };
+                let name = cstr_to_string(name)?;
+                // SAFETY: index in range and `self` alive.
+                let kind =
+                    match unsafe { sys::ocio_gpu_shader_get_uniform_type(self.ptr.as_ptr(), i) } {
+                        sys::OCIO_GPU_UNIFORM_DOUBLE => OcioGpuUniformKind::Double,
+                        sys::OCIO_GPU_UNIFORM_BOOL => OcioGpuUniformKind::Bool,
+                        sys::OCIO_GPU_UNIFORM_FLOAT3 => OcioGpuUniformKind::Float3,
+                        sys::OCIO_GPU_UNIFORM_VECTOR_FLOAT => OcioGpuUniformKind::VectorFloat,
+                        sys::OCIO_GPU_UNIFORM_VECTOR_INT => OcioGpuUniformKind::VectorInt,
+                        _ => OcioGpuUniformKind::Unknown,
+                    };
+
+                // SAFETY: a null output pointer only queries the value count.
+                let len = unsafe {
+                    sys::ocio_gpu_shader_get_uniform_values(
+                        self.ptr.as_ptr(),
+                        i,
+                        std::ptr::null_mut(),
+                        0,
+                    )
+                };
+                let mut values = vec![0.0_f32; len.max(0) as usize];
+                if !values.is_empty() {
+                    // SAFETY: `values` holds exactly `len` floats.
+                    unsafe {
+                        sys::ocio_gpu_shader_get_uniform_values(
+                            self.ptr.as_ptr(),
+                            i,
+                            values.as_mut_ptr(),
+                            len,
+                        );
+                    }
+                }
+
+                Some(OcioGpuUniform { name, kind, values })
+            })
+            .collect()
+    }
+
+    /// 1D/2D LUT textures required by the shader.
+    pub fn textures(&self) -> Vec<OcioGpuTexture> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let count = unsafe { sys::ocio_gpu_shader_get_num_textures(self.ptr.as_ptr()) };
+        self.collect_textures(
+            count,
+            sys::ocio_gpu_shader_get_texture,
+            sys::ocio_gpu_shader_get_texture_values,
+        )
+    }
+
+    /// 3D LUT textures required by the shader.
+    pub fn textures_3d(&self) -> Vec<OcioGpuTexture> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let count = unsafe { sys::ocio_gpu_shader_get_num_textures_3d(self.ptr.as_ptr()) };
+        self.collect_textures(
+            count,
+            sys::ocio_gpu_shader_get_texture_3d,
+            sys::ocio_gpu_shader_get_texture_3d_values,
+        )
+    }
+
+    fn collect_textures(
+        &self,
+        count: i32,
+        info_fn: unsafe extern "C" fn(
+            *const sys::OcioGpuShader,
+            i32,
+            *mut sys::OcioGpuTextureInfo,
+        ) -> i32,
+        values_fn: unsafe extern "C" fn(*const sys::OcioGpuShader, i32) -> *const f32,
+    ) -> Vec<OcioGpuTexture> {
+        if count <= 0 {
+            return Vec::new();
+        }
+
+        (0..count)
+            .filter_map(|i| {
+                let mut info = sys::OcioGpuTextureInfo {
+                    texture_name: std::ptr::null(),
+                    sampler_name: std::ptr::null(),
+                    width: 0,
+                    height: 0,
+                    depth: 0,
+                    channels: 0,
+                    dimensions: 0,
+                    linear_filter: 0,
+                };
+                // SAFETY: index in range, `info` is a valid out-parameter.
+                if unsafe { info_fn(self.ptr.as_ptr(), i, &mut info) } == 0 {
+                    return None;
+                }
+
+                let len = info.width.max(0) as usize
+                    * info.height.max(0) as usize
+                    * info.depth.max(0) as usize
+                    * info.channels.max(0) as usize;
+                // SAFETY: index in range and `self` alive.
+                let ptr = unsafe { values_fn(self.ptr.as_ptr(), i) };
+                let values = if ptr.is_null() || len == 0 {
+                    Vec::new()
+                } else {
+                    // SAFETY: OCIO guarantees `len` floats of texel data.
+                    unsafe { std::slice::from_raw_parts(ptr, len) }.to_vec()
+                };
+
+                Some(OcioGpuTexture {
+                    texture_name: cstr_to_string(info.texture_name).unwrap_or_default(),
+                    sampler_name: cstr_to_string(info.sampler_name).unwrap_or_default(),
+                    width: info.width.max(0) as u32,
+                    height: info.height.max(0) as u32,
+                    depth: info.depth.max(0) as u32,
+                    channels: info.channels.max(0) as u32,
+                    dimensions: info.dimensions.max(0) as u32,
+                    linear_filter: info.linear_filter != 0,
+                    values,
+                })
+            })
+            .collect()
+    }
+}
+
+impl Drop for OcioGpuShader {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::ocio_gpu_shader_destroy(self.ptr.as_ptr()) };
+    }
+}
@@ -0,0 +1,55 @@
+//! Working-space grades folded into fused processors.
+//!
+//! [`OcioConfig::fused_processor`](crate::OcioConfig::fused_processor)
+//! builds IDT -> grade -> ODT as one OCIO processor, so a CPU render or
+//! export makes one pass over each frame instead of three.
+
+use crate::lut3d::OcioLutInterpolation;
+use crate::sys;
+
+/// A `size`³ RGBA lattice in the [`bake_3d_lut`] layout over `[0, 1]` of
+/// the working space. LUT alpha is ignored.
+///
+/// [`bake_3d_lut`]: crate::OcioCpuProcessor::bake_3d_lut
+#[derive(Debug, Clone, Copy)]
+pub struct OcioGradeLut<'a> {
+    pub entries: &'a [[f32; 4]],
+    pub size: u32,
+    pub interpolation: OcioLutInterpolation,
+}
+
+/// Grade applied in the working space. The matrix and offset apply before
+/// the LUT; unset parts are skipped.
+#[derive(Debug, Clone, Copy, Default)]
+pub struct OcioGrade<'a> {
+    /// Row-major 4x4 matrix on RGBA.
+    pub matrix: Option<[f32; 16]>,
+    /// RGBA offset added after the matrix.
+    pub offset: Option<[f32; 4]>,
+    pub lut3d: Option<OcioGradeLut<'a>>,
+}
+
+impl OcioGrade<'_> {
+    /// The C descriptor; borrows `self` for the pointers it holds.
+    pub(crate) fn as_raw(&self) -> sys::OcioGradeDesc {
+        sys::OcioGradeDesc {
+            matrix: self
+                .matrix
+                .as_ref()
+                .map_or(std::ptr::null(), |m| m.as_ptr()),
+            offset: self
+                .offset
+                .as_ref()
+                .map_or(std::ptr::null(), |o| o.as_ptr()),
+            lut3d: self
+                .lut3d
+                .map_or(std::ptr::null(), |lut| lut.entries.as_ptr().cast::<f32>()),
+            lut3d_size: self
+                .lut3d
+                .map_or(0, |lut| lut.size.min(i32::MAX as u32) as i32),
+            lut3d_interpolation: self.lut3d.map_or(sys::OCIO_LUT3D_INTERP_TRILINEAR, |lut| {
+                lut.interpolation.to_raw()
+            }),
+        }
+    }
+}
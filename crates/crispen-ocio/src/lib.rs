@@ -5,11 +5,37 @@
 #![allow(unsafe_code)]
 // FFI wrappers necessarily use unsafe externs and raw pointers.
 
+mod cache;
 mod config;
+mod config_load;
 mod error;
+mod gpu_shader;
+mod grade;
+mod lut3d;
+mod lut_cache;
+mod perf;
+mod pixel;
 mod processor;
 mod sys;
+mod tiles;
 
+pub use cache::{
+    OcioProcessorCacheStats, clear_processor_cache, processor_cache_stats,
+    set_processor_cache_capacity,
+};
 pub use config::OcioConfig;
+pub use config_load::{OcioConfigLoad, OcioConfigLoadStatus, OcioConfigSource, OcioPrewarm};
 pub use error::OcioError;
-pub use processor::{OcioCpuProcessor, OcioProcessor};
+pub use gpu_shader::{
+    OcioGpuLanguage, OcioGpuShader, OcioGpuTexture, OcioGpuUniform, OcioGpuUniformKind,
+};
+pub use grade::{OcioGrade, OcioGradeLut};
+pub use lut_cache::{OcioMappedLut, set_lut_cache_directory};
+pub use lut3d::{OcioLutInterpolation, apply_lut3d_rgba, lut3d_kernel_name};
+pub use perf::{
+    OcioPerfCallback, OcioPerfCounter, OcioPerfStage, OcioPerfStats, perf_enabled, perf_stats,
+    reset_perf_stats, set_perf_callback, set_perf_enabled,
+};
+pub use pixel::{OcioBitDepth, OcioChannelOrder, OcioImageLayout, OcioSample};
+pub use processor::{OcioCpuOptions, OcioCpuProcessor, OcioOptimization, OcioProcessor};
+pub use tiles::{OcioRect, OcioTileTracker};
@@ -0,0 +1,92 @@
+//! CPU apply of baked 3D LUTs.
+//!
+//! A LUT from [`OcioCpuProcessor::bake_3d_lut`] or
+//! [`OcioCpuProcessor::bake_3d_lut_cached`] stands in for the processor on
+//! the CPU: one SIMD lattice lookup per pixel instead of the full OCIO op
+//! chain, and the same result the viewer gets from sampling the LUT on the
+//! GPU.
+//!
+//! [`OcioCpuProcessor::bake_3d_lut`]: crate::OcioCpuProcessor::bake_3d_lut
+//! [`OcioCpuProcessor::bake_3d_lut_cached`]: crate::OcioCpuProcessor::bake_3d_lut_cached
+
+use std::ffi::CStr;
+
+use crate::error::{OcioError, ffi_error};
+use crate::sys;
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum OcioLutInterpolation {
+    /// Matches sampling the lattice as a linearly filtered 3D texture.
+    #[default]
+    Trilinear,
+    Tetrahedral,
+}
+
+impl OcioLutInterpolation {
+    pub(crate) fn to_raw(self) -> i32 {
+        match self {
+            Self::Trilinear => sys::OCIO_LUT3D_INTERP_TRILINEAR,
+            Self::Tetrahedral => sys::OCIO_LUT3D_INTERP_TETRAHEDRAL,
+        }
+    }
+}
+
+/// Apply a baked `size`³ LUT in place to a packed RGBA frame. Inputs are
+/// clamped to the `[0, 1]` lattice domain and alpha is left unchanged.
+///
+/// `threads == 0` uses every hardware thread; `1` applies on the calling
+/// thread only.
+pub fn apply_lut3d_rgba(
+    lut: &[[f32; 4]],
+    size: u32,
+    pixels: &mut [[f32; 4]],
+    width: u32,
+    height: u32,
+    interpolation: OcioLutInterpolation,
+    threads: u32,
+) -> Result<(), OcioError> {
+    let entries = (size as usize).pow(3);
+    if size < 2 || lut.len() != entries {
+        return Err(OcioError::InvalidArgument(
+            "LUT must hold size^3 entries with size >= 2",
+        ));
+    }
+    if pixels.len() != width as usize * height as usize {
+        return Err(OcioError::InvalidArgument(
+            "pixel buffer does not match dimensions",
+        ));
+    }
+    if pixels.is_empty() {
+        return Ok(());
+    }
+
+    // SAFETY: `lut` holds `size`³ RGBA f32 entries and `pixels` exactly
+    // `width * height` RGBA f32 pixels, both contiguous.
+    let ok = unsafe {
+        sys::ocio_lut3d_apply_rgba(
+            lut.as_ptr().cast::<f32>(),
+            size.min(i32::MAX as u32) as i32,
+            pixels.as_mut_ptr().cast::<f32>(),
+            width as i32,
+            height as i32,
+            interpolation.to_raw(),
+            threads.min(i32::MAX as u32) as i32,
+        )
+    };
+    if ok == 0 {
+        return Err(ffi_error());
+    }
+    Ok(())
+}
+
+/// SIMD kernel [`apply_lut3d_rgba`] uses on this CPU: `"avx512"`,
+/// `"avx2"`, `"neon"` or `"scalar"`.
+pub fn lut3d_kernel_name() -> &'static str {
+    // SAFETY: returns a static NUL-terminated string.
+    let ptr = unsafe { sys::ocio_lut3d_kernel_name() };
+    if ptr.is_null() {
+        return "scalar";
+    }
+    // SAFETY: the string is static and valid UTF-8 (ASCII).
+    unsafe { CStr::from_ptr(ptr) }.to_str().unwrap_or("scalar")
+}
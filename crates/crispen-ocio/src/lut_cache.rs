@@ -0,0 +1,102 @@
+//! Persistent on-disk cache for baked 3D LUTs.
+//!
+//! [`OcioCpuProcessor::bake_3d_lut_cached`] stores each baked lattice under
+//! the configured directory, keyed by the CPU processor cache ID and the
+//! LUT size, and memory-maps it on later calls, so a relaunch or a switch
+//! back to a known view skips the bake entirely.
+//!
+//! [`OcioCpuProcessor::bake_3d_lut_cached`]: crate::OcioCpuProcessor::bake_3d_lut_cached
+
+use std::ffi::CString;
+use std::path::Path;
+use std::ptr::NonNull;
+
+use crate::error::{OcioError, ffi_error};
+use crate::lut3d::{OcioLutInterpolation, apply_lut3d_rgba};
+use crate::sys;
+
+/// Set the directory baked LUTs are stored in. `None` disables the disk
+/// cache (the default); the directory is created on first write.
+pub fn set_lut_cache_directory(dir: Option<&Path>) -> Result<(), OcioError> {
+    let dir = dir
+        .map(|dir| CString::new(dir.to_string_lossy().as_bytes()))
+        .transpose()?;
+    let ptr = dir.as_ref().map_or(std::ptr::null(), |dir| dir.as_ptr());
+    // SAFETY: `ptr` is null or a NUL-terminated string alive for the call.
+    let ok = unsafe { sys::ocio_lut_cache_set_directory(ptr) };
+    if ok == 0 {
+        return Err(ffi_error());
+    }
+    Ok(())
+}
+
+/// A baked `size`³ RGBA 3D LUT, either memory-mapped from the disk cache
+/// or held in memory after a fresh bake.
+pub struct OcioMappedLut {
+    ptr: NonNull<sys::OcioMappedLut>,
+}
+
+// SAFETY: The LUT is immutable after construction and owned by this wrapper.
+unsafe impl Send for OcioMappedLut {}
+// SAFETY: Only read-only accessors are exposed.
+unsafe impl Sync for OcioMappedLut {}
+
+impl OcioMappedLut {
+    pub(crate) fn from_raw(raw: *mut sys::OcioMappedLut) -> Result<Self, OcioError> {
+        NonNull::new(raw)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    pub fn size(&self) -> u32 {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        unsafe { sys::ocio_mapped_lut_size(self.ptr.as_ptr()) }.max(0) as u32
+    }
+
+    /// Whether the entries were mapped from an existing cache file rather
+    /// than baked by this call.
+    pub fn from_disk(&self) -> bool {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        unsafe { sys::ocio_mapped_lut_from_disk(self.ptr.as_ptr()) != 0 }
+    }
+
+    /// Entries ordered red-fastest, then green, then blue.
+    pub fn as_slice(&self) -> &[[f32; 4]] {
+        let size = self.size() as usize;
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let data = unsafe { sys::ocio_mapped_lut_data(self.ptr.as_ptr()) };
+        if data.is_null() {
+            return &[];
+        }
+        // SAFETY: the C side guarantees `size`³ RGBA f32 entries (16-byte
+        // aligned within the mapping) that live as long as the handle.
+        unsafe { std::slice::from_raw_parts(data.cast::<[f32; 4]>(), size * size * size) }
+    }
+
+    /// [`apply_lut3d_rgba`](crate::apply_lut3d_rgba) with this LUT.
+    pub fn apply_rgba(
+        &self,
+        pixels: &mut [[f32; 4]],
+        width: u32,
+        height: u32,
+        interpolation: OcioLutInterpolation,
+        threads: u32,
+    ) -> Result<(), OcioError> {
+        apply_lut3d_rgba(
+            self.as_slice(),
+            self.size(),
+            pixels,
+            width,
+            height,
+            interpolation,
+            threads,
+        )
+    }
+}
+
+impl Drop for OcioMappedLut {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::ocio_mapped_lut_destroy(self.ptr.as_ptr()) };
+    }
+}
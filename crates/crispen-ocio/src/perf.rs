@@ -0,0 +1,119 @@
+//! Opt-in hot-path instrumentation.
+//!
+//! When enabled with [`set_perf_enabled`], every processor build, buffer
+//! apply, LUT bake and shader extraction adds to per-stage call counts,
+//! cumulative wall time and bytes processed on the C++ side. Totals are
+//! read with [`perf_stats`]; [`set_perf_callback`] additionally reports
+//! each call as it completes.
+
+use std::ffi::c_int;
+
+use crispen_ffi::perf::{PerfCallback, PerfCallbackSlot, PerfCounter, PerfStage, PerfStats};
+
+use crate::sys;
+
+/// Instrumented stage of the OCIO C API.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum OcioPerfStage {
+    /// Processor lookup/build from a config.
+    ProcessorBuild,
+    /// CPU processor lookup/build from a processor.
+    CpuProcessorBuild,
+    /// Buffer applies (per-pixel applies are not instrumented).
+    CpuApply,
+    LutBake,
+    /// LUTs mapped from the disk cache instead of baked.
+    LutCacheLoad,
+    GpuShader,
+}
+
+impl OcioPerfStage {
+    pub const ALL: [Self; sys::OCIO_PERF_STAGE_COUNT] = [
+        Self::ProcessorBuild,
+        Self::CpuProcessorBuild,
+        Self::CpuApply,
+        Self::LutBake,
+        Self::LutCacheLoad,
+        Self::GpuShader,
+    ];
+
+    /// Short snake_case name, e.g. `"cpu_apply"`.
+    pub fn name(self) -> &'static str {
+        match self {
+            Self::ProcessorBuild => "processor_build",
+            Self::CpuProcessorBuild => "cpu_processor_build",
+            Self::CpuApply => "cpu_apply",
+            Self::LutBake => "lut_bake",
+            Self::LutCacheLoad => "lut_cache_load",
+            Self::GpuShader => "gpu_shader",
+        }
+    }
+}
+
+impl PerfStage for OcioPerfStage {
+    const ALL: &'static [Self] = &Self::ALL;
+
+    fn to_raw(self) -> c_int {
+        match self {
+            Self::ProcessorBuild => sys::OCIO_PERF_PROCESSOR_BUILD,
+            Self::CpuProcessorBuild => sys::OCIO_PERF_CPU_PROCESSOR_BUILD,
+            Self::CpuApply => sys::OCIO_PERF_CPU_APPLY,
+            Self::LutBake => sys::OCIO_PERF_LUT_BAKE,
+            Self::LutCacheLoad => sys::OCIO_PERF_LUT_CACHE_LOAD,
+            Self::GpuShader => sys::OCIO_PERF_GPU_SHADER,
+        }
+    }
+}
+
+/// Cumulative totals for one stage. `bytes` counts source pixel bytes
+/// for applies, output bytes for LUT bakes, 0 for builds.
+pub type OcioPerfCounter = PerfCounter;
+
+/// Snapshot of every stage's counters.
+pub type OcioPerfStats = PerfStats<OcioPerfStage, { sys::OCIO_PERF_STAGE_COUNT }>;
+
+/// Per-call callback: stage, wall time and bytes processed.
+pub type OcioPerfCallback = PerfCallback<OcioPerfStage>;
+
+/// Registered callback, kept alive here while the C side may call it.
+static CALLBACK: PerfCallbackSlot<OcioPerfStage> = PerfCallbackSlot::new();
+
+/// Turn instrumentation on or off (off by default).
+pub fn set_perf_enabled(enabled: bool) {
+    // SAFETY: plain value call with no pointer arguments.
+    unsafe { sys::ocio_perf_set_enabled(c_int::from(enabled)) };
+}
+
+pub fn perf_enabled() -> bool {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::ocio_perf_is_enabled() != 0 }
+}
+
+/// Read the cumulative per-stage counters.
+pub fn perf_stats() -> OcioPerfStats {
+    let mut raw = sys::OcioPerfStats::default();
+    // SAFETY: `raw` is a valid out-parameter for the duration of the call.
+    unsafe { sys::ocio_perf_get_stats(&mut raw) };
+    OcioPerfStats::from_raw(&raw)
+}
+
+/// Zero every stage's counters.
+pub fn reset_perf_stats() {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::ocio_perf_reset() };
+}
+
+/// Register `callback` to be called after every instrumented call, on the
+/// calling thread, while instrumentation is enabled. `None` unregisters.
+///
+/// The callback may call `set_perf_callback` itself, e.g. to unregister
+/// after the first slow call.
+pub fn set_perf_callback(callback: Option<OcioPerfCallback>) {
+    // SAFETY: `ocio_perf_set_callback` waits for calls of the
+    // callback it replaces on other threads before returning.
+    unsafe {
+        CALLBACK.set(callback, |callback, user| {
+            sys::ocio_perf_set_callback(callback, user)
+        })
+    };
+}
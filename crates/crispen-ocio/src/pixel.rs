@@ -0,0 +1,195 @@
+use crate::error::OcioError;
+use crate::sys;
+
+/// Channel layout of a pixel region passed to the strided/typed applies.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OcioChannelOrder {
+    Rgb,
+    Rgba,
+    Bgra,
+}
+
+impl OcioChannelOrder {
+    pub fn channels(self) -> usize {
+        match self {
+            Self::Rgb => 3,
+            Self::Rgba | Self::Bgra => 4,
+        }
+    }
+
+    pub(crate) fn to_raw(self) -> i32 {
+        match self {
+            Self::Rgb => sys::OCIO_CHANNEL_ORDER_RGB,
+            Self::Rgba => sys::OCIO_CHANNEL_ORDER_RGBA,
+            Self::Bgra => sys::OCIO_CHANNEL_ORDER_BGRA,
+        }
+    }
+}
+
+/// Per-channel storage of a CPU processor's input or output buffers.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OcioBitDepth {
+    U8,
+    U10,
+    U12,
+    U16,
+    F16,
+    F32,
+}
+
+impl OcioBitDepth {
+    pub(crate) fn to_raw(self) -> i32 {
+        match self {
+            Self::U8 => sys::OCIO_BIT_DEPTH_UINT8,
+            Self::U10 => sys::OCIO_BIT_DEPTH_UINT10,
+            Self::U12 => sys::OCIO_BIT_DEPTH_UINT12,
+            Self::U16 => sys::OCIO_BIT_DEPTH_UINT16,
+            Self::F16 => sys::OCIO_BIT_DEPTH_F16,
+            Self::F32 => sys::OCIO_BIT_DEPTH_F32,
+        }
+    }
+
+    pub(crate) fn from_raw(raw: i32) -> Option<Self> {
+        match raw {
+            sys::OCIO_BIT_DEPTH_UINT8 => Some(Self::U8),
+            sys::OCIO_BIT_DEPTH_UINT10 => Some(Self::U10),
+            sys::OCIO_BIT_DEPTH_UINT12 => Some(Self::U12),
+            sys::OCIO_BIT_DEPTH_UINT16 => Some(Self::U16),
+            sys::OCIO_BIT_DEPTH_F16 => Some(Self::F16),
+            sys::OCIO_BIT_DEPTH_F32 => Some(Self::F32),
+            _ => None,
+        }
+    }
+}
+
+mod sealed {
+    pub trait Sealed {}
+    impl Sealed for u8 {}
+    impl Sealed for u16 {}
+    impl Sealed for f32 {}
+}
+
+/// Rust storage type for one channel sample at a given [`OcioBitDepth`].
+///
+/// 10/12/16-bit integers and half floats are all stored as `u16` words
+/// (half as raw IEEE bits).
+pub trait OcioSample: sealed::Sealed + Copy {
+    fn supports(depth: OcioBitDepth) -> bool;
+}
+
+impl OcioSample for u8 {
+    fn supports(depth: OcioBitDepth) -> bool {
+        depth == OcioBitDepth::U8
+    }
+}
+
+impl OcioSample for u16 {
+    fn supports(depth: OcioBitDepth) -> bool {
+        matches!(
+            depth,
+            OcioBitDepth::U10 | OcioBitDepth::U12 | OcioBitDepth::U16 | OcioBitDepth::F16
+        )
+    }
+}
+
+impl OcioSample for f32 {
+    fn supports(depth: OcioBitDepth) -> bool {
+        depth == OcioBitDepth::F32
+    }
+}
+
+/// Memory layout of a pixel region, possibly inside a larger image.
+///
+/// Strides are in bytes; `0` means tightly packed (`x_stride_bytes` equal to
+/// one pixel, `y_stride_bytes` equal to `width` pixels).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct OcioImageLayout {
+    pub width: u32,
+    pub height: u32,
+    pub channel_order: OcioChannelOrder,
+    pub x_stride_bytes: usize,
+    pub y_stride_bytes: usize,
+}
+
+impl OcioImageLayout {
+    /// A tightly packed `width` x `height` layout.
+    pub fn packed(width: u32, height: u32, channel_order: OcioChannelOrder) -> Self {
+        Self {
+            width,
+            height,
+            channel_order,
+            x_stride_bytes: 0,
+            y_stride_bytes: 0,
+        }
+    }
+
+    /// A `width` x `height` region inside a packed image of `T` samples that
+    /// is `full_width` pixels wide.
+    ///
+    /// The slice passed to an apply must start at the region's first pixel.
+    pub fn sub_region<T: OcioSample>(
+        width: u32,
+        height: u32,
+        full_width: u32,
+        channel_order: OcioChannelOrder,
+    ) -> Self {
+        let pixel_bytes = channel_order.channels() * std::mem::size_of::<T>();
+        Self {
+            width,
+            height,
+            channel_order,
+            x_stride_bytes: pixel_bytes,
+            y_stride_bytes: full_width as usize * pixel_bytes,
+        }
+    }
+
+    /// Effective (x, y) strides in bytes for `T` samples.
+    fn strides<T: OcioSample>(&self) -> (usize, usize) {
+        let pixel_bytes = self.channel_order.channels() * std::mem::size_of::<T>();
+        let x = if self.x_stride_bytes == 0 {
+            pixel_bytes
+        } else {
+            self.x_stride_bytes
+        };
+        let y = if self.y_stride_bytes == 0 {
+            x * self.width as usize
+        } else {
+            self.y_stride_bytes
+        };
+        (x, y)
+    }
+
+    /// Number of `T` samples a slice must hold to cover the whole region.
+    pub fn required_len<T: OcioSample>(&self) -> usize {
+        if self.width == 0 || self.height == 0 {
+            return 0;
+        }
+        let (x, y) = self.strides::<T>();
+        let last_pixel = (self.height as usize - 1) * y + (self.width as usize - 1) * x;
+        last_pixel / std::mem::size_of::<T>() + self.channel_order.channels()
+    }
+
+    /// Check the layout against a slice of `len` samples and return the
+    /// effective byte strides.
+    pub(crate) fn validate<T: OcioSample>(&self, len: usize) -> Result<(usize, usize), OcioError> {
+        if self.width == 0 || self.height == 0 {
+            return Err(OcioError::InvalidArgument("region has zero dimensions"));
+        }
+        let sample = std::mem::size_of::<T>();
+        let (x, y) = self.strides::<T>();
+        if x % sample != 0 || y % sample != 0 {
+            return Err(OcioError::InvalidArgument(
+                "strides must be multiples of the sample size",
+            ));
+        }
+        if x < self.channel_order.channels() * sample || y < x * self.width as usize {
+            return Err(OcioError::InvalidArgument("strides overlap pixels"));
+        }
+        if len < self.required_len::<T>() {
+            return Err(OcioError::InvalidArgument(
+                "pixel slice too small for layout",
+            ));
+        }
+        Ok((x, y))
+    }
+}
@@ -1,16 +1,103 @@
+use std::ffi::c_long;
 use std::ptr::NonNull;
 
+use crate::config::cstr_to_string;
 use crate::error::{OcioError, ffi_error};
+use crate::gpu_shader::{OcioGpuLanguage, OcioGpuShader};
+use crate::lut_cache::OcioMappedLut;
+use crate::pixel::{OcioBitDepth, OcioImageLayout, OcioSample};
 use crate::sys;
+use crate::tiles::{OcioRect, OcioTileTracker};
 
 pub struct OcioProcessor {
     ptr: NonNull<sys::OcioProcessor>,
 }
 
+// SAFETY: OCIO processors are immutable after creation, and building CPU
+// processors or shaders from one goes through mutex-guarded caches.
+unsafe impl Send for OcioProcessor {}
+// SAFETY: See `Send` safety note above.
+unsafe impl Sync for OcioProcessor {}
+
+/// A built CPU transform.
+///
+/// Cheap to share: every apply takes `&self` and the C API guarantees that
+/// concurrent applies on one processor are safe without locking, so
+/// export workers and scope passes can use a single instance (e.g. behind
+/// an `Arc`) instead of building one each. Errors are returned by the call
+/// that hit them.
 pub struct OcioCpuProcessor {
     ptr: NonNull<sys::OcioCpuProcessor>,
 }
 
+// SAFETY: The C API documents every CPU processor apply and bake as
+// reentrant: OCIO's CPUProcessor is immutable after build, applies only read
+// it, and error messages are kept per thread.
+unsafe impl Send for OcioCpuProcessor {}
+// SAFETY: See `Send` safety note above.
+unsafe impl Sync for OcioCpuProcessor {}
+
+/// Optimization preset used when building a CPU processor.
+///
+/// Lower presets fold more of the op chain into approximations, which makes
+/// apply and LUT bake faster at the cost of precision.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum OcioOptimization {
+    #[default]
+    Default,
+    Lossless,
+    VeryGood,
+    Good,
+    Draft,
+}
+
+impl OcioOptimization {
+    pub(crate) fn to_raw(self) -> i32 {
+        match self {
+            Self::Default => sys::OCIO_OPTIMIZATION_DEFAULT,
+            Self::Lossless => sys::OCIO_OPTIMIZATION_LOSSLESS,
+            Self::VeryGood => sys::OCIO_OPTIMIZATION_VERY_GOOD,
+            Self::Good => sys::OCIO_OPTIMIZATION_GOOD,
+            Self::Draft => sys::OCIO_OPTIMIZATION_DRAFT,
+        }
+    }
+}
+
+/// Creation settings for [`OcioProcessor::cpu_f32_with`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct OcioCpuOptions {
+    pub optimization: OcioOptimization,
+    /// Use OCIO's approximate log/exp/pow (`OPTIMIZATION_FAST_LOG_EXP_POW`).
+    /// Implied by [`OcioOptimization::Draft`].
+    pub fast_log_exp_pow: bool,
+}
+
+impl OcioCpuOptions {
+    /// Settings for interactive previews: the draft preset.
+    pub fn draft() -> Self {
+        Self {
+            optimization: OcioOptimization::Draft,
+            fast_log_exp_pow: true,
+        }
+    }
+
+    /// Settings for final bakes and exports: no lossy folding.
+    pub fn lossless() -> Self {
+        Self {
+            optimization: OcioOptimization::Lossless,
+            fast_log_exp_pow: false,
+        }
+    }
+
+    fn fast_paths(self) -> i32 {
+        if self.fast_log_exp_pow {
+            sys::OCIO_FAST_PATH_LOG_EXP_POW
+        } else {
+            sys::OCIO_FAST_PATH_NONE
+        }
+    }
+}
+
 impl OcioProcessor {
     pub(crate) fn from_raw(raw: *mut sys::OcioProcessor) -> Result<Self, OcioError> {
         NonNull::new(raw)
@@ -18,11 +105,69 @@ impl OcioProcessor {
             .ok_or_else(ffi_error)
     }
 
+    /// OCIO cache ID; identical transforms from the same config contents
+    /// share it, including across launches.
+    pub fn cache_id(&self) -> String {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        cstr_to_string(unsafe { sys::ocio_processor_get_cache_id(self.ptr.as_ptr()) })
+            .unwrap_or_default()
+    }
+
     pub fn cpu_f32(&self) -> Result<OcioCpuProcessor, OcioError> {
         // SAFETY: `self.ptr` is valid while `self` is alive.
         let raw = unsafe { sys::ocio_processor_get_cpu_f32(self.ptr.as_ptr()) };
         OcioCpuProcessor::from_raw(raw)
     }
+
+    /// [`cpu_f32`](Self::cpu_f32) with an explicit optimization preset and
+    /// fast paths, e.g. [`OcioCpuOptions::draft`] while scrubbing and
+    /// [`OcioCpuOptions::lossless`] for the final bake.
+    pub fn cpu_f32_with(&self, options: OcioCpuOptions) -> Result<OcioCpuProcessor, OcioError> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let raw = unsafe {
+            sys::ocio_processor_get_cpu_f32_with(
+                self.ptr.as_ptr(),
+                options.optimization.to_raw(),
+                options.fast_paths(),
+            )
+        };
+        OcioCpuProcessor::from_raw(raw)
+    }
+
+    /// Build a CPU processor for buffers in `in_depth` / `out_depth`.
+    ///
+    /// Lets 8/10/12/16-bit and half sources be transformed in their native
+    /// depth instead of being widened to f32 first.
+    pub fn cpu(
+        &self,
+        in_depth: OcioBitDepth,
+        out_depth: OcioBitDepth,
+        optimization: OcioOptimization,
+    ) -> Result<OcioCpuProcessor, OcioError> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let raw = unsafe {
+            sys::ocio_processor_get_cpu(
+                self.ptr.as_ptr(),
+                in_depth.to_raw(),
+                out_depth.to_raw(),
+                optimization.to_raw(),
+            )
+        };
+        OcioCpuProcessor::from_raw(raw)
+    }
+
+    /// Extract this processor as a GPU shader for analytic (LUT-free where
+    /// possible) evaluation.
+    ///
+    /// Empty `function_name`/`resource_prefix` keep OCIO's defaults.
+    pub fn gpu_shader(
+        &self,
+        language: OcioGpuLanguage,
+        function_name: &str,
+        resource_prefix: &str,
+    ) -> Result<OcioGpuShader, OcioError> {
+        OcioGpuShader::create(self.ptr.as_ptr(), language, function_name, resource_prefix)
+    }
 }
 
 impl Drop for OcioProcessor {
@@ -44,48 +189,389 @@ impl OcioCpuProcessor {
         unsafe { sys::ocio_cpu_processor_is_noop(self.ptr.as_ptr()) != 0 }
     }
 
-    pub fn apply_rgba(&self, pixels: &mut [[f32; 4]], width: u32, height: u32) {
-        let expected_len = width as usize * height as usize;
-        if pixels.len() != expected_len {
-            return;
-        }
+    /// OCIO cache ID, which also covers bit depths and optimization flags.
+    pub fn cache_id(&self) -> String {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        cstr_to_string(unsafe { sys::ocio_cpu_processor_get_cache_id(self.ptr.as_ptr()) })
+            .unwrap_or_default()
+    }
+
+    pub fn apply_rgba(
+        &self,
+        pixels: &mut [[f32; 4]],
+        width: u32,
+        height: u32,
+    ) -> Result<(), OcioError> {
+        check_frame(pixels, width, height)?;
 
         // SAFETY: pixel slice is contiguous f32 RGBA memory, dimensions validated.
-        unsafe {
+        let ok = unsafe {
             sys::ocio_cpu_processor_apply_rgba(
                 self.ptr.as_ptr(),
                 pixels.as_mut_ptr().cast::<f32>(),
                 width as i32,
                 height as i32,
-            );
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Apply to a full RGBA frame split into row bands across a worker pool.
+    ///
+    /// `threads == 0` uses every hardware thread; `1` behaves like
+    /// [`apply_rgba`](Self::apply_rgba).
+    pub fn apply_rgba_threaded(
+        &self,
+        pixels: &mut [[f32; 4]],
+        width: u32,
+        height: u32,
+        threads: u32,
+    ) -> Result<(), OcioError> {
+        check_frame(pixels, width, height)?;
+
+        // SAFETY: pixel slice is contiguous f32 RGBA memory, dimensions validated.
+        let ok = unsafe {
+            sys::ocio_cpu_processor_apply_rgba_threaded(
+                self.ptr.as_ptr(),
+                pixels.as_mut_ptr().cast::<f32>(),
+                width as i32,
+                height as i32,
+                threads.min(i32::MAX as u32) as i32,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Apply in place to an f32 region described by `layout`.
+    ///
+    /// This transforms crops, padded rows and sub-rectangles without copying
+    /// them into a dense buffer first. `threads` follows
+    /// [`apply_rgba_threaded`](Self::apply_rgba_threaded).
+    pub fn apply_strided(
+        &self,
+        pixels: &mut [f32],
+        layout: OcioImageLayout,
+        threads: u32,
+    ) -> Result<(), OcioError> {
+        let (x_stride, y_stride) = layout.validate::<f32>(pixels.len())?;
+
+        // SAFETY: the slice covers every pixel addressed by `layout` (checked above).
+        let ok = unsafe {
+            sys::ocio_cpu_processor_apply_strided(
+                self.ptr.as_ptr(),
+                pixels.as_mut_ptr(),
+                layout.width as i32,
+                layout.height as i32,
+                layout.channel_order.to_raw(),
+                x_stride as isize,
+                y_stride as isize,
+                threads.min(i32::MAX as u32) as i32,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
         }
+        Ok(())
     }
 
-    pub fn apply_pixel(&self, rgb: &mut [f32; 3]) {
+    /// Bit depth this processor expects for source buffers.
+    pub fn input_bit_depth(&self) -> Option<OcioBitDepth> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        OcioBitDepth::from_raw(unsafe {
+            sys::ocio_cpu_processor_get_input_bit_depth(self.ptr.as_ptr())
+        })
+    }
+
+    /// Bit depth this processor writes to destination buffers.
+    pub fn output_bit_depth(&self) -> Option<OcioBitDepth> {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        OcioBitDepth::from_raw(unsafe {
+            sys::ocio_cpu_processor_get_output_bit_depth(self.ptr.as_ptr())
+        })
+    }
+
+    /// Apply from `src` into `dst` in the processor's native bit depths.
+    ///
+    /// `S`/`D` must match [`input_bit_depth`](Self::input_bit_depth) and
+    /// [`output_bit_depth`](Self::output_bit_depth): `u8` for 8-bit, `u16`
+    /// for 10/12/16-bit and half (raw bits), `f32` for float. Both layouts
+    /// must share dimensions and channel order.
+    pub fn apply_typed<S: OcioSample, D: OcioSample>(
+        &self,
+        src: &[S],
+        src_layout: OcioImageLayout,
+        dst: &mut [D],
+        dst_layout: OcioImageLayout,
+        threads: u32,
+    ) -> Result<(), OcioError> {
+        if src_layout.width != dst_layout.width
+            || src_layout.height != dst_layout.height
+            || src_layout.channel_order != dst_layout.channel_order
+        {
+            return Err(OcioError::InvalidArgument(
+                "source and destination layouts differ",
+            ));
+        }
+        self.check_sample_types::<S, D>()?;
+        let (sx, sy) = src_layout.validate::<S>(src.len())?;
+        let (dx, dy) = dst_layout.validate::<D>(dst.len())?;
+
+        // SAFETY: both slices cover every pixel addressed by their layouts,
+        // and the sample types match the processor depths (checked above).
+        let ok = unsafe {
+            sys::ocio_cpu_processor_apply_typed(
+                self.ptr.as_ptr(),
+                src.as_ptr().cast(),
+                dst.as_mut_ptr().cast(),
+                src_layout.width as i32,
+                src_layout.height as i32,
+                src_layout.channel_order.to_raw(),
+                sx as isize,
+                sy as isize,
+                dx as isize,
+                dy as isize,
+                threads.min(i32::MAX as u32) as i32,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Apply in place in the processor's native bit depth.
+    ///
+    /// Requires matching input and output depths; see
+    /// [`apply_typed`](Self::apply_typed) for the sample type mapping.
+    pub fn apply_in_place<T: OcioSample>(
+        &self,
+        pixels: &mut [T],
+        layout: OcioImageLayout,
+        threads: u32,
+    ) -> Result<(), OcioError> {
+        self.check_sample_types::<T, T>()?;
+        let (x_stride, y_stride) = layout.validate::<T>(pixels.len())?;
+        let ptr = pixels.as_mut_ptr();
+
+        // SAFETY: the slice covers every pixel addressed by `layout`, and
+        // source and destination alias with identical depths (checked above).
+        let ok = unsafe {
+            sys::ocio_cpu_processor_apply_typed(
+                self.ptr.as_ptr(),
+                ptr.cast_const().cast(),
+                ptr.cast(),
+                layout.width as i32,
+                layout.height as i32,
+                layout.channel_order.to_raw(),
+                x_stride as isize,
+                y_stride as isize,
+                x_stride as isize,
+                y_stride as isize,
+                threads.min(i32::MAX as u32) as i32,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    fn check_sample_types<S: OcioSample, D: OcioSample>(&self) -> Result<(), OcioError> {
+        let in_ok = self.input_bit_depth().is_some_and(S::supports);
+        let out_ok = self.output_bit_depth().is_some_and(D::supports);
+        if in_ok && out_ok {
+            Ok(())
+        } else {
+            Err(OcioError::InvalidArgument(
+                "sample type does not match processor bit depth",
+            ))
+        }
+    }
+
+    /// Apply to the tiles of a packed RGBA frame touched by `rects`, reading
+    /// `src` and writing `dst`. The frame size is the tracker's.
+    ///
+    /// Rectangles are rounded out to the tile grid and overlapping tiles are
+    /// applied once; an empty `rects` covers the whole frame. Tiles the
+    /// tracker already records as holding this processor's output are
+    /// skipped. Returns the number of tiles applied.
+    pub fn apply_rgba_rects(
+        &self,
+        src: &[[f32; 4]],
+        dst: &mut [[f32; 4]],
+        rects: &[OcioRect],
+        tracker: &mut OcioTileTracker,
+        threads: u32,
+    ) -> Result<u32, OcioError> {
+        let (width, height) = (tracker.width(), tracker.height());
+        let expected_len = width as usize * height as usize;
+        if src.len() != expected_len || dst.len() != expected_len {
+            return Err(OcioError::InvalidArgument(
+                "pixel slices do not match tracker size",
+            ));
+        }
+        self.apply_rects_raw(
+            src.as_ptr().cast(),
+            dst.as_mut_ptr().cast(),
+            (width, height),
+            rects,
+            tracker.as_mut_ptr(),
+            threads,
+        )
+    }
+
+    /// In-place form of [`apply_rgba_rects`](Self::apply_rgba_rects),
+    /// without tile tracking: the source is overwritten, so tiles cannot
+    /// later be re-applied with another processor.
+    pub fn apply_rgba_rects_in_place(
+        &self,
+        pixels: &mut [[f32; 4]],
+        width: u32,
+        height: u32,
+        rects: &[OcioRect],
+        threads: u32,
+    ) -> Result<u32, OcioError> {
+        if pixels.len() != width as usize * height as usize {
+            return Err(OcioError::InvalidArgument(
+                "pixel slice does not match frame size",
+            ));
+        }
+        let ptr = pixels.as_mut_ptr().cast::<f32>();
+        self.apply_rects_raw(
+            ptr.cast_const(),
+            ptr,
+            (width, height),
+            rects,
+            std::ptr::null_mut(),
+            threads,
+        )
+    }
+
+    fn apply_rects_raw(
+        &self,
+        src: *const f32,
+        dst: *mut f32,
+        (width, height): (u32, u32),
+        rects: &[OcioRect],
+        tracker: *mut sys::OcioTileTracker,
+        threads: u32,
+    ) -> Result<u32, OcioError> {
+        if width == 0 || height == 0 {
+            return Err(OcioError::InvalidArgument("frame has zero dimensions"));
+        }
+        let raw: Vec<sys::OcioRect> = rects.iter().map(|r| r.to_raw()).collect();
+
+        // SAFETY: callers pass buffers of `width * height` RGBA pixels and a
+        // null or live tracker of the same size; `raw` outlives the call.
+        let applied = unsafe {
+            sys::ocio_cpu_processor_apply_rgba_rects(
+                self.ptr.as_ptr(),
+                src,
+                dst,
+                width.min(i32::MAX as u32) as i32,
+                height.min(i32::MAX as u32) as i32,
+                raw.as_ptr(),
+                raw.len().min(i32::MAX as usize) as i32,
+                tracker,
+                threads.min(i32::MAX as u32) as i32,
+            )
+        };
+        if applied < 0 {
+            return Err(ffi_error());
+        }
+        Ok(applied as u32)
+    }
+
+    pub fn apply_pixel(&self, rgb: &mut [f32; 3]) -> Result<(), OcioError> {
         // SAFETY: pointer references exactly 3 contiguous f32 values.
-        unsafe { sys::ocio_cpu_processor_apply_rgb_pixel(self.ptr.as_ptr(), rgb.as_mut_ptr()) };
+        let ok =
+            unsafe { sys::ocio_cpu_processor_apply_rgb_pixel(self.ptr.as_ptr(), rgb.as_mut_ptr()) };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Apply to sparse RGB samples, e.g. scope overlay points or
+    /// auto-balance probes, with one packed apply instead of one call per
+    /// sample.
+    pub fn apply_rgb_points(&self, points: &mut [[f32; 3]]) -> Result<(), OcioError> {
+        self.apply_points(points.as_mut_ptr().cast::<f32>(), points.len(), 12)
+    }
+
+    /// [`apply_rgb_points`](Self::apply_rgb_points) on the RGB of RGBA
+    /// samples; alpha is left untouched.
+    pub fn apply_rgba_points(&self, points: &mut [[f32; 4]]) -> Result<(), OcioError> {
+        self.apply_points(points.as_mut_ptr().cast::<f32>(), points.len(), 16)
+    }
+
+    fn apply_points(&self, xyz: *mut f32, count: usize, stride: isize) -> Result<(), OcioError> {
+        if count == 0 {
+            return Ok(());
+        }
+        let count = c_long::try_from(count)
+            .map_err(|_| OcioError::InvalidArgument("too many sample points"))?;
+        // SAFETY: callers pass `count` samples of 3+ contiguous f32 values each,
+        // `stride` bytes apart, borrowed mutably for the call.
+        let ok = unsafe {
+            sys::ocio_cpu_processor_apply_rgb_points(self.ptr.as_ptr(), xyz, count, stride)
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
     }
 
-    pub fn bake_3d_lut(&self, size: u32) -> Vec<[f32; 4]> {
+    /// Bake this processor into a `size`³ RGBA 3D LUT.
+    ///
+    /// Entries are ordered red-fastest, then green, then blue. The whole
+    /// lattice is transformed by a single packed apply on the C++ side.
+    pub fn bake_3d_lut(&self, size: u32) -> Result<Vec<[f32; 4]>, OcioError> {
         if size < 2 {
-            return vec![[0.0, 0.0, 0.0, 1.0]];
+            return Ok(vec![[0.0, 0.0, 0.0, 1.0]]);
         }
 
         let total = size as usize * size as usize * size as usize;
-        let mut lut = Vec::with_capacity(total);
-        let denom = (size - 1) as f32;
+        let mut lut = vec![[0.0_f32; 4]; total];
 
-        for z in 0..size {
-            for y in 0..size {
-                for x in 0..size {
-                    let mut px = [x as f32 / denom, y as f32 / denom, z as f32 / denom];
-                    self.apply_pixel(&mut px);
-                    lut.push([px[0], px[1], px[2], 1.0]);
-                }
-            }
+        // SAFETY: `lut` holds exactly `size`³ contiguous RGBA f32 entries.
+        let ok = unsafe {
+            sys::ocio_cpu_processor_bake_lut3d(
+                self.ptr.as_ptr(),
+                size as i32,
+                lut.as_mut_ptr().cast::<f32>(),
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
         }
 
-        lut
+        Ok(lut)
+    }
+
+    /// [`bake_3d_lut`](Self::bake_3d_lut) through the LUT disk cache set up
+    /// with [`set_lut_cache_directory`](crate::set_lut_cache_directory).
+    ///
+    /// A hit memory-maps the stored file; a miss bakes and stores it. With
+    /// no cache directory this is a plain bake.
+    pub fn bake_3d_lut_cached(&self, size: u32) -> Result<OcioMappedLut, OcioError> {
+        if size < 2 {
+            return Err(OcioError::InvalidArgument("LUT size must be at least 2"));
+        }
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        let raw = unsafe {
+            sys::ocio_cpu_processor_bake_lut3d_cached(
+                self.ptr.as_ptr(),
+                size.min(i32::MAX as u32) as i32,
+            )
+        };
+        OcioMappedLut::from_raw(raw)
     }
 }
 
@@ -95,3 +581,15 @@ impl Drop for OcioCpuProcessor {
         unsafe { sys::ocio_cpu_processor_destroy(self.ptr.as_ptr()) };
     }
 }
+
+fn check_frame(pixels: &[[f32; 4]], width: u32, height: u32) -> Result<(), OcioError> {
+    if width == 0 || height == 0 || width > i32::MAX as u32 || height > i32::MAX as u32 {
+        return Err(OcioError::InvalidArgument("invalid frame dimensions"));
+    }
+    if pixels.len() != width as usize * height as usize {
+        return Err(OcioError::InvalidArgument(
+            "pixel slice does not match frame size",
+        ));
+    }
+    Ok(())
+}
@@ -1,4 +1,4 @@
-use std::ffi::{c_char, c_int};
+use std::ffi::{c_char, c_int, c_long, c_void};
 
 #[repr(C)]
 pub struct OcioConfig {
@@ -15,6 +15,122 @@ pub struct OcioCpuProcessor {
     _private: [u8; 0],
 }
 
+#[repr(C)]
+pub struct OcioGpuShader {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OcioTileTracker {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OcioMappedLut {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OcioConfigLoad {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OcioGradeDesc {
+    pub matrix: *const f32,
+    pub offset: *const f32,
+    pub lut3d: *const f32,
+    pub lut3d_size: c_int,
+    pub lut3d_interpolation: c_int,
+}
+
+#[repr(C)]
+pub struct OcioRect {
+    pub x: c_int,
+    pub y: c_int,
+    pub width: c_int,
+    pub height: c_int,
+}
+
+pub const OCIO_GPU_LANGUAGE_GLSL_4_0: c_int = 0;
+pub const OCIO_GPU_LANGUAGE_GLSL_ES_3_0: c_int = 1;
+pub const OCIO_GPU_LANGUAGE_HLSL_DX11: c_int = 2;
+pub const OCIO_GPU_LANGUAGE_MSL_2_0: c_int = 3;
+
+pub const OCIO_CHANNEL_ORDER_RGB: c_int = 0;
+pub const OCIO_CHANNEL_ORDER_RGBA: c_int = 1;
+pub const OCIO_CHANNEL_ORDER_BGRA: c_int = 2;
+
+pub const OCIO_BIT_DEPTH_UINT8: c_int = 0;
+pub const OCIO_BIT_DEPTH_UINT10: c_int = 1;
+pub const OCIO_BIT_DEPTH_UINT12: c_int = 2;
+pub const OCIO_BIT_DEPTH_UINT16: c_int = 3;
+pub const OCIO_BIT_DEPTH_F16: c_int = 4;
+pub const OCIO_BIT_DEPTH_F32: c_int = 5;
+
+pub const OCIO_OPTIMIZATION_DEFAULT: c_int = 0;
+pub const OCIO_OPTIMIZATION_LOSSLESS: c_int = 1;
+pub const OCIO_OPTIMIZATION_VERY_GOOD: c_int = 2;
+pub const OCIO_OPTIMIZATION_GOOD: c_int = 3;
+pub const OCIO_OPTIMIZATION_DRAFT: c_int = 4;
+
+pub const OCIO_FAST_PATH_NONE: c_int = 0;
+pub const OCIO_FAST_PATH_LOG_EXP_POW: c_int = 1;
+
+pub const OCIO_LUT3D_INTERP_TRILINEAR: c_int = 0;
+pub const OCIO_LUT3D_INTERP_TETRAHEDRAL: c_int = 1;
+
+pub const OCIO_CONFIG_SOURCE_FILE: c_int = 0;
+pub const OCIO_CONFIG_SOURCE_BUILTIN: c_int = 1;
+pub const OCIO_CONFIG_SOURCE_ENV: c_int = 2;
+
+pub const OCIO_PREWARM_DISPLAY_VIEW: c_int = 1;
+pub const OCIO_PREWARM_ROLES: c_int = 2;
+
+pub const OCIO_CONFIG_LOAD_PENDING: c_int = 0;
+pub const OCIO_CONFIG_LOAD_READY: c_int = 1;
+
+pub const OCIO_GPU_UNIFORM_DOUBLE: c_int = 0;
+pub const OCIO_GPU_UNIFORM_BOOL: c_int = 1;
+pub const OCIO_GPU_UNIFORM_FLOAT3: c_int = 2;
+pub const OCIO_GPU_UNIFORM_VECTOR_FLOAT: c_int = 3;
+pub const OCIO_GPU_UNIFORM_VECTOR_INT: c_int = 4;
+
+#[repr(C)]
+#[derive(Default)]
+pub struct OcioProcessorCacheStats {
+    pub processor_hits: u64,
+    pub processor_misses: u64,
+    pub cpu_hits: u64,
+    pub cpu_misses: u64,
+    pub processor_entries: c_int,
+    pub cpu_entries: c_int,
+    pub capacity: c_int,
+}
+
+pub const OCIO_PERF_PROCESSOR_BUILD: c_int = 0;
+pub const OCIO_PERF_CPU_PROCESSOR_BUILD: c_int = 1;
+pub const OCIO_PERF_CPU_APPLY: c_int = 2;
+pub const OCIO_PERF_LUT_BAKE: c_int = 3;
+pub const OCIO_PERF_LUT_CACHE_LOAD: c_int = 4;
+pub const OCIO_PERF_GPU_SHADER: c_int = 5;
+pub const OCIO_PERF_STAGE_COUNT: usize = 6;
+
+pub type OcioPerfStats = crispen_ffi::perf::RawPerfStats<OCIO_PERF_STAGE_COUNT>;
+pub type OcioPerfCallback = crispen_ffi::perf::RawPerfCallback;
+
+#[repr(C)]
+pub struct OcioGpuTextureInfo {
+    pub texture_name: *const c_char,
+    pub sampler_name: *const c_char,
+    pub width: c_int,
+    pub height: c_int,
+    pub depth: c_int,
+    pub channels: c_int,
+    pub dimensions: c_int,
+    pub linear_filter: c_int,
+}
+
 unsafe extern "C" {
     pub fn ocio_get_last_error() -> *const c_char;
 
@@ -23,6 +139,18 @@ unsafe extern "C" {
     pub fn ocio_config_create_builtin(uri: *const c_char) -> *mut OcioConfig;
     pub fn ocio_config_destroy(config: *mut OcioConfig);
 
+    pub fn ocio_config_load_async(
+        source: c_int,
+        path_or_uri: *const c_char,
+        input_space: *const c_char,
+        prewarm: c_int,
+    ) -> *mut OcioConfigLoad;
+    pub fn ocio_config_load_status(load: *const OcioConfigLoad) -> c_int;
+    pub fn ocio_config_load_wait(load: *mut OcioConfigLoad, timeout_ms: c_int) -> c_int;
+    pub fn ocio_config_load_get_config(load: *const OcioConfigLoad) -> *mut OcioConfig;
+    pub fn ocio_config_load_get_error(load: *const OcioConfigLoad) -> *const c_char;
+    pub fn ocio_config_load_destroy(load: *mut OcioConfigLoad);
+
     pub fn ocio_config_get_num_color_spaces(config: *const OcioConfig) -> c_int;
     pub fn ocio_config_get_color_space_name(
         config: *const OcioConfig,
@@ -55,16 +183,187 @@ unsafe extern "C" {
         display: *const c_char,
         view: *const c_char,
     ) -> *mut OcioProcessor;
+    pub fn ocio_config_get_look_processor(
+        config: *const OcioConfig,
+        src: *const c_char,
+        dst: *const c_char,
+        looks: *const c_char,
+    ) -> *mut OcioProcessor;
+    pub fn ocio_config_get_fused_processor(
+        config: *const OcioConfig,
+        src: *const c_char,
+        working: *const c_char,
+        display: *const c_char,
+        view: *const c_char,
+        grade: *const OcioGradeDesc,
+        optimization: c_int,
+    ) -> *mut OcioProcessor;
     pub fn ocio_processor_destroy(proc: *mut OcioProcessor);
+    pub fn ocio_processor_get_cache_id(proc: *const OcioProcessor) -> *const c_char;
+
+    pub fn ocio_processor_cache_set_capacity(max_entries: c_int);
+    pub fn ocio_processor_cache_clear();
+    pub fn ocio_processor_cache_get_stats(out: *mut OcioProcessorCacheStats);
+    pub fn ocio_lut_cache_set_directory(dir: *const c_char) -> c_int;
+
+    pub fn ocio_perf_set_enabled(enabled: c_int);
+    pub fn ocio_perf_is_enabled() -> c_int;
+    pub fn ocio_perf_set_callback(callback: OcioPerfCallback, user: *mut c_void);
+    pub fn ocio_perf_get_stats(out: *mut OcioPerfStats);
+    pub fn ocio_perf_reset();
 
     pub fn ocio_processor_get_cpu_f32(proc: *const OcioProcessor) -> *mut OcioCpuProcessor;
+    pub fn ocio_processor_get_cpu_f32_with(
+        proc: *const OcioProcessor,
+        optimization: c_int,
+        fast_paths: c_int,
+    ) -> *mut OcioCpuProcessor;
+    pub fn ocio_processor_get_cpu(
+        proc: *const OcioProcessor,
+        in_depth: c_int,
+        out_depth: c_int,
+        optimization: c_int,
+    ) -> *mut OcioCpuProcessor;
     pub fn ocio_cpu_processor_destroy(cpu: *mut OcioCpuProcessor);
+    pub fn ocio_cpu_processor_get_cache_id(cpu: *const OcioCpuProcessor) -> *const c_char;
+    pub fn ocio_cpu_processor_get_input_bit_depth(cpu: *const OcioCpuProcessor) -> c_int;
+    pub fn ocio_cpu_processor_get_output_bit_depth(cpu: *const OcioCpuProcessor) -> c_int;
     pub fn ocio_cpu_processor_apply_rgba(
         cpu: *const OcioCpuProcessor,
         pixels: *mut f32,
         width: c_int,
         height: c_int,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_apply_rgba_threaded(
+        cpu: *const OcioCpuProcessor,
+        pixels: *mut f32,
+        width: c_int,
+        height: c_int,
+        num_threads: c_int,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_apply_strided(
+        cpu: *const OcioCpuProcessor,
+        pixels: *mut f32,
+        width: c_int,
+        height: c_int,
+        channel_order: c_int,
+        x_stride_bytes: isize,
+        y_stride_bytes: isize,
+        num_threads: c_int,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_apply_typed(
+        cpu: *const OcioCpuProcessor,
+        src: *const c_void,
+        dst: *mut c_void,
+        width: c_int,
+        height: c_int,
+        channel_order: c_int,
+        src_x_stride_bytes: isize,
+        src_y_stride_bytes: isize,
+        dst_x_stride_bytes: isize,
+        dst_y_stride_bytes: isize,
+        num_threads: c_int,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_apply_rgb_pixel(
+        cpu: *const OcioCpuProcessor,
+        pixel: *mut f32,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_apply_rgb_points(
+        cpu: *const OcioCpuProcessor,
+        xyz: *mut f32,
+        count: c_long,
+        stride_bytes: isize,
+    ) -> c_int;
+
+    pub fn ocio_tile_tracker_create(
+        width: c_int,
+        height: c_int,
+        tile_size: c_int,
+    ) -> *mut OcioTileTracker;
+    pub fn ocio_tile_tracker_destroy(tracker: *mut OcioTileTracker);
+    pub fn ocio_tile_tracker_invalidate(
+        tracker: *mut OcioTileTracker,
+        rects: *const OcioRect,
+        count: c_int,
     );
-    pub fn ocio_cpu_processor_apply_rgb_pixel(cpu: *const OcioCpuProcessor, pixel: *mut f32);
+    pub fn ocio_tile_tracker_num_valid(tracker: *const OcioTileTracker) -> c_int;
+    pub fn ocio_cpu_processor_apply_rgba_rects(
+        cpu: *const OcioCpuProcessor,
+        src: *const f32,
+        dst: *mut f32,
+        width: c_int,
+        height: c_int,
+        rects: *const OcioRect,
+        count: c_int,
+        tracker: *mut OcioTileTracker,
+        num_threads: c_int,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_bake_lut3d(
+        cpu: *const OcioCpuProcessor,
+        size: c_int,
+        out_rgba: *mut f32,
+    ) -> c_int;
+    pub fn ocio_cpu_processor_bake_lut3d_cached(
+        cpu: *const OcioCpuProcessor,
+        size: c_int,
+    ) -> *mut OcioMappedLut;
+    pub fn ocio_mapped_lut_destroy(lut: *mut OcioMappedLut);
+    pub fn ocio_mapped_lut_data(lut: *const OcioMappedLut) -> *const f32;
+    pub fn ocio_mapped_lut_size(lut: *const OcioMappedLut) -> c_int;
+    pub fn ocio_mapped_lut_from_disk(lut: *const OcioMappedLut) -> c_int;
+    pub fn ocio_lut3d_apply_rgba(
+        lut: *const f32,
+        size: c_int,
+        pixels: *mut f32,
+        width: c_int,
+        height: c_int,
+        interpolation: c_int,
+        num_threads: c_int,
+    ) -> c_int;
+    pub fn ocio_lut3d_kernel_name() -> *const c_char;
     pub fn ocio_cpu_processor_is_noop(cpu: *const OcioCpuProcessor) -> c_int;
+
+    pub fn ocio_processor_get_gpu_shader(
+        proc: *const OcioProcessor,
+        language: c_int,
+        function_name: *const c_char,
+        resource_prefix: *const c_char,
+    ) -> *mut OcioGpuShader;
+    pub fn ocio_gpu_shader_destroy(shader: *mut OcioGpuShader);
+    pub fn ocio_gpu_shader_get_text(shader: *const OcioGpuShader) -> *const c_char;
+    pub fn ocio_gpu_shader_get_function_name(shader: *const OcioGpuShader) -> *const c_char;
+
+    pub fn ocio_gpu_shader_get_num_uniforms(shader: *const OcioGpuShader) -> c_int;
+    pub fn ocio_gpu_shader_get_uniform_name(
+        shader: *const OcioGpuShader,
+        index: c_int,
+    ) -> *const c_char;
+    pub fn ocio_gpu_shader_get_uniform_type(shader: *const OcioGpuShader, index: c_int) -> c_int;
+    pub fn ocio_gpu_shader_get_uniform_values(
+        shader: *const OcioGpuShader,
+        index: c_int,
+        out_values: *mut f32,
+        max_values: c_int,
+    ) -> c_int;
+
+    pub fn ocio_gpu_shader_get_num_textures(shader: *const OcioGpuShader) -> c_int;
+    pub fn ocio_gpu_shader_get_texture(
+        shader: *const OcioGpuShader,
+        index: c_int,
+        out: *mut OcioGpuTextureInfo,
+    ) -> c_int;
+    pub fn ocio_gpu_shader_get_texture_values(
+        shader: *const OcioGpuShader,
+        index: c_int,
+    ) -> *const f32;
+    pub fn ocio_gpu_shader_get_num_textures_3d(shader: *const OcioGpuShader) -> c_int;
+    pub fn ocio_gpu_shader_get_texture_3d(
+        shader: *const OcioGpuShader,
+        index: c_int,
+        out: *mut OcioGpuTextureInfo,
+    ) -> c_int;
+    pub fn ocio_gpu_shader_get_texture_3d_values(
+        shader: *const OcioGpuShader,
+        index: c_int,
+    ) -> *const f32;
 }
@@ -0,0 +1,109 @@
+use std::ptr::NonNull;
+
+use crate::error::{OcioError, ffi_error};
+use crate::sys;
+
+/// Pixel rectangle within a frame, from the top-left corner.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct OcioRect {
+    pub x: u32,
+    pub y: u32,
+    pub width: u32,
+    pub height: u32,
+}
+
+impl OcioRect {
+    pub fn new(x: u32, y: u32, width: u32, height: u32) -> Self {
+        Self {
+            x,
+            y,
+            width,
+            height,
+        }
+    }
+
+    pub(crate) fn to_raw(self) -> sys::OcioRect {
+        let clamp = |v: u32| v.min(i32::MAX as u32) as i32;
+        sys::OcioRect {
+            x: clamp(self.x),
+            y: clamp(self.y),
+            width: clamp(self.width),
+            height: clamp(self.height),
+        }
+    }
+}
+
+/// Remembers which tiles of a destination frame already hold the output of
+/// a processor, so [`OcioCpuProcessor::apply_rgba_rects`] only re-applies
+/// the tiles that changed.
+///
+/// Tiles are invalidated explicitly when source pixels change, and all at
+/// once when the frame is applied with a different processor.
+///
+/// [`OcioCpuProcessor::apply_rgba_rects`]: crate::OcioCpuProcessor::apply_rgba_rects
+pub struct OcioTileTracker {
+    ptr: NonNull<sys::OcioTileTracker>,
+    width: u32,
+    height: u32,
+}
+
+// SAFETY: The tracker is plain state owned by this wrapper; every mutation
+// goes through `&mut self`.
+unsafe impl Send for OcioTileTracker {}
+
+impl OcioTileTracker {
+    /// Track a `width` x `height` frame in `tile_size` square tiles
+    /// (`0` uses the default of 128).
+    pub fn new(width: u32, height: u32, tile_size: u32) -> Result<Self, OcioError> {
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let raw = unsafe {
+            sys::ocio_tile_tracker_create(
+                width.min(i32::MAX as u32) as i32,
+                height.min(i32::MAX as u32) as i32,
+                tile_size.min(i32::MAX as u32) as i32,
+            )
+        };
+        NonNull::new(raw)
+            .map(|ptr| Self { ptr, width, height })
+            .ok_or_else(ffi_error)
+    }
+
+    pub fn width(&self) -> u32 {
+        self.width
+    }
+
+    pub fn height(&self) -> u32 {
+        self.height
+    }
+
+    /// Mark the tiles touching `rects` stale; an empty slice marks every
+    /// tile stale.
+    pub fn invalidate(&mut self, rects: &[OcioRect]) {
+        let raw: Vec<sys::OcioRect> = rects.iter().map(|r| r.to_raw()).collect();
+        // SAFETY: `raw` holds `raw.len()` rectangles for the duration of the call.
+        unsafe {
+            sys::ocio_tile_tracker_invalidate(
+                self.ptr.as_ptr(),
+                raw.as_ptr(),
+                raw.len().min(i32::MAX as usize) as i32,
+            )
+        };
+    }
+
+    /// Number of tiles holding up-to-date output.
+    pub fn valid_tiles(&self) -> u32 {
+        // SAFETY: `self.ptr` is valid while `self` is alive.
+        unsafe { sys::ocio_tile_tracker_num_valid(self.ptr.as_ptr()).max(0) as u32 }
+    }
+
+    pub(crate) fn as_mut_ptr(&mut self) -> *mut sys::OcioTileTracker {
+        self.ptr.as_ptr()
+    }
+}
+
+impl Drop for OcioTileTracker {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::ocio_tile_tracker_destroy(self.ptr.as_ptr()) };
+    }
+}
@@ -1,4 +1,13 @@
-use crispen_ocio::OcioConfig;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use crispen_ocio::{
+    OcioBitDepth, OcioChannelOrder, OcioConfig, OcioConfigLoad, OcioConfigLoadStatus,
+    OcioConfigSource, OcioCpuOptions, OcioGpuLanguage, OcioGrade, OcioImageLayout,
+    OcioLutInterpolation, OcioOptimization, OcioPerfStage, OcioPrewarm, OcioRect, OcioTileTracker,
+    apply_lut3d_rgba, perf_stats, processor_cache_stats, set_lut_cache_directory,
+    set_perf_callback, set_perf_enabled,
+};
 
 /// Try to load a test config. Returns `None` when no config is available
 /// (e.g. OCIO 2.1 has no built-in configs and `OCIO` env var is unset).
@@ -114,8 +123,12 @@ fn roundtrip_via_scene_linear_is_stable() {
 
     for expected in samples {
         let mut px = expected;
-        to_working.apply_pixel(&mut px);
-        to_srgb.apply_pixel(&mut px);
+        to_working
+            .apply_pixel(&mut px)
+            .expect("pixel apply should succeed");
+        to_srgb
+            .apply_pixel(&mut px)
+            .expect("pixel apply should succeed");
         assert_close3(px, expected, 0.001);
     }
 }
@@ -133,7 +146,7 @@ fn lut_bake_has_expected_size_and_identity_corners() {
         .expect("same-space processor should be available");
 
     let size = 17_u32;
-    let lut = cpu.bake_3d_lut(size);
+    let lut = cpu.bake_3d_lut(size).expect("LUT bake should succeed");
     assert_eq!(lut.len(), size as usize * size as usize * size as usize);
 
     assert_close3([lut[0][0], lut[0][1], lut[0][2]], [0.0, 0.0, 0.0], 0.0001);
@@ -180,3 +193,750 @@ fn same_space_processor_reports_noop() {
         .expect("same-space processor should be available");
     assert!(cpu.is_noop(), "same-space processor should be no-op");
 }
+
+#[test]
+fn batched_lut_bake_matches_per_pixel_apply() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let size = 9_u32;
+    let lut = cpu.bake_3d_lut(size).expect("LUT bake should succeed");
+    let denom = (size - 1) as f32;
+    for (b, g, r) in [(0, 0, 0), (1, 2, 3), (4, 4, 4), (8, 0, 5), (8, 8, 8)] {
+        let mut expected = [r as f32 / denom, g as f32 / denom, b as f32 / denom];
+        cpu.apply_pixel(&mut expected)
+            .expect("pixel apply should succeed");
+        let entry = lut[(b * size as usize + g) * size as usize + r];
+        assert_close3([entry[0], entry[1], entry[2]], expected, 0.0001);
+    }
+}
+
+#[test]
+fn display_view_gpu_shader_has_text_and_function() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let scene_linear = config
+        .role("scene_linear")
+        .unwrap_or_else(|| pick_same_space(&config));
+    let display = config.default_display();
+    let view = config.default_view(&display);
+
+    let shader = config
+        .display_view_processor(&scene_linear, &display, &view)
+        .and_then(|p| p.gpu_shader(OcioGpuLanguage::Glsl4_0, "crispen_odt", "crispen_odt_"))
+        .expect("display/view GPU shader should be available");
+    assert_eq!(shader.function_name(), "crispen_odt");
+    assert!(shader.shader_text().contains("crispen_odt"));
+
+    for tex in shader.textures_3d() {
+        let expected = (tex.width * tex.height * tex.depth * tex.channels) as usize;
+        assert_eq!(
+            tex.values.len(),
+            expected,
+            "3D LUT {} size",
+            tex.texture_name
+        );
+    }
+}
+
+#[test]
+fn threaded_apply_matches_single_threaded_apply() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let (width, height) = (97_u32, 203_u32);
+    let source: Vec<[f32; 4]> = (0..width * height)
+        .map(|i| {
+            let t = i as f32 / (width * height) as f32;
+            [t, 1.0 - t, (t * 7.0).fract(), 1.0]
+        })
+        .collect();
+
+    let mut expected = source.clone();
+    cpu.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+    let mut threaded = source;
+    cpu.apply_rgba_threaded(&mut threaded, width, height, 4)
+        .expect("apply should succeed");
+
+    for (a, e) in threaded.iter().zip(&expected) {
+        assert_close3([a[0], a[1], a[2]], [e[0], e[1], e[2]], 1e-6);
+    }
+}
+
+#[test]
+fn shared_processor_applies_concurrently_with_per_call_errors() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let (width, height) = (64_u32, 48_u32);
+    let source: Vec<[f32; 4]> = (0..width * height)
+        .map(|i| {
+            let t = i as f32 / (width * height) as f32;
+            [t, (t * 3.0).fract(), 1.0 - t, 1.0]
+        })
+        .collect();
+    let mut expected = source.clone();
+    cpu.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+
+    // One processor shared by reference; half the threads also make a
+    // failing call, which must not leak into the other threads' results.
+    std::thread::scope(|scope| {
+        for worker in 0..8 {
+            let (cpu, source, expected) = (&cpu, &source, &expected);
+            scope.spawn(move || {
+                for _ in 0..4 {
+                    if worker % 2 == 1 {
+                        let mut short = vec![[0.0_f32; 4]; 3];
+                        assert!(cpu.apply_rgba(&mut short, width, height).is_err());
+                    }
+                    let mut pixels = source.clone();
+                    cpu.apply_rgba_threaded(&mut pixels, width, height, 2)
+                        .expect("concurrent apply should succeed");
+                    for (a, e) in pixels.iter().zip(expected) {
+                        assert_close3([a[0], a[1], a[2]], [e[0], e[1], e[2]], 1e-6);
+                    }
+                }
+            });
+        }
+    });
+}
+
+#[test]
+fn strided_sub_region_apply_leaves_surroundings_untouched() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let (full_w, full_h) = (16_u32, 12_u32);
+    let (x0, y0, w, h) = (3_u32, 2_u32, 8_u32, 5_u32);
+    let original: Vec<f32> = (0..full_w * full_h * 4)
+        .map(|i| {
+            if i % 4 == 3 {
+                1.0
+            } else {
+                (i % 97) as f32 / 97.0
+            }
+        })
+        .collect();
+
+    let mut image = original.clone();
+    let offset = ((y0 * full_w + x0) * 4) as usize;
+    let layout = OcioImageLayout::sub_region::<f32>(w, h, full_w, OcioChannelOrder::Rgba);
+    cpu.apply_strided(&mut image[offset..], layout, 2)
+        .expect("strided apply should succeed");
+
+    for y in 0..full_h {
+        for x in 0..full_w {
+            let i = ((y * full_w + x) * 4) as usize;
+            let inside = (x0..x0 + w).contains(&x) && (y0..y0 + h).contains(&y);
+            let mut expected = [original[i], original[i + 1], original[i + 2]];
+            if inside {
+                cpu.apply_pixel(&mut expected)
+                    .expect("pixel apply should succeed");
+            }
+            assert_close3([image[i], image[i + 1], image[i + 2]], expected, 0.0001);
+        }
+    }
+}
+
+#[test]
+fn native_u8_processor_tracks_f32_processor() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let proc = config
+        .processor(&scene_linear, &src)
+        .expect("scene linear -> source processor should be available");
+    let cpu_u8 = proc
+        .cpu(
+            OcioBitDepth::U8,
+            OcioBitDepth::U8,
+            OcioOptimization::Default,
+        )
+        .expect("u8 processor should be available");
+    let cpu_f32 = proc.cpu_f32().expect("f32 processor should be available");
+    assert_eq!(cpu_u8.input_bit_depth(), Some(OcioBitDepth::U8));
+
+    let (width, height) = (16_u32, 16_u32);
+    let mut pixels: Vec<u8> = (0..width * height * 4).map(|i| (i % 256) as u8).collect();
+    let source = pixels.clone();
+    cpu_u8
+        .apply_in_place(
+            &mut pixels,
+            OcioImageLayout::packed(width, height, OcioChannelOrder::Rgba),
+            1,
+        )
+        .expect("u8 apply should succeed");
+
+    for (i, chunk) in source.chunks_exact(4).enumerate().step_by(17) {
+        let mut expected = [
+            chunk[0] as f32 / 255.0,
+            chunk[1] as f32 / 255.0,
+            chunk[2] as f32 / 255.0,
+        ];
+        cpu_f32
+            .apply_pixel(&mut expected)
+            .expect("pixel apply should succeed");
+        let expected = expected.map(|v| v.clamp(0.0, 1.0));
+        let got = &pixels[i * 4..i * 4 + 3];
+        assert_close3(
+            [
+                got[0] as f32 / 255.0,
+                got[1] as f32 / 255.0,
+                got[2] as f32 / 255.0,
+            ],
+            expected,
+            2.0 / 255.0,
+        );
+    }
+}
+
+#[test]
+fn repeated_processor_requests_hit_the_cache() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+
+    let _first = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("processor should be available");
+    let before = processor_cache_stats();
+    let _second = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("processor should be available");
+    let after = processor_cache_stats();
+
+    // Other tests share the process-wide cache, so only check monotonic growth.
+    assert!(after.processor_hits > before.processor_hits);
+    assert!(after.cpu_hits > before.cpu_hits);
+}
+
+#[test]
+fn dirty_rect_apply_skips_tiles_already_transformed() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let (width, height, tile) = (40_u32, 24_u32, 16_u32);
+    let source: Vec<[f32; 4]> = (0..width * height)
+        .map(|i| {
+            let t = i as f32 / (width * height) as f32;
+            [t, (t * 3.0).fract(), 1.0 - t, 1.0]
+        })
+        .collect();
+    let mut expected = source.clone();
+    cpu.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+
+    let mut tracker = OcioTileTracker::new(width, height, tile).expect("tracker");
+    let mut output = vec![[0.0_f32; 4]; source.len()];
+    let rect = [OcioRect::new(5, 3, 12, 6)];
+    let applied = cpu
+        .apply_rgba_rects(&source, &mut output, &rect, &mut tracker, 2)
+        .expect("rect apply should succeed");
+    // x 5..17 spans tile columns 0-1, y 3..9 spans tile row 0.
+    assert_eq!(applied, 2);
+    assert_eq!(tracker.valid_tiles(), 2);
+
+    let again = cpu
+        .apply_rgba_rects(&source, &mut output, &rect, &mut tracker, 2)
+        .expect("repeat apply should succeed");
+    assert_eq!(again, 0, "unchanged tiles should be skipped");
+
+    tracker.invalidate(&[OcioRect::new(0, 0, 1, 1)]);
+    let full = cpu
+        .apply_rgba_rects(&source, &mut output, &[], &mut tracker, 2)
+        .expect("full-frame apply should succeed");
+    // 3 x 2 tiles in total, one of the two earlier tiles is still valid.
+    assert_eq!(full, 5);
+
+    for (a, e) in output.iter().zip(&expected) {
+        assert_close3([a[0], a[1], a[2]], [e[0], e[1], e[2]], 1e-6);
+    }
+}
+
+#[test]
+fn draft_processor_tracks_lossless_processor() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let proc = config
+        .processor(&src, &scene_linear)
+        .expect("source -> scene linear processor should be available");
+    let lossless = proc
+        .cpu_f32_with(OcioCpuOptions::lossless())
+        .expect("lossless processor should be available");
+    let draft = proc
+        .cpu_f32_with(OcioCpuOptions::draft())
+        .expect("draft processor should be available");
+
+    for i in 0..=16 {
+        let v = i as f32 / 16.0;
+        let mut exact = [v, v * 0.5, 1.0 - v];
+        let mut fast = exact;
+        lossless
+            .apply_pixel(&mut exact)
+            .expect("pixel apply should succeed");
+        draft
+            .apply_pixel(&mut fast)
+            .expect("pixel apply should succeed");
+        let tol = 1e-2 * exact.iter().fold(1.0_f32, |m, c| m.max(c.abs()));
+        assert_close3(fast, exact, tol);
+    }
+}
+
+#[test]
+fn cached_lut_bake_is_mapped_from_disk_on_second_call() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let proc = config
+        .processor(&src, &scene_linear)
+        .expect("source -> scene linear processor should be available");
+    let cpu = proc.cpu_f32().expect("CPU processor should be available");
+    assert!(!proc.cache_id().is_empty());
+    assert!(!cpu.cache_id().is_empty());
+
+    let dir = std::env::temp_dir().join(format!("crispen-lut-cache-{}", std::process::id()));
+    set_lut_cache_directory(Some(&dir)).expect("cache directory should be accepted");
+
+    let size = 9_u32;
+    let baked = cpu
+        .bake_3d_lut_cached(size)
+        .expect("cached bake should succeed");
+    let mapped = cpu
+        .bake_3d_lut_cached(size)
+        .expect("cached bake should succeed");
+    set_lut_cache_directory(None).expect("disabling the cache should succeed");
+    let _ = std::fs::remove_dir_all(&dir);
+
+    assert!(!baked.from_disk());
+    assert!(mapped.from_disk());
+    let reference = cpu.bake_3d_lut(size).expect("LUT bake should succeed");
+    assert_eq!(mapped.as_slice(), reference.as_slice());
+    assert_eq!(baked.as_slice(), reference.as_slice());
+}
+
+#[test]
+fn enabled_perf_counters_record_applies() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    // Other tests may run concurrently, so only lower bounds are checked.
+    set_perf_enabled(true);
+    let before = perf_stats().get(OcioPerfStage::CpuApply);
+    let (width, height) = (64_u32, 32_u32);
+    let mut pixels = vec![[0.25_f32, 0.5, 0.75, 1.0]; (width * height) as usize];
+    cpu.apply_rgba(&mut pixels, width, height)
+        .expect("apply should succeed");
+    let after = perf_stats().get(OcioPerfStage::CpuApply);
+
+    assert!(after.calls > before.calls);
+    assert!(after.bytes - before.bytes >= u64::from(width * height) * 16);
+}
+
+#[test]
+fn perf_callback_can_unregister_itself() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let calls = Arc::new(AtomicUsize::new(0));
+    let seen = Arc::clone(&calls);
+    set_perf_enabled(true);
+    set_perf_callback(Some(Box::new(move |_, _, _| {
+        seen.fetch_add(1, Ordering::SeqCst);
+        // Re-registering from inside the callback must not deadlock.
+        set_perf_callback(None);
+    })));
+    let mut pixels = vec![[0.25_f32, 0.5, 0.75, 1.0]; 64];
+    cpu.apply_rgba(&mut pixels, 8, 8)
+        .expect("apply should succeed");
+    let after_first = calls.load(Ordering::SeqCst);
+    cpu.apply_rgba(&mut pixels, 8, 8)
+        .expect("apply should succeed");
+
+    // Applies from concurrent tests may reach the callback first.
+    assert!(after_first >= 1);
+    assert_eq!(calls.load(Ordering::SeqCst), after_first);
+}
+
+#[test]
+fn async_load_prewarms_display_view_processor() {
+    let prewarm = OcioPrewarm {
+        display_view: true,
+        ..Default::default()
+    };
+    let loaded = [
+        "ocio://studio-config-latest",
+        "studio-config-v4.0.0_aces-v2.0_ocio-v2.5",
+        "studio-config-v2.2.0_aces-v1.3_ocio-v2.4",
+    ]
+    .into_iter()
+    .find_map(|uri| {
+        let load = OcioConfigLoad::start(&OcioConfigSource::Builtin(uri.to_string()), &prewarm)
+            .expect("async load should start");
+        load.wait().ok().map(|config| (load, config))
+    });
+    let Some((load, config)) = loaded else {
+        eprintln!("skipping: no built-in OCIO config available (needs OCIO 2.2+)");
+        return;
+    };
+    assert_eq!(load.status(), OcioConfigLoadStatus::Ready);
+    assert!(load.error().is_none());
+    let Some(scene_linear) = config.role("scene_linear") else {
+        eprintln!("skipping: config has no scene_linear role");
+        return;
+    };
+
+    let display = config.default_display();
+    let view = config.default_view(&display);
+    let before = processor_cache_stats();
+    let _cpu = config
+        .display_view_processor(&scene_linear, &display, &view)
+        .and_then(|p| p.cpu_f32_with(OcioCpuOptions::lossless()))
+        .expect("display/view processor should be available");
+    let after = processor_cache_stats();
+
+    // Other tests share the process-wide cache, so only check monotonic growth.
+    assert!(after.processor_hits > before.processor_hits);
+    assert!(after.cpu_hits > before.cpu_hits);
+}
+
+#[test]
+fn lut3d_apply_matches_processor_on_lattice_points() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+    let size = 17_u32;
+    let lut = cpu.bake_3d_lut(size).expect("LUT bake should succeed");
+
+    // Every lattice point of each axis plus odd sizes, so SIMD tails run too.
+    let denom = (size - 1) as f32;
+    let (width, height) = (size * size, size + 2);
+    let source: Vec<[f32; 4]> = (0..width * height)
+        .map(|i| {
+            let n = i % (size * size * size);
+            [
+                (n % size) as f32 / denom,
+                (n / size % size) as f32 / denom,
+                (n / (size * size)) as f32 / denom,
+                0.5,
+            ]
+        })
+        .collect();
+    let mut expected = source.clone();
+    cpu.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+
+    for interpolation in [
+        OcioLutInterpolation::Trilinear,
+        OcioLutInterpolation::Tetrahedral,
+    ] {
+        let mut pixels = source.clone();
+        apply_lut3d_rgba(&lut, size, &mut pixels, width, height, interpolation, 0)
+            .expect("LUT apply should succeed");
+        for (actual, expected) in pixels.iter().zip(&expected) {
+            assert_close3(
+                [actual[0], actual[1], actual[2]],
+                [expected[0], expected[1], expected[2]],
+                1e-4,
+            );
+            assert_eq!(actual[3], 0.5);
+        }
+    }
+}
+
+/// Scalar f64 reference for `apply_lut3d_rgba` on one RGB value of a
+/// red-fastest `size`³ lattice.
+fn lut3d_reference(
+    lut: &[[f32; 4]],
+    size: usize,
+    rgb: [f32; 3],
+    interpolation: OcioLutInterpolation,
+) -> [f32; 3] {
+    let scale = (size - 1) as f64;
+    let mut cell = [0_usize; 3];
+    let mut frac = [0_f64; 3];
+    for axis in 0..3 {
+        let x = f64::from(rgb[axis]).clamp(0.0, 1.0) * scale;
+        cell[axis] = (x.floor() as usize).min(size - 2);
+        frac[axis] = x - cell[axis] as f64;
+    }
+    let entry = |corner: [usize; 3]| {
+        let index = (cell[0] + corner[0])
+            + (cell[1] + corner[1]) * size
+            + (cell[2] + corner[2]) * size * size;
+        lut[index].map(f64::from)
+    };
+
+    let mut out = [0_f64; 3];
+    match interpolation {
+        OcioLutInterpolation::Trilinear => {
+            for corner in 0..8 {
+                let corner = [corner & 1, corner >> 1 & 1, corner >> 2];
+                let weight: f64 = (0..3)
+                    .map(|axis| match corner[axis] {
+                        0 => 1.0 - frac[axis],
+                        _ => frac[axis],
+                    })
+                    .product();
+                let e = entry(corner);
+                for c in 0..3 {
+                    out[c] += weight * e[c];
+                }
+            }
+        }
+        OcioLutInterpolation::Tetrahedral => {
+            // Walk from (0,0,0) to (1,1,1), largest fraction first.
+            let mut axes = [0, 1, 2];
+            axes.sort_by(|&a, &b| frac[b].total_cmp(&frac[a]));
+            let mut corner = [0; 3];
+            let mut previous = 1.0;
+            for step in 0..=3 {
+                let f = if step < 3 { frac[axes[step]] } else { 0.0 };
+                let e = entry(corner);
+                for c in 0..3 {
+                    out[c] += (previous - f) * e[c];
+                }
+                if step < 3 {
+                    corner[axes[step]] = 1;
+                }
+                previous = f;
+            }
+        }
+    }
+    out.map(|v| v as f32)
+}
+
+#[test]
+fn lut3d_apply_matches_scalar_reference_off_lattice() {
+    // A curved, channel-mixing lattice, so trilinear and tetrahedral
+    // disagree between lattice points and a wrong corner or weight shows.
+    let size = 9_usize;
+    let denom = (size - 1) as f32;
+    let lut: Vec<[f32; 4]> = (0..size * size * size)
+        .map(|i| {
+            let r = (i % size) as f32 / denom;
+            let g = (i / size % size) as f32 / denom;
+            let b = (i / (size * size)) as f32 / denom;
+            [
+                r * r * g + b,
+                (g + 0.3 * b).sin(),
+                r * b * b - 0.5 * g * g,
+                1.0,
+            ]
+        })
+        .collect();
+
+    // Every combination of these fractions covers all six fr/fg/fb
+    // orderings and the two- and three-way ties. They are exact in binary,
+    // so the ties survive the scale to lattice units.
+    let fractions = [0.0, 0.25, 0.5, 0.75, 0.875];
+    let mut source = Vec::new();
+    for cell in [[0, 0, 0], [3, 5, 1], [7, 7, 7], [2, 7, 4]] {
+        for fr in fractions {
+            for fg in fractions {
+                for fb in fractions {
+                    let f = [fr, fg, fb];
+                    source.push(std::array::from_fn::<f32, 4, _>(|c| match c {
+                        3 => 0.25,
+                        _ => (cell[c] as f32 + f[c]) / denom,
+                    }));
+                }
+            }
+        }
+    }
+    // Out-of-domain inputs clamp to the lattice faces.
+    source.push([-0.2, 0.5, 1.3, 0.25]);
+    source.push([1.0, 1.0, 1.0, 0.25]);
+    source.push([0.6, 1.2, -0.4, 0.25]);
+    // An odd width leaves SIMD tails.
+    let width = source.len() as u32;
+    assert_eq!(width % 2, 1);
+
+    for interpolation in [
+        OcioLutInterpolation::Trilinear,
+        OcioLutInterpolation::Tetrahedral,
+    ] {
+        let mut pixels = source.clone();
+        apply_lut3d_rgba(&lut, size as u32, &mut pixels, width, 1, interpolation, 0)
+            .expect("LUT apply should succeed");
+        for (actual, input) in pixels.iter().zip(&source) {
+            let expected =
+                lut3d_reference(&lut, size, [input[0], input[1], input[2]], interpolation);
+            assert_close3([actual[0], actual[1], actual[2]], expected, 1e-5);
+            assert_eq!(actual[3], 0.25);
+        }
+    }
+}
+
+#[test]
+fn fused_processor_matches_separate_stages() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let display = config.default_display();
+    let view = config.default_view(&display);
+    let lossless = OcioCpuOptions::lossless();
+
+    let gain = 0.5_f32;
+    let mut matrix = [0.0_f32; 16];
+    for i in 0..3 {
+        matrix[i * 5] = gain;
+    }
+    matrix[15] = 1.0;
+    let grade = OcioGrade {
+        matrix: Some(matrix),
+        ..Default::default()
+    };
+    let fused = config
+        .fused_processor(
+            &src,
+            &scene_linear,
+            &display,
+            &view,
+            &grade,
+            OcioOptimization::Lossless,
+        )
+        .and_then(|p| p.cpu_f32_with(lossless))
+        .expect("fused processor should build");
+    let idt = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32_with(lossless))
+        .expect("source -> scene linear processor should be available");
+    let odt = config
+        .display_view_processor(&scene_linear, &display, &view)
+        .and_then(|p| p.cpu_f32_with(lossless))
+        .expect("display/view processor should be available");
+
+    let (width, height) = (16_u32, 4_u32);
+    let source: Vec<[f32; 4]> = (0..width * height)
+        .map(|i| {
+            let t = i as f32 / (width * height) as f32;
+            [t, 1.0 - t, (t * 3.0).fract(), 1.0]
+        })
+        .collect();
+
+    let mut expected = source.clone();
+    idt.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+    for px in &mut expected {
+        for c in &mut px[..3] {
+            *c *= gain;
+        }
+    }
+    odt.apply_rgba(&mut expected, width, height)
+        .expect("apply should succeed");
+
+    let mut actual = source;
+    fused
+        .apply_rgba(&mut actual, width, height)
+        .expect("apply should succeed");
+    for (a, e) in actual.iter().zip(&expected) {
+        assert_close3([a[0], a[1], a[2]], [e[0], e[1], e[2]], 2e-3);
+    }
+}
+
+#[test]
+fn batched_points_match_per_pixel_apply() {
+    let Some(config) = load_test_config() else {
+        eprintln!("skipping: no OCIO config available (needs OCIO 2.2+ or OCIO env var)");
+        return;
+    };
+    let (src, scene_linear) = pick_roundtrip_spaces(&config);
+    let cpu = config
+        .processor(&src, &scene_linear)
+        .and_then(|p| p.cpu_f32())
+        .expect("source -> scene linear processor should be available");
+
+    let samples: Vec<[f32; 3]> = (0..257)
+        .map(|i| {
+            let t = i as f32 / 256.0;
+            [t, (t * 5.0).fract(), 1.0 - t]
+        })
+        .collect();
+    let mut points = samples.clone();
+    cpu.apply_rgb_points(&mut points)
+        .expect("batched apply should succeed");
+    let mut rgba: Vec<[f32; 4]> = samples.iter().map(|&[r, g, b]| [r, g, b, 0.25]).collect();
+    cpu.apply_rgba_points(&mut rgba)
+        .expect("batched apply should succeed");
+
+    for ((sample, point), px) in samples.iter().zip(&points).zip(&rgba) {
+        let mut expected = *sample;
+        cpu.apply_pixel(&mut expected)
+            .expect("pixel apply should succeed");
+        assert_close3(*point, expected, 1e-5);
+        assert_close3([px[0], px[1], px[2]], expected, 1e-5);
+        assert_eq!(px[3], 0.25);
+    }
+}
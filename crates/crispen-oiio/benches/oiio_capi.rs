@@ -0,0 +1,188 @@
+//! Throughput benchmarks for the oiio_capi read paths.
+//!
+//! Run with `cargo bench -p crispen-oiio [-- <filter>]`. Each case reports
+//! the median time per iteration plus pixels/s and bytes/s (decoded RGBA
+//! f32 bytes), so runs can be compared across commits and machines.
+//!
+//! UHD EXR (half, zip and uncompressed), TIFF (16-bit, deflate and
+//! uncompressed) and DPX (10-bit) files are generated into a temp directory
+//! first. Files the raw mapped reader accepts also get `raw_*` cases, and
+//! `batch_export/*` runs a short sequence through the export pipeline. Set
+//! `CRISPEN_BENCH_IMAGES` to a directory to also benchmark every image in
+//! it, e.g. real camera plates.
+
+// The mapped OiioRawImage reads are unsafe.
+#![allow(unsafe_code)]
+
+use std::hint::black_box;
+use std::path::{Path, PathBuf};
+
+use crispen_core::image::BitDepth;
+use crispen_ffi::bench::Bench;
+use crispen_oiio::{
+    OiioExportJob, OiioExportOptions, OiioImageInput, OiioImageOutput, OiioOutputOptions,
+    OiioRawImage, batch_export,
+};
+
+fn write_sample(dir: &Path, name: &str, options: &OiioOutputOptions) -> Option<PathBuf> {
+    let (width, height) = (3840_u32, 2160_u32);
+    let pixels: Vec<[f32; 4]> = (0..width as usize * height as usize)
+        .map(|i| {
+            let x = (i % width as usize) as f32 / width as f32;
+            let y = (i / width as usize) as f32 / height as f32;
+            [x, y, (x * 7.0 + y * 3.0).fract(), 1.0]
+        })
+        .collect();
+
+    let path = dir.join(name);
+    let mut output = OiioImageOutput::create(&path, width, height, options).ok()?;
+    output.write_image(&pixels).ok()?;
+    output.close().ok()?;
+    Some(path)
+}
+
+fn sample_files(dir: &Path) -> Vec<PathBuf> {
+    let exr = OiioOutputOptions {
+        compression: Some("zip".to_string()),
+        ..Default::default()
+    };
+    let exr_none = OiioOutputOptions {
+        compression: Some("none".to_string()),
+        ..Default::default()
+    };
+    let tiff = OiioOutputOptions {
+        bit_depth: BitDepth::U16,
+        ..Default::default()
+    };
+    let tiff_none = OiioOutputOptions {
+        compression: Some("none".to_string()),
+        ..tiff.clone()
+    };
+    let dpx = OiioOutputOptions {
+        bit_depth: BitDepth::U10,
+        write_alpha: false,
+        ..Default::default()
+    };
+
+    let mut files: Vec<PathBuf> = [
+        ("uhd_half_zip.exr", &exr),
+        ("uhd_half_none.exr", &exr_none),
+        ("uhd_u16.tif", &tiff),
+        ("uhd_u16_none.tif", &tiff_none),
+        ("uhd_u10.dpx", &dpx),
+    ]
+    .into_iter()
+    .filter_map(|(name, options)| {
+        let path = write_sample(dir, name, options);
+        if path.is_none() {
+            eprintln!("skipping {name}: could not be written");
+        }
+        path
+    })
+    .collect();
+
+    if let Some(extra) = std::env::var_os("CRISPEN_BENCH_IMAGES")
+        && let Ok(entries) = std::fs::read_dir(extra)
+    {
+        let mut extra: Vec<PathBuf> = entries
+            .filter_map(|entry| entry.ok().map(|entry| entry.path()))
+            .filter(|path| path.is_file())
+            .collect();
+        extra.sort();
+        files.extend(extra);
+    }
+    files
+}
+
+fn bench_read(bench: &Bench, path: &Path) {
+    let name = path
+        .file_name()
+        .map(|name| name.to_string_lossy().into_owned())
+        .unwrap_or_default();
+    let Ok(input) = OiioImageInput::open(path) else {
+        eprintln!("skipping {name}: not readable");
+        return;
+    };
+    let count = u64::from(input.width()) * u64::from(input.height());
+    drop(input);
+
+    bench.run(&format!("open/{name}"), 0, || {
+        black_box(OiioImageInput::open(path).expect("image should open"));
+    });
+    bench.run(&format!("open_read_rgba_f32/{name}"), count, || {
+        let input = OiioImageInput::open(path).expect("image should open");
+        black_box(input.read_rgba_f32().expect("image should decode"));
+    });
+
+    if OiioRawImage::open(path).is_err() {
+        return;
+    }
+    bench.run(&format!("raw_open/{name}"), 0, || {
+        black_box(OiioRawImage::open(path).expect("image should map"));
+    });
+    bench.run(&format!("raw_open_read_rgba_f32/{name}"), count, || {
+        let raw = OiioRawImage::open(path).expect("image should map");
+        // SAFETY: the bench files are not modified while mapped.
+        black_box(unsafe { raw.read_rgba_f32(64) }.expect("image should convert"));
+    });
+}
+
+/// Export 8 copies of `path` with a gain transform, reporting the pixels of
+/// all frames so the rate is directly comparable with the read cases.
+fn bench_export(bench: &Bench, dir: &Path, path: &Path) {
+    const FRAMES: usize = 8;
+    let Ok(input) = OiioImageInput::open(path) else {
+        return;
+    };
+    let count = u64::from(input.width()) * u64::from(input.height()) * FRAMES as u64;
+    drop(input);
+
+    let jobs: Vec<OiioExportJob> = (0..FRAMES)
+        .map(|i| OiioExportJob {
+            input: path.to_path_buf(),
+            output: dir.join(format!("export_{i:04}.exr")),
+        })
+        .collect();
+    let gain = |_: usize, pixels: &mut [[f32; 4]], _: u32, _: u32| {
+        for px in pixels {
+            px[0] *= 1.1;
+            px[1] *= 1.1;
+            px[2] *= 1.1;
+        }
+        Ok(())
+    };
+    let options = OiioExportOptions {
+        output: OiioOutputOptions {
+            compression: Some("zip".to_string()),
+            ..Default::default()
+        },
+        transform: Some(&gain),
+        ..Default::default()
+    };
+    let name = path
+        .file_name()
+        .map(|name| name.to_string_lossy().into_owned())
+        .unwrap_or_default();
+    bench.run(&format!("batch_export/{name}"), count, || {
+        let report = batch_export(&jobs, &options).expect("batch should run");
+        black_box(report.stats);
+    });
+}
+
+fn main() {
+    let bench = Bench::from_args();
+    let dir = std::env::temp_dir().join(format!("crispen-oiio-bench-{}", std::process::id()));
+    if let Err(err) = std::fs::create_dir_all(&dir) {
+        eprintln!("skipping: cannot create {}: {err}", dir.display());
+        return;
+    }
+
+    let files = sample_files(&dir);
+    for path in &files {
+        bench_read(&bench, path);
+    }
+    if let Some(path) = files.first() {
+        bench_export(&bench, &dir, path);
+    }
+    let _ = std::fs::remove_dir_all(&dir);
+}
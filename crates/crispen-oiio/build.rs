@@ -5,6 +5,7 @@ fn main() {
     println!("cargo:rerun-if-changed=build.rs");
     println!("cargo:rerun-if-changed=csrc/oiio_capi.h");
     println!("cargo:rerun-if-changed=csrc/oiio_capi.cpp");
+    println!("cargo:rerun-if-changed=csrc/raw_layout.h");
     println!("cargo:rerun-if-env-changed=CRISPEN_OIIO_PREBUILT_DIR");
     println!("cargo:rerun-if-env-changed=CRISPEN_OIIO_SOURCE_DIR");
     println!("cargo:rerun-if-env-changed=CRISPEN_OIIO_SKIP_NATIVE_BUILD");
@@ -78,11 +79,17 @@ fn main() {
 }
 
 fn compile_wrapper(include_dirs: &[PathBuf]) {
+    // Headers shared with the other C API, from the crispen-ffi crate.
+    let shared_include =
+        PathBuf::from(env::var("DEP_CRISPEN_FFI_INCLUDE").expect("crispen-ffi include dir"));
+    println!("cargo:rerun-if-changed={}", shared_include.display());
+
     let mut build = cc::Build::new();
     build
         .cpp(true)
         .file("csrc/oiio_capi.cpp")
         .include("csrc")
+        .include(&shared_include)
         .flag_if_supported("-std=c++17");
     for dir in include_dirs {
         build.include(dir);
@@ -1,26 +1,90 @@
 #include "oiio_capi.h"
+#include "raw_layout.h"
+
+#include "crispen/mapped_file.h"
+#include "crispen/perf_counters.h"
+#include "crispen/worker_pool.h"
 
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagecache.h>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/strutil.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <exception>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 namespace OIIO = OIIO_NAMESPACE;
 
+// Holds an open decoder rather than decoded pixels: read_rgba_f32 decodes
+// straight into the caller's buffer, so the frame is only ever stored once.
 struct OiioImageInput
 {
-    OIIO::ImageBuf buf;
+    // Null for handles opened through the shared ImageCache.
+    std::unique_ptr<OIIO::ImageInput> input;
+    // Cached handles read through the ImageCache by this (interned) name.
+    OIIO::ustring cache_path;
+    OIIO::ImageSpec spec;
+    std::string color_space;
+    // Thread hint for decode and resize; 0 uses the global OIIO setting.
+    // Atomic because cached reads take it without the lock.
+    std::atomic<int> threads{0};
+    // Serializes reads on the shared ImageInput.
+    mutable std::mutex mutex;
+    // Headers of every subimage, scanned under `mutex` on first use by the
+    // subimage and layer queries and never changed afterwards.
+    mutable std::vector<OIIO::ImageSpec> subimages;
+    mutable bool subimages_scanned = false;
+};
+
+struct OiioImageStream
+{
+    std::unique_ptr<OIIO::ImageInput> input;
+    OIIO::ImageSpec spec;
     std::string color_space;
+    // Serializes reads on the shared ImageInput.
+    std::mutex mutex;
 };
 
 namespace
 {
 thread_local std::string g_last_error;
 
+using PerfCounters = crispen::PerfCounters<OIIO_PERF_STAGE_COUNT>;
+using PerfScope = crispen::PerfScope<OIIO_PERF_STAGE_COUNT>;
+
+PerfCounters & perf()
+{
+    static PerfCounters counters;
+    return counters;
+}
+
+// Bytes in a `width` x `height` RGBA buffer of `type` samples.
+std::uint64_t rgba_bytes(OIIO::TypeDesc type, long width, long height)
+{
+    return static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) * 4
+           * type.size();
+}
+
 void set_error(const char * err)
 {
     g_last_error = err ? err : "unknown OIIO error";
@@ -31,172 +95,3785 @@ void clear_error()
     g_last_error.clear();
 }
 
-} // namespace
-
-// ── Error ────────────────────────────────────────────────────────────────────
+void set_input_error(const OIIO::ImageInput & in, const char * fallback)
+{
+    std::string err = in.geterror();
+    if (err.empty())
+    {
+        err = fallback;
+    }
+    set_error(err.c_str());
+}
 
-extern "C" const char * oiio_get_last_error(void)
+// Check that a strided float region of `rows` x `cols` x `channels` fits in
+// `buf_len` floats, resolving 0 strides to tightly packed.
+bool resolve_float_strides(
+    int cols,
+    int rows,
+    int channels,
+    size_t buf_len,
+    std::ptrdiff_t & xstride,
+    std::ptrdiff_t & ystride)
 {
-    return g_last_error.empty() ? nullptr : g_last_error.c_str();
+    const std::ptrdiff_t pixel_bytes = static_cast<std::ptrdiff_t>(channels * sizeof(float));
+    if (xstride <= 0)
+    {
+        xstride = pixel_bytes;
+    }
+    if (ystride <= 0)
+    {
+        ystride = xstride * cols;
+    }
+    if (xstride < pixel_bytes || ystride < xstride * cols || xstride % sizeof(float) != 0
+        || ystride % sizeof(float) != 0)
+    {
+        return false;
+    }
+    const size_t last = static_cast<size_t>((rows - 1) * ystride + (cols - 1) * xstride)
+                        / sizeof(float);
+    return last + static_cast<size_t>(channels) <= buf_len;
 }
 
-// ── ImageInput lifecycle ─────────────────────────────────────────────────────
+// Byte stride between pixels of an RGBA f32 buffer.
+constexpr std::ptrdiff_t k_rgba_pixel_bytes = static_cast<std::ptrdiff_t>(4 * sizeof(float));
 
-extern "C" OiioImageInput * oiio_image_input_open(const char * path)
+// Byte stride of a tightly packed RGBA f32 row.
+std::ptrdiff_t packed_rgba_row(int width)
 {
-    clear_error();
-    if (!path || !path[0])
+    return k_rgba_pixel_bytes * width;
+}
+
+// RGBA pixel sample types accepted from callers (OIIO_PIXEL_*).
+bool pixel_type(int pixel_format, OIIO::TypeDesc & type)
+{
+    switch (pixel_format)
     {
-        set_error("oiio_image_input_open: empty path");
-        return nullptr;
+    case OIIO_PIXEL_F32:
+        type = OIIO::TypeFloat;
+        return true;
+    case OIIO_PIXEL_F16:
+        type = OIIO::TypeHalf;
+        return true;
+    default:
+        return false;
     }
-    try
+}
+
+// Byte stride between pixels of an RGBA buffer of `type` samples.
+std::ptrdiff_t rgba_pixel_bytes(OIIO::TypeDesc type)
+{
+    return static_cast<std::ptrdiff_t>(4 * type.size());
+}
+
+template <typename T>
+void expand_rgba_samples(
+    void * rgba, int width, int rows, std::ptrdiff_t ystride, int nchannels, T one)
+{
+    for (int y = 0; y < rows; ++y)
     {
-        auto h = new OiioImageInput;
-        h->buf.reset(path);
-        if (!h->buf.read(0, 0, false, OIIO::TypeFloat))
+        T * row = reinterpret_cast<T *>(static_cast<char *>(rgba) + y * ystride);
+        for (int x = 0; x < width; ++x)
         {
-            std::string err = h->buf.geterror();
-            if (err.empty())
+            T * px = row + x * 4;
+            switch (nchannels)
             {
-                err = "failed to read image: " + std::string(path);
+            case 1:
+                px[1] = px[0];
+                px[2] = px[0];
+                px[3] = one;
+                break;
+            case 2:
+                px[3] = px[1];
+                px[1] = px[0];
+                px[2] = px[0];
+                break;
+            default:
+                px[3] = one;
+                break;
             }
-            set_error(err.c_str());
-            delete h;
-            return nullptr;
         }
-        // Cache the detected color space from the "oiio:ColorSpace" attribute.
-        std::string cs = h->buf.spec()["oiio:ColorSpace"];
-        if (!cs.empty())
-        {
-            h->color_space = std::move(cs);
-        }
-        return h;
     }
-    catch (const std::exception & e)
+}
+
+// Expand pixels already decoded into the first `nchannels` slots of each
+// RGBA pixel: grayscale is replicated to RGB, gray+alpha moves alpha to
+// slot 3, and missing alpha is filled with 1. Rows are `ystride` bytes apart.
+// Half samples are only copied, so they are handled as raw 16-bit values.
+void expand_to_rgba(
+    void * rgba,
+    OIIO::TypeDesc type,
+    int width,
+    int rows,
+    std::ptrdiff_t ystride,
+    int nchannels)
+{
+    if (nchannels >= 4)
     {
-        set_error(e.what());
-        return nullptr;
+        return;
+    }
+    PerfScope scope(perf(), OIIO_PERF_CHANNEL_EXPAND, rgba_bytes(type, width, rows));
+    if (type == OIIO::TypeHalf)
+    {
+        // 0x3C00 is 1.0 in IEEE half.
+        expand_rgba_samples<std::uint16_t>(rgba, width, rows, ystride, nchannels, 0x3C00);
+    }
+    else
+    {
+        expand_rgba_samples<float>(rgba, width, rows, ystride, nchannels, 1.0f);
     }
 }
 
-extern "C" void oiio_image_input_destroy(OiioImageInput * h)
+// Decode rows [ybegin, yend) of `in` as RGBA f32 straight into `rgba`
+// (packed, `spec.width` pixels per row), with no intermediate buffer.
+bool read_rgba_rows(
+    OIIO::ImageInput & in,
+    const OIIO::ImageSpec & spec,
+    int subimage,
+    int miplevel,
+    int ybegin,
+    int yend,
+    float * rgba)
 {
-    delete h;
+    const int nread = std::min(spec.nchannels, 4);
+    const std::ptrdiff_t ystride = packed_rgba_row(spec.width);
+    PerfScope decode(
+        perf(), OIIO_PERF_DECODE, rgba_bytes(OIIO::TypeFloat, spec.width, yend - ybegin));
+    const bool ok = in.read_scanlines(
+        subimage,
+        miplevel,
+        spec.y + ybegin,
+        spec.y + yend,
+        spec.z,
+        0,
+        nread,
+        OIIO::TypeFloat,
+        rgba,
+        k_rgba_pixel_bytes,
+        ystride);
+    decode.finish();
+    if (!ok)
+    {
+        return false;
+    }
+    expand_to_rgba(rgba, OIIO::TypeFloat, spec.width, yend - ybegin, ystride, spec.nchannels);
+    return true;
 }
 
-// ── Spec queries ─────────────────────────────────────────────────────────────
+// Decode a whole subimage as RGBA `type` samples straight into `rgba`,
+// whose rows are `ystride` bytes apart. The decoder converts and writes the
+// first four channels into place (half EXRs stay half with TypeHalf); only
+// the channel expansion is a second (in-place) pass over the buffer.
+bool read_rgba_image(
+    OIIO::ImageInput & in,
+    const OIIO::ImageSpec & spec,
+    int subimage,
+    int miplevel,
+    OIIO::TypeDesc type,
+    void * rgba,
+    std::ptrdiff_t ystride)
+{
+    const int nread = std::min(spec.nchannels, 4);
+    PerfScope decode(perf(), OIIO_PERF_DECODE, rgba_bytes(type, spec.width, spec.height));
+    const bool ok = in.read_image(
+        subimage, miplevel, 0, nread, type, rgba, rgba_pixel_bytes(type), ystride);
+    decode.finish();
+    if (!ok)
+    {
+        return false;
+    }
+    expand_to_rgba(rgba, type, spec.width, spec.height, ystride, spec.nchannels);
+    return true;
+}
 
-extern "C" int oiio_image_input_width(const OiioImageInput * h)
+// Dimensions that fit within (max_w, max_h) preserving aspect ratio. Never
+// upscales; non-positive bounds mean full size.
+void fit_dimensions(int src_w, int src_h, int max_w, int max_h, int & out_w, int & out_h)
 {
-    return h ? h->buf.spec().width : 0;
+    out_w = src_w;
+    out_h = src_h;
+    if (max_w <= 0 || max_h <= 0 || (src_w <= max_w && src_h <= max_h))
+    {
+        return;
+    }
+    const double scale = std::min(
+        static_cast<double>(max_w) / src_w, static_cast<double>(max_h) / src_h);
+    out_w = std::max(1, static_cast<int>(std::lround(src_w * scale)));
+    out_h = std::max(1, static_cast<int>(std::lround(src_h * scale)));
 }
 
-extern "C" int oiio_image_input_height(const OiioImageInput * h)
+// Smallest MIP level of subimage 0 that still covers out_w x out_h, so the
+// decoder never reads more resolution than the display needs. Subimages are
+// not treated as a pyramid: in multi-part EXRs they are separate layers or
+// views rather than reduced-resolution copies. `level_spec(m, spec)` fills in
+// the dimensions of level m and returns false past the last level.
+template <typename LevelSpec>
+int pick_miplevel(LevelSpec && level_spec, int out_w, int out_h, OIIO::ImageSpec & level)
 {
-    return h ? h->buf.spec().height : 0;
+    int best = 0;
+    for (int m = 1;; ++m)
+    {
+        OIIO::ImageSpec s;
+        if (!level_spec(m, s) || s.width <= 0 || s.height <= 0 || s.width < out_w
+            || s.height < out_h)
+        {
+            break;
+        }
+        best = m;
+        level = s;
+    }
+    return best;
 }
 
-extern "C" int oiio_image_input_nchannels(const OiioImageInput * h)
+// Decode subimage 0 as RGBA `type` samples at out_w x out_h into `rgba`.
+// Picks the closest MIP level; if it is still larger than the target, the
+// level is decoded at native depth and ImageBufAlgo::resize writes the
+// converted result straight into `rgba` (rows `ystride` bytes apart). The
+// resize uses `filter` ("" = OIIO default) on up to `nthreads` threads
+// (0 = global default). Sets the error message on failure.
+bool read_rgba_fit(
+    OIIO::ImageInput & in,
+    const OIIO::ImageSpec & spec,
+    int out_w,
+    int out_h,
+    OIIO::TypeDesc type,
+    void * rgba,
+    std::ptrdiff_t ystride,
+    int nthreads,
+    const char * filter = "")
 {
-    return h ? h->buf.spec().nchannels : 0;
+    OIIO::ImageSpec level = spec;
+    const int mip = pick_miplevel(
+        [&](int m, OIIO::ImageSpec & s)
+        {
+            s = in.spec_dimensions(0, m);
+            return true;
+        },
+        out_w,
+        out_h,
+        level);
+    if (level.width == out_w && level.height == out_h)
+    {
+        if (!read_rgba_image(in, level, 0, mip, type, rgba, ystride))
+        {
+            set_input_error(in, "read_image failed");
+            return false;
+        }
+        return true;
+    }
+
+    const int nread = std::min(spec.nchannels, 4);
+    const OIIO::TypeDesc native =
+        level.format == OIIO::TypeUnknown ? OIIO::TypeFloat : level.format;
+    OIIO::ImageBuf src(OIIO::ImageSpec(level.width, level.height, nread, native));
+    {
+        PerfScope decode(perf(), OIIO_PERF_DECODE, src.spec().image_bytes());
+        if (!in.read_image(0, mip, 0, nread, native, src.localpixels()))
+        {
+            set_input_error(in, "read_image failed");
+            return false;
+        }
+    }
+
+    OIIO::ImageBuf dst(
+        OIIO::ImageSpec(out_w, out_h, nread, type), rgba, rgba_pixel_bytes(type), ystride);
+    PerfScope resize(perf(), OIIO_PERF_RESIZE, rgba_bytes(type, out_w, out_h));
+    const bool resized = OIIO::ImageBufAlgo::resize(dst, src, filter, 0.0f, {}, nthreads);
+    resize.finish();
+    if (!resized)
+    {
+        std::string err = dst.geterror();
+        set_error(err.empty() ? "resize failed" : err.c_str());
+        return false;
+    }
+    expand_to_rgba(rgba, type, out_w, out_h, ystride, spec.nchannels);
+    return true;
 }
 
-extern "C" int oiio_image_input_format(const OiioImageInput * h)
+// ── Shared image cache ───────────────────────────────────────────────────────
+
+// Process-wide ImageCache backing oiio_image_input_open_cached. It is a
+// private cache rather than OIIO's shared one, so its limits, stats and
+// invalidation never reach other OIIO users in the process (a host's
+// TextureSystem, say). Created lazily and never destroyed, since reads may
+// still be running on other threads at exit.
+OIIO::ImageCache & image_cache()
 {
-    if (!h)
+    static OIIO::ImageCache * cache = OIIO::ImageCache::create(false);
+    return *cache;
+}
+
+void set_cache_error(const char * fallback)
+{
+    std::string err = image_cache().geterror();
+    set_error(err.empty() ? fallback : err.c_str());
+}
+
+// Cached equivalent of read_rgba_image: ImageCache converts to `type` and
+// writes the first four channels of level `miplevel` straight into `rgba`.
+bool read_rgba_cached(
+    OIIO::ustring path,
+    const OIIO::ImageSpec & spec,
+    int miplevel,
+    OIIO::TypeDesc type,
+    void * rgba,
+    std::ptrdiff_t ystride)
+{
+    const int nread = std::min(spec.nchannels, 4);
+    PerfScope read(perf(), OIIO_PERF_CACHE_READ, rgba_bytes(type, spec.width, spec.height));
+    const bool ok = image_cache().get_pixels(
+        path,
+        0,
+        miplevel,
+        spec.x,
+        spec.x + spec.width,
+        spec.y,
+        spec.y + spec.height,
+        spec.z,
+        spec.z + std::max(1, spec.depth),
+        0,
+        nread,
+        type,
+        rgba,
+        rgba_pixel_bytes(type),
+        ystride,
+        OIIO::AutoStride,
+        0,
+        nread);
+    read.finish();
+    if (!ok)
     {
-        return 0;
+        set_cache_error("ImageCache::get_pixels failed");
+        return false;
     }
-    // Return the OIIO TypeDesc BASETYPE as an int.
-    return static_cast<int>(h->buf.spec().format.basetype);
+    expand_to_rgba(rgba, type, spec.width, spec.height, ystride, spec.nchannels);
+    return true;
 }
 
-extern "C" const char * oiio_image_input_color_space(const OiioImageInput * h)
+// Cached equivalent of read_rgba_fit. The resize source is an ImageBuf
+// backed by the cache, so only the tiles it touches are decoded, at the
+// file's native depth.
+bool read_rgba_fit_cached(
+    OIIO::ustring path,
+    const OIIO::ImageSpec & spec,
+    int out_w,
+    int out_h,
+    OIIO::TypeDesc type,
+    void * rgba,
+    std::ptrdiff_t ystride,
+    int nthreads)
 {
-    if (!h || h->color_space.empty())
+    OIIO::ImageSpec level = spec;
+    const int mip = pick_miplevel(
+        [&](int m, OIIO::ImageSpec & s) { return image_cache().get_imagespec(path, s, 0, m); },
+        out_w,
+        out_h,
+        level);
+    if (level.width == out_w && level.height == out_h)
     {
-        return nullptr;
+        return read_rgba_cached(path, level, mip, type, rgba, ystride);
     }
-    return h->color_space.c_str();
+
+    const int nread = std::min(spec.nchannels, 4);
+    OIIO::ImageBuf src(path.string(), 0, mip, &image_cache());
+    OIIO::ImageBuf dst(
+        OIIO::ImageSpec(out_w, out_h, nread, type), rgba, rgba_pixel_bytes(type), ystride);
+    // Includes decoding the cache tiles the filter touches.
+    PerfScope resize(perf(), OIIO_PERF_RESIZE, rgba_bytes(type, out_w, out_h));
+    const bool resized = OIIO::ImageBufAlgo::resize(dst, src, "", 0.0f, {}, nthreads);
+    resize.finish();
+    if (!resized)
+    {
+        std::string err = dst.geterror();
+        set_error(err.empty() ? "resize failed" : err.c_str());
+        return false;
+    }
+    expand_to_rgba(rgba, type, out_w, out_h, ystride, spec.nchannels);
+    return true;
 }
 
-// ── Pixel reading ────────────────────────────────────────────────────────────
 
-extern "C" int oiio_image_input_read_rgba_f32(
-    const OiioImageInput * h,
-    float * buf,
-    int buf_len)
+// ── Sequence prefetch ────────────────────────────────────────────────────────
+
+// Expand the frame number token in a sequence pattern: a run of '#' (one
+// digit each), or printf-style "%d" / "%0Nd". Returns false if the pattern
+// has no token. The pattern is never used as a format string.
+bool format_frame_path(const std::string & pattern, int frame, std::string & out)
 {
-    clear_error();
-    if (!h || !buf)
+    size_t start = std::string::npos;
+    size_t end = 0;
+    int width = 0;
+
+    const size_t hash = pattern.find('#');
+    const size_t pct = pattern.find('%');
+    if (hash != std::string::npos && (pct == std::string::npos || hash < pct))
     {
-        set_error("oiio_image_input_read_rgba_f32: null argument");
-        return 0;
+        start = hash;
+        end = pattern.find_first_not_of('#', hash);
+        end = end == std::string::npos ? pattern.size() : end;
+        width = static_cast<int>(end - start);
+    }
+    else if (pct != std::string::npos)
+    {
+        size_t i = pct + 1;
+        while (i < pattern.size() && pattern[i] >= '0' && pattern[i] <= '9')
+        {
+            width = width * 10 + (pattern[i] - '0');
+            ++i;
+        }
+        if (i >= pattern.size() || pattern[i] != 'd' || width > 32)
+        {
+            return false;
+        }
+        start = pct;
+        end = i + 1;
+    }
+    if (start == std::string::npos)
+    {
+        return false;
     }
 
-    const int w = h->buf.spec().width;
-    const int h_ = h->buf.spec().height;
-    const int required = w * h_ * 4;
-    if (buf_len < required)
+    std::string digits = std::to_string(frame < 0 ? -static_cast<long long>(frame) : frame);
+    if (static_cast<int>(digits.size()) < width)
     {
-        set_error("oiio_image_input_read_rgba_f32: buffer too small");
-        return 0;
+        digits.insert(0, static_cast<size_t>(width) - digits.size(), '0');
+    }
+    out = pattern.substr(0, start) + (frame < 0 ? "-" : "") + digits + pattern.substr(end);
+    return true;
+}
+
+// Read all of `path` into `out`, reusing its capacity. Fails when the file
+// cannot be opened or changes size while it is read.
+bool read_whole_file(const std::string & path, std::vector<unsigned char> & out)
+{
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0 || size > std::numeric_limits<size_t>::max())
+    {
+        return false;
+    }
+    std::FILE * f = std::fopen(path.c_str(), "rb");
+    if (!f)
+    {
+        return false;
+    }
+    out.resize(static_cast<size_t>(size));
+    const bool complete = std::fread(out.data(), 1, out.size(), f) == out.size()
+                          && std::fgetc(f) == EOF;
+    std::fclose(f);
+    return complete;
+}
+
+// Raw-file fast path of decode_sequence_frame: a full-size frame stored in
+// an uncompressed layout (see raw_layout.h) is read with one buffered read
+// and converted from that copy. Unlike a mapping, a file truncated or
+// rewritten while it is read (a render still being written, say) only
+// fails this frame. Returns false without touching the outputs when the
+// file needs the regular decoder, including when it has to be downscaled.
+bool decode_raw_frame(
+    const std::string & path,
+    int max_w,
+    int max_h,
+    std::vector<float> & pixels,
+    int & width,
+    int & height)
+{
+    // One file buffer per decode thread, kept between frames.
+    thread_local std::vector<unsigned char> file;
+    PerfScope open(perf(), OIIO_PERF_OPEN);
+    crispen::RawLayout layout;
+    if (!read_whole_file(path, file)
+        || crispen::parse_raw_layout(file.data(), file.size(), layout))
+    {
+        open.cancel();
+        return false;
+    }
+    int fit_w = 0;
+    int fit_h = 0;
+    fit_dimensions(layout.width, layout.height, max_w, max_h, fit_w, fit_h);
+    if (fit_w != layout.width || fit_h != layout.height)
+    {
+        open.cancel();
+        return false;
     }
+    open.finish();
+
+    const std::ptrdiff_t ystride = packed_rgba_row(fit_w);
+    pixels.resize(static_cast<size_t>(fit_w) * fit_h * 4);
+    PerfScope decode(perf(), OIIO_PERF_DECODE, rgba_bytes(OIIO::TypeFloat, fit_w, fit_h));
+    crispen::convert_raw_rows(layout, file.data(), 0, fit_h, pixels.data(), ystride);
+    decode.finish();
+    expand_to_rgba(pixels.data(), OIIO::TypeFloat, fit_w, fit_h, ystride, layout.nchannels);
+    width = fit_w;
+    height = fit_h;
+    return true;
+}
 
+// Decode one sequence frame as display-fit RGBA f32 into `pixels`, reusing
+// its capacity, through the raw-file fast path when the file allows it.
+// When `source` is set it receives the file's header spec, metadata
+// included. Runs on a prefetch or batch decode thread; errors go to `error`.
+bool decode_sequence_frame(
+    const std::string & path,
+    int max_w,
+    int max_h,
+    std::vector<float> & pixels,
+    int & width,
+    int & height,
+    std::string & error,
+    OIIO::ImageSpec * source = nullptr)
+{
     try
     {
-        const int nchannels = h->buf.nchannels();
+        const auto open_input = [&]() -> std::unique_ptr<OIIO::ImageInput> {
+            auto input = OIIO::ImageInput::open(path);
+            if (!input)
+            {
+                error = OIIO::geterror();
+                if (error.empty())
+                {
+                    error = "failed to open image: " + path;
+                }
+            }
+            return input;
+        };
 
-        // Ensure we have exactly 4 channels (RGBA).
-        OIIO::ImageBuf rgba;
-        if (nchannels == 4)
+        // The raw path only parses the pixel layout, so the header comes
+        // from the regular decoder, which is then reused if needed.
+        std::unique_ptr<OIIO::ImageInput> input;
+        if (source)
         {
-            rgba = h->buf;
+            input = open_input();
+            if (!input)
+            {
+                return false;
+            }
+            *source = input->spec();
+        }
+        if (decode_raw_frame(path, max_w, max_h, pixels, width, height))
+        {
+            return true;
         }
-        else if (nchannels < 4)
+
+        if (!input)
         {
-            // Map existing channels into RGBA, fill missing with 0 (alpha with 1).
-            std::vector<int> order(4);
-            std::vector<float> fill = {0.0f, 0.0f, 0.0f, 1.0f};
-            for (int i = 0; i < 4; ++i)
+            input = open_input();
+            if (!input)
             {
-                order[i] = (i < nchannels) ? i : -1;
+                return false;
             }
-            rgba = OIIO::ImageBufAlgo::channels(h->buf, 4, order, fill);
         }
-        else
+        // Frames are decoded concurrently, one per prefetch thread, so keep
+        // each decoder single-threaded to avoid oversubscription.
+        input->threads(1);
+
+        const OIIO::ImageSpec spec = input->spec();
+        fit_dimensions(spec.width, spec.height, max_w, max_h, width, height);
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        if (!read_rgba_fit(
+                *input,
+                spec,
+                width,
+                height,
+                OIIO::TypeFloat,
+                pixels.data(),
+                packed_rgba_row(width),
+                1))
         {
-            // More than 4 channels — take the first 4.
-            std::vector<int> order = {0, 1, 2, 3};
-            rgba = OIIO::ImageBufAlgo::channels(h->buf, 4, order);
+            error = g_last_error;
+            return false;
         }
+        return true;
+    }
+    catch (const std::exception & e)
+    {
+        error = e.what();
+        return false;
+    }
+}
+
+// ── Image output ─────────────────────────────────────────────────────────────
+
+// Build the file spec for an RGBA(/RGB) output. 10/12-bit depths are
+// stored as 16-bit samples tagged with oiio:BitsPerSample, which DPX and
+// TIFF writers honour.
+bool make_output_spec(
+    int width,
+    int height,
+    const OiioOutputOptions & options,
+    OIIO::ImageSpec & spec,
+    std::string & error)
+{
+    OIIO::TypeDesc format;
+    int bits = 0;
+    switch (options.bit_depth)
+    {
+    case OIIO_BIT_DEPTH_UINT8:
+        format = OIIO::TypeUInt8;
+        break;
+    case OIIO_BIT_DEPTH_UINT10:
+        format = OIIO::TypeUInt16;
+        bits = 10;
+        break;
+    case OIIO_BIT_DEPTH_UINT12:
+        format = OIIO::TypeUInt16;
+        bits = 12;
+        break;
+    case OIIO_BIT_DEPTH_UINT16:
+        format = OIIO::TypeUInt16;
+        break;
+    case OIIO_BIT_DEPTH_F16:
+        format = OIIO::TypeHalf;
+        break;
+    case OIIO_BIT_DEPTH_F32:
+        format = OIIO::TypeFloat;
+        break;
+    default:
+        error = "unsupported output bit depth";
+        return false;
+    }
+    if (width <= 0 || height <= 0 || options.tile_width < 0 || options.tile_height < 0)
+    {
+        error = "invalid output dimensions or tile size";
+        return false;
+    }
+
+    spec = OIIO::ImageSpec(width, height, options.write_alpha ? 4 : 3, format);
+    spec.alpha_channel = options.write_alpha ? 3 : -1;
+    if (bits > 0)
+    {
+        spec.attribute("oiio:BitsPerSample", bits);
+    }
+    if (options.compression && options.compression[0])
+    {
+        spec.attribute("compression", options.compression);
+    }
+    if (options.color_space && options.color_space[0])
+    {
+        spec.attribute("oiio:ColorSpace", options.color_space);
+    }
+    if (options.tile_width > 0 && options.tile_height > 0)
+    {
+        spec.tile_width = options.tile_width;
+        spec.tile_height = options.tile_height;
+        spec.tile_depth = 1;
+    }
+    return true;
+}
 
-        if (rgba.has_error())
+// Source attributes that describe how the source was encoded rather than
+// the image itself. The output spec makes those choices for itself.
+bool is_encoding_attribute(OIIO::string_view name)
+{
+    static const char * const k_names[] = {
+        "compression",
+        "oiio:BitsPerSample",
+        "oiio:UnassociatedAlpha",
+        "oiio:subimages",
+        "planarconfig",
+        "openexr:chunkCount",
+        "openexr:lineOrder",
+        "openexr:dwaCompressionLevel",
+        "tiff:Compression",
+        "tiff:PhotometricInterpretation",
+        "tiff:PlanarConfiguration",
+        "tiff:RowsPerStrip",
+        "dpx:Packing",
+        "dpx:Encoding",
+    };
+    for (const char * n : k_names)
+    {
+        if (OIIO::Strutil::iequals(name, n))
         {
-            set_error(rgba.geterror().c_str());
-            return 0;
+            return true;
         }
+    }
+    return false;
+}
 
-        // Use the raw-pointer get_pixels overload.
-        OIIO::ROI roi = rgba.roi();
-        bool ok = rgba.get_pixels(roi, OIIO::TypeFloat, buf);
-        if (!ok)
+// Carry the metadata and windows of the decoded `source` into `spec`, an
+// output spec from make_output_spec: attributes the output spec already
+// sets win, and windows are scaled when the frame was downscaled. Formats
+// without data/display windows drop them in open_output.
+void merge_source_metadata(const OIIO::ImageSpec & source, OIIO::ImageSpec & spec)
+{
+    for (const OIIO::ParamValue & p : source.extra_attribs)
+    {
+        if (!is_encoding_attribute(p.name()) && !spec.find_attribute(p.name()))
         {
-            std::string err = rgba.geterror();
-            if (err.empty())
-            {
-                err = "get_pixels failed";
-            }
-            set_error(err.c_str());
-            return 0;
+            spec.attribute(p.name(), p.type(), p.data());
         }
+    }
+    if (source.width <= 0 || source.height <= 0)
+    {
+        return;
+    }
+    const double sx = static_cast<double>(spec.width) / source.width;
+    const double sy = static_cast<double>(spec.height) / source.height;
+    spec.x = static_cast<int>(std::lround(source.x * sx));
+    spec.y = static_cast<int>(std::lround(source.y * sy));
+    spec.full_x = static_cast<int>(std::lround(source.full_x * sx));
+    spec.full_y = static_cast<int>(std::lround(source.full_y * sy));
+    spec.full_width = std::max(1, static_cast<int>(std::lround(source.full_width * sx)));
+    spec.full_height = std::max(1, static_cast<int>(std::lround(source.full_height * sy)));
+}
 
-        return 1;
+// Create and open a writer for `path`. Formats without tile support fall
+// back to scanlines.
+std::unique_ptr<OIIO::ImageOutput> open_output(
+    const std::string & path,
+    OIIO::ImageSpec & spec,
+    int nthreads,
+    std::string & error)
+{
+    auto out = OIIO::ImageOutput::create(path);
+    if (!out)
+    {
+        error = OIIO::geterror();
+        if (error.empty())
+        {
+            error = "no image writer for: " + path;
+        }
+        return nullptr;
     }
-    catch (const std::exception & e)
+    if (spec.tile_width > 0 && !out->supports("tiles"))
     {
-        set_error(e.what());
-        return 0;
+        spec.tile_width = 0;
+        spec.tile_height = 0;
+        spec.tile_depth = 0;
+    }
+    if (!out->supports("origin"))
+    {
+        spec.x = 0;
+        spec.y = 0;
+    }
+    if (!out->supports("displaywindow"))
+    {
+        spec.full_x = spec.x;
+        spec.full_y = spec.y;
+        spec.full_width = spec.width;
+        spec.full_height = spec.height;
+    }
+    if (nthreads > 0)
+    {
+        out->threads(nthreads);
+    }
+    if (!out->open(path, spec))
+    {
+        error = out->geterror();
+        if (error.empty())
+        {
+            error = "failed to open for writing: " + path;
+        }
+        return nullptr;
+    }
+    return out;
+}
+
+void take_output_error(OIIO::ImageOutput & out, const char * fallback, std::string & error)
+{
+    error = out.geterror();
+    if (error.empty())
+    {
+        error = fallback;
+    }
+}
+
+// Write a whole RGBA frame (rows `row_stride` bytes apart). The alpha
+// channel is skipped through the pixel stride when the file is RGB.
+bool write_rgba_image(
+    OIIO::ImageOutput & out,
+    OIIO::TypeDesc src_type,
+    const void * data,
+    std::ptrdiff_t row_stride,
+    std::string & error)
+{
+    const std::ptrdiff_t xstride = static_cast<std::ptrdiff_t>(4 * src_type.size());
+    PerfScope scope(
+        perf(), OIIO_PERF_WRITE, rgba_bytes(src_type, out.spec().width, out.spec().height));
+    if (!out.write_image(src_type, data, xstride, row_stride))
+    {
+        take_output_error(out, "write_image failed", error);
+        return false;
+    }
+    return true;
+}
+
+// Encode a whole RGBA frame to `path`: open, write, close.
+bool write_rgba_file(
+    const std::string & path,
+    OIIO::ImageSpec & spec,
+    int nthreads,
+    OIIO::TypeDesc src_type,
+    const void * data,
+    std::ptrdiff_t row_stride,
+    std::string & error)
+{
+    auto out = open_output(path, spec, nthreads, error);
+    bool ok = out && write_rgba_image(*out, src_type, data, row_stride, error);
+    if (out && !out->close() && ok)
+    {
+        take_output_error(*out, "close failed", error);
+        ok = false;
+    }
+    return ok;
+}
+} // namespace
+
+// An open output file. Pixels come from caller RGBA f32/f16 buffers and are
+// converted to the file's bit depth by the writer, without staging copies.
+struct OiioImageOutput
+{
+    std::unique_ptr<OIIO::ImageOutput> output;
+    OIIO::ImageSpec spec;
+    std::mutex mutex;
+};
+
+// Background encoder with a fixed set of recycled staging buffers. The
+// caller acquires a free buffer, fills it (e.g. from a GPU readback) and
+// submits it; a writer thread encodes it while the caller renders the next
+// frame into another buffer.
+struct OiioAsyncWriter
+{
+    enum class BufferState
+    {
+        Free,
+        Acquired,
+        Queued,
+    };
+
+    struct Job
+    {
+        std::string path;
+        int width = 0;
+        int height = 0;
+        OIIO::TypeDesc src_type;
+        std::ptrdiff_t row_stride = 0;
+        OIIO::ImageSpec spec;
+    };
+
+    struct Buffer
+    {
+        std::vector<unsigned char> data;
+        BufferState state = BufferState::Free;
+        Job job;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Buffer> buffers;
+    std::deque<int> queue;
+    std::thread thread;
+    int threads = 0;
+    int busy = 0;
+    int failures = 0;
+    std::string first_error;
+    bool stop = false;
+
+    ~OiioAsyncWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
     }
+
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            // Drain queued jobs before honouring stop so no submitted frame
+            // is dropped on destroy.
+            cv.wait(lock, [&] { return stop || !queue.empty(); });
+            if (queue.empty())
+            {
+                return;
+            }
+            const int id = queue.front();
+            queue.pop_front();
+            ++busy;
+            Buffer & buffer = buffers[static_cast<size_t>(id)];
+            lock.unlock();
+
+            // The buffer is private to this thread while Queued.
+            std::string error;
+            Job & job = buffer.job;
+            const bool ok = write_rgba_file(
+                job.path, job.spec, threads, job.src_type, buffer.data.data(), job.row_stride,
+                error);
+
+            lock.lock();
+            --busy;
+            if (!ok)
+            {
+                if (failures++ == 0)
+                {
+                    first_error = job.path + ": " + error;
+                }
+            }
+            buffer.state = BufferState::Free;
+            cv.notify_all();
+        }
+    }
+};
+
+// Read-ahead / read-behind decoder for an image sequence. A fixed ring of
+// slots holds decoded RGBA frames around the playhead; background threads
+// fill the slot for the most urgent missing frame, recycling the buffer of
+// the resident frame farthest outside the window. Pinned frames (acquired
+// by the caller and not yet released) are never recycled.
+struct OiioSequence
+{
+    enum class SlotState
+    {
+        Empty,
+        Loading,
+        Ready,
+        Failed,
+    };
+
+    struct Slot
+    {
+        int frame = 0;
+        SlotState state = SlotState::Empty;
+        int pins = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<float> pixels;
+        std::string error;
+    };
+
+    std::string pattern;
+    int first_frame = 0;
+    int last_frame = 0;
+    int max_width = 0;
+    int max_height = 0;
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable ready_cv;
+    std::vector<Slot> slots;
+    std::vector<std::thread> threads;
+    int playhead = 0;
+    int direction = 1;
+    bool stop = false;
+
+    ~OiioSequence()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        work_cv.notify_all();
+        ready_cv.notify_all();
+        for (auto & t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    // Frames the ring should hold, most urgent first. Caller holds `mutex`.
+    std::vector<int> wanted_frames() const
+    {
+        const int span = static_cast<int>(slots.size()) - 1;
+        const int ahead = direction == 0 ? span / 2 : span - span / 4;
+        const int behind = span - ahead;
+        const int step = direction < 0 ? -1 : 1;
+
+        std::vector<int> frames;
+        frames.reserve(slots.size());
+        auto push = [&](int f)
+        {
+            if (f >= first_frame && f <= last_frame)
+            {
+                frames.push_back(f);
+            }
+        };
+        push(playhead);
+        for (int i = 1; i <= std::max(ahead, behind); ++i)
+        {
+            if (i <= ahead)
+            {
+                push(playhead + step * i);
+            }
+            if (i <= behind)
+            {
+                push(playhead - step * i);
+            }
+        }
+        return frames;
+    }
+
+    Slot * find_slot(int frame)
+    {
+        for (auto & slot : slots)
+        {
+            if (slot.state != SlotState::Empty && slot.frame == frame)
+            {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    // Pick the next frame to decode and the slot to decode it into. Caller
+    // holds `mutex`.
+    bool next_job(Slot *& target, int & frame)
+    {
+        const std::vector<int> wanted = wanted_frames();
+        for (int f : wanted)
+        {
+            if (find_slot(f))
+            {
+                continue;
+            }
+
+            Slot * victim = nullptr;
+            int victim_distance = -1;
+            for (auto & slot : slots)
+            {
+                if (slot.state == SlotState::Empty)
+                {
+                    victim = &slot;
+                    break;
+                }
+                if (slot.state == SlotState::Loading || slot.pins > 0
+                    || std::find(wanted.begin(), wanted.end(), slot.frame) != wanted.end())
+                {
+                    continue;
+                }
+                const int distance = std::abs(slot.frame - playhead);
+                if (distance > victim_distance)
+                {
+                    victim = &slot;
+                    victim_distance = distance;
+                }
+            }
+            if (!victim)
+            {
+                // Every slot holds a wanted, loading or pinned frame; less
+                // urgent frames cannot get one either.
+                return false;
+            }
+            target = victim;
+            frame = f;
+            return true;
+        }
+        return false;
+    }
+
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            Slot * slot = nullptr;
+            int frame = 0;
+            work_cv.wait(lock, [&] { return stop || next_job(slot, frame); });
+            if (stop)
+            {
+                return;
+            }
+
+            slot->frame = frame;
+            slot->state = SlotState::Loading;
+            slot->error.clear();
+            std::string path;
+            format_frame_path(pattern, frame, path);
+            lock.unlock();
+
+            // The slot is private to this thread while Loading.
+            std::string error;
+            int width = 0;
+            int height = 0;
+            const bool ok = decode_sequence_frame(
+                path,
+                max_width,
+                max_height,
+                slot->pixels,
+                width,
+                height,
+                error);
+
+            lock.lock();
+            slot->width = width;
+            slot->height = height;
+            slot->state = ok ? SlotState::Ready : SlotState::Failed;
+            slot->error = std::move(error);
+            ready_cv.notify_all();
+            // A finished frame may free up work for threads that found none.
+            work_cv.notify_all();
+        }
+    }
+};
+
+// ── Error ────────────────────────────────────────────────────────────────────
+
+extern "C" const char * oiio_get_last_error(void)
+{
+    return g_last_error.empty() ? nullptr : g_last_error.c_str();
+}
+
+// ── Threading ────────────────────────────────────────────────────────────────
+
+extern "C" void oiio_set_threads(int n)
+{
+    const int threads = std::max(0, n);
+    OIIO::attribute("threads", threads);
+    // OpenEXR decompresses through its own pool, sized separately.
+    OIIO::attribute("exr_threads", threads);
+}
+
+extern "C" int oiio_get_threads(void)
+{
+    int threads = 0;
+    OIIO::getattribute("threads", threads);
+    return threads;
+}
+
+extern "C" void oiio_image_input_set_threads(OiioImageInput * h, int n)
+{
+    if (!h)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(h->mutex);
+    h->threads = std::max(0, n);
+    if (h->input)
+    {
+        h->input->threads(h->threads);
+    }
+}
+
+extern "C" void oiio_image_stream_set_threads(OiioImageStream * h, int n)
+{
+    if (!h)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(h->mutex);
+    h->input->threads(std::max(0, n));
+}
+
+// ── ImageInput lifecycle ─────────────────────────────────────────────────────
+
+extern "C" OiioImageInput * oiio_image_input_open(const char * path)
+{
+    clear_error();
+    if (!path || !path[0])
+    {
+        set_error("oiio_image_input_open: empty path");
+        return nullptr;
+    }
+    try
+    {
+        PerfScope scope(perf(), OIIO_PERF_OPEN);
+        auto input = OIIO::ImageInput::open(path);
+        if (!input)
+        {
+            std::string err = OIIO::geterror();
+            if (err.empty())
+            {
+                err = "failed to read image: " + std::string(path);
+            }
+            set_error(err.c_str());
+            return nullptr;
+        }
+
+        auto h = new OiioImageInput;
+        h->spec = input->spec();
+        h->input = std::move(input);
+        // Cache the detected color space from the "oiio:ColorSpace" attribute.
+        h->color_space = h->spec.get_string_attribute("oiio:ColorSpace");
+        return h;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" OiioImageInput * oiio_image_input_open_cached(const char * path)
+{
+    clear_error();
+    if (!path || !path[0])
+    {
+        set_error("oiio_image_input_open_cached: empty path");
+        return nullptr;
+    }
+    try
+    {
+        PerfScope scope(perf(), OIIO_PERF_OPEN);
+        OIIO::ImageSpec spec;
+        if (!image_cache().get_imagespec(OIIO::ustring(path), spec, 0, 0))
+        {
+            set_cache_error("failed to read image");
+            return nullptr;
+        }
+
+        auto h = new OiioImageInput;
+        h->spec = std::move(spec);
+        h->cache_path = OIIO::ustring(path);
+        h->color_space = h->spec.get_string_attribute("oiio:ColorSpace");
+        return h;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_image_input_destroy(OiioImageInput * h)
+{
+    delete h;
+}
+
+// ── Spec queries ─────────────────────────────────────────────────────────────
+
+extern "C" int oiio_image_input_width(const OiioImageInput * h)
+{
+    return h ? h->spec.width : 0;
+}
+
+extern "C" int oiio_image_input_height(const OiioImageInput * h)
+{
+    return h ? h->spec.height : 0;
+}
+
+extern "C" int oiio_image_input_nchannels(const OiioImageInput * h)
+{
+    return h ? h->spec.nchannels : 0;
+}
+
+extern "C" int oiio_image_input_format(const OiioImageInput * h)
+{
+    if (!h)
+    {
+        return 0;
+    }
+    // Return the OIIO TypeDesc BASETYPE as an int.
+    return static_cast<int>(h->spec.format.basetype);
+}
+
+extern "C" const char * oiio_image_input_color_space(const OiioImageInput * h)
+{
+    if (!h || h->color_space.empty())
+    {
+        return nullptr;
+    }
+    return h->color_space.c_str();
+}
+
+// ── Probe ────────────────────────────────────────────────────────────────────
+
+namespace
+{
+void copy_truncated(const std::string & src, char * dst, size_t dst_len)
+{
+    const size_t n = std::min(src.size(), dst_len - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+// Upper bound on the subimage / MIP scan so a malformed file cannot stall a
+// folder scan.
+constexpr int k_max_probe_levels = 1024;
+} // namespace
+
+extern "C" int oiio_probe(const char * path, OiioProbeSpec * out)
+{
+    clear_error();
+    if (!path || !path[0] || !out)
+    {
+        set_error("oiio_probe: null argument");
+        return 0;
+    }
+    std::memset(out, 0, sizeof(*out));
+    try
+    {
+        PerfScope scope(perf(), OIIO_PERF_OPEN);
+        auto input = OIIO::ImageInput::open(path);
+        if (!input)
+        {
+            std::string err = OIIO::geterror();
+            if (err.empty())
+            {
+                err = "failed to read image: " + std::string(path);
+            }
+            set_error(err.c_str());
+            return 0;
+        }
+
+        const OIIO::ImageSpec & spec = input->spec();
+        out->width = spec.width;
+        out->height = spec.height;
+        out->nchannels = spec.nchannels;
+        out->format = static_cast<int>(spec.format.basetype);
+        out->bits_per_sample = spec.get_int_attribute("oiio:BitsPerSample", 0);
+        out->tile_width = spec.tile_width;
+        out->tile_height = spec.tile_height;
+        copy_truncated(
+            spec.get_string_attribute("oiio:ColorSpace"),
+            out->color_space,
+            sizeof(out->color_space));
+        copy_truncated(input->format_name(), out->format_name, sizeof(out->format_name));
+
+        // Seeking only parses headers; the MIP scan leaves subimage 0 current.
+        int subimages = 1;
+        while (subimages < k_max_probe_levels && input->seek_subimage(subimages, 0))
+        {
+            ++subimages;
+        }
+        int miplevels = 1;
+        while (miplevels < k_max_probe_levels && input->seek_subimage(0, miplevels))
+        {
+            ++miplevels;
+        }
+        out->subimages = subimages;
+        out->miplevels = miplevels;
+        // Failed seeks past the last level leave an error on the input.
+        (void)input->geterror();
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+// ── Pixel reading ────────────────────────────────────────────────────────────
+
+extern "C" int oiio_image_input_read_rgba_f32(
+    const OiioImageInput * h,
+    float * buf,
+    int buf_len)
+{
+    clear_error();
+    if (!h || !buf)
+    {
+        set_error("oiio_image_input_read_rgba_f32: null argument");
+        return 0;
+    }
+
+    const size_t required = static_cast<size_t>(h->spec.width) * h->spec.height * 4;
+    if (buf_len < 0 || static_cast<size_t>(buf_len) < required)
+    {
+        set_error("oiio_image_input_read_rgba_f32: buffer too small");
+        return 0;
+    }
+
+    try
+    {
+        if (!h->input)
+        {
+            const bool ok = read_rgba_cached(
+                h->cache_path,
+                h->spec,
+                0,
+                OIIO::TypeFloat,
+                buf,
+                packed_rgba_row(h->spec.width));
+            return ok ? 1 : 0;
+        }
+
+        std::lock_guard<std::mutex> lock(h->mutex);
+        if (!read_rgba_image(
+                *h->input, h->spec, 0, 0, OIIO::TypeFloat, buf, packed_rgba_row(h->spec.width)))
+        {
+            set_input_error(*h->input, "read_image failed");
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_input_fit_size(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    int * out_width,
+    int * out_height)
+{
+    clear_error();
+    if (!h || !out_width || !out_height)
+    {
+        set_error("oiio_image_input_fit_size: null argument");
+        return 0;
+    }
+    fit_dimensions(h->spec.width, h->spec.height, max_width, max_height, *out_width, *out_height);
+    return 1;
+}
+
+extern "C" int oiio_image_input_read_rgba_f32_fit(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    float * buf,
+    int buf_len)
+{
+    if (buf_len < 0)
+    {
+        clear_error();
+        set_error("oiio_image_input_read_rgba_f32_fit: buffer too small");
+        return 0;
+    }
+    return oiio_image_input_read_rgba_f32_into(
+        h, max_width, max_height, buf, static_cast<size_t>(buf_len) * sizeof(float), 0);
+}
+
+extern "C" int oiio_image_input_read_rgba_f32_into(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    void * dst,
+    size_t dst_bytes,
+    ptrdiff_t row_stride)
+{
+    return oiio_image_input_read_rgba_into(
+        h, max_width, max_height, OIIO_PIXEL_F32, dst, dst_bytes, row_stride);
+}
+
+extern "C" int oiio_image_input_read_rgba_f16(
+    const OiioImageInput * h,
+    uint16_t * buf,
+    size_t buf_len)
+{
+    return oiio_image_input_read_rgba_into(
+        h, 0, 0, OIIO_PIXEL_F16, buf, buf_len * sizeof(uint16_t), 0);
+}
+
+extern "C" int oiio_image_input_read_rgba_into(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    int pixel_format,
+    void * dst,
+    size_t dst_bytes,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    OIIO::TypeDesc type;
+    if (!h || !dst || !pixel_type(pixel_format, type))
+    {
+        set_error("oiio_image_input_read_rgba_into: invalid argument");
+        return 0;
+    }
+
+    int out_w = 0;
+    int out_h = 0;
+    fit_dimensions(h->spec.width, h->spec.height, max_width, max_height, out_w, out_h);
+    if (out_w <= 0 || out_h <= 0)
+    {
+        set_error("oiio_image_input_read_rgba_into: image has zero dimensions");
+        return 0;
+    }
+    const std::ptrdiff_t packed_row = rgba_pixel_bytes(type) * out_w;
+    if (row_stride == 0)
+    {
+        row_stride = packed_row;
+    }
+    const std::ptrdiff_t elem = static_cast<std::ptrdiff_t>(type.size());
+    if (row_stride < packed_row || row_stride % elem != 0
+        || reinterpret_cast<std::uintptr_t>(dst) % elem != 0)
+    {
+        set_error("oiio_image_input_read_rgba_into: invalid row stride or alignment");
+        return 0;
+    }
+    const size_t required =
+        static_cast<size_t>(row_stride) * (out_h - 1) + static_cast<size_t>(packed_row);
+    if (dst_bytes < required)
+    {
+        set_error("oiio_image_input_read_rgba_into: buffer too small");
+        return 0;
+    }
+
+    try
+    {
+        const int nthreads = h->threads;
+        if (!h->input)
+        {
+            return read_rgba_fit_cached(
+                       h->cache_path, h->spec, out_w, out_h, type, dst, row_stride, nthreads)
+                       ? 1
+                       : 0;
+        }
+
+        std::lock_guard<std::mutex> lock(h->mutex);
+        return read_rgba_fit(*h->input, h->spec, out_w, out_h, type, dst, row_stride, nthreads)
+                   ? 1
+                   : 0;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+// ── Subimages and layers ─────────────────────────────────────────────────────
+
+namespace
+{
+// Headers of every subimage of `h`, scanned on the first call. The caller
+// holds `h.mutex`.
+const std::vector<OIIO::ImageSpec> & subimage_specs(const OiioImageInput & h)
+{
+    if (h.subimages_scanned)
+    {
+        return h.subimages;
+    }
+    h.subimages_scanned = true;
+    PerfScope scope(perf(), OIIO_PERF_OPEN);
+    for (int s = 0; s < k_max_probe_levels; ++s)
+    {
+        OIIO::ImageSpec spec;
+        if (h.input)
+        {
+            spec = h.input->spec(s, 0);
+        }
+        else if (!image_cache().get_imagespec(h.cache_path, spec, s, 0))
+        {
+            break;
+        }
+        if (spec.format == OIIO::TypeUnknown || spec.nchannels <= 0)
+        {
+            break;
+        }
+        h.subimages.push_back(std::move(spec));
+    }
+    // Looking up the subimage past the last one leaves an error behind.
+    if (h.input)
+    {
+        (void)h.input->geterror();
+    }
+    else
+    {
+        (void)image_cache().geterror();
+    }
+    return h.subimages;
+}
+
+// Channels of `layer` in `spec`, in RGBA slot order, written to `out`;
+// returns how many (0 when `spec` has none of them). A part named `layer`
+// stands for its unprefixed channels.
+int layer_channels(const OIIO::ImageSpec & spec, const std::string & layer, int (&out)[4])
+{
+    std::string prefix = layer.empty() ? std::string() : layer + ".";
+    if (!layer.empty() && spec.get_string_attribute("oiio:subimagename") == layer)
+    {
+        bool prefixed = false;
+        for (const std::string & name : spec.channelnames)
+        {
+            prefixed = prefixed || name.compare(0, prefix.size(), prefix) == 0;
+        }
+        if (!prefixed)
+        {
+            prefix.clear();
+        }
+    }
+
+    // Upper-cased channel name within the layer and its index in the file.
+    std::vector<std::pair<std::string, int>> members;
+    for (int c = 0; c < spec.nchannels && c < static_cast<int>(spec.channelnames.size()); ++c)
+    {
+        const std::string & name = spec.channelnames[c];
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0
+            || name.find('.', prefix.size()) != std::string::npos)
+        {
+            continue;
+        }
+        std::string suffix = name.substr(prefix.size());
+        for (char & ch : suffix)
+        {
+            ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        }
+        members.emplace_back(std::move(suffix), c);
+    }
+    auto find = [&](const char * suffix) {
+        for (const auto & member : members)
+        {
+            if (member.first == suffix)
+            {
+                return member.second;
+            }
+        }
+        return -1;
+    };
+
+    const int r = find("R");
+    const int g = find("G");
+    const int b = find("B");
+    const int a = find("A");
+    const int x = find("X");
+    const int y = find("Y");
+    const int z = find("Z");
+    int n = 0;
+    if (r >= 0 && g >= 0 && b >= 0)
+    {
+        out[n++] = r;
+        out[n++] = g;
+        out[n++] = b;
+        if (a >= 0)
+        {
+            out[n++] = a;
+        }
+    }
+    else if (x >= 0 && y >= 0 && z >= 0)
+    {
+        out[n++] = x;
+        out[n++] = y;
+        out[n++] = z;
+    }
+    else if (y >= 0)
+    {
+        out[n++] = y;
+        if (a >= 0)
+        {
+            out[n++] = a;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < members.size() && n < 4; ++i)
+        {
+            out[n++] = members[i].second;
+        }
+    }
+    return n;
+}
+
+// Read channels [chbegin, chend) of `subimage` as floats starting at the
+// first slot of each RGBA f32 pixel of `dst`. Sets the error on failure.
+bool read_channel_range(
+    const OiioImageInput & h,
+    int subimage,
+    const OIIO::ImageSpec & spec,
+    int chbegin,
+    int chend,
+    float * dst,
+    std::ptrdiff_t ystride)
+{
+    const std::uint64_t bytes = static_cast<std::uint64_t>(spec.width) * spec.height
+                                * (chend - chbegin) * sizeof(float);
+    if (!h.input)
+    {
+        PerfScope read(perf(), OIIO_PERF_CACHE_READ, bytes);
+        const bool ok = image_cache().get_pixels(
+            h.cache_path,
+            subimage,
+            0,
+            spec.x,
+            spec.x + spec.width,
+            spec.y,
+            spec.y + spec.height,
+            spec.z,
+            spec.z + std::max(1, spec.depth),
+            chbegin,
+            chend,
+            OIIO::TypeFloat,
+            dst,
+            k_rgba_pixel_bytes,
+            ystride,
+            OIIO::AutoStride,
+            // Cache tiles of the layer only, not of every channel.
+            chbegin,
+            chend);
+        read.finish();
+        if (!ok)
+        {
+            set_cache_error("ImageCache::get_pixels failed");
+        }
+        return ok;
+    }
+
+    std::lock_guard<std::mutex> lock(h.mutex);
+    PerfScope decode(perf(), OIIO_PERF_DECODE, bytes);
+    const bool ok = h.input->read_image(
+        subimage, 0, chbegin, chend, OIIO::TypeFloat, dst, k_rgba_pixel_bytes, ystride);
+    decode.finish();
+    if (!ok)
+    {
+        set_input_error(*h.input, "read_image failed");
+    }
+    return ok;
+}
+
+// Reorder RGBA f32 pixels read as channels [first, first + 4) so slot i
+// holds file channel `channels[i]`.
+void permute_layer_slots(
+    float * rgba,
+    int width,
+    int rows,
+    std::ptrdiff_t ystride,
+    const int * channels,
+    int count,
+    int first)
+{
+    bool identity = true;
+    for (int i = 0; i < count; ++i)
+    {
+        identity = identity && channels[i] == first + i;
+    }
+    if (identity)
+    {
+        return;
+    }
+    for (int y = 0; y < rows; ++y)
+    {
+        float * px = reinterpret_cast<float *>(reinterpret_cast<char *>(rgba) + y * ystride);
+        for (int x = 0; x < width; ++x, px += 4)
+        {
+            float read[4] = {px[0], px[1], px[2], px[3]};
+            for (int i = 0; i < count; ++i)
+            {
+                px[i] = read[channels[i] - first];
+            }
+        }
+    }
+}
+} // namespace
+
+extern "C" int oiio_image_input_subimage_count(const OiioImageInput * h)
+{
+    clear_error();
+    if (!h)
+    {
+        set_error("oiio_image_input_subimage_count: null argument");
+        return -1;
+    }
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        return static_cast<int>(subimage_specs(*h).size());
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" int oiio_image_input_subimage_spec(
+    const OiioImageInput * h,
+    int subimage,
+    OiioSubimageSpec * out)
+{
+    clear_error();
+    if (!h || !out || subimage < 0)
+    {
+        set_error("oiio_image_input_subimage_spec: invalid argument");
+        return 0;
+    }
+    std::memset(out, 0, sizeof(*out));
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        const std::vector<OIIO::ImageSpec> & specs = subimage_specs(*h);
+        if (subimage >= static_cast<int>(specs.size()))
+        {
+            set_error("oiio_image_input_subimage_spec: subimage out of range");
+            return 0;
+        }
+        const OIIO::ImageSpec & spec = specs[subimage];
+        out->width = spec.width;
+        out->height = spec.height;
+        out->nchannels = spec.nchannels;
+        out->format = static_cast<int>(spec.format.basetype);
+        copy_truncated(
+            spec.get_string_attribute("oiio:subimagename"), out->name, sizeof(out->name));
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" const char * oiio_image_input_channel_name(
+    const OiioImageInput * h,
+    int subimage,
+    int channel)
+{
+    if (!h || subimage < 0 || channel < 0)
+    {
+        return nullptr;
+    }
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        const std::vector<OIIO::ImageSpec> & specs = subimage_specs(*h);
+        if (subimage >= static_cast<int>(specs.size())
+            || channel >= static_cast<int>(specs[subimage].channelnames.size()))
+        {
+            return nullptr;
+        }
+        // The scanned headers never change, so the name outlives the lock.
+        return specs[subimage].channelnames[channel].c_str();
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+extern "C" int oiio_image_input_find_layer(const OiioImageInput * h, const char * layer)
+{
+    clear_error();
+    if (!h || !layer)
+    {
+        set_error("oiio_image_input_find_layer: null argument");
+        return -1;
+    }
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        const std::vector<OIIO::ImageSpec> & specs = subimage_specs(*h);
+        int channels[4];
+        for (size_t s = 0; s < specs.size(); ++s)
+        {
+            if (layer_channels(specs[s], layer, channels) > 0)
+            {
+                return static_cast<int>(s);
+            }
+        }
+        set_error(("oiio_image_input_find_layer: no layer named \"" + std::string(layer) + "\"")
+                      .c_str());
+        return -1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return -1;
+    }
+}
+
+extern "C" int oiio_image_input_read_layer_rgba_f32(
+    const OiioImageInput * h,
+    int subimage,
+    const char * layer,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    if (!h || !layer || !buf || subimage < 0)
+    {
+        set_error("oiio_image_input_read_layer_rgba_f32: invalid argument");
+        return 0;
+    }
+
+    try
+    {
+        // Copied out so cached reads do not hold the handle lock.
+        OIIO::ImageSpec spec;
+        {
+            std::lock_guard<std::mutex> lock(h->mutex);
+            const std::vector<OIIO::ImageSpec> & specs = subimage_specs(*h);
+            if (subimage >= static_cast<int>(specs.size()))
+            {
+                set_error("oiio_image_input_read_layer_rgba_f32: subimage out of range");
+                return 0;
+            }
+            spec = specs[subimage];
+        }
+
+        int channels[4];
+        const int count = layer_channels(spec, layer, channels);
+        if (count == 0)
+        {
+            set_error(("oiio_image_input_read_layer_rgba_f32: no layer named \""
+                       + std::string(layer) + "\" in subimage " + std::to_string(subimage))
+                          .c_str());
+            return 0;
+        }
+        if (spec.width <= 0 || spec.height <= 0)
+        {
+            set_error("oiio_image_input_read_layer_rgba_f32: image has zero dimensions");
+            return 0;
+        }
+        std::ptrdiff_t xstride = k_rgba_pixel_bytes;
+        if (!resolve_float_strides(spec.width, spec.height, 4, buf_len, xstride, row_stride))
+        {
+            set_error("oiio_image_input_read_layer_rgba_f32: buffer too small or bad stride");
+            return 0;
+        }
+
+        const int first = *std::min_element(channels, channels + count);
+        const int span = *std::max_element(channels, channels + count) - first + 1;
+        if (span <= 4)
+        {
+            // One ranged read covers the layer; EXR sorts channels by name (A
+            // before B), so put each pixel's samples into slot order after.
+            if (!read_channel_range(*h, subimage, spec, first, first + span, buf, row_stride))
+            {
+                return 0;
+            }
+            permute_layer_slots(buf, spec.width, spec.height, row_stride, channels, count, first);
+        }
+        else
+        {
+            // Other channels sit between the layer's: read each into its slot.
+            for (int i = 0; i < count; ++i)
+            {
+                if (!read_channel_range(
+                        *h, subimage, spec, channels[i], channels[i] + 1, buf + i, row_stride))
+                {
+                    return 0;
+                }
+            }
+        }
+        expand_to_rgba(buf, OIIO::TypeFloat, spec.width, spec.height, row_stride, count);
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+// ── Shared image cache ───────────────────────────────────────────────────────
+
+extern "C" int oiio_image_cache_configure(float max_memory_mb, int max_open_files)
+{
+    clear_error();
+    auto & cache = image_cache();
+    bool ok = true;
+    if (max_memory_mb > 0.0f)
+    {
+        ok = cache.attribute("max_memory_MB", max_memory_mb) && ok;
+    }
+    if (max_open_files > 0)
+    {
+        ok = cache.attribute("max_open_files", max_open_files) && ok;
+    }
+    if (!ok)
+    {
+        set_cache_error("oiio_image_cache_configure: attribute rejected");
+        return 0;
+    }
+    return 1;
+}
+
+extern "C" void oiio_image_cache_get_stats(OiioImageCacheStats * out)
+{
+    if (!out)
+    {
+        return;
+    }
+
+    const auto & cache = image_cache();
+    // 64-bit statistics are only readable through the TypeDesc overload.
+    long long find_tile_calls = 0;
+    long long bytes_read = 0;
+    long long memory_used = 0;
+    int tile_misses = 0;
+    int tiles_created = 0;
+    int tiles_current = 0;
+    int open_files = 0;
+    float max_memory_mb = 0.0f;
+    int max_open_files = 0;
+    cache.getattribute("stat:find_tile_calls", OIIO::TypeInt64, &find_tile_calls);
+    cache.getattribute("stat:find_tile_cache_misses", tile_misses);
+    cache.getattribute("stat:bytes_read", OIIO::TypeInt64, &bytes_read);
+    cache.getattribute("stat:cache_memory_used", OIIO::TypeInt64, &memory_used);
+    cache.getattribute("stat:tiles_created", tiles_created);
+    cache.getattribute("stat:tiles_current", tiles_current);
+    cache.getattribute("stat:open_files_current", open_files);
+    cache.getattribute("max_memory_MB", max_memory_mb);
+    cache.getattribute("max_open_files", max_open_files);
+
+    out->hits = static_cast<unsigned long long>(std::max(0LL, find_tile_calls - tile_misses));
+    out->misses = static_cast<unsigned long long>(std::max(0, tile_misses));
+    out->bytes_read = static_cast<unsigned long long>(std::max(0LL, bytes_read));
+    // Tiles that were created but are no longer resident were evicted (or
+    // dropped by oiio_image_cache_invalidate).
+    out->evictions = static_cast<unsigned long long>(std::max(0, tiles_created - tiles_current));
+    out->memory_used = static_cast<unsigned long long>(std::max(0LL, memory_used));
+    out->tiles_current = tiles_current;
+    out->open_files = open_files;
+    out->max_memory_mb = max_memory_mb;
+    out->max_open_files = max_open_files;
+}
+
+extern "C" void oiio_image_cache_reset_stats(void)
+{
+    image_cache().reset_stats();
+}
+
+extern "C" void oiio_image_cache_invalidate(const char * path)
+{
+    if (path && path[0])
+    {
+        image_cache().invalidate(OIIO::ustring(path), true);
+    }
+    else
+    {
+        image_cache().invalidate_all(true);
+    }
+}
+
+// ── Instrumentation ──────────────────────────────────────────────────────────
+
+extern "C" void oiio_perf_set_enabled(int enabled)
+{
+    perf().set_enabled(enabled != 0);
+}
+
+extern "C" int oiio_perf_is_enabled(void)
+{
+    return perf().enabled() ? 1 : 0;
+}
+
+extern "C" void oiio_perf_set_callback(OiioPerfCallback callback, void * user)
+{
+    perf().set_callback(callback, user);
+}
+
+extern "C" void oiio_perf_get_stats(OiioPerfStats * out)
+{
+    if (!out)
+    {
+        return;
+    }
+
+    for (int stage = 0; stage < OIIO_PERF_STAGE_COUNT; ++stage)
+    {
+        const auto snapshot = perf().snapshot(stage);
+        out->stages[stage].calls = snapshot.calls;
+        out->stages[stage].nanoseconds = snapshot.nanoseconds;
+        out->stages[stage].bytes = snapshot.bytes;
+    }
+}
+
+extern "C" void oiio_perf_reset(void)
+{
+    perf().reset();
+}
+
+extern "C" const char * oiio_perf_stage_name(int stage)
+{
+    switch (stage)
+    {
+    case OIIO_PERF_OPEN:
+        return "open";
+    case OIIO_PERF_DECODE:
+        return "decode";
+    case OIIO_PERF_CACHE_READ:
+        return "cache_read";
+    case OIIO_PERF_CHANNEL_EXPAND:
+        return "channel_expand";
+    case OIIO_PERF_RESIZE:
+        return "resize";
+    case OIIO_PERF_WRITE:
+        return "write";
+    default:
+        return nullptr;
+    }
+}
+
+// ── Streaming reader ─────────────────────────────────────────────────────────
+
+extern "C" OiioImageStream * oiio_image_stream_open(const char * path)
+{
+    clear_error();
+    if (!path || !path[0])
+    {
+        set_error("oiio_image_stream_open: empty path");
+        return nullptr;
+    }
+    try
+    {
+        PerfScope scope(perf(), OIIO_PERF_OPEN);
+        auto input = OIIO::ImageInput::open(path);
+        if (!input)
+        {
+            std::string err = OIIO::geterror();
+            if (err.empty())
+            {
+                err = "failed to open image: " + std::string(path);
+            }
+            set_error(err.c_str());
+            return nullptr;
+        }
+
+        auto h = new OiioImageStream;
+        h->spec = input->spec();
+        h->input = std::move(input);
+        h->color_space = h->spec.get_string_attribute("oiio:ColorSpace");
+        return h;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_image_stream_destroy(OiioImageStream * h)
+{
+    delete h;
+}
+
+extern "C" int oiio_image_stream_width(const OiioImageStream * h)
+{
+    return h ? h->spec.width : 0;
+}
+
+extern "C" int oiio_image_stream_height(const OiioImageStream * h)
+{
+    return h ? h->spec.height : 0;
+}
+
+extern "C" int oiio_image_stream_nchannels(const OiioImageStream * h)
+{
+    return h ? h->spec.nchannels : 0;
+}
+
+extern "C" int oiio_image_stream_format(const OiioImageStream * h)
+{
+    return h ? static_cast<int>(h->spec.format.basetype) : 0;
+}
+
+extern "C" int oiio_image_stream_tile_width(const OiioImageStream * h)
+{
+    return h ? h->spec.tile_width : 0;
+}
+
+extern "C" int oiio_image_stream_tile_height(const OiioImageStream * h)
+{
+    return h ? h->spec.tile_height : 0;
+}
+
+extern "C" const char * oiio_image_stream_color_space(const OiioImageStream * h)
+{
+    if (!h || h->color_space.empty())
+    {
+        return nullptr;
+    }
+    return h->color_space.c_str();
+}
+
+extern "C" int oiio_image_stream_read_scanlines(
+    OiioImageStream * h,
+    int ybegin,
+    int yend,
+    int chbegin,
+    int chend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t xstride,
+    ptrdiff_t ystride)
+{
+    clear_error();
+    if (!h || !buf || ybegin < 0 || yend > h->spec.height || ybegin >= yend || chbegin < 0
+        || chend > h->spec.nchannels || chbegin >= chend)
+    {
+        set_error("oiio_image_stream_read_scanlines: invalid region");
+        return 0;
+    }
+    if (!resolve_float_strides(
+            h->spec.width, yend - ybegin, chend - chbegin, buf_len, xstride, ystride))
+    {
+        set_error("oiio_image_stream_read_scanlines: buffer too small");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        PerfScope scope(
+            perf(),
+            OIIO_PERF_DECODE,
+            static_cast<std::uint64_t>(h->spec.width) * (yend - ybegin) * (chend - chbegin)
+                * sizeof(float));
+        const bool ok = h->input->read_scanlines(
+            0,
+            0,
+            h->spec.y + ybegin,
+            h->spec.y + yend,
+            h->spec.z,
+            chbegin,
+            chend,
+            OIIO::TypeFloat,
+            buf,
+            xstride,
+            ystride);
+        if (!ok)
+        {
+            set_input_error(*h->input, "read_scanlines failed");
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_stream_read_tiles(
+    OiioImageStream * h,
+    int xbegin,
+    int xend,
+    int ybegin,
+    int yend,
+    int chbegin,
+    int chend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t xstride,
+    ptrdiff_t ystride)
+{
+    clear_error();
+    if (!h || !buf || xbegin < 0 || xend > h->spec.width || xbegin >= xend || ybegin < 0
+        || yend > h->spec.height || ybegin >= yend || chbegin < 0 || chend > h->spec.nchannels
+        || chbegin >= chend)
+    {
+        set_error("oiio_image_stream_read_tiles: invalid region");
+        return 0;
+    }
+    if (h->spec.tile_width <= 0 || h->spec.tile_height <= 0)
+    {
+        set_error("oiio_image_stream_read_tiles: image is not tiled");
+        return 0;
+    }
+    if (!resolve_float_strides(
+            xend - xbegin, yend - ybegin, chend - chbegin, buf_len, xstride, ystride))
+    {
+        set_error("oiio_image_stream_read_tiles: buffer too small");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        PerfScope scope(
+            perf(),
+            OIIO_PERF_DECODE,
+            static_cast<std::uint64_t>(xend - xbegin) * (yend - ybegin) * (chend - chbegin)
+                * sizeof(float));
+        const bool ok = h->input->read_tiles(
+            0,
+            0,
+            h->spec.x + xbegin,
+            h->spec.x + xend,
+            h->spec.y + ybegin,
+            h->spec.y + yend,
+            h->spec.z,
+            h->spec.z + std::max(1, h->spec.depth),
+            chbegin,
+            chend,
+            OIIO::TypeFloat,
+            buf,
+            xstride,
+            ystride);
+        if (!ok)
+        {
+            set_input_error(*h->input, "read_tiles failed");
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_stream_read_rgba_f32(
+    OiioImageStream * h,
+    int ybegin,
+    int yend,
+    float * buf,
+    size_t buf_len)
+{
+    clear_error();
+    if (!h || !buf || ybegin < 0 || yend > h->spec.height || ybegin >= yend)
+    {
+        set_error("oiio_image_stream_read_rgba_f32: invalid region");
+        return 0;
+    }
+    const size_t required = static_cast<size_t>(yend - ybegin) * h->spec.width * 4;
+    if (buf_len < required)
+    {
+        set_error("oiio_image_stream_read_rgba_f32: buffer too small");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        if (!read_rgba_rows(*h->input, h->spec, 0, 0, ybegin, yend, buf))
+        {
+            set_input_error(*h->input, "read_scanlines failed");
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+// ── Raw mapped reader ────────────────────────────────────────────────────────
+
+struct OiioRawImage
+{
+    std::unique_ptr<crispen::MappedFile> file;
+    crispen::RawLayout layout;
+};
+
+namespace
+{
+int raw_format(crispen::RawSample sample)
+{
+    switch (sample)
+    {
+    case crispen::RawSample::U8:
+        return OIIO::TypeDesc::UINT8;
+    case crispen::RawSample::U16:
+        return OIIO::TypeDesc::UINT16;
+    case crispen::RawSample::F16:
+        return OIIO::TypeDesc::HALF;
+    case crispen::RawSample::F32:
+        return OIIO::TypeDesc::FLOAT;
+    default:
+        return OIIO::TypeDesc::UINT32;
+    }
+}
+
+int raw_packing(crispen::RawSample sample)
+{
+    switch (sample)
+    {
+    case crispen::RawSample::U10FilledA:
+        return OIIO_RAW_PACKING_10BIT_FILLED_A;
+    case crispen::RawSample::U10FilledB:
+        return OIIO_RAW_PACKING_10BIT_FILLED_B;
+    default:
+        return OIIO_RAW_PACKING_NONE;
+    }
+}
+} // namespace
+
+extern "C" OiioRawImage * oiio_raw_image_open(const char * path)
+{
+    clear_error();
+    if (!path || !path[0])
+    {
+        set_error("oiio_raw_image_open: empty path");
+        return nullptr;
+    }
+    try
+    {
+        PerfScope scope(perf(), OIIO_PERF_OPEN);
+        auto file = crispen::MappedFile::open(path);
+        if (!file)
+        {
+            set_error(("failed to map image: " + std::string(path)).c_str());
+            return nullptr;
+        }
+
+        crispen::RawLayout layout;
+        if (const char * why = crispen::parse_raw_layout(file->data(), file->size(), layout))
+        {
+            set_error(("no raw fast path for " + std::string(path) + ": " + why).c_str());
+            return nullptr;
+        }
+
+        auto h = new OiioRawImage;
+        h->file = std::move(file);
+        h->layout = layout;
+        return h;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_raw_image_destroy(OiioRawImage * h)
+{
+    delete h;
+}
+
+extern "C" int oiio_raw_image_layout(const OiioRawImage * h, OiioRawLayout * out)
+{
+    clear_error();
+    if (!h || !out)
+    {
+        set_error("oiio_raw_image_layout: null argument");
+        return 0;
+    }
+    const crispen::RawLayout & layout = h->layout;
+    std::memset(out, 0, sizeof(*out));
+    out->width = layout.width;
+    out->height = layout.height;
+    out->nchannels = layout.nchannels;
+    out->format = raw_format(layout.sample);
+    out->bits_per_sample = layout.bits_per_sample;
+    out->packing = raw_packing(layout.sample);
+    out->big_endian = layout.big_endian ? 1 : 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        out->channel_order[c] = c < layout.nchannels ? layout.channel_order[c] : -1;
+    }
+    out->pixel_stride = layout.pixel_stride;
+    out->channel_stride = layout.channel_stride;
+    out->row_stride = layout.row_stride;
+    copy_truncated(layout.format_name, out->format_name, sizeof(out->format_name));
+    return 1;
+}
+
+extern "C" const void * oiio_raw_image_data(const OiioRawImage * h, size_t * out_len)
+{
+    if (!h)
+    {
+        return nullptr;
+    }
+    if (out_len)
+    {
+        *out_len = crispen::raw_data_bytes(h->layout);
+    }
+    return h->file->data() + h->layout.data_offset;
+}
+
+extern "C" int oiio_raw_image_read_rgba_f32(
+    const OiioRawImage * h,
+    int ybegin,
+    int yend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    if (!h || !buf || ybegin < 0 || yend > h->layout.height || ybegin >= yend)
+    {
+        set_error("oiio_raw_image_read_rgba_f32: invalid region");
+        return 0;
+    }
+    const int width = h->layout.width;
+    std::ptrdiff_t xstride = k_rgba_pixel_bytes;
+    if (!resolve_float_strides(width, yend - ybegin, 4, buf_len, xstride, row_stride)
+        || xstride != k_rgba_pixel_bytes)
+    {
+        set_error("oiio_raw_image_read_rgba_f32: buffer too small or misaligned stride");
+        return 0;
+    }
+
+    // No lock: the mapping and layout never change after open. Page faults
+    // on first touch stand in for the decoder's file reads.
+    PerfScope decode(perf(), OIIO_PERF_DECODE, rgba_bytes(OIIO::TypeFloat, width, yend - ybegin));
+    crispen::convert_raw_rows(h->layout, h->file->data(), ybegin, yend, buf, row_stride);
+    decode.finish();
+    expand_to_rgba(buf, OIIO::TypeFloat, width, yend - ybegin, row_stride, h->layout.nchannels);
+    return 1;
+}
+
+// ── Sequence prefetch ────────────────────────────────────────────────────────
+
+extern "C" OiioSequence * oiio_sequence_create(
+    const char * pattern,
+    int first_frame,
+    int last_frame,
+    int ring_size,
+    int num_threads,
+    int max_width,
+    int max_height)
+{
+    clear_error();
+    std::string probe;
+    if (!pattern || !format_frame_path(pattern, first_frame, probe))
+    {
+        set_error("oiio_sequence_create: pattern needs a '#' or %0Nd frame token");
+        return nullptr;
+    }
+    if (last_frame < first_frame || ring_size < 1)
+    {
+        set_error("oiio_sequence_create: invalid frame range or ring size");
+        return nullptr;
+    }
+
+    try
+    {
+        auto seq = std::make_unique<OiioSequence>();
+        seq->pattern = pattern;
+        seq->first_frame = first_frame;
+        seq->last_frame = last_frame;
+        seq->max_width = max_width;
+        seq->max_height = max_height;
+        seq->playhead = first_frame;
+        seq->slots.resize(static_cast<size_t>(ring_size));
+
+        int threads = num_threads;
+        if (threads <= 0)
+        {
+            const unsigned hw = std::thread::hardware_concurrency();
+            threads = std::max(1, std::min(static_cast<int>(hw), 4));
+        }
+        threads = std::min(threads, ring_size);
+        for (int i = 0; i < threads; ++i)
+        {
+            OiioSequence * raw = seq.get();
+            seq->threads.emplace_back([raw] { raw->worker_loop(); });
+        }
+        return seq.release();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_sequence_destroy(OiioSequence * seq)
+{
+    delete seq;
+}
+
+extern "C" void oiio_sequence_set_playhead(OiioSequence * seq, int frame, int direction)
+{
+    if (!seq)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(seq->mutex);
+        seq->playhead = std::min(std::max(frame, seq->first_frame), seq->last_frame);
+        seq->direction = direction > 0 ? 1 : (direction < 0 ? -1 : 0);
+    }
+    seq->work_cv.notify_all();
+    // Waiters for frames that just fell out of the window should give up.
+    seq->ready_cv.notify_all();
+}
+
+extern "C" int oiio_sequence_frame_status(OiioSequence * seq, int frame)
+{
+    if (!seq)
+    {
+        return OIIO_FRAME_ABSENT;
+    }
+    std::lock_guard<std::mutex> lock(seq->mutex);
+    const OiioSequence::Slot * slot = seq->find_slot(frame);
+    if (!slot)
+    {
+        return OIIO_FRAME_ABSENT;
+    }
+    switch (slot->state)
+    {
+    case OiioSequence::SlotState::Loading:
+        return OIIO_FRAME_LOADING;
+    case OiioSequence::SlotState::Ready:
+        return OIIO_FRAME_READY;
+    case OiioSequence::SlotState::Failed:
+        return OIIO_FRAME_FAILED;
+    default:
+        return OIIO_FRAME_ABSENT;
+    }
+}
+
+extern "C" int oiio_sequence_acquire_frame(
+    OiioSequence * seq,
+    int frame,
+    int timeout_ms,
+    OiioSequenceFrame * out)
+{
+    clear_error();
+    if (!seq || !out)
+    {
+        set_error("oiio_sequence_acquire_frame: null argument");
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> lock(seq->mutex);
+    auto settled = [&]() -> OiioSequence::Slot *
+    {
+        OiioSequence::Slot * slot = seq->find_slot(frame);
+        if (slot && slot->state != OiioSequence::SlotState::Loading)
+        {
+            return slot;
+        }
+        return nullptr;
+    };
+    auto done_waiting = [&]
+    {
+        if (seq->stop || settled())
+        {
+            return true;
+        }
+        // Stop waiting for frames nobody is going to decode.
+        const std::vector<int> wanted = seq->wanted_frames();
+        return !seq->find_slot(frame)
+               && std::find(wanted.begin(), wanted.end(), frame) == wanted.end();
+    };
+    if (timeout_ms < 0)
+    {
+        seq->ready_cv.wait(lock, done_waiting);
+    }
+    else if (timeout_ms > 0)
+    {
+        seq->ready_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), done_waiting);
+    }
+
+    OiioSequence::Slot * slot = settled();
+    if (!slot)
+    {
+        return 0;
+    }
+    if (slot->state == OiioSequence::SlotState::Failed)
+    {
+        set_error(slot->error.c_str());
+        return -1;
+    }
+
+    ++slot->pins;
+    out->frame = frame;
+    out->width = slot->width;
+    out->height = slot->height;
+    out->pixels = slot->pixels.data();
+    return 1;
+}
+
+extern "C" void oiio_sequence_release_frame(OiioSequence * seq, int frame)
+{
+    if (!seq)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(seq->mutex);
+        OiioSequence::Slot * slot = seq->find_slot(frame);
+        if (!slot || slot->pins == 0)
+        {
+            return;
+        }
+        --slot->pins;
+    }
+    // An unpinned slot may now be recyclable.
+    seq->work_cv.notify_all();
+}
+
+// ── Image output ─────────────────────────────────────────────────────────────
+
+extern "C" OiioImageOutput * oiio_image_output_open(
+    const char * path,
+    int width,
+    int height,
+    const OiioOutputOptions * options)
+{
+    clear_error();
+    if (!path || !path[0] || !options)
+    {
+        set_error("oiio_image_output_open: null argument");
+        return nullptr;
+    }
+    try
+    {
+        std::string error;
+        OIIO::ImageSpec spec;
+        if (!make_output_spec(width, height, *options, spec, error))
+        {
+            set_error(error.c_str());
+            return nullptr;
+        }
+        auto output = open_output(path, spec, 0, error);
+        if (!output)
+        {
+            set_error(error.c_str());
+            return nullptr;
+        }
+
+        auto h = new OiioImageOutput;
+        h->output = std::move(output);
+        h->spec = std::move(spec);
+        return h;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int oiio_image_output_tile_width(const OiioImageOutput * h)
+{
+    return h ? h->spec.tile_width : 0;
+}
+
+extern "C" int oiio_image_output_tile_height(const OiioImageOutput * h)
+{
+    return h ? h->spec.tile_height : 0;
+}
+
+extern "C" int oiio_image_output_write_scanlines(
+    OiioImageOutput * h,
+    int ybegin,
+    int yend,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    OIIO::TypeDesc src_type;
+    if (!h || !data || !pixel_type(src_format, src_type))
+    {
+        set_error("oiio_image_output_write_scanlines: invalid argument");
+        return 0;
+    }
+    if (ybegin < 0 || yend > h->spec.height || ybegin >= yend)
+    {
+        set_error("oiio_image_output_write_scanlines: invalid row range");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        if (!h->output)
+        {
+            set_error("oiio_image_output_write_scanlines: output is closed");
+            return 0;
+        }
+        const std::ptrdiff_t xstride = static_cast<std::ptrdiff_t>(4 * src_type.size());
+        if (row_stride == 0)
+        {
+            row_stride = xstride * h->spec.width;
+        }
+        PerfScope scope(
+            perf(), OIIO_PERF_WRITE, rgba_bytes(src_type, h->spec.width, yend - ybegin));
+        if (!h->output->write_scanlines(
+                h->spec.y + ybegin, h->spec.y + yend, 0, src_type, data, xstride, row_stride))
+        {
+            std::string error;
+            take_output_error(*h->output, "write_scanlines failed", error);
+            set_error(error.c_str());
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_output_write_tiles(
+    OiioImageOutput * h,
+    int xbegin,
+    int xend,
+    int ybegin,
+    int yend,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    OIIO::TypeDesc src_type;
+    if (!h || !data || !pixel_type(src_format, src_type))
+    {
+        set_error("oiio_image_output_write_tiles: invalid argument");
+        return 0;
+    }
+    if (xbegin < 0 || xend > h->spec.width || xbegin >= xend || ybegin < 0
+        || yend > h->spec.height || ybegin >= yend)
+    {
+        set_error("oiio_image_output_write_tiles: invalid region");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        if (!h->output)
+        {
+            set_error("oiio_image_output_write_tiles: output is closed");
+            return 0;
+        }
+        if (h->spec.tile_width <= 0)
+        {
+            set_error("oiio_image_output_write_tiles: output is not tiled");
+            return 0;
+        }
+        const std::ptrdiff_t xstride = static_cast<std::ptrdiff_t>(4 * src_type.size());
+        if (row_stride == 0)
+        {
+            row_stride = xstride * (xend - xbegin);
+        }
+        PerfScope scope(
+            perf(), OIIO_PERF_WRITE, rgba_bytes(src_type, xend - xbegin, yend - ybegin));
+        if (!h->output->write_tiles(
+                h->spec.x + xbegin,
+                h->spec.x + xend,
+                h->spec.y + ybegin,
+                h->spec.y + yend,
+                0,
+                1,
+                src_type,
+                data,
+                xstride,
+                row_stride))
+        {
+            std::string error;
+            take_output_error(*h->output, "write_tiles failed", error);
+            set_error(error.c_str());
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_output_write_image(
+    OiioImageOutput * h,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride)
+{
+    clear_error();
+    OIIO::TypeDesc src_type;
+    if (!h || !data || !pixel_type(src_format, src_type))
+    {
+        set_error("oiio_image_output_write_image: invalid argument");
+        return 0;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(h->mutex);
+        if (!h->output)
+        {
+            set_error("oiio_image_output_write_image: output is closed");
+            return 0;
+        }
+        if (row_stride == 0)
+        {
+            row_stride = static_cast<std::ptrdiff_t>(4 * src_type.size()) * h->spec.width;
+        }
+        std::string error;
+        if (!write_rgba_image(*h->output, src_type, data, row_stride, error))
+        {
+            set_error(error.c_str());
+            return 0;
+        }
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_image_output_close(OiioImageOutput * h)
+{
+    clear_error();
+    if (!h)
+    {
+        set_error("oiio_image_output_close: null handle");
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(h->mutex);
+    if (!h->output)
+    {
+        return 1;
+    }
+    const bool ok = h->output->close();
+    if (!ok)
+    {
+        std::string error;
+        take_output_error(*h->output, "close failed", error);
+        set_error(error.c_str());
+    }
+    h->output.reset();
+    return ok ? 1 : 0;
+}
+
+extern "C" void oiio_image_output_destroy(OiioImageOutput * h)
+{
+    if (h && h->output)
+    {
+        h->output->close();
+    }
+    delete h;
+}
+
+// ── Async writer ─────────────────────────────────────────────────────────────
+
+extern "C" OiioAsyncWriter * oiio_async_writer_create(int num_buffers, int num_threads)
+{
+    clear_error();
+    try
+    {
+        auto w = std::make_unique<OiioAsyncWriter>();
+        w->buffers.resize(static_cast<size_t>(std::max(2, num_buffers)));
+        w->threads = std::max(0, num_threads);
+        OiioAsyncWriter * raw = w.get();
+        w->thread = std::thread([raw] { raw->worker_loop(); });
+        return w.release();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_async_writer_destroy(OiioAsyncWriter * w)
+{
+    delete w;
+}
+
+extern "C" void * oiio_async_writer_acquire(OiioAsyncWriter * w, size_t bytes, int * out_id)
+{
+    clear_error();
+    if (!w || !out_id || bytes == 0)
+    {
+        set_error("oiio_async_writer_acquire: invalid argument");
+        return nullptr;
+    }
+
+    try
+    {
+        std::unique_lock<std::mutex> lock(w->mutex);
+        int id = -1;
+        w->cv.wait(
+            lock,
+            [&]
+            {
+                for (size_t i = 0; i < w->buffers.size(); ++i)
+                {
+                    if (w->buffers[i].state == OiioAsyncWriter::BufferState::Free)
+                    {
+                        id = static_cast<int>(i);
+                        return true;
+                    }
+                }
+                return false;
+            });
+        OiioAsyncWriter::Buffer & buffer = w->buffers[static_cast<size_t>(id)];
+        // Buffers keep their capacity, so same-sized frames reuse memory.
+        buffer.data.resize(bytes);
+        buffer.state = OiioAsyncWriter::BufferState::Acquired;
+        *out_id = id;
+        return buffer.data.data();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" void oiio_async_writer_discard(OiioAsyncWriter * w, int id)
+{
+    if (!w)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(w->mutex);
+        if (id < 0 || id >= static_cast<int>(w->buffers.size())
+            || w->buffers[static_cast<size_t>(id)].state != OiioAsyncWriter::BufferState::Acquired)
+        {
+            return;
+        }
+        w->buffers[static_cast<size_t>(id)].state = OiioAsyncWriter::BufferState::Free;
+    }
+    w->cv.notify_all();
+}
+
+extern "C" int oiio_async_writer_submit(
+    OiioAsyncWriter * w,
+    int id,
+    const char * path,
+    int width,
+    int height,
+    int src_format,
+    ptrdiff_t row_stride,
+    const OiioOutputOptions * options)
+{
+    clear_error();
+    OIIO::TypeDesc src_type;
+    if (!w || !path || !path[0] || !options || !pixel_type(src_format, src_type))
+    {
+        set_error("oiio_async_writer_submit: invalid argument");
+        return 0;
+    }
+
+    try
+    {
+        OiioAsyncWriter::Job job;
+        std::string error;
+        if (!make_output_spec(width, height, *options, job.spec, error))
+        {
+            set_error(error.c_str());
+            return 0;
+        }
+        job.path = path;
+        job.width = width;
+        job.height = height;
+        job.src_type = src_type;
+        const std::ptrdiff_t packed = static_cast<std::ptrdiff_t>(4 * src_type.size()) * width;
+        job.row_stride = row_stride == 0 ? packed : row_stride;
+
+        {
+            std::lock_guard<std::mutex> lock(w->mutex);
+            if (id < 0 || id >= static_cast<int>(w->buffers.size()))
+            {
+                set_error("oiio_async_writer_submit: unknown buffer");
+                return 0;
+            }
+            OiioAsyncWriter::Buffer & buffer = w->buffers[static_cast<size_t>(id)];
+            const size_t needed =
+                static_cast<size_t>(job.row_stride) * (height - 1) + static_cast<size_t>(packed);
+            if (buffer.state != OiioAsyncWriter::BufferState::Acquired
+                || job.row_stride < packed || buffer.data.size() < needed)
+            {
+                set_error("oiio_async_writer_submit: buffer not acquired or too small");
+                return 0;
+            }
+            buffer.job = std::move(job);
+            buffer.state = OiioAsyncWriter::BufferState::Queued;
+            w->queue.push_back(id);
+        }
+        w->cv.notify_all();
+        return 1;
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return 0;
+    }
+}
+
+extern "C" int oiio_async_writer_flush(OiioAsyncWriter * w)
+{
+    clear_error();
+    if (!w)
+    {
+        set_error("oiio_async_writer_flush: null handle");
+        return -1;
+    }
+    std::unique_lock<std::mutex> lock(w->mutex);
+    w->cv.wait(lock, [&] { return w->queue.empty() && w->busy == 0; });
+    const int failures = w->failures;
+    if (failures > 0)
+    {
+        set_error(w->first_error.c_str());
+    }
+    w->failures = 0;
+    w->first_error.clear();
+    return failures;
+}
+
+// ── Thumbnails ───────────────────────────────────────────────────────────────
+
+namespace
+{
+// Resize filter for thumbnails: an area average is plenty at bin-view sizes
+// and much cheaper than the default windowed-sinc filters.
+constexpr const char * k_thumbnail_filter = "box";
+
+struct Thumbnail
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+    std::string error;
+};
+
+float unit_clamp(float v)
+{
+    // NaN compares false and maps to 0.
+    return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+}
+
+// Decode `path` at no more than max_edge on its longest side. Prefers an
+// embedded thumbnail that is at least as large as the target, then the
+// smallest covering MIP level, then a box-filtered reduction of the full
+// image. The optional transform runs on the float pixels before they are
+// quantized to 8 bits.
+bool make_thumbnail(
+    const char * path,
+    int index,
+    int max_edge,
+    OiioThumbnailTransform transform,
+    void * user_data,
+    Thumbnail & out)
+{
+    auto input = OIIO::ImageInput::open(path);
+    if (!input)
+    {
+        out.error = OIIO::geterror();
+        if (out.error.empty())
+        {
+            out.error = "failed to open image: " + std::string(path);
+        }
+        return false;
+    }
+    // Files are decoded concurrently, one per pool thread.
+    input->threads(1);
+
+    const OIIO::ImageSpec spec = input->spec();
+    int out_w = 0;
+    int out_h = 0;
+    fit_dimensions(spec.width, spec.height, max_edge, max_edge, out_w, out_h);
+    std::vector<float> rgba;
+
+    OIIO::ImageBuf embedded;
+    if (input->get_thumbnail(embedded, 0) && embedded.initialized()
+        && std::max(embedded.spec().width, embedded.spec().height) >= std::max(out_w, out_h))
+    {
+        const OIIO::ImageSpec & thumb = embedded.spec();
+        fit_dimensions(thumb.width, thumb.height, max_edge, max_edge, out_w, out_h);
+        const int nread = std::min(thumb.nchannels, 4);
+        rgba.resize(static_cast<size_t>(out_w) * out_h * 4);
+        OIIO::ImageBuf dst(
+            OIIO::ImageSpec(out_w, out_h, nread, OIIO::TypeFloat),
+            rgba.data(),
+            k_rgba_pixel_bytes,
+            packed_rgba_row(out_w));
+        if (!OIIO::ImageBufAlgo::resize(dst, embedded, k_thumbnail_filter, 0.0f, {}, 1))
+        {
+            out.error = dst.geterror();
+            return false;
+        }
+        expand_to_rgba(
+            rgba.data(), OIIO::TypeFloat, out_w, out_h, packed_rgba_row(out_w), thumb.nchannels);
+    }
+    else
+    {
+        if (out_w <= 0 || out_h <= 0)
+        {
+            out.error = "image has zero dimensions: " + std::string(path);
+            return false;
+        }
+        rgba.resize(static_cast<size_t>(out_w) * out_h * 4);
+        if (!read_rgba_fit(
+                *input,
+                spec,
+                out_w,
+                out_h,
+                OIIO::TypeFloat,
+                rgba.data(),
+                packed_rgba_row(out_w),
+                1,
+                k_thumbnail_filter))
+        {
+            out.error = g_last_error;
+            return false;
+        }
+    }
+
+    if (transform && !transform(user_data, index, rgba.data(), out_w, out_h))
+    {
+        out.error = "thumbnail transform failed: " + std::string(path);
+        return false;
+    }
+
+    out.width = out_w;
+    out.height = out_h;
+    out.pixels.resize(rgba.size());
+    for (size_t i = 0; i < rgba.size(); ++i)
+    {
+        out.pixels[i] = static_cast<unsigned char>(unit_clamp(rgba[i]) * 255.0f + 0.5f);
+    }
+    return true;
+}
+} // namespace
+
+struct OiioThumbnailBatch
+{
+    std::vector<Thumbnail> items;
+};
+
+extern "C" OiioThumbnailBatch * oiio_thumbnails_generate(
+    const char * const * paths,
+    int count,
+    int max_edge,
+    int num_threads,
+    OiioThumbnailTransform transform,
+    void * user_data)
+{
+    clear_error();
+    if (!paths || count < 0 || max_edge <= 0)
+    {
+        set_error("oiio_thumbnails_generate: invalid argument");
+        return nullptr;
+    }
+
+    try
+    {
+        auto batch = std::make_unique<OiioThumbnailBatch>();
+        batch->items.resize(static_cast<size_t>(count));
+
+        // Pool threads pull the next file index until the list is
+        // exhausted, so slow files do not hold up a fixed share of the
+        // batch. Each file records its own failure, so the pool never sees
+        // an exception.
+        auto make_item = [&](int i)
+        {
+            Thumbnail & item = batch->items[static_cast<size_t>(i)];
+            try
+            {
+                if (!paths[i] || !paths[i][0])
+                {
+                    item.error = "empty path";
+                }
+                else
+                {
+                    make_thumbnail(paths[i], i, max_edge, transform, user_data, item);
+                }
+            }
+            catch (const std::exception & e)
+            {
+                item.error = e.what();
+            }
+        };
+
+        std::string err;
+        crispen::WorkerPool::instance().run(count, num_threads, make_item, err);
+        return batch.release();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int oiio_thumbnail_batch_get(
+    const OiioThumbnailBatch * batch,
+    int index,
+    OiioThumbnail * out)
+{
+    clear_error();
+    if (!batch || !out || index < 0 || index >= static_cast<int>(batch->items.size()))
+    {
+        set_error("oiio_thumbnail_batch_get: invalid argument");
+        return 0;
+    }
+    const Thumbnail & item = batch->items[static_cast<size_t>(index)];
+    if (item.pixels.empty())
+    {
+        set_error(item.error.empty() ? "thumbnail failed" : item.error.c_str());
+        out->width = 0;
+        out->height = 0;
+        out->pixels = nullptr;
+        return 0;
+    }
+    out->width = item.width;
+    out->height = item.height;
+    out->pixels = item.pixels.data();
+    return 1;
+}
+
+extern "C" void oiio_thumbnail_batch_destroy(OiioThumbnailBatch * batch)
+{
+    delete batch;
+}
+
+// ── Batch export ─────────────────────────────────────────────────────────────
+
+namespace
+{
+struct BatchFrame
+{
+    int index = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels;
+    // Header of the input file, carried into the output spec.
+    OIIO::ImageSpec source;
+};
+
+using BatchFramePtr = std::unique_ptr<BatchFrame>;
+
+// Bounded hand-off between two pipeline stages. Producers block while it
+// is full; consumers block until a frame arrives, and get null once every
+// producer has closed and the queue is drained, or after abort().
+struct BatchQueue
+{
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<BatchFramePtr> frames;
+    size_t capacity = 1;
+    int producers = 0;
+    bool aborted = false;
+
+    BatchQueue(size_t depth, int num_producers) : capacity(depth), producers(num_producers) {}
+
+    // Hands the frame back when the queue was aborted.
+    BatchFramePtr push(BatchFramePtr frame)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [&] { return aborted || frames.size() < capacity; });
+        if (aborted)
+        {
+            return frame;
+        }
+        frames.push_back(std::move(frame));
+        not_empty.notify_one();
+        return nullptr;
+    }
+
+    BatchFramePtr pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [&] { return aborted || !frames.empty() || producers == 0; });
+        if (aborted || frames.empty())
+        {
+            return nullptr;
+        }
+        BatchFramePtr frame = std::move(frames.front());
+        frames.pop_front();
+        not_full.notify_one();
+        return frame;
+    }
+
+    // Called by each producer once it has no more frames.
+    void close_producer()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--producers == 0)
+        {
+            not_empty.notify_all();
+        }
+    }
+
+    void abort()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        aborted = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+};
+
+std::uint64_t nanoseconds_since(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+}
+} // namespace
+
+struct OiioBatchExport
+{
+    // Empty for jobs that were written.
+    std::vector<std::string> errors;
+    std::vector<char> written;
+    OiioBatchStats stats{};
+};
+
+namespace
+{
+// One run of oiio_batch_export_run. Decoders claim job indices in order and
+// push frames into `decoded`; transform threads move them on to `encoded`
+// (or decoders feed it directly without a transform) and encoders write
+// them and return the buffers to `spare` for the next decode.
+struct BatchPipeline
+{
+    const char * const * inputs = nullptr;
+    const char * const * outputs = nullptr;
+    int count = 0;
+    OiioOutputOptions output{};
+    int max_width = 0;
+    int max_height = 0;
+    OiioBatchTransform transform = nullptr;
+    OiioBatchProgress progress = nullptr;
+    void * user_data = nullptr;
+    OiioBatchExport * result = nullptr;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::atomic<int> next{0};
+    std::atomic<bool> cancelled{false};
+    std::atomic<std::uint64_t> decode_ns{0};
+    std::atomic<std::uint64_t> transform_ns{0};
+    std::atomic<std::uint64_t> encode_ns{0};
+
+    std::mutex spare_mutex;
+    std::vector<BatchFramePtr> spare;
+
+    // Guards `result` and serializes progress callbacks.
+    std::mutex result_mutex;
+    std::vector<char> finished;
+
+    BatchFramePtr acquire_frame()
+    {
+        std::lock_guard<std::mutex> lock(spare_mutex);
+        if (spare.empty())
+        {
+            return std::make_unique<BatchFrame>();
+        }
+        BatchFramePtr frame = std::move(spare.back());
+        spare.pop_back();
+        return frame;
+    }
+
+    void recycle(BatchFramePtr frame)
+    {
+        std::lock_guard<std::mutex> lock(spare_mutex);
+        try
+        {
+            spare.push_back(std::move(frame));
+        }
+        catch (const std::exception &)
+        {
+            // Out of memory: free the buffer instead of keeping it.
+        }
+    }
+
+    // Totals so far. Caller holds `result_mutex`.
+    OiioBatchStats snapshot() const
+    {
+        OiioBatchStats stats = result->stats;
+        stats.elapsed_ns = nanoseconds_since(start);
+        stats.decode_ns = decode_ns.load();
+        stats.transform_ns = transform_ns.load();
+        stats.encode_ns = encode_ns.load();
+        return stats;
+    }
+
+    // Record the outcome of job `index`; `pixels` counts towards the totals
+    // when it was written.
+    void finish(int index, bool ok, unsigned long long pixels, std::string error)
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        const size_t i = static_cast<size_t>(index);
+        finished[i] = 1;
+        result->written[i] = ok ? 1 : 0;
+        result->errors[i] = std::move(error);
+        if (ok)
+        {
+            ++result->stats.frames_written;
+            result->stats.pixels_written += pixels;
+        }
+        else
+        {
+            ++result->stats.frames_failed;
+        }
+        if (progress)
+        {
+            const OiioBatchStats stats = snapshot();
+            if (!progress(user_data, index, ok ? 1 : 0, &stats))
+            {
+                cancelled = true;
+            }
+        }
+    }
+
+    std::string input_error(int index, const std::string & error) const
+    {
+        return std::string(inputs[index]) + ": " + error;
+    }
+
+    // The loops below run on their own threads, so nothing may escape them:
+    // an exception (such as a failed allocation) fails the job at hand only.
+
+    void decode_loop(BatchQueue & out)
+    {
+        for (int i = next++; i < count && !cancelled; i = next++)
+        {
+            if (!inputs[i] || !inputs[i][0])
+            {
+                finish(i, false, 0, "empty input path");
+                continue;
+            }
+            try
+            {
+                BatchFramePtr frame = acquire_frame();
+                frame->index = i;
+                std::string error;
+                const auto t0 = std::chrono::steady_clock::now();
+                const bool ok = decode_sequence_frame(
+                    inputs[i],
+                    max_width,
+                    max_height,
+                    frame->pixels,
+                    frame->width,
+                    frame->height,
+                    error,
+                    &frame->source);
+                decode_ns += nanoseconds_since(t0);
+                if (!ok)
+                {
+                    recycle(std::move(frame));
+                    finish(i, false, 0, input_error(i, error));
+                    continue;
+                }
+                if (BatchFramePtr rejected = out.push(std::move(frame)))
+                {
+                    recycle(std::move(rejected));
+                    break;
+                }
+            }
+            catch (const std::exception & e)
+            {
+                finish(i, false, 0, input_error(i, e.what()));
+            }
+        }
+        out.close_producer();
+    }
+
+    void transform_loop(BatchQueue & in, BatchQueue & out)
+    {
+        while (BatchFramePtr frame = in.pop())
+        {
+            const int index = frame->index;
+            try
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                const int transformed = transform(
+                    user_data,
+                    index,
+                    frame->pixels.data(),
+                    frame->width,
+                    frame->height);
+                const bool ok = transformed != 0;
+                transform_ns += nanoseconds_since(t0);
+                if (!ok)
+                {
+                    recycle(std::move(frame));
+                    finish(index, false, 0, input_error(index, "transform failed"));
+                    continue;
+                }
+                if (BatchFramePtr rejected = out.push(std::move(frame)))
+                {
+                    recycle(std::move(rejected));
+                    break;
+                }
+            }
+            catch (const std::exception & e)
+            {
+                finish(index, false, 0, input_error(index, e.what()));
+            }
+        }
+        out.close_producer();
+    }
+
+    void encode_loop(BatchQueue & in)
+    {
+        while (BatchFramePtr frame = in.pop())
+        {
+            const char * path = outputs[frame->index];
+            std::string error;
+            bool ok = false;
+            const auto t0 = std::chrono::steady_clock::now();
+            try
+            {
+                OIIO::ImageSpec spec;
+                if (!path || !path[0])
+                {
+                    error = "empty output path";
+                }
+                else
+                {
+                    // Files are encoded concurrently, one per encode thread.
+                    ok = make_output_spec(frame->width, frame->height, output, spec, error);
+                    if (ok)
+                    {
+                        merge_source_metadata(frame->source, spec);
+                        ok = write_rgba_file(
+                            path,
+                            spec,
+                            1,
+                            OIIO::TypeFloat,
+                            frame->pixels.data(),
+                            packed_rgba_row(frame->width),
+                            error);
+                    }
+                    if (!ok)
+                    {
+                        error = std::string(path) + ": " + error;
+                    }
+                }
+            }
+            catch (const std::exception & e)
+            {
+                error = e.what();
+            }
+            encode_ns += nanoseconds_since(t0);
+            const int index = frame->index;
+            const unsigned long long pixels = static_cast<unsigned long long>(frame->width)
+                                              * static_cast<unsigned long long>(frame->height);
+            recycle(std::move(frame));
+            finish(index, ok, pixels, ok ? std::string() : std::move(error));
+        }
+    }
+
+    void run(int decoders, int transformers, int encoders, int queue_depth)
+    {
+        finished.assign(static_cast<size_t>(count), 0);
+        const size_t depth = static_cast<size_t>(queue_depth);
+        BatchQueue decoded(depth, decoders);
+        BatchQueue transformed(depth, transformers);
+        BatchQueue & encoded = transformers > 0 ? transformed : decoded;
+
+        std::vector<std::thread> threads;
+        try
+        {
+            for (int t = 0; t < encoders; ++t)
+            {
+                threads.emplace_back([&] { encode_loop(encoded); });
+            }
+            for (int t = 0; t < transformers; ++t)
+            {
+                threads.emplace_back([&] { transform_loop(decoded, transformed); });
+            }
+            for (int t = 0; t < decoders; ++t)
+            {
+                threads.emplace_back([&] { decode_loop(decoded); });
+            }
+        }
+        catch (const std::exception &)
+        {
+            // A stage short of threads could never drain: stop everything.
+            cancelled = true;
+            decoded.abort();
+            transformed.abort();
+            for (std::thread & t : threads)
+            {
+                t.join();
+            }
+            throw;
+        }
+        for (std::thread & t : threads)
+        {
+            t.join();
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (!finished[static_cast<size_t>(i)])
+            {
+                result->errors[static_cast<size_t>(i)] = "cancelled";
+                ++result->stats.frames_failed;
+            }
+        }
+        result->stats = snapshot();
+    }
+};
+} // namespace
+
+extern "C" OiioBatchExport * oiio_batch_export_run(
+    const char * const * inputs,
+    const char * const * outputs,
+    int count,
+    const OiioBatchOptions * options,
+    const OiioOutputOptions * output,
+    OiioBatchTransform transform,
+    OiioBatchProgress progress,
+    void * user_data)
+{
+    clear_error();
+    const OiioBatchOptions defaults{};
+    const OiioBatchOptions & opts = options ? *options : defaults;
+    if (!inputs || !outputs || count < 0 || !output || opts.decode_threads < 0
+        || opts.transform_threads < 0 || opts.encode_threads < 0 || opts.queue_depth < 0)
+    {
+        set_error("oiio_batch_export_run: invalid argument");
+        return nullptr;
+    }
+
+    try
+    {
+        auto batch = std::make_unique<OiioBatchExport>();
+        batch->errors.resize(static_cast<size_t>(count));
+        batch->written.assign(static_cast<size_t>(count), 0);
+        batch->stats.frames_total = count;
+        if (count == 0)
+        {
+            return batch.release();
+        }
+
+        // More threads than jobs in a stage would only sit idle.
+        auto stage_threads = [&](int requested, int fallback)
+        { return std::max(1, std::min(requested > 0 ? requested : fallback, count)); };
+        const int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        const int decoders = stage_threads(opts.decode_threads, 2);
+        const int transformers = transform ? stage_threads(opts.transform_threads, hardware) : 0;
+        const int encoders = stage_threads(opts.encode_threads, 2);
+
+        BatchPipeline pipeline;
+        pipeline.inputs = inputs;
+        pipeline.outputs = outputs;
+        pipeline.count = count;
+        pipeline.output = *output;
+        pipeline.max_width = opts.max_width;
+        pipeline.max_height = opts.max_height;
+        pipeline.transform = transform;
+        pipeline.progress = progress;
+        pipeline.user_data = user_data;
+        pipeline.result = batch.get();
+        pipeline.run(
+            decoders, transformers, encoders, opts.queue_depth > 0 ? opts.queue_depth : 2);
+        return batch.release();
+    }
+    catch (const std::exception & e)
+    {
+        set_error(e.what());
+        return nullptr;
+    }
+}
+
+extern "C" int oiio_batch_export_result(const OiioBatchExport * batch, int index)
+{
+    clear_error();
+    if (!batch || index < 0 || index >= static_cast<int>(batch->written.size()))
+    {
+        set_error("oiio_batch_export_result: invalid argument");
+        return 0;
+    }
+    const size_t i = static_cast<size_t>(index);
+    if (!batch->written[i])
+    {
+        set_error(batch->errors[i].empty() ? "export failed" : batch->errors[i].c_str());
+        return 0;
+    }
+    return 1;
+}
+
+extern "C" void oiio_batch_export_get_stats(const OiioBatchExport * batch, OiioBatchStats * out)
+{
+    if (!batch || !out)
+    {
+        return;
+    }
+    *out = batch->stats;
+}
+
+extern "C" void oiio_batch_export_destroy(OiioBatchExport * batch)
+{
+    delete batch;
 }
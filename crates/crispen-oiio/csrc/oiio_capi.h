@@ -1,15 +1,139 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct OiioImageInput OiioImageInput;
+typedef struct OiioImageStream OiioImageStream;
+typedef struct OiioSequence OiioSequence;
+typedef struct OiioImageOutput OiioImageOutput;
+typedef struct OiioAsyncWriter OiioAsyncWriter;
+typedef struct OiioThumbnailBatch OiioThumbnailBatch;
+typedef struct OiioRawImage OiioRawImage;
+typedef struct OiioBatchExport OiioBatchExport;
+
+// Sample type of caller RGBA pixel buffers, for reads and writes.
+enum
+{
+    OIIO_PIXEL_F32 = 0,
+    // IEEE half, passed as raw 16-bit values.
+    OIIO_PIXEL_F16 = 1,
+};
+
+// Counters for the process-wide ImageCache (see oiio_image_cache_*).
+typedef struct OiioImageCacheStats
+{
+    // Tile lookups served from memory / decoded from disk.
+    unsigned long long hits;
+    unsigned long long misses;
+    // Bytes read from disk by the cache.
+    unsigned long long bytes_read;
+    // Tiles dropped from memory after being created.
+    unsigned long long evictions;
+    // Bytes currently held in the tile cache.
+    unsigned long long memory_used;
+    int tiles_current;
+    int open_files;
+    float max_memory_mb;
+    int max_open_files;
+} OiioImageCacheStats;
+
+// Instrumented stages reported by oiio_perf_get_stats and the perf callback.
+enum
+{
+    // ImageInput open / ImageCache spec lookup / probe.
+    OIIO_PERF_OPEN = 0,
+    // Decoder reads (read_image / read_scanlines / read_tiles), including
+    // the decoder's conversion to the requested sample type.
+    OIIO_PERF_DECODE = 1,
+    // ImageCache::get_pixels copies out of the tile cache.
+    OIIO_PERF_CACHE_READ = 2,
+    // In-place gray/alpha expansion of 1-3 channel images to RGBA.
+    OIIO_PERF_CHANNEL_EXPAND = 3,
+    // Downscaling for fit/thumbnail reads.
+    OIIO_PERF_RESIZE = 4,
+    OIIO_PERF_WRITE = 5,
+    OIIO_PERF_STAGE_COUNT = 6,
+};
+
+// Cumulative totals for one instrumented stage; `bytes` counts the pixel
+// bytes produced (reads) or consumed (writes), 0 for opens.
+typedef struct OiioPerfCounter
+{
+    unsigned long long calls;
+    unsigned long long nanoseconds;
+    unsigned long long bytes;
+} OiioPerfCounter;
+
+typedef struct OiioPerfStats
+{
+    OiioPerfCounter stages[OIIO_PERF_STAGE_COUNT];
+} OiioPerfStats;
+
+// Called after every instrumented call while instrumentation is enabled, on
+// the thread that made it (possibly an internal worker). Calls may run
+// concurrently; the callback may call oiio_perf_set_callback.
+typedef void (*OiioPerfCallback)(
+    void * user, int stage, unsigned long long nanoseconds, unsigned long long bytes);
+
+// Header metadata filled by oiio_probe. Strings are NUL-terminated and
+// truncated to fit.
+typedef struct OiioProbeSpec
+{
+    int width;
+    int height;
+    int nchannels;
+    // OIIO TypeDesc basetype, as returned by oiio_image_input_format.
+    int format;
+    // "oiio:BitsPerSample" when the file stores fewer bits than `format`
+    // (10/12-bit DPX), otherwise 0.
+    int bits_per_sample;
+    // 0 for scanline files.
+    int tile_width;
+    int tile_height;
+    // Subimages (EXR parts, TIFF pages) and MIP levels of subimage 0.
+    int subimages;
+    int miplevels;
+    // "oiio:ColorSpace" hint usable as an OCIO color space name; empty when
+    // the file carries none.
+    char color_space[128];
+    // OIIO plugin name, e.g. "openexr", "dpx".
+    char format_name[32];
+} OiioProbeSpec;
+
+// One subimage (EXR part, TIFF page) as described by
+// oiio_image_input_subimage_spec.
+typedef struct OiioSubimageSpec
+{
+    int width;
+    int height;
+    int nchannels;
+    // OIIO TypeDesc basetype, as returned by oiio_image_input_format.
+    int format;
+    // "oiio:subimagename" (EXR part name); empty when the part is unnamed.
+    char name[128];
+} OiioSubimageSpec;
 
 // Error handling
 const char * oiio_get_last_error(void);
 
-// Open an image file for reading. Returns owned handle or NULL on error.
+// Global OIIO thread budget for decode and ImageBufAlgo work, also applied
+// to OpenEXR's decompression pool. 0 uses every hardware thread.
+void oiio_set_threads(int n);
+int oiio_get_threads(void);
+
+// Per-handle thread hint for pixel reads and decode-time resizes; 0 falls
+// back to the global setting.
+void oiio_image_input_set_threads(OiioImageInput * h, int n);
+void oiio_image_stream_set_threads(OiioImageStream * h, int n);
+
+// Open an image file for reading. Only the header is read here; pixels are
+// decoded by oiio_image_input_read_rgba_f32. Returns owned handle or NULL on
+// error.
 OiioImageInput * oiio_image_input_open(const char * path);
 
 // Spec queries (handle must be non-NULL).
@@ -23,14 +147,572 @@ int oiio_image_input_format(const OiioImageInput * h);
 // Returns the detected color space ("oiio:ColorSpace" attribute) or NULL.
 const char * oiio_image_input_color_space(const OiioImageInput * h);
 
-// Read entire image as RGBA f32 into caller-provided buffer.
+// Read only the header of `path` into `out`: no pixels are decoded and no
+// handle is kept open. Returns 1 on success, 0 on error.
+int oiio_probe(const char * path, OiioProbeSpec * out);
+
+// Decode entire image as RGBA f32 directly into caller-provided buffer.
+// 1 channel: R=G=B=value, A=1; 2 channels: gray + alpha; 3 channels: A=1;
+// >4 channels: first 4 used.
 // buf_len is the total number of floats (must be >= width * height * 4).
 // Returns 1 on success, 0 on error (check oiio_get_last_error).
 int oiio_image_input_read_rgba_f32(const OiioImageInput * h, float * buf, int buf_len);
 
+// Size oiio_image_input_read_rgba_f32_fit produces for a display bound:
+// fits within (max_width, max_height) preserving aspect ratio, never
+// upscaling. Non-positive bounds mean full size. Returns 1 on success.
+int oiio_image_input_fit_size(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    int * out_width,
+    int * out_height);
+
+// Decode a display-sized RGBA f32 image into caller-provided buffer.
+// Uses the smallest MIP level that covers the fitted size, and resizes the
+// native-depth pixels before float conversion when no level matches.
+// buf_len is the total number of floats (must be >= fit width * height * 4).
+// Returns 1 on success, 0 on error (check oiio_get_last_error).
+int oiio_image_input_read_rgba_f32_fit(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    float * buf,
+    int buf_len);
+
+// Decode a display-fit RGBA f32 image (as oiio_image_input_read_rgba_f32_fit;
+// non-positive bounds mean full size) into arbitrary caller memory, e.g. a
+// mapped GPU upload buffer. Rows start `row_stride` bytes apart (0 = packed;
+// otherwise >= width * 16 and a multiple of 4); row padding is left untouched.
+// dst must be 4-byte aligned and hold dst_bytes bytes.
+// Returns 1 on success, 0 on error (check oiio_get_last_error).
+int oiio_image_input_read_rgba_f32_into(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    void * dst,
+    size_t dst_bytes,
+    ptrdiff_t row_stride);
+
+// Generalization of oiio_image_input_read_rgba_f32_into for any OIIO_PIXEL_*
+// sample type. OIIO_PIXEL_F16 keeps half EXRs at half precision from decode
+// to upload (no float round trip, half the memory); other sources are
+// converted to half by the decoder. Row stride must be a multiple of the
+// sample size and dst aligned to it.
+int oiio_image_input_read_rgba_into(
+    const OiioImageInput * h,
+    int max_width,
+    int max_height,
+    int pixel_format,
+    void * dst,
+    size_t dst_bytes,
+    ptrdiff_t row_stride);
+
+// Decode the entire image as packed RGBA half (raw IEEE binary16 values).
+// buf_len is the number of 16-bit values (>= width * height * 4).
+// Returns 1 on success, 0 on error.
+int oiio_image_input_read_rgba_f16(const OiioImageInput * h, uint16_t * buf, size_t buf_len);
+
+// Open an image through the process-wide ImageCache. Pixel reads are served
+// from cached tiles, so re-opening or re-reading a recent frame does not
+// decode it again. Returns owned handle or NULL on error.
+OiioImageInput * oiio_image_input_open_cached(const char * path);
+
 // Destroy handle and free resources.
 void oiio_image_input_destroy(OiioImageInput * h);
 
+// ── Subimages and layers ─────────────────────────────────────────────────────
+
+// Multi-part and multi-layer files (EXR render passes, multi-page TIFF).
+// Subimage headers are scanned once, on the first call below; no pixels are
+// decoded until a layer is read.
+
+// Number of subimages, or -1 on error. Plain images have one.
+int oiio_image_input_subimage_count(const OiioImageInput * h);
+
+// Header of `subimage`. Returns 1 on success, 0 on error.
+int oiio_image_input_subimage_spec(
+    const OiioImageInput * h,
+    int subimage,
+    OiioSubimageSpec * out);
+
+// Name of `channel` in `subimage`, e.g. "diffuse.R". The string is owned by
+// the handle and valid until it is destroyed; NULL when out of range.
+const char * oiio_image_input_channel_name(const OiioImageInput * h, int subimage, int channel);
+
+// First subimage holding `layer`: channels named "<layer>.<name>", or a part
+// named `layer` with unprefixed channels. "" selects unprefixed channels.
+// Returns -1 (with an error set) when no subimage has the layer.
+int oiio_image_input_find_layer(const OiioImageInput * h, const char * layer);
+
+// Decode only the channels of `layer` in `subimage` as RGBA f32. Channels
+// named R/G/B[/A], X/Y/Z or Y[/A] (case-insensitive) go to their slots;
+// other layers use their first four channels in file order, expanded as in
+// oiio_image_input_read_rgba_f32. Layers whose channels lie within four
+// adjacent file channels are decoded with a single channel range. buf_len
+// is in floats and rows start `row_stride` bytes apart (0 = packed,
+// width * 16), sized for the subimage's dimensions.
+// Returns 1 on success, 0 on error.
+int oiio_image_input_read_layer_rgba_f32(
+    const OiioImageInput * h,
+    int subimage,
+    const char * layer,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t row_stride);
+
+// ── Shared image cache ───────────────────────────────────────────────────────
+
+// Set cache limits; non-positive values leave a limit unchanged.
+// Returns 1 on success, 0 on error.
+int oiio_image_cache_configure(float max_memory_mb, int max_open_files);
+void oiio_image_cache_get_stats(OiioImageCacheStats * out);
+void oiio_image_cache_reset_stats(void);
+// Drop cached tiles and file handles for `path`, or for every file if NULL.
+void oiio_image_cache_invalidate(const char * path);
+
+// ── Instrumentation ──────────────────────────────────────────────────────────
+
+// Opt-in per-stage call counts, wall time and bytes processed, off by
+// default. While disabled nothing is timed and the counters do not change.
+void oiio_perf_set_enabled(int enabled);
+int oiio_perf_is_enabled(void);
+// NULL callback unregisters; once this returns the old callback is not
+// running on any other thread (it may still be on the stack of this one,
+// when called from inside it).
+void oiio_perf_set_callback(OiioPerfCallback callback, void * user);
+void oiio_perf_get_stats(OiioPerfStats * out);
+void oiio_perf_reset(void);
+// Short snake_case stage name, or NULL for an unknown stage.
+const char * oiio_perf_stage_name(int stage);
+
+// ── Streaming reader ─────────────────────────────────────────────────────────
+//
+// Opens the file header only; pixels are decoded on demand for a caller
+// chosen row band or tile region. Row/column indices are relative to the
+// data window origin. Strides are in bytes; 0 means tightly packed.
+
+// Open an image file for streaming reads. Returns owned handle or NULL on error.
+OiioImageStream * oiio_image_stream_open(const char * path);
+void oiio_image_stream_destroy(OiioImageStream * h);
+
+int oiio_image_stream_width(const OiioImageStream * h);
+int oiio_image_stream_height(const OiioImageStream * h);
+int oiio_image_stream_nchannels(const OiioImageStream * h);
+int oiio_image_stream_format(const OiioImageStream * h);
+// Tile size, or 0 for scanline files.
+int oiio_image_stream_tile_width(const OiioImageStream * h);
+int oiio_image_stream_tile_height(const OiioImageStream * h);
+const char * oiio_image_stream_color_space(const OiioImageStream * h);
+
+// Decode rows [ybegin, yend), channels [chbegin, chend) as f32 into buf.
+// buf_len is the total number of floats available at buf.
+// Returns 1 on success, 0 on error (check oiio_get_last_error).
+int oiio_image_stream_read_scanlines(
+    OiioImageStream * h,
+    int ybegin,
+    int yend,
+    int chbegin,
+    int chend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t xstride,
+    ptrdiff_t ystride);
+
+// Decode the tile-aligned region [xbegin, xend) x [ybegin, yend) (ends may
+// stop at the image edge) for channels [chbegin, chend) as f32 into buf.
+// Tiled files only. Returns 1 on success, 0 on error.
+int oiio_image_stream_read_tiles(
+    OiioImageStream * h,
+    int xbegin,
+    int xend,
+    int ybegin,
+    int yend,
+    int chbegin,
+    int chend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t xstride,
+    ptrdiff_t ystride);
+
+// Decode rows [ybegin, yend) as RGBA f32 (same channel mapping as
+// oiio_image_input_read_rgba_f32) into a packed buffer of
+// (yend - ybegin) * width * 4 floats. Returns 1 on success, 0 on error.
+int oiio_image_stream_read_rgba_f32(
+    OiioImageStream * h,
+    int ybegin,
+    int yend,
+    float * buf,
+    size_t buf_len);
+
+// ── Raw mapped reader ────────────────────────────────────────────────────────
+//
+// Fast path for files whose pixels are stored uncompressed in a plain
+// layout: DPX (8-bit big-endian, 16-bit, 10-bit filled RGB), strip TIFF with
+// contiguous interleaved strips, and single-part scanline EXR with
+// R,G,B[,A] or Y[,A] channels. The file is memory-mapped instead of
+// decoded; rows are converted to RGBA f32 only when a band is requested.
+// Handles are immutable after open, so any number of threads may read
+// bands of one handle concurrently without locking. The file must not be
+// truncated while mapped: reading a truncated mapping raises SIGBUS, so
+// only open handles on files that are complete and no longer written.
+//
+// Sequence prefetch and batch export parse the same layouts on their own
+// for full-size frames, but read the file with a buffered read instead of
+// mapping it, so a frame that is still being written fails on its own
+// rather than crashing the process. A handle is only needed to convert
+// bands of one frame on caller threads.
+
+// Storage packing of OiioRawLayout samples.
+enum
+{
+    OIIO_RAW_PACKING_NONE = 0,
+    // Three 10-bit samples per 32-bit word, first sample in the top bits.
+    // Method A pads the bottom two bits, method B the top two.
+    OIIO_RAW_PACKING_10BIT_FILLED_A = 1,
+    OIIO_RAW_PACKING_10BIT_FILLED_B = 2,
+};
+
+// Describes where every stored sample lives. Sample (x, y, c) starts at
+// data + y * row_stride + x * pixel_stride + c * channel_stride bytes, with
+// data from oiio_raw_image_data.
+typedef struct OiioRawLayout
+{
+    int width;
+    int height;
+    int nchannels;
+    // OIIO TypeDesc basetype of one stored sample; UINT32 for packed
+    // 10-bit words.
+    int format;
+    int bits_per_sample;
+    int packing;
+    // Multi-byte samples are big-endian.
+    int big_endian;
+    // Stored channel index of each of the first four channels in OIIO order
+    // (EXR stores channels sorted by name); -1 past nchannels.
+    int channel_order[4];
+    ptrdiff_t pixel_stride;
+    ptrdiff_t channel_stride;
+    ptrdiff_t row_stride;
+    // "dpx", "tiff" or "openexr".
+    char format_name[32];
+} OiioRawLayout;
+
+// Map `path` if its layout is supported. Returns owned handle, or NULL with
+// the reason in oiio_get_last_error when the file needs the regular decoder.
+OiioRawImage * oiio_raw_image_open(const char * path);
+void oiio_raw_image_destroy(OiioRawImage * h);
+
+// Returns 1 and fills `out`, or 0 on a null argument.
+int oiio_raw_image_layout(const OiioRawImage * h, OiioRawLayout * out);
+// First stored sample of row 0, valid until the handle is destroyed. The
+// bytes are the file itself: they change if the file is written in place,
+// and reading them faults if it is truncated.
+// `out_len` (optional) receives the bytes up to the end of the last sample.
+const void * oiio_raw_image_data(const OiioRawImage * h, size_t * out_len);
+
+// Convert rows [ybegin, yend) to RGBA f32 (same channel mapping as
+// oiio_image_input_read_rgba_f32) into buf, whose rows are row_stride bytes
+// apart (0 = packed). buf_len is the total number of floats at buf.
+// Returns 1 on success, 0 on error.
+int oiio_raw_image_read_rgba_f32(
+    const OiioRawImage * h,
+    int ybegin,
+    int yend,
+    float * buf,
+    size_t buf_len,
+    ptrdiff_t row_stride);
+
+// ── Sequence prefetch ────────────────────────────────────────────────────────
+//
+// Background decode threads keep a bounded ring of RGBA f32 frames around
+// a playhead. Frames are read ahead in the play direction (and a shorter
+// distance behind it), downscaled at decode time like
+// oiio_image_input_read_rgba_f32_fit.
+
+// Frame states returned by oiio_sequence_frame_status.
+enum
+{
+    OIIO_FRAME_ABSENT = 0,
+    OIIO_FRAME_LOADING = 1,
+    OIIO_FRAME_READY = 2,
+    OIIO_FRAME_FAILED = 3,
+};
+
+// A decoded frame pinned by oiio_sequence_acquire_frame. `pixels` holds
+// width * height * 4 floats and stays valid until the matching
+// oiio_sequence_release_frame.
+typedef struct OiioSequenceFrame
+{
+    int frame;
+    int width;
+    int height;
+    const float * pixels;
+} OiioSequenceFrame;
+
+// Create a prefetcher for frames [first_frame, last_frame] of `pattern`,
+// where the frame number token is a run of '#' or printf-style %0Nd.
+// ring_size frames are kept resident; num_threads <= 0 picks a default.
+// Non-positive max_width/max_height decode at full size.
+// Returns owned handle or NULL on error.
+OiioSequence * oiio_sequence_create(
+    const char * pattern,
+    int first_frame,
+    int last_frame,
+    int ring_size,
+    int num_threads,
+    int max_width,
+    int max_height);
+void oiio_sequence_destroy(OiioSequence * seq);
+
+// Move the playhead. direction > 0 reads ahead forwards, < 0 backwards,
+// 0 (paused / scrubbing) splits the ring evenly on both sides.
+void oiio_sequence_set_playhead(OiioSequence * seq, int frame, int direction);
+
+int oiio_sequence_frame_status(OiioSequence * seq, int frame);
+
+// Pin a decoded frame. Waits up to timeout_ms (0 polls, < 0 waits until the
+// frame settles or leaves the prefetch window). Returns 1 and fills `out`
+// on success, 0 if the frame is not ready, -1 if it failed to decode
+// (check oiio_get_last_error).
+int oiio_sequence_acquire_frame(
+    OiioSequence * seq,
+    int frame,
+    int timeout_ms,
+    OiioSequenceFrame * out);
+// Unpin a frame returned by oiio_sequence_acquire_frame.
+void oiio_sequence_release_frame(OiioSequence * seq, int frame);
+
+// ── Image output ─────────────────────────────────────────────────────────────
+
+// File bit depth.
+enum
+{
+    OIIO_BIT_DEPTH_UINT8 = 0,
+    OIIO_BIT_DEPTH_UINT10 = 1,
+    OIIO_BIT_DEPTH_UINT12 = 2,
+    OIIO_BIT_DEPTH_UINT16 = 3,
+    OIIO_BIT_DEPTH_F16 = 4,
+    OIIO_BIT_DEPTH_F32 = 5,
+};
+
+typedef struct OiioOutputOptions
+{
+    int bit_depth;
+    // Format-specific compression, e.g. "zip", "piz", "dwaa:45"; NULL or
+    // empty keeps the writer default.
+    const char * compression;
+    // Tile size; 0 writes scanlines. Ignored by formats without tiles.
+    int tile_width;
+    int tile_height;
+    // Written as "oiio:ColorSpace" metadata when non-NULL.
+    const char * color_space;
+    // 1 writes RGBA, 0 writes RGB (source alpha is skipped).
+    int write_alpha;
+} OiioOutputOptions;
+
+// Open `path` for writing a width x height image. The format is chosen
+// from the file extension. Returns owned handle or NULL on error.
+OiioImageOutput * oiio_image_output_open(
+    const char * path,
+    int width,
+    int height,
+    const OiioOutputOptions * options);
+
+// Tile size actually used (0 when the format fell back to scanlines).
+int oiio_image_output_tile_width(const OiioImageOutput * h);
+int oiio_image_output_tile_height(const OiioImageOutput * h);
+
+// Write rows [ybegin, yend) from an RGBA source whose rows are row_stride
+// bytes apart (0 = packed). Returns 1 on success, 0 on error.
+int oiio_image_output_write_scanlines(
+    OiioImageOutput * h,
+    int ybegin,
+    int yend,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride);
+
+// Write the tile-aligned region [xbegin, xend) x [ybegin, yend) from an
+// RGBA source (row_stride 0 = packed region). Tiled outputs only.
+int oiio_image_output_write_tiles(
+    OiioImageOutput * h,
+    int xbegin,
+    int xend,
+    int ybegin,
+    int yend,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride);
+
+// Write the whole image, scanline or tiled, from an RGBA source.
+int oiio_image_output_write_image(
+    OiioImageOutput * h,
+    int src_format,
+    const void * data,
+    ptrdiff_t row_stride);
+
+// Finish the file. Returns 1 on success, 0 on error. Further writes fail.
+int oiio_image_output_close(OiioImageOutput * h);
+// Close (if still open) and free the handle.
+void oiio_image_output_destroy(OiioImageOutput * h);
+
+// ── Async writer ─────────────────────────────────────────────────────────────
+//
+// Double-buffered background encoding: acquire a staging buffer, fill it,
+// submit it with a path and options, and keep working while a writer
+// thread encodes it. Buffers are recycled across frames.
+
+// num_buffers is clamped to >= 2; num_threads is the per-file encode
+// thread hint (0 = global default). Returns owned handle or NULL on error.
+OiioAsyncWriter * oiio_async_writer_create(int num_buffers, int num_threads);
+// Finishes every submitted frame, then frees the writer.
+void oiio_async_writer_destroy(OiioAsyncWriter * w);
+
+// Block until a staging buffer is free and return it with at least `bytes`
+// bytes (16-byte aligned); its id is written to out_id. NULL on error.
+void * oiio_async_writer_acquire(OiioAsyncWriter * w, size_t bytes, int * out_id);
+// Return an acquired buffer without writing it.
+void oiio_async_writer_discard(OiioAsyncWriter * w, int id);
+
+// Queue an acquired buffer holding a width x height RGBA image (rows
+// row_stride bytes apart, 0 = packed) to be written to `path`. The buffer
+// must not be touched until it is acquired again. Returns 1 on success.
+int oiio_async_writer_submit(
+    OiioAsyncWriter * w,
+    int id,
+    const char * path,
+    int width,
+    int height,
+    int src_format,
+    ptrdiff_t row_stride,
+    const OiioOutputOptions * options);
+
+// Wait for all queued frames. Returns the number of frames that failed
+// since the last flush (the first error is in oiio_get_last_error), or -1.
+int oiio_async_writer_flush(OiioAsyncWriter * w);
+
+// ── Thumbnails ───────────────────────────────────────────────────────────────
+
+// Optional per-thumbnail color transform, e.g. an OCIO display processor.
+// Receives the path index and packed RGBA f32 pixels before 8-bit
+// quantization, and may be called from several threads at once. Returns
+// nonzero on success; on zero that thumbnail fails.
+typedef int (*OiioThumbnailTransform)(
+    void * user_data,
+    int index,
+    float * rgba,
+    int width,
+    int height);
+
+// One decoded thumbnail: packed RGBA8, owned by the batch.
+typedef struct OiioThumbnail
+{
+    int width;
+    int height;
+    const unsigned char * pixels;
+} OiioThumbnail;
+
+// Decode `count` files into thumbnails no larger than max_edge on their
+// longest side, on up to num_threads threads (0 = one per hardware thread).
+// Uses an embedded thumbnail or the smallest covering MIP level when the
+// file has one, and a box filter for the remaining reduction. Blocks until
+// every file is done; per-file failures are reported by
+// oiio_thumbnail_batch_get. Returns NULL only on invalid arguments.
+OiioThumbnailBatch * oiio_thumbnails_generate(
+    const char * const * paths,
+    int count,
+    int max_edge,
+    int num_threads,
+    OiioThumbnailTransform transform,
+    void * user_data);
+
+// Fetch thumbnail `index`. Returns 1 on success; 0 if that file failed
+// (reason in oiio_get_last_error). Pixels stay valid until the batch is
+// destroyed.
+int oiio_thumbnail_batch_get(
+    const OiioThumbnailBatch * batch,
+    int index,
+    OiioThumbnail * out);
+void oiio_thumbnail_batch_destroy(OiioThumbnailBatch * batch);
+
+// ── Batch export ─────────────────────────────────────────────────────────────
+//
+// Headless read -> transform -> write of whole sequences. Decode, transform
+// and encode run as concurrent stages, each on its own threads, joined by
+// bounded frame queues; frame buffers are recycled once encoded, so memory
+// stays at (threads + 2 * queue_depth) frames however long the batch is.
+
+// Per-frame color transform, e.g. an OCIO CPU processor. Receives the job
+// index and packed RGBA f32 pixels to modify in place; called from several
+// transform threads at once. Returns nonzero on success.
+typedef int (*OiioBatchTransform)(
+    void * user_data, int index, float * rgba, int width, int height);
+
+// Running totals of a batch export. Stage times are summed over the stage's
+// threads and exclude time spent waiting on the queues, so the stage with
+// the largest time per thread is the bottleneck.
+typedef struct OiioBatchStats
+{
+    int frames_total;
+    int frames_written;
+    int frames_failed;
+    // Pixels of the frames written so far.
+    unsigned long long pixels_written;
+    unsigned long long elapsed_ns;
+    unsigned long long decode_ns;
+    unsigned long long transform_ns;
+    unsigned long long encode_ns;
+} OiioBatchStats;
+
+// Called after every frame is written (ok = 1) or fails (ok = 0), from the
+// thread that finished it; calls are serialized. Return 0 to cancel: frames
+// not yet decoded are skipped and fail as cancelled, frames in flight finish.
+typedef int (*OiioBatchProgress)(
+    void * user_data, int index, int ok, const OiioBatchStats * stats);
+
+typedef struct OiioBatchOptions
+{
+    // Stage thread counts. 0 = 2 decode / 2 encode threads and one transform
+    // thread per hardware thread. Each decoder and encoder works on one file
+    // single-threaded; parallelism comes from files in flight.
+    int decode_threads;
+    int transform_threads;
+    int encode_threads;
+    // Frames buffered between consecutive stages; 0 = 2.
+    int queue_depth;
+    // Fit bound as in oiio_image_input_read_rgba_f32_fit; 0 = full size.
+    int max_width;
+    int max_height;
+} OiioBatchOptions;
+
+// Read each inputs[i], apply `transform` (may be NULL) and write it to
+// outputs[i] encoded with `output`. `options` may be NULL for defaults.
+// Blocks until every job is done or the batch is cancelled; per-job
+// failures are reported by oiio_batch_export_result. Returns NULL only on
+// invalid arguments.
+//
+// Each output keeps its input's metadata (timecode, pixel aspect, EXR
+// attributes, ...) and its data/display windows, scaled with the frame.
+// `output` settings win over the source's, so set output->color_space
+// when `transform` converts to another color space.
+OiioBatchExport * oiio_batch_export_run(
+    const char * const * inputs,
+    const char * const * outputs,
+    int count,
+    const OiioBatchOptions * options,
+    const OiioOutputOptions * output,
+    OiioBatchTransform transform,
+    OiioBatchProgress progress,
+    void * user_data);
+
+// Returns 1 if job `index` was written; 0 if it failed (reason in
+// oiio_get_last_error).
+int oiio_batch_export_result(const OiioBatchExport * batch, int index);
+// Final totals of the batch.
+void oiio_batch_export_get_stats(const OiioBatchExport * batch, OiioBatchStats * out);
+void oiio_batch_export_destroy(OiioBatchExport * batch);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,790 @@
+#pragma once
+
+// Layout detection for image files whose pixels can be read straight out of
+// a memory mapping, skipping the OIIO decoder entirely.
+//
+// Recognised: uncompressed DPX (8-bit big-endian, 16-bit, and 10-bit RGB
+// filled into 32-bit words), uncompressed strip TIFF with contiguous
+// interleaved strips (8/16-bit uint, 16/32-bit float), and uncompressed
+// single-part scanline EXR with R,G,B[,A] or Y[,A] channels of one sample
+// type. Anything else is rejected with a reason so callers can fall back to
+// the regular decoder.
+//
+// Stored samples of every supported layout are addressed as
+//   data + data_offset + y * row_stride + x * pixel_stride + c * channel_stride
+// which covers interleaved DPX/TIFF rows and EXR's per-row channel planes.
+// Only headers are parsed here; conversion reads the mapping directly, so a
+// parsed layout is immutable and safe to share between reader threads.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace crispen
+{
+
+enum class RawSample
+{
+    U8,
+    U16,
+    // Three 10-bit samples per 32-bit word, DPX "filled" method A (two
+    // padding bits at the bottom) or method B (two padding bits at the top).
+    U10FilledA,
+    U10FilledB,
+    F16,
+    F32,
+};
+
+struct RawLayout
+{
+    const char * format_name = "";
+    int width = 0;
+    int height = 0;
+    int nchannels = 0;
+    RawSample sample = RawSample::U8;
+    int bits_per_sample = 0;
+    bool big_endian = false;
+    // File offset of the first sample of row 0.
+    std::size_t data_offset = 0;
+    // Byte steps between pixels, stored channels and rows. Packed 10-bit
+    // pixels are a single word, so their channel stride is 0.
+    std::ptrdiff_t pixel_stride = 0;
+    std::ptrdiff_t channel_stride = 0;
+    std::ptrdiff_t row_stride = 0;
+    // Stored index of each of the first four channels in OIIO's channel
+    // order (EXR keeps channels sorted by name, OIIO reports R,G,B,A).
+    int channel_order[4] = {0, 1, 2, 3};
+};
+
+inline std::size_t raw_sample_bytes(RawSample sample)
+{
+    switch (sample)
+    {
+    case RawSample::U8:
+        return 1;
+    case RawSample::U16:
+    case RawSample::F16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+namespace raw_detail
+{
+
+inline std::uint16_t load_u16(const unsigned char * p, bool big_endian)
+{
+    return big_endian ? static_cast<std::uint16_t>((p[0] << 8) | p[1])
+                      : static_cast<std::uint16_t>((p[1] << 8) | p[0]);
+}
+
+inline std::uint32_t load_u32(const unsigned char * p, bool big_endian)
+{
+    const std::uint32_t b0 = p[0], b1 = p[1], b2 = p[2], b3 = p[3];
+    return big_endian ? (b0 << 24) | (b1 << 16) | (b2 << 8) | b3
+                      : (b3 << 24) | (b2 << 16) | (b1 << 8) | b0;
+}
+
+inline std::uint64_t load_u64_le(const unsigned char * p)
+{
+    return static_cast<std::uint64_t>(load_u32(p, false))
+           | (static_cast<std::uint64_t>(load_u32(p + 4, false)) << 32);
+}
+
+inline bool in_bounds(std::uint64_t offset, std::uint64_t len, std::size_t size)
+{
+    return offset <= size && len <= size - offset;
+}
+
+// ── DPX ──────────────────────────────────────────────────────────────────────
+
+// SMPTE 268M field offsets used below.
+constexpr std::size_t k_dpx_header_bytes = 2048;
+constexpr std::size_t k_dpx_orientation = 768;
+constexpr std::size_t k_dpx_element = 780;
+
+inline const char * parse_dpx(const unsigned char * data, std::size_t size, RawLayout & out)
+{
+    if (size < k_dpx_header_bytes)
+    {
+        return "truncated DPX header";
+    }
+    const bool be = std::memcmp(data, "SDPX", 4) == 0;
+    const unsigned char * el = data + k_dpx_element;
+    const std::uint32_t image_offset = load_u32(data + 4, be);
+    const std::uint16_t orientation = load_u16(data + k_dpx_orientation, be);
+    const std::uint16_t elements = load_u16(data + k_dpx_orientation + 2, be);
+    const std::uint32_t width = load_u32(data + k_dpx_orientation + 4, be);
+    const std::uint32_t height = load_u32(data + k_dpx_orientation + 8, be);
+    const std::uint32_t data_sign = load_u32(el, be);
+    const unsigned descriptor = el[20];
+    const unsigned bit_size = el[23];
+    const std::uint16_t packing = load_u16(el + 24, be);
+    const std::uint16_t encoding = load_u16(el + 26, be);
+    const std::uint32_t element_offset = load_u32(el + 28, be);
+    std::uint32_t eol_padding = load_u32(el + 32, be);
+
+    if (orientation != 0)
+    {
+        return "DPX orientation is not left-to-right, top-to-bottom";
+    }
+    if (elements != 1)
+    {
+        return "multi-element DPX";
+    }
+    if (data_sign != 0 || encoding != 0)
+    {
+        return "signed or RLE-encoded DPX";
+    }
+    switch (descriptor)
+    {
+    case 6:
+        out.nchannels = 1;
+        break;
+    case 50:
+        out.nchannels = 3;
+        break;
+    case 51:
+        out.nchannels = 4;
+        break;
+    default:
+        return "unsupported DPX descriptor";
+    }
+
+    switch (bit_size)
+    {
+    case 8:
+        // Little-endian writers swap bytes within each 32-bit word.
+        if (!be)
+        {
+            return "8-bit little-endian DPX";
+        }
+        out.sample = RawSample::U8;
+        break;
+    case 16:
+        out.sample = RawSample::U16;
+        break;
+    case 10:
+        // Other channel counts straddle word boundaries.
+        if (out.nchannels != 3 || (packing != 1 && packing != 2))
+        {
+            return "10-bit DPX that is not filled RGB";
+        }
+        out.sample = packing == 1 ? RawSample::U10FilledA : RawSample::U10FilledB;
+        break;
+    default:
+        return "unsupported DPX bit depth";
+    }
+
+    out.format_name = "dpx";
+    out.width = static_cast<int>(std::min<std::uint32_t>(width, INT32_MAX));
+    out.height = static_cast<int>(std::min<std::uint32_t>(height, INT32_MAX));
+    out.bits_per_sample = static_cast<int>(bit_size);
+    out.big_endian = be;
+    out.data_offset = element_offset != 0 && element_offset != 0xFFFFFFFFu ? element_offset
+                                                                           : image_offset;
+    const bool packed = out.sample == RawSample::U10FilledA
+                        || out.sample == RawSample::U10FilledB;
+    out.pixel_stride =
+        static_cast<std::ptrdiff_t>(packed ? 4 : out.nchannels * raw_sample_bytes(out.sample));
+    out.channel_stride = packed ? 0 : static_cast<std::ptrdiff_t>(raw_sample_bytes(out.sample));
+    // Rows start on 32-bit word boundaries; 0xFFFFFFFF means "undefined".
+    if (eol_padding == 0xFFFFFFFFu)
+    {
+        eol_padding = 0;
+    }
+    const std::uint64_t row_bytes =
+        (static_cast<std::uint64_t>(out.pixel_stride) * out.width + 3) & ~3ull;
+    out.row_stride = static_cast<std::ptrdiff_t>(row_bytes + eol_padding);
+    return nullptr;
+}
+
+// ── TIFF ─────────────────────────────────────────────────────────────────────
+
+struct TiffEntry
+{
+    std::uint16_t type = 0;
+    std::uint32_t count = 0;
+    // Offset of the value itself (inline or out of line).
+    std::size_t value = 0;
+};
+
+// Value `i` of a SHORT or LONG entry; false if out of bounds or another type.
+inline bool tiff_value(
+    const unsigned char * data,
+    std::size_t size,
+    bool be,
+    const TiffEntry & e,
+    std::uint32_t i,
+    std::uint32_t & out)
+{
+    const std::size_t bytes = e.type == 3 ? 2 : e.type == 4 ? 4 : 0;
+    if (bytes == 0 || i >= e.count || !in_bounds(e.value + std::uint64_t(i) * bytes, bytes, size))
+    {
+        return false;
+    }
+    const unsigned char * p = data + e.value + std::size_t(i) * bytes;
+    out = bytes == 2 ? load_u16(p, be) : load_u32(p, be);
+    return true;
+}
+
+inline const char * parse_tiff(const unsigned char * data, std::size_t size, RawLayout & out)
+{
+    const bool be = data[0] == 'M';
+    if (load_u16(data + 2, be) != 42)
+    {
+        return "BigTIFF or malformed TIFF header";
+    }
+    const std::uint32_t ifd = load_u32(data + 4, be);
+    if (!in_bounds(ifd, 2, size))
+    {
+        return "truncated TIFF directory";
+    }
+    const std::uint16_t nentries = load_u16(data + ifd, be);
+    if (!in_bounds(ifd + 2ull, nentries * 12ull, size))
+    {
+        return "truncated TIFF directory";
+    }
+
+    std::uint32_t width = 0, height = 0, spp = 1, compression = 1, photometric = 2;
+    std::uint32_t rows_per_strip = UINT32_MAX, planar = 1, sample_format = 1, orientation = 1;
+    TiffEntry bits, offsets, byte_counts;
+    for (std::uint16_t i = 0; i < nentries; ++i)
+    {
+        const unsigned char * p = data + ifd + 2 + std::size_t(i) * 12;
+        TiffEntry e;
+        const std::uint16_t tag = load_u16(p, be);
+        e.type = load_u16(p + 2, be);
+        e.count = load_u32(p + 4, be);
+        const std::size_t bytes = e.type == 3 ? 2 : 4;
+        e.value = std::uint64_t(e.count) * bytes <= 4 ? std::size_t(p + 8 - data)
+                                                      : load_u32(p + 8, be);
+        std::uint32_t v = 0;
+        const bool scalar = tiff_value(data, size, be, e, 0, v);
+        switch (tag)
+        {
+        case 256:
+            width = scalar ? v : 0;
+            break;
+        case 257:
+            height = scalar ? v : 0;
+            break;
+        case 258:
+            bits = e;
+            break;
+        case 259:
+            compression = scalar ? v : 0;
+            break;
+        case 262:
+            photometric = scalar ? v : 0;
+            break;
+        case 273:
+            offsets = e;
+            break;
+        case 274:
+            orientation = scalar ? v : 0;
+            break;
+        case 277:
+            spp = scalar ? v : 0;
+            break;
+        case 278:
+            rows_per_strip = scalar ? v : 0;
+            break;
+        case 279:
+            byte_counts = e;
+            break;
+        case 284:
+            planar = scalar ? v : 0;
+            break;
+        case 322:
+        case 323:
+        case 324:
+        case 325:
+            return "tiled TIFF";
+        case 339:
+            sample_format = scalar ? v : 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (compression != 1)
+    {
+        return "compressed TIFF";
+    }
+    if (planar != 1 || orientation != 1)
+    {
+        return "planar or reoriented TIFF";
+    }
+    // 0 (min-is-white) and palette images need a remap.
+    if (photometric != 1 && photometric != 2)
+    {
+        return "unsupported TIFF photometric interpretation";
+    }
+    if (width == 0 || height == 0 || spp == 0 || width > INT32_MAX || height > INT32_MAX)
+    {
+        return "unsupported TIFF dimensions";
+    }
+    std::uint32_t bps = 0;
+    for (std::uint32_t c = 0; c < spp; ++c)
+    {
+        std::uint32_t b = 0;
+        if (!tiff_value(data, size, be, bits, c, b) || (c > 0 && b != bps))
+        {
+            return "TIFF channels differ in bit depth";
+        }
+        bps = b;
+    }
+    if (sample_format == 1 && bps == 8)
+    {
+        out.sample = RawSample::U8;
+    }
+    else if (sample_format == 1 && bps == 16)
+    {
+        out.sample = RawSample::U16;
+    }
+    else if (sample_format == 3 && bps == 16)
+    {
+        out.sample = RawSample::F16;
+    }
+    else if (sample_format == 3 && bps == 32)
+    {
+        out.sample = RawSample::F32;
+    }
+    else
+    {
+        return "unsupported TIFF sample format";
+    }
+
+    // One contiguous run of strips, each holding whole packed rows.
+    const std::uint64_t row_bytes = std::uint64_t(width) * spp * (bps / 8);
+    const std::uint32_t rps = std::min(std::max(rows_per_strip, 1u), height);
+    const std::uint32_t nstrips = (height + rps - 1) / rps;
+    if (offsets.count != nstrips || byte_counts.count != nstrips)
+    {
+        return "TIFF strip table does not match the image height";
+    }
+    std::uint32_t first = 0;
+    if (!tiff_value(data, size, be, offsets, 0, first))
+    {
+        return "malformed TIFF strip table";
+    }
+    for (std::uint32_t s = 0; s < nstrips; ++s)
+    {
+        const std::uint32_t rows = std::min(rps, height - s * rps);
+        std::uint32_t offset = 0, count = 0;
+        if (!tiff_value(data, size, be, offsets, s, offset)
+            || !tiff_value(data, size, be, byte_counts, s, count))
+        {
+            return "malformed TIFF strip table";
+        }
+        if (offset != first + std::uint64_t(s) * rps * row_bytes || count < rows * row_bytes)
+        {
+            return "TIFF strips are not contiguous";
+        }
+    }
+
+    out.format_name = "tiff";
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    out.nchannels = static_cast<int>(spp);
+    out.bits_per_sample = static_cast<int>(bps);
+    out.big_endian = be;
+    out.data_offset = first;
+    out.channel_stride = static_cast<std::ptrdiff_t>(bps / 8);
+    out.pixel_stride = out.channel_stride * spp;
+    out.row_stride = static_cast<std::ptrdiff_t>(row_bytes);
+    return nullptr;
+}
+
+// ── OpenEXR ──────────────────────────────────────────────────────────────────
+
+constexpr std::uint32_t k_exr_tiled = 0x200;
+constexpr std::uint32_t k_exr_deep = 0x800;
+constexpr std::uint32_t k_exr_multipart = 0x1000;
+// Bytes of the (y, packed size) header in front of every scanline chunk.
+constexpr std::size_t k_exr_chunk_header = 8;
+// Upper bound on stored channels considered.
+constexpr int k_exr_max_channels = 16;
+
+// Length of the NUL-terminated string at `pos`, or 0 if it runs off the end.
+inline std::size_t exr_string(const unsigned char * data, std::size_t size, std::size_t pos)
+{
+    const void * nul = pos < size ? std::memchr(data + pos, 0, size - pos) : nullptr;
+    return nul ? static_cast<const unsigned char *>(nul) - (data + pos) + 1 : 0;
+}
+
+inline const char * parse_exr(const unsigned char * data, std::size_t size, RawLayout & out)
+{
+    const std::uint32_t version = load_u32(data + 4, false);
+    if ((version & 0xFF) != 2)
+    {
+        return "unsupported EXR version";
+    }
+    if (version & (k_exr_tiled | k_exr_deep | k_exr_multipart))
+    {
+        return "tiled, deep or multi-part EXR";
+    }
+
+    std::size_t pos = 8;
+    std::size_t channels_pos = 0, channels_end = 0;
+    int compression = -1, line_order = 0;
+    std::int32_t window[4] = {0, 0, -1, -1};
+    for (;;)
+    {
+        const std::size_t name_len = exr_string(data, size, pos);
+        if (name_len == 0)
+        {
+            return "truncated EXR header";
+        }
+        if (name_len == 1)
+        {
+            ++pos;
+            break;
+        }
+        const char * name = reinterpret_cast<const char *>(data + pos);
+        const std::size_t type_len = exr_string(data, size, pos + name_len);
+        const std::size_t value_pos = pos + name_len + type_len + 4;
+        if (type_len == 0 || !in_bounds(value_pos - 4, 4, size))
+        {
+            return "truncated EXR header";
+        }
+        const std::uint32_t value_len = load_u32(data + value_pos - 4, false);
+        if (!in_bounds(value_pos, value_len, size))
+        {
+            return "truncated EXR header";
+        }
+        if (std::strcmp(name, "channels") == 0)
+        {
+            channels_pos = value_pos;
+            channels_end = value_pos + value_len;
+        }
+        else if (std::strcmp(name, "compression") == 0 && value_len == 1)
+        {
+            compression = data[value_pos];
+        }
+        else if (std::strcmp(name, "lineOrder") == 0 && value_len == 1)
+        {
+            line_order = data[value_pos];
+        }
+        else if (std::strcmp(name, "dataWindow") == 0 && value_len == 16)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                window[i] = static_cast<std::int32_t>(load_u32(data + value_pos + i * 4, false));
+            }
+        }
+        pos = value_pos + value_len;
+    }
+
+    if (compression != 0)
+    {
+        return "compressed EXR";
+    }
+    if (line_order != 0)
+    {
+        return "EXR line order is not increasing Y";
+    }
+    const std::int64_t width = std::int64_t(window[2]) - window[0] + 1;
+    const std::int64_t height = std::int64_t(window[3]) - window[1] + 1;
+    if (width <= 0 || height <= 0 || width > INT32_MAX || height > INT32_MAX)
+    {
+        return "unsupported EXR data window";
+    }
+
+    // Stored channels, sorted by name: name, pixel type, pLinear + 3
+    // reserved bytes, x and y sampling.
+    char names[k_exr_max_channels] = {};
+    int nchannels = 0;
+    std::uint32_t pixel_type = 0;
+    for (std::size_t p = channels_pos; p < channels_end && data[p] != 0;)
+    {
+        const std::size_t len = exr_string(data, channels_end, p);
+        if (len == 0 || !in_bounds(p + len, 16, channels_end) || nchannels == k_exr_max_channels)
+        {
+            return "malformed EXR channel list";
+        }
+        const std::uint32_t type = load_u32(data + p + len, false);
+        const std::uint32_t xs = load_u32(data + p + len + 8, false);
+        const std::uint32_t ys = load_u32(data + p + len + 12, false);
+        if (len != 2 || xs != 1 || ys != 1 || (nchannels > 0 && type != pixel_type))
+        {
+            return "EXR channels are layered, subsampled or of mixed types";
+        }
+        names[nchannels++] = static_cast<char>(data[p]);
+        pixel_type = type;
+        p += len + 16;
+    }
+    if (pixel_type != 1 && pixel_type != 2)
+    {
+        return "unsupported EXR pixel type";
+    }
+
+    auto index_of = [&](char c)
+    {
+        const char * it = std::find(names, names + nchannels, c);
+        return it == names + nchannels ? -1 : static_cast<int>(it - names);
+    };
+    const int r = index_of('R'), g = index_of('G'), b = index_of('B');
+    const int a = index_of('A'), y = index_of('Y');
+    if (r >= 0 && g >= 0 && b >= 0 && nchannels == (a >= 0 ? 4 : 3))
+    {
+        out.channel_order[0] = r;
+        out.channel_order[1] = g;
+        out.channel_order[2] = b;
+        out.channel_order[3] = a;
+    }
+    else if (y >= 0 && nchannels == (a >= 0 ? 2 : 1))
+    {
+        out.channel_order[0] = y;
+        out.channel_order[1] = a;
+    }
+    else
+    {
+        return "EXR channels are not R,G,B[,A] or Y[,A]";
+    }
+
+    out.format_name = "openexr";
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    out.nchannels = nchannels;
+    out.sample = pixel_type == 1 ? RawSample::F16 : RawSample::F32;
+    out.bits_per_sample = pixel_type == 1 ? 16 : 32;
+    out.big_endian = false;
+
+    // The offset table follows the header; uncompressed scanline files
+    // store one row per chunk, and the rows must sit back to back.
+    const std::uint64_t row_bytes = std::uint64_t(width) * nchannels * raw_sample_bytes(out.sample);
+    const std::uint64_t chunk_bytes = k_exr_chunk_header + row_bytes;
+    if (!in_bounds(pos, std::uint64_t(height) * 8, size))
+    {
+        return "truncated EXR offset table";
+    }
+    const std::uint64_t first = load_u64_le(data + pos);
+    for (std::int64_t row = 1; row < height; ++row)
+    {
+        if (load_u64_le(data + pos + row * 8) != first + row * chunk_bytes)
+        {
+            return "EXR scanlines are not contiguous";
+        }
+    }
+    if (!in_bounds(first, k_exr_chunk_header, size)
+        || static_cast<std::int32_t>(load_u32(data + first, false)) != window[1]
+        || load_u32(data + first + 4, false) != row_bytes)
+    {
+        return "malformed EXR scanline chunk";
+    }
+
+    out.data_offset = static_cast<std::size_t>(first + k_exr_chunk_header);
+    out.pixel_stride = static_cast<std::ptrdiff_t>(raw_sample_bytes(out.sample));
+    out.channel_stride = out.pixel_stride * out.width;
+    out.row_stride = static_cast<std::ptrdiff_t>(chunk_bytes);
+    return nullptr;
+}
+
+// ── Sample conversion ────────────────────────────────────────────────────────
+
+inline float half_to_float(std::uint16_t h)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    std::uint32_t exponent = (h >> 10) & 0x1Fu;
+    std::uint32_t mantissa = h & 0x3FFu;
+    std::uint32_t bits;
+    if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0)
+    {
+        bits = sign;
+    }
+    else
+    {
+        // Subnormal: renormalize into a float exponent.
+        exponent = 113;
+        while (!(mantissa & 0x400u))
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+template <bool BigEndian>
+float load_sample(RawSample sample, const unsigned char * p, int channel)
+{
+    switch (sample)
+    {
+    case RawSample::U8:
+        return p[0] * (1.0f / 255.0f);
+    case RawSample::U16:
+        return load_u16(p, BigEndian) * (1.0f / 65535.0f);
+    case RawSample::U10FilledA:
+        return ((load_u32(p, BigEndian) >> (22 - 10 * channel)) & 0x3FFu) * (1.0f / 1023.0f);
+    case RawSample::U10FilledB:
+        return ((load_u32(p, BigEndian) >> (20 - 10 * channel)) & 0x3FFu) * (1.0f / 1023.0f);
+    case RawSample::F16:
+        return half_to_float(load_u16(p, BigEndian));
+    case RawSample::F32:
+    {
+        const std::uint32_t bits = load_u32(p, BigEndian);
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+    }
+    return 0.0f;
+}
+
+template <bool BigEndian, RawSample Sample>
+void convert_rows(
+    const RawLayout & layout,
+    const unsigned char * data,
+    int ybegin,
+    int yend,
+    float * rgba,
+    std::ptrdiff_t ystride)
+{
+    const int nread = std::min(layout.nchannels, 4);
+    for (int y = ybegin; y < yend; ++y)
+    {
+        const unsigned char * row =
+            data + layout.data_offset + static_cast<std::ptrdiff_t>(y) * layout.row_stride;
+        float * out = reinterpret_cast<float *>(
+            reinterpret_cast<char *>(rgba) + static_cast<std::ptrdiff_t>(y - ybegin) * ystride);
+        for (int c = 0; c < nread; ++c)
+        {
+            const int ch = layout.channel_order[c];
+            const unsigned char * src = row + ch * layout.channel_stride;
+            for (int x = 0; x < layout.width; ++x)
+            {
+                out[x * 4 + c] = load_sample<BigEndian>(Sample, src + x * layout.pixel_stride, ch);
+            }
+        }
+    }
+}
+
+template <bool BigEndian>
+void convert_rows(
+    const RawLayout & layout,
+    const unsigned char * data,
+    int ybegin,
+    int yend,
+    float * rgba,
+    std::ptrdiff_t ystride)
+{
+    // Per-sample dispatch is hoisted out of the loops, one instantiation
+    // per stored sample type.
+    switch (layout.sample)
+    {
+    case RawSample::U8:
+        convert_rows<BigEndian, RawSample::U8>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    case RawSample::U16:
+        convert_rows<BigEndian, RawSample::U16>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    case RawSample::U10FilledA:
+        convert_rows<BigEndian, RawSample::U10FilledA>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    case RawSample::U10FilledB:
+        convert_rows<BigEndian, RawSample::U10FilledB>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    case RawSample::F16:
+        convert_rows<BigEndian, RawSample::F16>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    case RawSample::F32:
+        convert_rows<BigEndian, RawSample::F32>(layout, data, ybegin, yend, rgba, ystride);
+        break;
+    }
+}
+
+} // namespace raw_detail
+
+// Detect a mappable layout in the `size` bytes at `data`. Returns null on
+// success, otherwise a short reason the file needs the regular decoder.
+inline const char * parse_raw_layout(const unsigned char * data, std::size_t size, RawLayout & out)
+{
+    out = RawLayout{};
+    if (size < 8)
+    {
+        return "file too small";
+    }
+    const char * err = "not an uncompressed DPX, TIFF or EXR file";
+    if (std::memcmp(data, "SDPX", 4) == 0 || std::memcmp(data, "XPDS", 4) == 0)
+    {
+        err = raw_detail::parse_dpx(data, size, out);
+    }
+    else if (std::memcmp(data, "II", 2) == 0 || std::memcmp(data, "MM", 2) == 0)
+    {
+        err = raw_detail::parse_tiff(data, size, out);
+    }
+    else if (raw_detail::load_u32(data, false) == 20000630u)
+    {
+        err = raw_detail::parse_exr(data, size, out);
+    }
+    if (err)
+    {
+        return err;
+    }
+    if (out.width <= 0 || out.height <= 0 || out.nchannels <= 0)
+    {
+        return "image has zero dimensions";
+    }
+
+    // The last stored sample must lie inside the file.
+    const std::uint64_t end = out.data_offset
+                              + std::uint64_t(out.height - 1) * out.row_stride
+                              + std::uint64_t(out.width - 1) * out.pixel_stride
+                              + std::uint64_t(out.nchannels - 1) * out.channel_stride
+                              + raw_sample_bytes(out.sample);
+    if (end > size)
+    {
+        return "pixel data extends past the end of the file";
+    }
+    return nullptr;
+}
+
+// Bytes from the first stored sample to the end of the last one.
+inline std::size_t raw_data_bytes(const RawLayout & layout)
+{
+    return static_cast<std::size_t>(
+        std::uint64_t(layout.height - 1) * layout.row_stride
+        + std::uint64_t(layout.width - 1) * layout.pixel_stride
+        + std::uint64_t(layout.nchannels - 1) * layout.channel_stride
+        + raw_sample_bytes(layout.sample));
+}
+
+// Convert rows [ybegin, yend) into the first min(nchannels, 4) slots of
+// each RGBA f32 pixel of `rgba`, whose rows are `ystride` bytes apart.
+// Unsigned samples are normalized to [0, 1]. Reads only; any number of
+// threads may convert disjoint (or overlapping) bands concurrently.
+inline void convert_raw_rows(
+    const RawLayout & layout,
+    const unsigned char * data,
+    int ybegin,
+    int yend,
+    float * rgba,
+    std::ptrdiff_t ystride)
+{
+    if (layout.big_endian)
+    {
+        raw_detail::convert_rows<true>(layout, data, ybegin, yend, rgba, ystride);
+    }
+    else
+    {
+        raw_detail::convert_rows<false>(layout, data, ybegin, yend, rgba, ystride);
+    }
+}
+
+} // namespace crispen
@@ -0,0 +1,303 @@
+//! Headless batch export of whole sequences.
+//!
+//! [`batch_export`] reads every job's input, passes it through an optional
+//! float RGBA transform (typically an OCIO CPU processor) and writes it back
+//! out. Decode, transform and encode run concurrently on their own native
+//! threads, joined by bounded queues, and frame buffers are recycled once a
+//! frame is written, so a farm node keeps its disks and cores busy at the
+//! same time with memory fixed by the thread and queue counts.
+
+use std::ffi::{CString, c_int, c_void};
+use std::panic::{AssertUnwindSafe, catch_unwind};
+use std::path::PathBuf;
+use std::ptr::NonNull;
+use std::sync::{Mutex, PoisonError};
+use std::time::Duration;
+
+use crate::error::{OiioError, ffi_error};
+use crate::image_output::OiioOutputOptions;
+use crate::sys;
+
+/// One frame of a [`batch_export`]: read `input`, write `output` (format
+/// chosen by extension).
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioExportJob {
+    pub input: PathBuf,
+    pub output: PathBuf,
+}
+
+/// Float RGBA transform applied to each frame before encoding, e.g. a
+/// closure over an OCIO CPU processor. Called concurrently from the
+/// transform threads with the job index, packed pixels and the frame size.
+pub type OiioExportTransform<'a> =
+    &'a (dyn Fn(usize, &mut [[f32; 4]], u32, u32) -> Result<(), String> + Sync);
+
+/// Called after every frame is written (`true`) or fails (`false`), with
+/// the job index and the running totals. Calls are serialized. Returning
+/// `false` cancels the batch: frames not yet decoded fail as cancelled and
+/// frames already in flight still finish.
+pub type OiioExportProgress<'a> = &'a (dyn Fn(usize, bool, &OiioExportStats) -> bool + Sync);
+
+/// Settings for [`batch_export`].
+#[derive(Clone, Default)]
+pub struct OiioExportOptions<'a> {
+    /// Frames decoded at once; `0` uses two. Each file is decoded on one
+    /// thread, so this is also the number of files being read.
+    pub decode_threads: u32,
+    /// Transform threads; `0` uses one per hardware thread.
+    pub transform_threads: u32,
+    /// Frames encoded at once; `0` uses two.
+    pub encode_threads: u32,
+    /// Frames buffered between consecutive stages; `0` uses two.
+    pub queue_depth: u32,
+    /// Fit bound for proxies as in
+    /// [`OiioImageInput::read_rgba_f32_fit`](crate::OiioImageInput::read_rgba_f32_fit);
+    /// `0` keeps the full size.
+    pub max_width: u32,
+    pub max_height: u32,
+    /// Encoding of every output. Outputs otherwise keep their input's
+    /// metadata and data/display windows, so set
+    /// [`color_space`](OiioOutputOptions::color_space) when `transform`
+    /// converts to another color space.
+    pub output: OiioOutputOptions,
+    pub transform: Option<OiioExportTransform<'a>>,
+    pub progress: Option<OiioExportProgress<'a>>,
+}
+
+/// Running totals of a [`batch_export`].
+///
+/// Stage times are summed over the stage's threads and leave out time spent
+/// waiting on the queues: the stage with the most time per thread is the
+/// one holding the batch back.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct OiioExportStats {
+    pub frames_total: u32,
+    pub frames_written: u32,
+    pub frames_failed: u32,
+    pub pixels_written: u64,
+    pub elapsed: Duration,
+    pub decode_time: Duration,
+    pub transform_time: Duration,
+    pub encode_time: Duration,
+}
+
+impl OiioExportStats {
+    fn from_raw(raw: &sys::OiioBatchStats) -> Self {
+        Self {
+            frames_total: raw.frames_total.max(0) as u32,
+            frames_written: raw.frames_written.max(0) as u32,
+            frames_failed: raw.frames_failed.max(0) as u32,
+            pixels_written: raw.pixels_written,
+            elapsed: Duration::from_nanos(raw.elapsed_ns),
+            decode_time: Duration::from_nanos(raw.decode_ns),
+            transform_time: Duration::from_nanos(raw.transform_ns),
+            encode_time: Duration::from_nanos(raw.encode_ns),
+        }
+    }
+
+    /// Frames written per second of wall-clock time so far.
+    pub fn frames_per_second(&self) -> f64 {
+        f64::from(self.frames_written) / self.elapsed.as_secs_f64().max(f64::MIN_POSITIVE)
+    }
+
+    /// Megapixels written per second of wall-clock time so far.
+    pub fn megapixels_per_second(&self) -> f64 {
+        self.pixels_written as f64 / 1e6 / self.elapsed.as_secs_f64().max(f64::MIN_POSITIVE)
+    }
+}
+
+/// Outcome of a [`batch_export`].
+#[derive(Debug)]
+pub struct OiioExportReport {
+    /// One result per job, in order.
+    pub results: Vec<Result<(), OiioError>>,
+    pub stats: OiioExportStats,
+}
+
+struct ExportContext<'a> {
+    transform: Option<OiioExportTransform<'a>>,
+    progress: Option<OiioExportProgress<'a>>,
+    // Messages of failed transforms by job index; the native side only
+    // learns that the transform failed.
+    transform_errors: Mutex<Vec<Option<String>>>,
+}
+
+impl ExportContext<'_> {
+    fn record_transform_error(&self, index: usize, message: String) {
+        let mut errors = self
+            .transform_errors
+            .lock()
+            .unwrap_or_else(PoisonError::into_inner);
+        if let Some(slot) = errors.get_mut(index) {
+            *slot = Some(message);
+        }
+    }
+}
+
+unsafe extern "C" fn transform_trampoline(
+    user_data: *mut c_void,
+    index: c_int,
+    rgba: *mut f32,
+    width: c_int,
+    height: c_int,
+) -> c_int {
+    let (Ok(index), Ok(w), Ok(h)) = (
+        usize::try_from(index),
+        u32::try_from(width),
+        u32::try_from(height),
+    ) else {
+        return 0;
+    };
+    // SAFETY: `user_data` is the `ExportContext` owned by `batch_export`,
+    // which outlives the blocking native call, and `rgba` holds
+    // `width * height` packed RGBA pixels owned by this frame.
+    let (context, pixels) = unsafe {
+        (
+            &*user_data.cast::<ExportContext<'_>>(),
+            std::slice::from_raw_parts_mut(rgba.cast::<[f32; 4]>(), w as usize * h as usize),
+        )
+    };
+    let Some(transform) = context.transform else {
+        return 1;
+    };
+    // A panic must not unwind into the native threads.
+    match catch_unwind(AssertUnwindSafe(|| transform(index, pixels, w, h))) {
+        Ok(Ok(())) => 1,
+        Ok(Err(message)) => {
+            context.record_transform_error(index, message);
+            0
+        }
+        Err(_) => {
+            context.record_transform_error(index, "transform panicked".to_string());
+            0
+        }
+    }
+}
+
+unsafe extern "C" fn progress_trampoline(
+    user_data: *mut c_void,
+    index: c_int,
+    ok: c_int,
+    stats: *const sys::OiioBatchStats,
+) -> c_int {
+    // SAFETY: `user_data` is the `ExportContext` owned by `batch_export` and
+    // `stats` points to a snapshot valid for this call.
+    let (context, stats) = unsafe { (&*user_data.cast::<ExportContext<'_>>(), &*stats) };
+    let Some(progress) = context.progress else {
+        return 1;
+    };
+    let stats = OiioExportStats::from_raw(stats);
+    // A panicking callback cancels the batch rather than unwinding into the
+    // native threads.
+    match catch_unwind(AssertUnwindSafe(|| {
+        progress(index.max(0) as usize, ok != 0, &stats)
+    })) {
+        Ok(true) => 1,
+        _ => 0,
+    }
+}
+
+struct Batch {
+    ptr: NonNull<sys::OiioBatchExport>,
+}
+
+impl Drop for Batch {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_batch_export_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+fn to_c_int(v: u32) -> i32 {
+    v.min(i32::MAX as u32) as i32
+}
+
+/// Export `jobs`, blocking until every frame is written, has failed, or the
+/// batch was cancelled from the progress callback.
+///
+/// A frame that fails to decode, transform or encode does not affect the
+/// others; its error is in [`OiioExportReport::results`].
+pub fn batch_export(
+    jobs: &[OiioExportJob],
+    options: &OiioExportOptions<'_>,
+) -> Result<OiioExportReport, OiioError> {
+    let inputs = jobs
+        .iter()
+        .map(|job| CString::new(job.input.to_string_lossy().as_bytes()))
+        .collect::<Result<Vec<_>, _>>()?;
+    let outputs = jobs
+        .iter()
+        .map(|job| CString::new(job.output.to_string_lossy().as_bytes()))
+        .collect::<Result<Vec<_>, _>>()?;
+    let input_ptrs: Vec<_> = inputs.iter().map(|p| p.as_ptr()).collect();
+    let output_ptrs: Vec<_> = outputs.iter().map(|p| p.as_ptr()).collect();
+    let count =
+        i32::try_from(jobs.len()).map_err(|_| OiioError::InvalidArgument("too many jobs"))?;
+
+    let raw_options = sys::OiioBatchOptions {
+        decode_threads: to_c_int(options.decode_threads),
+        transform_threads: to_c_int(options.transform_threads),
+        encode_threads: to_c_int(options.encode_threads),
+        queue_depth: to_c_int(options.queue_depth),
+        max_width: to_c_int(options.max_width),
+        max_height: to_c_int(options.max_height),
+    };
+    let context = ExportContext {
+        transform: options.transform,
+        progress: options.progress,
+        transform_errors: Mutex::new(vec![None; jobs.len()]),
+    };
+    let transform = options
+        .transform
+        .map(|_| transform_trampoline as sys::OiioBatchTransform);
+    let progress = options
+        .progress
+        .map(|_| progress_trampoline as sys::OiioBatchProgress);
+    let user_data = std::ptr::from_ref(&context).cast_mut().cast::<c_void>();
+
+    let raw = options.output.with_raw(|output| {
+        // SAFETY: `input_ptrs` / `output_ptrs` hold `count` NUL-terminated
+        // strings kept alive by `inputs` / `outputs`, and `context` outlives
+        // the call, which blocks until every callback has returned.
+        unsafe {
+            sys::oiio_batch_export_run(
+                input_ptrs.as_ptr(),
+                output_ptrs.as_ptr(),
+                count,
+                &raw_options,
+                output,
+                transform,
+                progress,
+                user_data,
+            )
+        }
+    })?;
+    let batch = NonNull::new(raw)
+        .map(|ptr| Batch { ptr })
+        .ok_or_else(ffi_error)?;
+
+    let mut transform_errors = context
+        .transform_errors
+        .into_inner()
+        .unwrap_or_else(PoisonError::into_inner);
+    let results = (0..count)
+        .map(|index| {
+            // SAFETY: `batch` is valid and `index` is in range.
+            if unsafe { sys::oiio_batch_export_result(batch.ptr.as_ptr(), index) } != 0 {
+                return Ok(());
+            }
+            match transform_errors[index as usize].take() {
+                Some(message) => Err(OiioError::Transform(message)),
+                None => Err(ffi_error()),
+            }
+        })
+        .collect();
+
+    let mut raw_stats = sys::OiioBatchStats::default();
+    // SAFETY: `batch` is valid and `raw_stats` is a valid out-parameter.
+    unsafe { sys::oiio_batch_export_get_stats(batch.ptr.as_ptr(), &mut raw_stats) };
+    Ok(OiioExportReport {
+        results,
+        stats: OiioExportStats::from_raw(&raw_stats),
+    })
+}
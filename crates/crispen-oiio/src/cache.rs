@@ -0,0 +1,90 @@
+//! Process-wide OIIO image cache controls.
+//!
+//! Handles opened with [`OiioImageInput::open_cached`](crate::OiioImageInput::open_cached)
+//! read through a single `OIIO::ImageCache`. Decoded tiles stay in memory up
+//! to the configured limit, so scrubbing back over recently viewed frames
+//! does not decode them from disk again.
+//!
+//! The cache is private to this crate, not OIIO's shared cache, so these
+//! limits and stats do not affect other OIIO users in the process.
+
+use std::ffi::CString;
+use std::path::Path;
+
+use crate::error::{OiioError, ffi_error};
+use crate::sys;
+
+/// Snapshot of the image cache counters.
+#[derive(Debug, Clone, Copy, PartialEq, Default)]
+pub struct OiioImageCacheStats {
+    /// Tile lookups served from memory.
+    pub hits: u64,
+    /// Tile lookups that had to decode from disk.
+    pub misses: u64,
+    pub bytes_read: u64,
+    /// Tiles dropped from memory after being decoded.
+    pub evictions: u64,
+    /// Bytes currently held in the tile cache.
+    pub memory_used: u64,
+    pub tiles_current: u32,
+    pub open_files: u32,
+    pub max_memory_mb: f32,
+    pub max_open_files: u32,
+}
+
+/// Set the cache memory and open-file limits.
+///
+/// `None` leaves a limit unchanged.
+pub fn configure_image_cache(
+    max_memory_mb: Option<f32>,
+    max_open_files: Option<u32>,
+) -> Result<(), OiioError> {
+    let memory = max_memory_mb.unwrap_or(0.0);
+    if !memory.is_finite() || memory < 0.0 {
+        return Err(OiioError::InvalidArgument("max_memory_mb must be positive"));
+    }
+    let files = max_open_files.map_or(0, |n| n.min(i32::MAX as u32) as i32);
+
+    // SAFETY: plain value call with no pointer arguments.
+    let ok = unsafe { sys::oiio_image_cache_configure(memory, files) };
+    if ok == 0 {
+        return Err(ffi_error());
+    }
+    Ok(())
+}
+
+/// Read the current cache counters.
+pub fn image_cache_stats() -> OiioImageCacheStats {
+    let mut raw = sys::OiioImageCacheStats::default();
+    // SAFETY: `raw` is a valid out-parameter for the duration of the call.
+    unsafe { sys::oiio_image_cache_get_stats(&mut raw) };
+    OiioImageCacheStats {
+        hits: raw.hits,
+        misses: raw.misses,
+        bytes_read: raw.bytes_read,
+        evictions: raw.evictions,
+        memory_used: raw.memory_used,
+        tiles_current: raw.tiles_current.max(0) as u32,
+        open_files: raw.open_files.max(0) as u32,
+        max_memory_mb: raw.max_memory_mb,
+        max_open_files: raw.max_open_files.max(0) as u32,
+    }
+}
+
+/// Reset the cache counters without dropping cached tiles.
+pub fn reset_image_cache_stats() {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::oiio_image_cache_reset_stats() };
+}
+
+/// Drop cached tiles for `path` (e.g. after the file changed on disk), or
+/// for every file when `path` is `None`.
+pub fn invalidate_image_cache(path: Option<&Path>) -> Result<(), OiioError> {
+    let path = path
+        .map(|p| CString::new(p.to_string_lossy().as_bytes()))
+        .transpose()?;
+    let ptr = path.as_ref().map_or(std::ptr::null(), |p| p.as_ptr());
+    // SAFETY: `ptr` is null or a NUL-terminated string that outlives the call.
+    unsafe { sys::oiio_image_cache_invalidate(ptr) };
+    Ok(())
+}
@@ -10,6 +10,9 @@ pub enum OiioError {
     Oiio(String),
     #[error("invalid argument: {0}")]
     InvalidArgument(&'static str),
+    /// A caller-supplied pixel transform reported an error.
+    #[error("transform failed: {0}")]
+    Transform(String),
 }
 
 pub(crate) fn last_error_message() -> String {
@@ -1,14 +1,17 @@
 use std::ffi::{CStr, CString};
+use std::mem::MaybeUninit;
 use std::path::Path;
 use std::ptr::NonNull;
 
 use crispen_core::image::BitDepth;
 
 use crate::error::{OiioError, ffi_error};
+use crate::image_output::OiioRgbaSample;
+use crate::probe::fixed_string;
 use crate::sys;
 
 /// OIIO TypeDesc BASETYPE constants (mirrors the C++ enum).
-mod basetype {
+pub(crate) mod basetype {
     pub const UINT8: i32 = 2;
     pub const UINT16: i32 = 4;
     pub const INT16: i32 = 5;
@@ -17,21 +20,59 @@ mod basetype {
     pub const DOUBLE: i32 = 12;
 }
 
-/// A loaded image file opened via OpenImageIO.
+/// Map an OIIO TypeDesc basetype to the closest [`BitDepth`].
+pub(crate) fn bit_depth_from_format(fmt: i32) -> BitDepth {
+    match fmt {
+        basetype::UINT8 => BitDepth::U8,
+        basetype::UINT16 | basetype::INT16 => BitDepth::U16,
+        basetype::HALF => BitDepth::F16,
+        basetype::FLOAT | basetype::DOUBLE => BitDepth::F32,
+        _ => BitDepth::U8,
+    }
+}
+
+/// One subimage (EXR part, TIFF page) of an [`OiioImageInput`].
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioSubimage {
+    pub width: u32,
+    pub height: u32,
+    pub bit_depth: BitDepth,
+    /// EXR part name (`oiio:subimagename`), if the part has one.
+    pub name: Option<String>,
+    /// Channel names in file order, e.g. `"diffuse.R"`.
+    pub channels: Vec<String>,
+}
+
+impl OiioSubimage {
+    /// Distinct layer names in channel order: the part of each channel name
+    /// before its last `.`, or `""` for unprefixed channels such as `"R"`.
+    pub fn layers(&self) -> Vec<String> {
+        let mut layers: Vec<String> = Vec::new();
+        for channel in &self.channels {
+            let layer = channel.rsplit_once('.').map_or("", |(layer, _)| layer);
+            if !layers.iter().any(|l| l == layer) {
+                layers.push(layer.to_owned());
+            }
+        }
+        layers
+    }
+}
+
+/// An image file opened via OpenImageIO.
 ///
-/// The image data is read eagerly on [`open`](Self::open) and converted to
-/// f32 internally. Use [`read_rgba_f32`](Self::read_rgba_f32) to retrieve
-/// pixel data as RGBA f32.
+/// [`open`](Self::open) reads the header only.
+/// [`read_rgba_f32`](Self::read_rgba_f32) decodes the pixels as f32 straight
+/// into the returned RGBA buffer, with no intermediate full-frame copy.
 pub struct OiioImageInput {
     ptr: NonNull<sys::OiioImageInput>,
 }
 
-// SAFETY: The handle wraps an OIIO ImageBuf which is safe to send across
-// threads. We only expose shared (`&self`) access to the underlying data.
+// SAFETY: The handle wraps an OIIO ImageInput whose reads are serialized by a
+// mutex on the C++ side. We only expose shared (`&self`) access to it.
 unsafe impl Send for OiioImageInput {}
 
 impl OiioImageInput {
-    /// Open an image file and read its pixel data.
+    /// Open an image file and read its header.
     pub fn open(path: &Path) -> Result<Self, OiioError> {
         let path = CString::new(path.to_string_lossy().as_bytes())?;
         // SAFETY: FFI constructor returns owned opaque pointer or null on error.
@@ -41,6 +82,30 @@ impl OiioImageInput {
             .ok_or_else(ffi_error)
     }
 
+    /// Open an image file through the process-wide OIIO `ImageCache`.
+    ///
+    /// Pixel reads are served from cached tiles, so re-opening or re-reading
+    /// a recently viewed frame skips the disk decode. Limits and statistics
+    /// are controlled through [`configure_image_cache`](crate::configure_image_cache)
+    /// and [`image_cache_stats`](crate::image_cache_stats).
+    pub fn open_cached(path: &Path) -> Result<Self, OiioError> {
+        let path = CString::new(path.to_string_lossy().as_bytes())?;
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let ptr = unsafe { sys::oiio_image_input_open_cached(path.as_ptr()) };
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Thread hint for this handle's pixel reads and decode-time resizes.
+    ///
+    /// `0` falls back to the global [`set_threads`](crate::set_threads) budget.
+    pub fn set_threads(&self, threads: u32) {
+        let threads = threads.min(i32::MAX as u32) as i32;
+        // SAFETY: `self.ptr` is valid; the C++ side locks the handle.
+        unsafe { sys::oiio_image_input_set_threads(self.ptr.as_ptr(), threads) };
+    }
+
     /// Image width in pixels.
     pub fn width(&self) -> u32 {
         // SAFETY: `self.ptr` is valid for the life of `self`.
@@ -66,13 +131,7 @@ impl OiioImageInput {
     pub fn bit_depth(&self) -> BitDepth {
         // SAFETY: `self.ptr` is valid for the life of `self`.
         let fmt = unsafe { sys::oiio_image_input_format(self.ptr.as_ptr()) };
-        match fmt {
-            basetype::UINT8 => BitDepth::U8,
-            basetype::UINT16 | basetype::INT16 => BitDepth::U16,
-            basetype::HALF => BitDepth::F16,
-            basetype::FLOAT | basetype::DOUBLE => BitDepth::F32,
-            _ => BitDepth::U8,
-        }
+        bit_depth_from_format(fmt)
     }
 
     /// The color space detected by OIIO from file metadata (`oiio:ColorSpace`).
@@ -93,6 +152,7 @@ impl OiioImageInput {
     ///
     /// Channels are mapped as follows:
     /// - 1 channel (grayscale): R=G=B=value, A=1
+    /// - 2 channels (grayscale + alpha): R=G=B=value
     /// - 3 channels (RGB): A=1
     /// - 4 channels (RGBA): used directly
     /// - >4 channels: first 4 used
@@ -122,6 +182,263 @@ impl OiioImageInput {
 
         Ok(buf)
     }
+
+    /// Dimensions [`read_rgba_f32_fit`](Self::read_rgba_f32_fit) produces
+    /// for a `(max_width, max_height)` display bound.
+    pub fn fit_size(&self, max_width: u32, max_height: u32) -> Result<(u32, u32), OiioError> {
+        let (mut w, mut h) = (0, 0);
+        // SAFETY: `self.ptr` is valid and both out-pointers reference live locals.
+        let ok = unsafe {
+            sys::oiio_image_input_fit_size(
+                self.ptr.as_ptr(),
+                max_width.min(i32::MAX as u32) as i32,
+                max_height.min(i32::MAX as u32) as i32,
+                &mut w,
+                &mut h,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok((w.max(0) as u32, h.max(0) as u32))
+    }
+
+    /// Read the image as RGBA f32 pixels downscaled to fit a display bound.
+    ///
+    /// The aspect ratio is preserved and images are never upscaled; a zero
+    /// bound means full size. MIP-mapped files decode only the closest level
+    /// that covers the target, and remaining downscaling happens on the
+    /// native-depth pixels before float conversion. Returns
+    /// `(width, height, pixels)`; channel mapping matches
+    /// [`read_rgba_f32`](Self::read_rgba_f32).
+    pub fn read_rgba_f32_fit(
+        &self,
+        max_width: u32,
+        max_height: u32,
+    ) -> Result<(u32, u32, Vec<[f32; 4]>), OiioError> {
+        let (w, h) = self.fit_size(max_width, max_height)?;
+        let pixel_count = w as usize * h as usize;
+        if pixel_count == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+
+        let float_count = pixel_count * 4;
+        if float_count > i32::MAX as usize {
+            return Err(OiioError::InvalidArgument("image too large"));
+        }
+        let mut buf: Vec<[f32; 4]> = vec![[0.0, 0.0, 0.0, 1.0]; pixel_count];
+
+        // SAFETY: buf is a contiguous [f32; 4] array with exactly float_count floats.
+        let ok = unsafe {
+            sys::oiio_image_input_read_rgba_f32_fit(
+                self.ptr.as_ptr(),
+                max_width.min(i32::MAX as u32) as i32,
+                max_height.min(i32::MAX as u32) as i32,
+                buf.as_mut_ptr().cast::<f32>(),
+                float_count as i32,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+
+        Ok((w, h, buf))
+    }
+
+    /// Decode the display-fit RGBA f32 image straight into caller memory.
+    ///
+    /// `dst` can be any byte buffer, such as a mapped GPU upload buffer
+    /// reused across frames. Rows start `row_stride` bytes apart (`0` means
+    /// packed), so padded layouts like wgpu's 256-byte aligned
+    /// `bytes_per_row` work without a repack; padding bytes are left
+    /// untouched. `dst` must be 4-byte aligned. Bounds follow
+    /// [`read_rgba_f32_fit`](Self::read_rgba_f32_fit); pass `0, 0` for full
+    /// size. Returns the decoded `(width, height)`.
+    pub fn read_rgba_f32_into(
+        &self,
+        max_width: u32,
+        max_height: u32,
+        dst: &mut [u8],
+        row_stride: usize,
+    ) -> Result<(u32, u32), OiioError> {
+        self.read_rgba_into::<f32>(max_width, max_height, dst, row_stride)
+    }
+
+    /// Decode the whole image as packed RGBA half samples (raw IEEE binary16
+    /// bits). Half EXRs are never expanded to float, halving memory and upload
+    /// size versus [`read_rgba_f32`](Self::read_rgba_f32); other sources are
+    /// converted by the decoder.
+    pub fn read_rgba_f16(&self) -> Result<Vec<[u16; 4]>, OiioError> {
+        let pixel_count = self.width() as usize * self.height() as usize;
+        if pixel_count == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+
+        let mut buf: Vec<[u16; 4]> = vec![[0; 4]; pixel_count];
+        // SAFETY: buf is a contiguous [u16; 4] array with pixel_count * 4 values.
+        let ok = unsafe {
+            sys::oiio_image_input_read_rgba_f16(
+                self.ptr.as_ptr(),
+                buf.as_mut_ptr().cast::<u16>(),
+                pixel_count * 4,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(buf)
+    }
+
+    /// Sample-type generic form of
+    /// [`read_rgba_f32_into`](Self::read_rgba_f32_into): `T` is `f32` or `u16`
+    /// (half bits). The stride must be a multiple of the sample size and
+    /// `dst` aligned to it.
+    pub fn read_rgba_into<T: OiioRgbaSample>(
+        &self,
+        max_width: u32,
+        max_height: u32,
+        dst: &mut [u8],
+        row_stride: usize,
+    ) -> Result<(u32, u32), OiioError> {
+        let (w, h) = self.fit_size(max_width, max_height)?;
+        if w == 0 || h == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+        let sample = std::mem::size_of::<T>();
+        let packed = w as usize * 4 * sample;
+        let stride = if row_stride == 0 { packed } else { row_stride };
+        if stride < packed || stride % sample != 0 || stride > isize::MAX as usize {
+            return Err(OiioError::InvalidArgument("invalid row stride"));
+        }
+        if !(dst.as_ptr() as usize).is_multiple_of(std::mem::align_of::<T>()) {
+            return Err(OiioError::InvalidArgument("unaligned destination"));
+        }
+        if dst.len() < stride * (h as usize - 1) + packed {
+            return Err(OiioError::InvalidArgument("destination buffer too small"));
+        }
+
+        // SAFETY: `dst` is aligned and covers every row addressed by the
+        // fitted size and stride (checked above).
+        let ok = unsafe {
+            sys::oiio_image_input_read_rgba_into(
+                self.ptr.as_ptr(),
+                max_width.min(i32::MAX as u32) as i32,
+                max_height.min(i32::MAX as u32) as i32,
+                T::FORMAT,
+                dst.as_mut_ptr().cast(),
+                dst.len(),
+                stride as isize,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok((w, h))
+    }
+
+    /// Headers and channel names of every subimage.
+    ///
+    /// Headers are scanned once, on the first subimage or layer query; no
+    /// pixels are decoded.
+    pub fn subimages(&self) -> Result<Vec<OiioSubimage>, OiioError> {
+        // SAFETY: `self.ptr` is valid; the C++ side locks the handle.
+        let count = unsafe { sys::oiio_image_input_subimage_count(self.ptr.as_ptr()) };
+        if count < 0 {
+            return Err(ffi_error());
+        }
+        (0..count as u32).map(|s| self.subimage(s)).collect()
+    }
+
+    /// Header and channel names of one subimage.
+    pub fn subimage(&self, subimage: u32) -> Result<OiioSubimage, OiioError> {
+        let index = subimage.min(i32::MAX as u32) as i32;
+        let mut raw = MaybeUninit::<sys::OiioSubimageSpec>::zeroed();
+        // SAFETY: `self.ptr` is valid and `raw` is a valid out-parameter.
+        let ok = unsafe {
+            sys::oiio_image_input_subimage_spec(self.ptr.as_ptr(), index, raw.as_mut_ptr())
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        // SAFETY: the struct is plain data, zero-initialized and filled on success.
+        let raw = unsafe { raw.assume_init() };
+
+        let channels = (0..raw.nchannels.max(0))
+            .map(|c| {
+                // SAFETY: `self.ptr` is valid; indices are in range for this
+                // subimage, and a null return is handled.
+                let ptr =
+                    unsafe { sys::oiio_image_input_channel_name(self.ptr.as_ptr(), index, c) };
+                if ptr.is_null() {
+                    return String::new();
+                }
+                // SAFETY: the name is NUL-terminated and owned by the handle,
+                // which outlives this call.
+                unsafe { CStr::from_ptr(ptr) }
+                    .to_string_lossy()
+                    .into_owned()
+            })
+            .collect();
+        let name = fixed_string(&raw.name);
+        Ok(OiioSubimage {
+            width: raw.width.max(0) as u32,
+            height: raw.height.max(0) as u32,
+            bit_depth: bit_depth_from_format(raw.format),
+            name: (!name.is_empty()).then_some(name),
+            channels,
+        })
+    }
+
+    /// Index of the first subimage holding `layer`, such as `"diffuse"` for
+    /// `diffuse.R/G/B/A` or the name of an EXR part; `""` selects
+    /// unprefixed channels.
+    pub fn find_layer(&self, layer: &str) -> Result<u32, OiioError> {
+        let layer = CString::new(layer)?;
+        // SAFETY: `self.ptr` is valid and `layer` is NUL-terminated.
+        let index = unsafe { sys::oiio_image_input_find_layer(self.ptr.as_ptr(), layer.as_ptr()) };
+        if index < 0 {
+            return Err(ffi_error());
+        }
+        Ok(index as u32)
+    }
+
+    /// Decode only the channels of `layer` in `subimage` as RGBA f32.
+    ///
+    /// Other channels and parts are never converted, and a layer stored in
+    /// adjacent channels is decoded with one channel-ranged read. Channels
+    /// named R/G/B/A, X/Y/Z or Y/A go to their slots; other layers are
+    /// mapped like [`read_rgba_f32`](Self::read_rgba_f32). Returns
+    /// `(width, height, pixels)` of the subimage.
+    pub fn read_layer_rgba_f32(
+        &self,
+        subimage: u32,
+        layer: &str,
+    ) -> Result<(u32, u32, Vec<[f32; 4]>), OiioError> {
+        let spec = self.subimage(subimage)?;
+        let pixel_count = spec.width as usize * spec.height as usize;
+        if pixel_count == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+        let layer = CString::new(layer)?;
+        let mut buf: Vec<[f32; 4]> = vec![[0.0, 0.0, 0.0, 1.0]; pixel_count];
+
+        // SAFETY: buf is a contiguous [f32; 4] array sized for the subimage,
+        // and `layer` is NUL-terminated.
+        let ok = unsafe {
+            sys::oiio_image_input_read_layer_rgba_f32(
+                self.ptr.as_ptr(),
+                subimage.min(i32::MAX as u32) as i32,
+                layer.as_ptr(),
+                buf.as_mut_ptr().cast::<f32>(),
+                pixel_count * 4,
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok((spec.width, spec.height, buf))
+    }
 }
 
 impl Drop for OiioImageInput {
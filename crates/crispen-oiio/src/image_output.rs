@@ -0,0 +1,407 @@
+use std::ffi::CString;
+use std::marker::PhantomData;
+use std::ops::Range;
+use std::path::Path;
+use std::ptr::NonNull;
+
+use crispen_core::image::BitDepth;
+
+use crate::error::{OiioError, ffi_error};
+use crate::sys;
+
+mod sealed {
+    pub trait Sealed {}
+    impl Sealed for f32 {}
+    impl Sealed for u16 {}
+}
+
+/// Sample type of an RGBA source buffer handed to the writer: `f32`, or
+/// `u16` holding raw IEEE half bits.
+pub trait OiioRgbaSample: sealed::Sealed + Copy + Default {
+    #[doc(hidden)]
+    const FORMAT: i32;
+}
+
+impl OiioRgbaSample for f32 {
+    const FORMAT: i32 = sys::OIIO_PIXEL_F32;
+}
+
+impl OiioRgbaSample for u16 {
+    const FORMAT: i32 = sys::OIIO_PIXEL_F16;
+}
+
+/// File encoding settings for [`OiioImageOutput`] and [`OiioAsyncWriter`].
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioOutputOptions {
+    /// Sample depth stored in the file. 10/12-bit are honoured by formats
+    /// that support them (DPX, TIFF).
+    pub bit_depth: BitDepth,
+    /// Format-specific compression such as `"zip"`, `"piz"` or `"dwaa:45"`;
+    /// `None` keeps the writer default.
+    pub compression: Option<String>,
+    /// Tile size; `None` writes scanlines. Ignored by formats without tiles.
+    pub tile_size: Option<(u32, u32)>,
+    /// Written as `oiio:ColorSpace` metadata.
+    pub color_space: Option<String>,
+    /// Write RGBA; `false` writes RGB and drops the source alpha.
+    pub write_alpha: bool,
+}
+
+impl Default for OiioOutputOptions {
+    fn default() -> Self {
+        Self {
+            bit_depth: BitDepth::F16,
+            compression: None,
+            tile_size: None,
+            color_space: None,
+            write_alpha: true,
+        }
+    }
+}
+
+impl OiioOutputOptions {
+    /// Call `f` with the C view of these options; the strings it points to
+    /// live for the duration of the call.
+    pub(crate) fn with_raw<R>(
+        &self,
+        f: impl FnOnce(&sys::OiioOutputOptions) -> R,
+    ) -> Result<R, OiioError> {
+        let compression = self.compression.as_deref().map(CString::new).transpose()?;
+        let color_space = self.color_space.as_deref().map(CString::new).transpose()?;
+        let (tile_w, tile_h) = self.tile_size.unwrap_or((0, 0));
+        let raw = sys::OiioOutputOptions {
+            bit_depth: match self.bit_depth {
+                BitDepth::U8 => sys::OIIO_BIT_DEPTH_UINT8,
+                BitDepth::U10 => sys::OIIO_BIT_DEPTH_UINT10,
+                BitDepth::U12 => sys::OIIO_BIT_DEPTH_UINT12,
+                BitDepth::U16 => sys::OIIO_BIT_DEPTH_UINT16,
+                BitDepth::F16 => sys::OIIO_BIT_DEPTH_F16,
+                BitDepth::F32 => sys::OIIO_BIT_DEPTH_F32,
+            },
+            compression: compression
+                .as_ref()
+                .map_or(std::ptr::null(), |s| s.as_ptr()),
+            tile_width: tile_w.min(i32::MAX as u32) as i32,
+            tile_height: tile_h.min(i32::MAX as u32) as i32,
+            color_space: color_space
+                .as_ref()
+                .map_or(std::ptr::null(), |s| s.as_ptr()),
+            write_alpha: i32::from(self.write_alpha),
+        };
+        Ok(f(&raw))
+    }
+}
+
+fn path_cstring(path: &Path) -> Result<CString, OiioError> {
+    Ok(CString::new(path.to_string_lossy().as_bytes())?)
+}
+
+fn to_c_int(v: u32) -> i32 {
+    v.min(i32::MAX as u32) as i32
+}
+
+/// An image file open for writing via OpenImageIO.
+///
+/// Pixels are passed straight from caller RGBA `f32` / half buffers and
+/// converted to the file bit depth by the writer, without staging copies.
+pub struct OiioImageOutput {
+    ptr: NonNull<sys::OiioImageOutput>,
+    width: u32,
+    height: u32,
+}
+
+// SAFETY: The handle owns an OIIO ImageOutput; writes are serialized by a
+// mutex on the C++ side and require `&mut self` here.
+unsafe impl Send for OiioImageOutput {}
+
+impl OiioImageOutput {
+    /// Create `path` (format chosen by extension) for a `width` x `height`
+    /// image.
+    pub fn create(
+        path: &Path,
+        width: u32,
+        height: u32,
+        options: &OiioOutputOptions,
+    ) -> Result<Self, OiioError> {
+        let path = path_cstring(path)?;
+        let ptr = options.with_raw(|raw| {
+            // SAFETY: all pointers are valid for the duration of the call.
+            unsafe {
+                sys::oiio_image_output_open(path.as_ptr(), to_c_int(width), to_c_int(height), raw)
+            }
+        })?;
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr, width, height })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Tile size in use, or `None` when writing scanlines (including when
+    /// the format has no tile support).
+    pub fn tile_size(&self) -> Option<(u32, u32)> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let (w, h) = unsafe {
+            (
+                sys::oiio_image_output_tile_width(self.ptr.as_ptr()),
+                sys::oiio_image_output_tile_height(self.ptr.as_ptr()),
+            )
+        };
+        if w > 0 && h > 0 {
+            Some((w as u32, h as u32))
+        } else {
+            None
+        }
+    }
+
+    /// Write `rows` from packed RGBA pixels (`rows.len() * width` entries).
+    pub fn write_scanlines<T: OiioRgbaSample>(
+        &mut self,
+        rows: Range<u32>,
+        pixels: &[[T; 4]],
+    ) -> Result<(), OiioError> {
+        if rows.is_empty() || rows.end > self.height {
+            return Err(OiioError::InvalidArgument("row range out of bounds"));
+        }
+        if pixels.len() != rows.len() * self.width as usize {
+            return Err(OiioError::InvalidArgument(
+                "pixel count does not match rows",
+            ));
+        }
+
+        // SAFETY: `pixels` covers every packed row in the range (checked above).
+        let ok = unsafe {
+            sys::oiio_image_output_write_scanlines(
+                self.ptr.as_ptr(),
+                rows.start as i32,
+                rows.end as i32,
+                T::FORMAT,
+                pixels.as_ptr().cast(),
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Write a tile-aligned region from packed RGBA pixels
+    /// (`cols.len() * rows.len()` entries). Tiled outputs only.
+    pub fn write_tiles<T: OiioRgbaSample>(
+        &mut self,
+        cols: Range<u32>,
+        rows: Range<u32>,
+        pixels: &[[T; 4]],
+    ) -> Result<(), OiioError> {
+        if cols.is_empty() || cols.end > self.width || rows.is_empty() || rows.end > self.height {
+            return Err(OiioError::InvalidArgument("tile region out of bounds"));
+        }
+        if pixels.len() != cols.len() * rows.len() {
+            return Err(OiioError::InvalidArgument(
+                "pixel count does not match region",
+            ));
+        }
+
+        // SAFETY: `pixels` covers the packed region (checked above).
+        let ok = unsafe {
+            sys::oiio_image_output_write_tiles(
+                self.ptr.as_ptr(),
+                cols.start as i32,
+                cols.end as i32,
+                rows.start as i32,
+                rows.end as i32,
+                T::FORMAT,
+                pixels.as_ptr().cast(),
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Write the whole image from packed RGBA pixels.
+    pub fn write_image<T: OiioRgbaSample>(&mut self, pixels: &[[T; 4]]) -> Result<(), OiioError> {
+        if pixels.len() != self.width as usize * self.height as usize {
+            return Err(OiioError::InvalidArgument(
+                "pixel count does not match image",
+            ));
+        }
+
+        // SAFETY: `pixels` covers the packed image (checked above).
+        let ok = unsafe {
+            sys::oiio_image_output_write_image(
+                self.ptr.as_ptr(),
+                T::FORMAT,
+                pixels.as_ptr().cast(),
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Finish the file and report any error from the final flush.
+    pub fn close(self) -> Result<(), OiioError> {
+        // SAFETY: `self.ptr` is valid; Drop still frees the handle.
+        let ok = unsafe { sys::oiio_image_output_close(self.ptr.as_ptr()) };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+}
+
+impl Drop for OiioImageOutput {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_image_output_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+/// Double-buffered background image writer.
+///
+/// [`acquire`](Self::acquire) hands out one of a fixed set of recycled
+/// staging buffers; once filled, [`OiioWriteBuffer::submit`] queues it and a
+/// native thread encodes it while the caller prepares the next frame.
+/// Dropping the writer finishes every submitted frame.
+pub struct OiioAsyncWriter {
+    ptr: NonNull<sys::OiioAsyncWriter>,
+}
+
+// SAFETY: Every entry point of the C++ writer locks its internal mutex, and
+// staging buffers are only handed out to one guard at a time.
+unsafe impl Send for OiioAsyncWriter {}
+// SAFETY: See above; shared access is synchronized internally.
+unsafe impl Sync for OiioAsyncWriter {}
+
+impl OiioAsyncWriter {
+    /// Create a writer with `buffers` staging buffers (at least 2) and a
+    /// per-file encode thread hint (`0` = global default).
+    pub fn new(buffers: u32, threads: u32) -> Result<Self, OiioError> {
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let ptr = unsafe { sys::oiio_async_writer_create(to_c_int(buffers), to_c_int(threads)) };
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Wait for a free staging buffer sized for a packed RGBA frame.
+    pub fn acquire<T: OiioRgbaSample>(
+        &self,
+        width: u32,
+        height: u32,
+    ) -> Result<OiioWriteBuffer<'_, T>, OiioError> {
+        let len = width as usize * height as usize;
+        if len == 0 {
+            return Err(OiioError::InvalidArgument("frame has zero dimensions"));
+        }
+
+        let mut id = 0;
+        // SAFETY: `self.ptr` is valid and `id` is a valid out-parameter.
+        let data = unsafe {
+            sys::oiio_async_writer_acquire(
+                self.ptr.as_ptr(),
+                len * std::mem::size_of::<[T; 4]>(),
+                &mut id,
+            )
+        };
+        let data = NonNull::new(data.cast::<[T; 4]>()).ok_or_else(ffi_error)?;
+        Ok(OiioWriteBuffer {
+            writer: self,
+            id,
+            data,
+            width,
+            height,
+            submitted: false,
+            _sample: PhantomData,
+        })
+    }
+
+    /// Wait until every submitted frame is written. Fails if any frame
+    /// since the previous flush could not be written.
+    pub fn flush(&self) -> Result<(), OiioError> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let failures = unsafe { sys::oiio_async_writer_flush(self.ptr.as_ptr()) };
+        if failures != 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+}
+
+impl Drop for OiioAsyncWriter {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_async_writer_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+/// A staging buffer acquired from an [`OiioAsyncWriter`].
+///
+/// Fill it through [`pixels_mut`](Self::pixels_mut) and
+/// [`submit`](Self::submit) it; dropping it unsubmitted returns the buffer.
+pub struct OiioWriteBuffer<'a, T: OiioRgbaSample> {
+    writer: &'a OiioAsyncWriter,
+    id: i32,
+    data: NonNull<[T; 4]>,
+    width: u32,
+    height: u32,
+    submitted: bool,
+    _sample: PhantomData<&'a mut [T]>,
+}
+
+impl<T: OiioRgbaSample> OiioWriteBuffer<'_, T> {
+    pub fn width(&self) -> u32 {
+        self.width
+    }
+
+    pub fn height(&self) -> u32 {
+        self.height
+    }
+
+    /// Packed RGBA pixels, `width * height` entries. Contents are left over
+    /// from the buffer's previous frame.
+    pub fn pixels_mut(&mut self) -> &mut [[T; 4]] {
+        let len = self.width as usize * self.height as usize;
+        // SAFETY: the acquired buffer holds `len` 16-byte aligned RGBA
+        // samples and is owned exclusively by this guard until submit/drop.
+        unsafe { std::slice::from_raw_parts_mut(self.data.as_ptr(), len) }
+    }
+
+    /// Queue this frame for encoding to `path`.
+    pub fn submit(mut self, path: &Path, options: &OiioOutputOptions) -> Result<(), OiioError> {
+        let path = path_cstring(path)?;
+        let ok = options.with_raw(|raw| {
+            // SAFETY: all pointers are valid for the duration of the call.
+            unsafe {
+                sys::oiio_async_writer_submit(
+                    self.writer.ptr.as_ptr(),
+                    self.id,
+                    path.as_ptr(),
+                    to_c_int(self.width),
+                    to_c_int(self.height),
+                    T::FORMAT,
+                    0,
+                    raw,
+                )
+            }
+        })?;
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        self.submitted = true;
+        Ok(())
+    }
+}
+
+impl<T: OiioRgbaSample> Drop for OiioWriteBuffer<'_, T> {
+    fn drop(&mut self) {
+        if !self.submitted {
+            // SAFETY: the writer outlives this guard; `id` came from acquire.
+            unsafe { sys::oiio_async_writer_discard(self.writer.ptr.as_ptr(), self.id) };
+        }
+    }
+}
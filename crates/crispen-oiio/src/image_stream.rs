@@ -0,0 +1,266 @@
+use std::ffi::{CStr, CString};
+use std::ops::Range;
+use std::path::Path;
+use std::ptr::NonNull;
+
+use crispen_core::image::BitDepth;
+
+use crate::error::{OiioError, ffi_error};
+use crate::image_input::bit_depth_from_format;
+use crate::sys;
+
+/// An image file opened for on-demand decoding via OpenImageIO.
+///
+/// Unlike [`OiioImageInput`](crate::OiioImageInput), [`open`](Self::open)
+/// only reads the header. Pixels are decoded per row band or tile region, so
+/// large frames can be converted into a caller buffer without an
+/// intermediate full-frame float copy.
+pub struct OiioImageStream {
+    ptr: NonNull<sys::OiioImageStream>,
+}
+
+// SAFETY: The handle owns an OIIO ImageInput; every read on the C++ side is
+// serialized by a mutex inside the handle, and header queries read an
+// immutable copy of the spec.
+unsafe impl Send for OiioImageStream {}
+// SAFETY: See above; shared access is synchronized internally.
+unsafe impl Sync for OiioImageStream {}
+
+impl OiioImageStream {
+    /// Open an image file, reading only its header.
+    pub fn open(path: &Path) -> Result<Self, OiioError> {
+        let path = CString::new(path.to_string_lossy().as_bytes())?;
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let ptr = unsafe { sys::oiio_image_stream_open(path.as_ptr()) };
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Thread hint for this handle's pixel reads and decode-time resizes.
+    ///
+    /// `0` falls back to the global [`set_threads`](crate::set_threads) budget.
+    pub fn set_threads(&self, threads: u32) {
+        let threads = threads.min(i32::MAX as u32) as i32;
+        // SAFETY: `self.ptr` is valid; the C++ side locks the handle.
+        unsafe { sys::oiio_image_stream_set_threads(self.ptr.as_ptr(), threads) };
+    }
+
+    /// Image width in pixels.
+    pub fn width(&self) -> u32 {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let v = unsafe { sys::oiio_image_stream_width(self.ptr.as_ptr()) };
+        v.max(0) as u32
+    }
+
+    /// Image height in pixels.
+    pub fn height(&self) -> u32 {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let v = unsafe { sys::oiio_image_stream_height(self.ptr.as_ptr()) };
+        v.max(0) as u32
+    }
+
+    /// Number of channels in the source image.
+    pub fn nchannels(&self) -> u32 {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let v = unsafe { sys::oiio_image_stream_nchannels(self.ptr.as_ptr()) };
+        v.max(0) as u32
+    }
+
+    /// Original bit depth / format of the source image.
+    pub fn bit_depth(&self) -> BitDepth {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let fmt = unsafe { sys::oiio_image_stream_format(self.ptr.as_ptr()) };
+        bit_depth_from_format(fmt)
+    }
+
+    /// Tile size as `(width, height)`, or `None` for scanline files.
+    pub fn tile_size(&self) -> Option<(u32, u32)> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let (w, h) = unsafe {
+            (
+                sys::oiio_image_stream_tile_width(self.ptr.as_ptr()),
+                sys::oiio_image_stream_tile_height(self.ptr.as_ptr()),
+            )
+        };
+        if w > 0 && h > 0 {
+            Some((w as u32, h as u32))
+        } else {
+            None
+        }
+    }
+
+    /// A row band height that lines up with the file's storage: the tile
+    /// height for tiled files, otherwise `fallback`.
+    pub fn preferred_band_rows(&self, fallback: u32) -> u32 {
+        self.tile_size().map_or(fallback, |(_, h)| h).max(1)
+    }
+
+    /// The color space detected by OIIO from file metadata (`oiio:ColorSpace`).
+    ///
+    /// Returns `None` if no color space information was found.
+    pub fn color_space(&self) -> Option<String> {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let ptr = unsafe { sys::oiio_image_stream_color_space(self.ptr.as_ptr()) };
+        if ptr.is_null() {
+            return None;
+        }
+        // SAFETY: FFI contract returns valid NUL-terminated strings.
+        let s = unsafe { CStr::from_ptr(ptr) }.to_string_lossy();
+        if s.is_empty() {
+            None
+        } else {
+            Some(s.into_owned())
+        }
+    }
+
+    /// Decode `rows` for `channels` as packed f32 samples into `buf`.
+    ///
+    /// `buf` must hold at least `rows.len() * width * channels.len()` floats.
+    pub fn read_scanlines(
+        &self,
+        rows: Range<u32>,
+        channels: Range<u32>,
+        buf: &mut [f32],
+    ) -> Result<(), OiioError> {
+        self.check_rows(&rows)?;
+        self.check_channels(&channels)?;
+        let needed = rows.len() * self.width() as usize * channels.len();
+        if buf.len() < needed {
+            return Err(OiioError::InvalidArgument("buffer too small for band"));
+        }
+
+        // SAFETY: `buf` holds at least `needed` floats; packed strides (0)
+        // never address beyond that.
+        let ok = unsafe {
+            sys::oiio_image_stream_read_scanlines(
+                self.ptr.as_ptr(),
+                rows.start as i32,
+                rows.end as i32,
+                channels.start as i32,
+                channels.end as i32,
+                buf.as_mut_ptr(),
+                buf.len(),
+                0,
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Decode a tile-aligned region for `channels` as packed f32 samples.
+    ///
+    /// Region starts must be multiples of the tile size; ends must be too,
+    /// or sit on the image edge. Only valid for tiled files.
+    pub fn read_tiles(
+        &self,
+        cols: Range<u32>,
+        rows: Range<u32>,
+        channels: Range<u32>,
+        buf: &mut [f32],
+    ) -> Result<(), OiioError> {
+        if cols.is_empty() || cols.end > self.width() {
+            return Err(OiioError::InvalidArgument("column range out of bounds"));
+        }
+        self.check_rows(&rows)?;
+        self.check_channels(&channels)?;
+        let needed = rows.len() * cols.len() * channels.len();
+        if buf.len() < needed {
+            return Err(OiioError::InvalidArgument("buffer too small for region"));
+        }
+
+        // SAFETY: `buf` holds at least `needed` floats; packed strides (0)
+        // never address beyond that.
+        let ok = unsafe {
+            sys::oiio_image_stream_read_tiles(
+                self.ptr.as_ptr(),
+                cols.start as i32,
+                cols.end as i32,
+                rows.start as i32,
+                rows.end as i32,
+                channels.start as i32,
+                channels.end as i32,
+                buf.as_mut_ptr(),
+                buf.len(),
+                0,
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Decode `rows` as RGBA f32 pixels into `buf`.
+    ///
+    /// Channel mapping matches
+    /// [`OiioImageInput::read_rgba_f32`](crate::OiioImageInput::read_rgba_f32);
+    /// 2-channel images are treated as gray + alpha. `buf` must hold exactly
+    /// `rows.len() * width` pixels.
+    pub fn read_rgba_rows(&self, rows: Range<u32>, buf: &mut [[f32; 4]]) -> Result<(), OiioError> {
+        self.check_rows(&rows)?;
+        if buf.len() != rows.len() * self.width() as usize {
+            return Err(OiioError::InvalidArgument(
+                "buffer does not match band size",
+            ));
+        }
+
+        // SAFETY: `buf` is contiguous RGBA f32 memory sized for the band.
+        let ok = unsafe {
+            sys::oiio_image_stream_read_rgba_f32(
+                self.ptr.as_ptr(),
+                rows.start as i32,
+                rows.end as i32,
+                buf.as_mut_ptr().cast::<f32>(),
+                buf.len() * 4,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Decode the whole image as RGBA f32, `band_rows` rows at a time.
+    pub fn read_rgba_f32(&self, band_rows: u32) -> Result<Vec<[f32; 4]>, OiioError> {
+        let w = self.width() as usize;
+        let h = self.height();
+        if w == 0 || h == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+
+        let band_rows = band_rows.max(1);
+        let mut pixels = vec![[0.0_f32, 0.0, 0.0, 1.0]; w * h as usize];
+        for (i, band) in pixels.chunks_mut(w * band_rows as usize).enumerate() {
+            let y0 = i as u32 * band_rows;
+            let y1 = y0 + (band.len() / w) as u32;
+            self.read_rgba_rows(y0..y1, band)?;
+        }
+        Ok(pixels)
+    }
+
+    fn check_rows(&self, rows: &Range<u32>) -> Result<(), OiioError> {
+        if rows.is_empty() || rows.end > self.height() {
+            return Err(OiioError::InvalidArgument("row range out of bounds"));
+        }
+        Ok(())
+    }
+
+    fn check_channels(&self, channels: &Range<u32>) -> Result<(), OiioError> {
+        if channels.is_empty() || channels.end > self.nchannels() {
+            return Err(OiioError::InvalidArgument("channel range out of bounds"));
+        }
+        Ok(())
+    }
+}
+
+impl Drop for OiioImageStream {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_image_stream_destroy(self.ptr.as_ptr()) };
+    }
+}
@@ -2,13 +2,52 @@
 //!
 //! This crate provides a minimal safe wrapper over a thin C ABI layer built on
 //! top of OpenImageIO's C++ API. It supports reading images and extracting
-//! color space metadata detected from file headers.
+//! color space metadata detected from file headers, either eagerly, one
+//! multi-part / multi-layer EXR layer at a time, or as a stream of scanline
+//! bands / tiles, memory-mapping uncompressed frames, generating thumbnails,
+//! and writing graded frames back out, one at a time or as a pipelined
+//! batch export.
 #![allow(unsafe_code)]
 // FFI wrappers necessarily use unsafe externs and raw pointers.
 
+mod batch_export;
+mod cache;
 mod error;
 mod image_input;
+mod image_output;
+mod image_stream;
+mod perf;
+mod probe;
+mod raw_image;
+mod sequence;
 mod sys;
+mod threading;
+mod thumbnail;
 
+pub use batch_export::{
+    OiioExportJob, OiioExportOptions, OiioExportProgress, OiioExportReport, OiioExportStats,
+    OiioExportTransform, batch_export,
+};
+pub use cache::{
+    OiioImageCacheStats, configure_image_cache, image_cache_stats, invalidate_image_cache,
+    reset_image_cache_stats,
+};
 pub use error::OiioError;
-pub use image_input::OiioImageInput;
+pub use image_input::{OiioImageInput, OiioSubimage};
+pub use image_output::{
+    OiioAsyncWriter, OiioImageOutput, OiioOutputOptions, OiioRgbaSample, OiioWriteBuffer,
+};
+pub use image_stream::OiioImageStream;
+pub use perf::{
+    OiioPerfCallback, OiioPerfCounter, OiioPerfStage, OiioPerfStats, perf_enabled, perf_stats,
+    reset_perf_stats, set_perf_callback, set_perf_enabled,
+};
+pub use probe::{OiioProbe, probe};
+pub use raw_image::{OiioRawImage, OiioRawLayout, OiioRawSample};
+pub use sequence::{
+    OiioFrameStatus, OiioImageSequence, OiioPlayDirection, OiioSequenceFrame, OiioSequenceOptions,
+};
+pub use threading::{set_threads, threads};
+pub use thumbnail::{
+    OiioThumbnail, OiioThumbnailOptions, OiioThumbnailTransform, generate_thumbnails,
+};
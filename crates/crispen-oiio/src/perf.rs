@@ -0,0 +1,121 @@
+//! Opt-in hot-path instrumentation.
+//!
+//! When enabled with [`set_perf_enabled`], every open, decode, tile-cache
+//! copy, channel expansion, resize and write adds to per-stage call counts,
+//! cumulative wall time and bytes processed on the C++ side. Totals are
+//! read with [`perf_stats`]; [`set_perf_callback`] additionally reports
+//! each call as it completes.
+
+use std::ffi::c_int;
+
+use crispen_ffi::perf::{PerfCallback, PerfCallbackSlot, PerfCounter, PerfStage, PerfStats};
+
+use crate::sys;
+
+/// Instrumented stage of the OIIO C API.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum OiioPerfStage {
+    /// Opening a file, an ImageCache spec lookup or a probe.
+    Open,
+    /// Decoder reads, including conversion to the requested sample type.
+    Decode,
+    /// Copies out of the shared ImageCache.
+    CacheRead,
+    /// In-place expansion of 1-3 channel images to RGBA.
+    ChannelExpand,
+    /// Downscaling for fit and thumbnail reads.
+    Resize,
+    Write,
+}
+
+impl OiioPerfStage {
+    pub const ALL: [Self; sys::OIIO_PERF_STAGE_COUNT] = [
+        Self::Open,
+        Self::Decode,
+        Self::CacheRead,
+        Self::ChannelExpand,
+        Self::Resize,
+        Self::Write,
+    ];
+
+    /// Short snake_case name, e.g. `"decode"`.
+    pub fn name(self) -> &'static str {
+        match self {
+            Self::Open => "open",
+            Self::Decode => "decode",
+            Self::CacheRead => "cache_read",
+            Self::ChannelExpand => "channel_expand",
+            Self::Resize => "resize",
+            Self::Write => "write",
+        }
+    }
+}
+
+impl PerfStage for OiioPerfStage {
+    const ALL: &'static [Self] = &Self::ALL;
+
+    fn to_raw(self) -> c_int {
+        match self {
+            Self::Open => sys::OIIO_PERF_OPEN,
+            Self::Decode => sys::OIIO_PERF_DECODE,
+            Self::CacheRead => sys::OIIO_PERF_CACHE_READ,
+            Self::ChannelExpand => sys::OIIO_PERF_CHANNEL_EXPAND,
+            Self::Resize => sys::OIIO_PERF_RESIZE,
+            Self::Write => sys::OIIO_PERF_WRITE,
+        }
+    }
+}
+
+/// Cumulative totals for one stage. `bytes` counts pixel bytes produced
+/// by reads or consumed by writes, 0 for opens.
+pub type OiioPerfCounter = PerfCounter;
+
+/// Snapshot of every stage's counters.
+pub type OiioPerfStats = PerfStats<OiioPerfStage, { sys::OIIO_PERF_STAGE_COUNT }>;
+
+/// Per-call callback: stage, wall time and bytes processed.
+pub type OiioPerfCallback = PerfCallback<OiioPerfStage>;
+
+/// Registered callback, kept alive here while the C side may call it.
+static CALLBACK: PerfCallbackSlot<OiioPerfStage> = PerfCallbackSlot::new();
+
+/// Turn instrumentation on or off (off by default).
+pub fn set_perf_enabled(enabled: bool) {
+    // SAFETY: plain value call with no pointer arguments.
+    unsafe { sys::oiio_perf_set_enabled(c_int::from(enabled)) };
+}
+
+pub fn perf_enabled() -> bool {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::oiio_perf_is_enabled() != 0 }
+}
+
+/// Read the cumulative per-stage counters.
+pub fn perf_stats() -> OiioPerfStats {
+    let mut raw = sys::OiioPerfStats::default();
+    // SAFETY: `raw` is a valid out-parameter for the duration of the call.
+    unsafe { sys::oiio_perf_get_stats(&mut raw) };
+    OiioPerfStats::from_raw(&raw)
+}
+
+/// Zero every stage's counters.
+pub fn reset_perf_stats() {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::oiio_perf_reset() };
+}
+
+/// Register `callback` to be called after every instrumented call, on the
+/// thread that made it (which may be an internal decode or writer thread),
+/// while instrumentation is enabled. `None` unregisters.
+///
+/// The callback may call `set_perf_callback` itself, e.g. to unregister
+/// after the first slow call.
+pub fn set_perf_callback(callback: Option<OiioPerfCallback>) {
+    // SAFETY: `oiio_perf_set_callback` waits for calls of the
+    // callback it replaces on other threads before returning.
+    unsafe {
+        CALLBACK.set(callback, |callback, user| {
+            sys::oiio_perf_set_callback(callback, user)
+        })
+    };
+}
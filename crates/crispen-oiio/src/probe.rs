@@ -0,0 +1,76 @@
+//! Header-only metadata queries.
+//!
+//! [`probe`] opens a file, reads its header and closes it again without
+//! decoding any pixels, so browsing a folder of thousands of frames stays
+//! cheap.
+
+use std::ffi::{CStr, CString, c_char};
+use std::mem::MaybeUninit;
+use std::path::Path;
+
+use crispen_core::image::BitDepth;
+
+use crate::error::{OiioError, ffi_error};
+use crate::image_input::bit_depth_from_format;
+use crate::sys;
+
+/// Image metadata read from a file header.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioProbe {
+    pub width: u32,
+    pub height: u32,
+    pub nchannels: u32,
+    /// Stored sample depth, including 10/12-bit packed formats.
+    pub bit_depth: BitDepth,
+    /// Native tile size, `None` for scanline files.
+    pub tile_size: Option<(u32, u32)>,
+    /// Number of subimages (EXR parts, TIFF pages).
+    pub subimages: u32,
+    /// MIP levels of the first subimage (1 when there is no pyramid).
+    pub mip_levels: u32,
+    /// `oiio:ColorSpace` hint, usable as an OCIO color space name.
+    pub color_space: Option<String>,
+    /// OIIO format plugin name, e.g. `"openexr"`.
+    pub format_name: String,
+}
+
+pub(crate) fn fixed_string(buf: &[c_char]) -> String {
+    // SAFETY: the C side always NUL-terminates within the buffer.
+    unsafe { CStr::from_ptr(buf.as_ptr()) }
+        .to_string_lossy()
+        .into_owned()
+}
+
+/// Read the header of `path` without decoding pixels.
+pub fn probe(path: &Path) -> Result<OiioProbe, OiioError> {
+    let c_path = CString::new(path.to_string_lossy().as_bytes())?;
+    let mut raw = MaybeUninit::<sys::OiioProbeSpec>::zeroed();
+    // SAFETY: `c_path` is NUL-terminated and `raw` is a valid out-parameter.
+    let ok = unsafe { sys::oiio_probe(c_path.as_ptr(), raw.as_mut_ptr()) };
+    if ok == 0 {
+        return Err(ffi_error());
+    }
+    // SAFETY: the struct is plain data, zero-initialized and filled on success.
+    let raw = unsafe { raw.assume_init() };
+
+    let bit_depth = match raw.bits_per_sample {
+        10 => BitDepth::U10,
+        12 => BitDepth::U12,
+        _ => bit_depth_from_format(raw.format),
+    };
+    let tile_size = (raw.tile_width > 0 && raw.tile_height > 0)
+        .then_some((raw.tile_width as u32, raw.tile_height as u32));
+    let color_space = fixed_string(&raw.color_space);
+
+    Ok(OiioProbe {
+        width: raw.width.max(0) as u32,
+        height: raw.height.max(0) as u32,
+        nchannels: raw.nchannels.max(0) as u32,
+        bit_depth,
+        tile_size,
+        subimages: raw.subimages.max(1) as u32,
+        mip_levels: raw.miplevels.max(1) as u32,
+        color_space: (!color_space.is_empty()).then_some(color_space),
+        format_name: fixed_string(&raw.format_name),
+    })
+}
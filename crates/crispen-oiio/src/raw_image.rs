@@ -0,0 +1,258 @@
+//! Memory-mapped reads of uncompressed frames.
+//!
+//! Uncompressed DPX, strip TIFF and scanline EXR plates spend most of a
+//! regular decode copying bytes through OIIO's buffers. [`OiioRawImage`]
+//! maps such files instead, describes where every stored sample lives, and
+//! only converts rows to RGBA f32 when a band is asked for. The handle is
+//! immutable, so many threads can convert bands of one frame at once.
+//!
+//! [`OiioImageSequence`](crate::OiioImageSequence) and
+//! [`batch_export`](crate::batch_export) convert the same layouts without
+//! a handle, from a buffered read rather than a mapping, so files still
+//! being written cannot fault there. Open a handle directly to split one
+//! frame's conversion across threads, on files that are complete.
+
+use std::ffi::CString;
+use std::mem::MaybeUninit;
+use std::ops::Range;
+use std::path::Path;
+use std::ptr::NonNull;
+
+use crate::error::{OiioError, ffi_error};
+use crate::image_input::basetype;
+use crate::probe::fixed_string;
+use crate::sys;
+
+/// How one stored sample is encoded.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OiioRawSample {
+    U8,
+    U16,
+    /// Three 10-bit samples per 32-bit word (DPX filled, method A: padding
+    /// in the low two bits).
+    U10FilledA,
+    /// As [`U10FilledA`](Self::U10FilledA) with the padding in the high bits.
+    U10FilledB,
+    F16,
+    F32,
+}
+
+/// Where the samples of an [`OiioRawImage`] live.
+///
+/// Sample `(x, y, c)` starts at byte
+/// `y * row_stride + x * pixel_stride + c * channel_stride` of
+/// [`OiioRawImage::data`].
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioRawLayout {
+    pub width: u32,
+    pub height: u32,
+    pub nchannels: u32,
+    pub sample: OiioRawSample,
+    /// Multi-byte samples are big-endian.
+    pub big_endian: bool,
+    /// Stored channel index of each of the first four channels in OIIO
+    /// order (EXR stores channels sorted by name); `None` past `nchannels`.
+    pub channel_order: [Option<u32>; 4],
+    pub pixel_stride: isize,
+    pub channel_stride: isize,
+    pub row_stride: isize,
+    /// `"dpx"`, `"tiff"` or `"openexr"`.
+    pub format_name: String,
+}
+
+/// A memory-mapped uncompressed image file.
+///
+/// Conversions copy out of the mapping. As with any memory-mapped reader, a
+/// file truncated by another process while it is mapped makes those copies
+/// fault, so every method that reads pixels is `unsafe` and carries the
+/// contract of [`data`](Self::data): only map files that are complete and
+/// no longer being written.
+pub struct OiioRawImage {
+    ptr: NonNull<sys::OiioRawImage>,
+    layout: OiioRawLayout,
+}
+
+// SAFETY: The handle owns a read-only mapping and a layout that never change
+// after open; the C++ side converts bands without touching shared state.
+unsafe impl Send for OiioRawImage {}
+// SAFETY: See above; concurrent reads are lock-free and race-free.
+unsafe impl Sync for OiioRawImage {}
+
+impl OiioRawImage {
+    /// Map `path` if it is stored uncompressed in a supported layout.
+    ///
+    /// Fails with the reason otherwise, so callers can fall back to
+    /// [`OiioImageInput`](crate::OiioImageInput) or
+    /// [`OiioImageStream`](crate::OiioImageStream).
+    pub fn open(path: &Path) -> Result<Self, OiioError> {
+        let path = CString::new(path.to_string_lossy().as_bytes())?;
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let ptr = unsafe { sys::oiio_raw_image_open(path.as_ptr()) };
+        let ptr = NonNull::new(ptr).ok_or_else(ffi_error)?;
+
+        let mut raw = MaybeUninit::<sys::OiioRawLayout>::zeroed();
+        // SAFETY: `ptr` is a live handle and `raw` a valid out-parameter.
+        if unsafe { sys::oiio_raw_image_layout(ptr.as_ptr(), raw.as_mut_ptr()) } == 0 {
+            let err = ffi_error();
+            // SAFETY: `ptr` came from the constructor above and is not used again.
+            unsafe { sys::oiio_raw_image_destroy(ptr.as_ptr()) };
+            return Err(err);
+        }
+        // SAFETY: the struct is plain data, zero-initialized and filled on success.
+        let raw = unsafe { raw.assume_init() };
+        Ok(Self {
+            ptr,
+            layout: layout_from_raw(&raw),
+        })
+    }
+
+    pub fn layout(&self) -> &OiioRawLayout {
+        &self.layout
+    }
+
+    pub fn width(&self) -> u32 {
+        self.layout.width
+    }
+
+    pub fn height(&self) -> u32 {
+        self.layout.height
+    }
+
+    /// The stored samples, from the first sample of row 0 to the end of the
+    /// last one, straight out of the mapping.
+    ///
+    /// # Safety
+    ///
+    /// The slice aliases the file itself: the file must not be written to,
+    /// truncated or replaced in place while the slice is alive. A write would
+    /// change bytes behind a shared reference, and reading past a truncated
+    /// end raises `SIGBUS`. Replacing the file by renaming a new one over it
+    /// is fine.
+    pub unsafe fn data(&self) -> &[u8] {
+        let mut len = 0_usize;
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        let ptr = unsafe { sys::oiio_raw_image_data(self.ptr.as_ptr(), &mut len) };
+        // SAFETY: the mapping covers `len` bytes from `ptr`, is read-only and
+        // stays mapped until `self` is dropped; the caller guarantees the file
+        // is not modified meanwhile.
+        unsafe { std::slice::from_raw_parts(ptr.cast::<u8>(), len) }
+    }
+
+    /// Convert `rows` to RGBA f32 pixels in `buf`.
+    ///
+    /// Channel mapping matches
+    /// [`OiioImageInput::read_rgba_f32`](crate::OiioImageInput::read_rgba_f32).
+    /// `buf` must hold exactly `rows.len() * width` pixels.
+    ///
+    /// # Safety
+    ///
+    /// As for [`data`](Self::data): the file must not be written to,
+    /// truncated or replaced in place during the call.
+    pub unsafe fn read_rgba_rows(
+        &self,
+        rows: Range<u32>,
+        buf: &mut [[f32; 4]],
+    ) -> Result<(), OiioError> {
+        if rows.is_empty() || rows.end > self.height() {
+            return Err(OiioError::InvalidArgument("row range out of bounds"));
+        }
+        if buf.len() != rows.len() * self.width() as usize {
+            return Err(OiioError::InvalidArgument("buffer size mismatch"));
+        }
+        // SAFETY: `buf` is valid for writes of `buf.len() * 4` floats, the
+        // handle is only read, and the caller keeps the mapped file intact.
+        let ok = unsafe {
+            sys::oiio_raw_image_read_rgba_f32(
+                self.ptr.as_ptr(),
+                rows.start as i32,
+                rows.end as i32,
+                buf.as_mut_ptr().cast::<f32>(),
+                buf.len() * 4,
+                0,
+            )
+        };
+        if ok == 0 {
+            return Err(ffi_error());
+        }
+        Ok(())
+    }
+
+    /// Convert the whole image to RGBA f32, `band_rows` rows at a time,
+    /// spreading the bands over all available cores.
+    ///
+    /// # Safety
+    ///
+    /// As for [`data`](Self::data): the file must not be written to,
+    /// truncated or replaced in place during the call.
+    pub unsafe fn read_rgba_f32(&self, band_rows: u32) -> Result<Vec<[f32; 4]>, OiioError> {
+        let w = self.width() as usize;
+        let h = self.height();
+        if w == 0 || h == 0 {
+            return Err(OiioError::InvalidArgument("image has zero dimensions"));
+        }
+
+        let band_rows = band_rows.max(1);
+        let mut pixels = vec![[0.0_f32, 0.0, 0.0, 1.0]; w * h as usize];
+        let bands: Vec<(u32, &mut [[f32; 4]])> = pixels
+            .chunks_mut(w * band_rows as usize)
+            .enumerate()
+            .map(|(i, band)| (i as u32 * band_rows, band))
+            .collect();
+        let workers = std::thread::available_parallelism()
+            .map_or(1, |n| n.get())
+            .min(bands.len());
+        let per_worker = bands.len().div_ceil(workers);
+
+        let mut bands = bands.into_iter();
+        std::thread::scope(|scope| {
+            let handles: Vec<_> = (0..workers)
+                .map(|_| {
+                    let chunk: Vec<_> = bands.by_ref().take(per_worker).collect();
+                    scope.spawn(move || {
+                        for (y0, band) in chunk {
+                            let y1 = y0 + (band.len() / w) as u32;
+                            // SAFETY: the caller's contract covers the
+                            // whole call.
+                            unsafe { self.read_rgba_rows(y0..y1, band)? };
+                        }
+                        Ok::<_, OiioError>(())
+                    })
+                })
+                .collect();
+            handles
+                .into_iter()
+                .try_for_each(|handle| handle.join().expect("band conversion panicked"))
+        })?;
+        Ok(pixels)
+    }
+}
+
+impl Drop for OiioRawImage {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_raw_image_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+fn layout_from_raw(raw: &sys::OiioRawLayout) -> OiioRawLayout {
+    let sample = match (raw.packing, raw.format) {
+        (sys::OIIO_RAW_PACKING_10BIT_FILLED_A, _) => OiioRawSample::U10FilledA,
+        (sys::OIIO_RAW_PACKING_10BIT_FILLED_B, _) => OiioRawSample::U10FilledB,
+        (_, basetype::UINT8) => OiioRawSample::U8,
+        (_, basetype::UINT16) => OiioRawSample::U16,
+        (_, basetype::HALF) => OiioRawSample::F16,
+        _ => OiioRawSample::F32,
+    };
+    OiioRawLayout {
+        width: raw.width.max(0) as u32,
+        height: raw.height.max(0) as u32,
+        nchannels: raw.nchannels.max(0) as u32,
+        sample,
+        big_endian: raw.big_endian != 0,
+        channel_order: raw.channel_order.map(|c| u32::try_from(c).ok()),
+        pixel_stride: raw.pixel_stride,
+        channel_stride: raw.channel_stride,
+        row_stride: raw.row_stride,
+        format_name: fixed_string(&raw.format_name),
+    }
+}
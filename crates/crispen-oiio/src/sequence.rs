@@ -0,0 +1,217 @@
+use std::ffi::CString;
+use std::marker::PhantomData;
+use std::ops::RangeInclusive;
+use std::ptr::NonNull;
+use std::time::Duration;
+
+use crate::error::{OiioError, ffi_error};
+use crate::sys;
+
+/// Direction the playhead is moving, which decides where frames are read
+/// ahead.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum OiioPlayDirection {
+    #[default]
+    Forward,
+    Reverse,
+    /// Paused or scrubbing: prefetch evenly on both sides of the playhead.
+    Still,
+}
+
+/// Residency of one frame in the prefetch ring.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum OiioFrameStatus {
+    Absent,
+    Loading,
+    Ready,
+    Failed,
+}
+
+/// Prefetcher configuration.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct OiioSequenceOptions {
+    /// Number of decoded frames kept resident around the playhead.
+    pub ring_size: u32,
+    /// Decode threads; `0` picks a default.
+    pub threads: u32,
+    /// Downscale frames at decode time to fit `(max_width, max_height)`.
+    pub max_size: Option<(u32, u32)>,
+}
+
+impl Default for OiioSequenceOptions {
+    fn default() -> Self {
+        Self {
+            ring_size: 16,
+            threads: 0,
+            max_size: None,
+        }
+    }
+}
+
+/// Read-ahead decoder for an image sequence.
+///
+/// Native threads decode frames around the playhead into a bounded ring of
+/// RGBA f32 buffers, so playback never blocks on disk or EXR decode as long
+/// as the ring keeps up. Poll with [`try_frame`](Self::try_frame) or block
+/// with [`wait_frame`](Self::wait_frame). Full-size uncompressed DPX, TIFF
+/// and EXR frames skip the regular decoder and are converted from one
+/// buffered read of the file, as [`OiioRawImage`](crate::OiioRawImage) does
+/// from a mapping; a frame still being written fails instead of faulting.
+pub struct OiioImageSequence {
+    ptr: NonNull<sys::OiioSequence>,
+}
+
+// SAFETY: Every entry point of the C++ prefetcher locks its internal mutex,
+// and decoded buffers are only handed out while pinned.
+unsafe impl Send for OiioImageSequence {}
+// SAFETY: See above; shared access is synchronized internally.
+unsafe impl Sync for OiioImageSequence {}
+
+impl OiioImageSequence {
+    /// Start prefetching `frames` of `pattern`.
+    ///
+    /// The frame number token in `pattern` is a run of `#` (one digit each)
+    /// or printf-style `%04d`. The playhead starts on the first frame, moving
+    /// forward.
+    pub fn new(
+        pattern: &str,
+        frames: RangeInclusive<i32>,
+        options: OiioSequenceOptions,
+    ) -> Result<Self, OiioError> {
+        if options.ring_size == 0 {
+            return Err(OiioError::InvalidArgument("ring_size must be at least 1"));
+        }
+        let pattern = CString::new(pattern)?;
+        let (max_w, max_h) = options.max_size.unwrap_or((0, 0));
+
+        // SAFETY: FFI constructor returns owned opaque pointer or null on error.
+        let ptr = unsafe {
+            sys::oiio_sequence_create(
+                pattern.as_ptr(),
+                *frames.start(),
+                *frames.end(),
+                options.ring_size.min(i32::MAX as u32) as i32,
+                options.threads.min(i32::MAX as u32) as i32,
+                max_w.min(i32::MAX as u32) as i32,
+                max_h.min(i32::MAX as u32) as i32,
+            )
+        };
+        NonNull::new(ptr)
+            .map(|ptr| Self { ptr })
+            .ok_or_else(ffi_error)
+    }
+
+    /// Move the playhead; prefetching re-targets immediately.
+    pub fn set_playhead(&self, frame: i32, direction: OiioPlayDirection) {
+        let direction = match direction {
+            OiioPlayDirection::Forward => 1,
+            OiioPlayDirection::Reverse => -1,
+            OiioPlayDirection::Still => 0,
+        };
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        unsafe { sys::oiio_sequence_set_playhead(self.ptr.as_ptr(), frame, direction) };
+    }
+
+    pub fn status(&self, frame: i32) -> OiioFrameStatus {
+        // SAFETY: `self.ptr` is valid for the life of `self`.
+        match unsafe { sys::oiio_sequence_frame_status(self.ptr.as_ptr(), frame) } {
+            sys::OIIO_FRAME_LOADING => OiioFrameStatus::Loading,
+            sys::OIIO_FRAME_READY => OiioFrameStatus::Ready,
+            sys::OIIO_FRAME_FAILED => OiioFrameStatus::Failed,
+            _ => OiioFrameStatus::Absent,
+        }
+    }
+
+    /// Return `frame` if it is already decoded, without blocking.
+    pub fn try_frame(&self, frame: i32) -> Result<Option<OiioSequenceFrame<'_>>, OiioError> {
+        self.acquire(frame, 0)
+    }
+
+    /// Wait up to `timeout` for `frame` to finish decoding.
+    ///
+    /// Returns `Ok(None)` on timeout, or early if the frame is outside the
+    /// prefetch window (move the playhead first).
+    pub fn wait_frame(
+        &self,
+        frame: i32,
+        timeout: Duration,
+    ) -> Result<Option<OiioSequenceFrame<'_>>, OiioError> {
+        let ms = timeout.as_millis().clamp(1, i32::MAX as u128) as i32;
+        self.acquire(frame, ms)
+    }
+
+    fn acquire(
+        &self,
+        frame: i32,
+        timeout_ms: i32,
+    ) -> Result<Option<OiioSequenceFrame<'_>>, OiioError> {
+        let mut raw = sys::OiioSequenceFrame {
+            frame: 0,
+            width: 0,
+            height: 0,
+            pixels: std::ptr::null(),
+        };
+        // SAFETY: `self.ptr` is valid and `raw` is a valid out-parameter.
+        let rc = unsafe {
+            sys::oiio_sequence_acquire_frame(self.ptr.as_ptr(), frame, timeout_ms, &mut raw)
+        };
+        match rc {
+            1 => Ok(Some(OiioSequenceFrame {
+                seq: self.ptr,
+                raw,
+                _borrow: PhantomData,
+            })),
+            0 => Ok(None),
+            _ => Err(ffi_error()),
+        }
+    }
+}
+
+impl Drop for OiioImageSequence {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_sequence_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+/// A decoded frame pinned in the prefetch ring.
+///
+/// The buffer is not recycled while this guard is alive; dropping it returns
+/// the slot to the prefetcher.
+pub struct OiioSequenceFrame<'a> {
+    seq: NonNull<sys::OiioSequence>,
+    raw: sys::OiioSequenceFrame,
+    _borrow: PhantomData<&'a OiioImageSequence>,
+}
+
+impl OiioSequenceFrame<'_> {
+    pub fn frame(&self) -> i32 {
+        self.raw.frame
+    }
+
+    pub fn width(&self) -> u32 {
+        self.raw.width.max(0) as u32
+    }
+
+    pub fn height(&self) -> u32 {
+        self.raw.height.max(0) as u32
+    }
+
+    /// Decoded RGBA f32 pixels, `width * height` entries.
+    pub fn pixels(&self) -> &[[f32; 4]] {
+        let len = self.width() as usize * self.height() as usize;
+        if len == 0 || self.raw.pixels.is_null() {
+            return &[];
+        }
+        // SAFETY: the pinned slot holds `len` RGBA f32 pixels that are not
+        // written or freed until this guard releases the pin.
+        unsafe { std::slice::from_raw_parts(self.raw.pixels.cast::<[f32; 4]>(), len) }
+    }
+}
+
+impl Drop for OiioSequenceFrame<'_> {
+    fn drop(&mut self) {
+        // SAFETY: the borrowed sequence outlives this guard.
+        unsafe { sys::oiio_sequence_release_frame(self.seq.as_ptr(), self.raw.frame) };
+    }
+}
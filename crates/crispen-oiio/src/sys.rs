@@ -1,16 +1,259 @@
-use std::ffi::{c_char, c_int};
+use std::ffi::{c_char, c_int, c_void};
 
 #[repr(C)]
 pub struct OiioImageInput {
     _private: [u8; 0],
 }
 
+#[repr(C)]
+pub struct OiioImageStream {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OiioImageOutput {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+pub struct OiioAsyncWriter {
+    _private: [u8; 0],
+}
+
+pub const OIIO_PIXEL_F32: c_int = 0;
+pub const OIIO_PIXEL_F16: c_int = 1;
+
+pub const OIIO_BIT_DEPTH_UINT8: c_int = 0;
+pub const OIIO_BIT_DEPTH_UINT10: c_int = 1;
+pub const OIIO_BIT_DEPTH_UINT12: c_int = 2;
+pub const OIIO_BIT_DEPTH_UINT16: c_int = 3;
+pub const OIIO_BIT_DEPTH_F16: c_int = 4;
+pub const OIIO_BIT_DEPTH_F32: c_int = 5;
+
+#[repr(C)]
+pub struct OiioOutputOptions {
+    pub bit_depth: c_int,
+    pub compression: *const c_char,
+    pub tile_width: c_int,
+    pub tile_height: c_int,
+    pub color_space: *const c_char,
+    pub write_alpha: c_int,
+}
+
+#[repr(C)]
+pub struct OiioSequence {
+    _private: [u8; 0],
+}
+
+pub const OIIO_FRAME_LOADING: c_int = 1;
+pub const OIIO_FRAME_READY: c_int = 2;
+pub const OIIO_FRAME_FAILED: c_int = 3;
+
+#[repr(C)]
+pub struct OiioSequenceFrame {
+    pub frame: c_int,
+    pub width: c_int,
+    pub height: c_int,
+    pub pixels: *const f32,
+}
+
+#[repr(C)]
+#[derive(Default)]
+pub struct OiioImageCacheStats {
+    pub hits: u64,
+    pub misses: u64,
+    pub bytes_read: u64,
+    pub evictions: u64,
+    pub memory_used: u64,
+    pub tiles_current: c_int,
+    pub open_files: c_int,
+    pub max_memory_mb: f32,
+    pub max_open_files: c_int,
+}
+
+pub const OIIO_PERF_OPEN: c_int = 0;
+pub const OIIO_PERF_DECODE: c_int = 1;
+pub const OIIO_PERF_CACHE_READ: c_int = 2;
+pub const OIIO_PERF_CHANNEL_EXPAND: c_int = 3;
+pub const OIIO_PERF_RESIZE: c_int = 4;
+pub const OIIO_PERF_WRITE: c_int = 5;
+pub const OIIO_PERF_STAGE_COUNT: usize = 6;
+
+pub type OiioPerfStats = crispen_ffi::perf::RawPerfStats<OIIO_PERF_STAGE_COUNT>;
+pub type OiioPerfCallback = crispen_ffi::perf::RawPerfCallback;
+
+#[repr(C)]
+pub struct OiioProbeSpec {
+    pub width: c_int,
+    pub height: c_int,
+    pub nchannels: c_int,
+    pub format: c_int,
+    pub bits_per_sample: c_int,
+    pub tile_width: c_int,
+    pub tile_height: c_int,
+    pub subimages: c_int,
+    pub miplevels: c_int,
+    pub color_space: [c_char; 128],
+    pub format_name: [c_char; 32],
+}
+
+#[repr(C)]
+pub struct OiioSubimageSpec {
+    pub width: c_int,
+    pub height: c_int,
+    pub nchannels: c_int,
+    pub format: c_int,
+    pub name: [c_char; 128],
+}
+
+#[repr(C)]
+pub struct OiioRawImage {
+    _private: [u8; 0],
+}
+
+pub const OIIO_RAW_PACKING_10BIT_FILLED_A: c_int = 1;
+pub const OIIO_RAW_PACKING_10BIT_FILLED_B: c_int = 2;
+
+#[repr(C)]
+pub struct OiioRawLayout {
+    pub width: c_int,
+    pub height: c_int,
+    pub nchannels: c_int,
+    pub format: c_int,
+    pub bits_per_sample: c_int,
+    pub packing: c_int,
+    pub big_endian: c_int,
+    pub channel_order: [c_int; 4],
+    pub pixel_stride: isize,
+    pub channel_stride: isize,
+    pub row_stride: isize,
+    pub format_name: [c_char; 32],
+}
+
+#[repr(C)]
+pub struct OiioThumbnailBatch {
+    _private: [u8; 0],
+}
+
+pub type OiioThumbnailTransform = unsafe extern "C" fn(
+    user_data: *mut c_void,
+    index: c_int,
+    rgba: *mut f32,
+    width: c_int,
+    height: c_int,
+) -> c_int;
+
+#[repr(C)]
+pub struct OiioThumbnail {
+    pub width: c_int,
+    pub height: c_int,
+    pub pixels: *const u8,
+}
+
+#[repr(C)]
+pub struct OiioBatchExport {
+    _private: [u8; 0],
+}
+
+pub type OiioBatchTransform = unsafe extern "C" fn(
+    user_data: *mut c_void,
+    index: c_int,
+    rgba: *mut f32,
+    width: c_int,
+    height: c_int,
+) -> c_int;
+
+#[repr(C)]
+#[derive(Default)]
+pub struct OiioBatchStats {
+    pub frames_total: c_int,
+    pub frames_written: c_int,
+    pub frames_failed: c_int,
+    pub pixels_written: u64,
+    pub elapsed_ns: u64,
+    pub decode_ns: u64,
+    pub transform_ns: u64,
+    pub encode_ns: u64,
+}
+
+pub type OiioBatchProgress = unsafe extern "C" fn(
+    user_data: *mut c_void,
+    index: c_int,
+    ok: c_int,
+    stats: *const OiioBatchStats,
+) -> c_int;
+
+#[repr(C)]
+pub struct OiioBatchOptions {
+    pub decode_threads: c_int,
+    pub transform_threads: c_int,
+    pub encode_threads: c_int,
+    pub queue_depth: c_int,
+    pub max_width: c_int,
+    pub max_height: c_int,
+}
+
 unsafe extern "C" {
     pub fn oiio_get_last_error() -> *const c_char;
 
+    pub fn oiio_set_threads(n: c_int);
+    pub fn oiio_get_threads() -> c_int;
+    pub fn oiio_image_input_set_threads(h: *mut OiioImageInput, n: c_int);
+    pub fn oiio_image_stream_set_threads(h: *mut OiioImageStream, n: c_int);
+
     pub fn oiio_image_input_open(path: *const c_char) -> *mut OiioImageInput;
+    pub fn oiio_image_input_read_rgba_into(
+        h: *const OiioImageInput,
+        max_width: c_int,
+        max_height: c_int,
+        pixel_format: c_int,
+        dst: *mut c_void,
+        dst_bytes: usize,
+        row_stride: isize,
+    ) -> c_int;
+    pub fn oiio_image_input_read_rgba_f16(
+        h: *const OiioImageInput,
+        buf: *mut u16,
+        buf_len: usize,
+    ) -> c_int;
+
+    pub fn oiio_image_input_open_cached(path: *const c_char) -> *mut OiioImageInput;
     pub fn oiio_image_input_destroy(h: *mut OiioImageInput);
 
+    pub fn oiio_image_input_subimage_count(h: *const OiioImageInput) -> c_int;
+    pub fn oiio_image_input_subimage_spec(
+        h: *const OiioImageInput,
+        subimage: c_int,
+        out: *mut OiioSubimageSpec,
+    ) -> c_int;
+    pub fn oiio_image_input_channel_name(
+        h: *const OiioImageInput,
+        subimage: c_int,
+        channel: c_int,
+    ) -> *const c_char;
+    pub fn oiio_image_input_find_layer(h: *const OiioImageInput, layer: *const c_char) -> c_int;
+    pub fn oiio_image_input_read_layer_rgba_f32(
+        h: *const OiioImageInput,
+        subimage: c_int,
+        layer: *const c_char,
+        buf: *mut f32,
+        buf_len: usize,
+        row_stride: isize,
+    ) -> c_int;
+
+    pub fn oiio_image_cache_configure(max_memory_mb: f32, max_open_files: c_int) -> c_int;
+    pub fn oiio_image_cache_get_stats(out: *mut OiioImageCacheStats);
+    pub fn oiio_image_cache_reset_stats();
+    pub fn oiio_image_cache_invalidate(path: *const c_char);
+
+    pub fn oiio_perf_set_enabled(enabled: c_int);
+    pub fn oiio_perf_is_enabled() -> c_int;
+    pub fn oiio_perf_set_callback(callback: OiioPerfCallback, user: *mut c_void);
+    pub fn oiio_perf_get_stats(out: *mut OiioPerfStats);
+    pub fn oiio_perf_reset();
+
+    pub fn oiio_probe(path: *const c_char, out: *mut OiioProbeSpec) -> c_int;
+
     pub fn oiio_image_input_width(h: *const OiioImageInput) -> c_int;
     pub fn oiio_image_input_height(h: *const OiioImageInput) -> c_int;
     pub fn oiio_image_input_nchannels(h: *const OiioImageInput) -> c_int;
@@ -22,4 +265,183 @@ unsafe extern "C" {
         buf: *mut f32,
         buf_len: c_int,
     ) -> c_int;
+
+    pub fn oiio_image_input_fit_size(
+        h: *const OiioImageInput,
+        max_width: c_int,
+        max_height: c_int,
+        out_width: *mut c_int,
+        out_height: *mut c_int,
+    ) -> c_int;
+
+    pub fn oiio_image_input_read_rgba_f32_fit(
+        h: *const OiioImageInput,
+        max_width: c_int,
+        max_height: c_int,
+        buf: *mut f32,
+        buf_len: c_int,
+    ) -> c_int;
+
+    pub fn oiio_image_stream_open(path: *const c_char) -> *mut OiioImageStream;
+    pub fn oiio_image_stream_destroy(h: *mut OiioImageStream);
+
+    pub fn oiio_image_stream_width(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_height(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_nchannels(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_format(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_tile_width(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_tile_height(h: *const OiioImageStream) -> c_int;
+    pub fn oiio_image_stream_color_space(h: *const OiioImageStream) -> *const c_char;
+
+    pub fn oiio_image_stream_read_scanlines(
+        h: *mut OiioImageStream,
+        ybegin: c_int,
+        yend: c_int,
+        chbegin: c_int,
+        chend: c_int,
+        buf: *mut f32,
+        buf_len: usize,
+        xstride: isize,
+        ystride: isize,
+    ) -> c_int;
+
+    pub fn oiio_image_stream_read_tiles(
+        h: *mut OiioImageStream,
+        xbegin: c_int,
+        xend: c_int,
+        ybegin: c_int,
+        yend: c_int,
+        chbegin: c_int,
+        chend: c_int,
+        buf: *mut f32,
+        buf_len: usize,
+        xstride: isize,
+        ystride: isize,
+    ) -> c_int;
+
+    pub fn oiio_image_stream_read_rgba_f32(
+        h: *mut OiioImageStream,
+        ybegin: c_int,
+        yend: c_int,
+        buf: *mut f32,
+        buf_len: usize,
+    ) -> c_int;
+
+    pub fn oiio_raw_image_open(path: *const c_char) -> *mut OiioRawImage;
+    pub fn oiio_raw_image_destroy(h: *mut OiioRawImage);
+    pub fn oiio_raw_image_layout(h: *const OiioRawImage, out: *mut OiioRawLayout) -> c_int;
+    pub fn oiio_raw_image_data(h: *const OiioRawImage, out_len: *mut usize) -> *const c_void;
+    pub fn oiio_raw_image_read_rgba_f32(
+        h: *const OiioRawImage,
+        ybegin: c_int,
+        yend: c_int,
+        buf: *mut f32,
+        buf_len: usize,
+        row_stride: isize,
+    ) -> c_int;
+
+    pub fn oiio_sequence_create(
+        pattern: *const c_char,
+        first_frame: c_int,
+        last_frame: c_int,
+        ring_size: c_int,
+        num_threads: c_int,
+        max_width: c_int,
+        max_height: c_int,
+    ) -> *mut OiioSequence;
+    pub fn oiio_sequence_destroy(seq: *mut OiioSequence);
+    pub fn oiio_sequence_set_playhead(seq: *mut OiioSequence, frame: c_int, direction: c_int);
+    pub fn oiio_sequence_frame_status(seq: *mut OiioSequence, frame: c_int) -> c_int;
+    pub fn oiio_sequence_acquire_frame(
+        seq: *mut OiioSequence,
+        frame: c_int,
+        timeout_ms: c_int,
+        out: *mut OiioSequenceFrame,
+    ) -> c_int;
+    pub fn oiio_sequence_release_frame(seq: *mut OiioSequence, frame: c_int);
+
+    pub fn oiio_image_output_open(
+        path: *const c_char,
+        width: c_int,
+        height: c_int,
+        options: *const OiioOutputOptions,
+    ) -> *mut OiioImageOutput;
+    pub fn oiio_image_output_tile_width(h: *const OiioImageOutput) -> c_int;
+    pub fn oiio_image_output_tile_height(h: *const OiioImageOutput) -> c_int;
+    pub fn oiio_image_output_write_scanlines(
+        h: *mut OiioImageOutput,
+        ybegin: c_int,
+        yend: c_int,
+        src_format: c_int,
+        data: *const c_void,
+        row_stride: isize,
+    ) -> c_int;
+    pub fn oiio_image_output_write_tiles(
+        h: *mut OiioImageOutput,
+        xbegin: c_int,
+        xend: c_int,
+        ybegin: c_int,
+        yend: c_int,
+        src_format: c_int,
+        data: *const c_void,
+        row_stride: isize,
+    ) -> c_int;
+    pub fn oiio_image_output_write_image(
+        h: *mut OiioImageOutput,
+        src_format: c_int,
+        data: *const c_void,
+        row_stride: isize,
+    ) -> c_int;
+    pub fn oiio_image_output_close(h: *mut OiioImageOutput) -> c_int;
+    pub fn oiio_image_output_destroy(h: *mut OiioImageOutput);
+
+    pub fn oiio_async_writer_create(num_buffers: c_int, num_threads: c_int)
+    -> *mut OiioAsyncWriter;
+    pub fn oiio_async_writer_destroy(w: *mut OiioAsyncWriter);
+    pub fn oiio_async_writer_acquire(
+        w: *mut OiioAsyncWriter,
+        bytes: usize,
+        out_id: *mut c_int,
+    ) -> *mut c_void;
+    pub fn oiio_async_writer_discard(w: *mut OiioAsyncWriter, id: c_int);
+    pub fn oiio_async_writer_submit(
+        w: *mut OiioAsyncWriter,
+        id: c_int,
+        path: *const c_char,
+        width: c_int,
+        height: c_int,
+        src_format: c_int,
+        row_stride: isize,
+        options: *const OiioOutputOptions,
+    ) -> c_int;
+    pub fn oiio_async_writer_flush(w: *mut OiioAsyncWriter) -> c_int;
+
+    pub fn oiio_thumbnails_generate(
+        paths: *const *const c_char,
+        count: c_int,
+        max_edge: c_int,
+        num_threads: c_int,
+        transform: Option<OiioThumbnailTransform>,
+        user_data: *mut c_void,
+    ) -> *mut OiioThumbnailBatch;
+    pub fn oiio_thumbnail_batch_get(
+        batch: *const OiioThumbnailBatch,
+        index: c_int,
+        out: *mut OiioThumbnail,
+    ) -> c_int;
+    pub fn oiio_thumbnail_batch_destroy(batch: *mut OiioThumbnailBatch);
+
+    pub fn oiio_batch_export_run(
+        inputs: *const *const c_char,
+        outputs: *const *const c_char,
+        count: c_int,
+        options: *const OiioBatchOptions,
+        output: *const OiioOutputOptions,
+        transform: Option<OiioBatchTransform>,
+        progress: Option<OiioBatchProgress>,
+        user_data: *mut c_void,
+    ) -> *mut OiioBatchExport;
+    pub fn oiio_batch_export_result(batch: *const OiioBatchExport, index: c_int) -> c_int;
+    pub fn oiio_batch_export_get_stats(batch: *const OiioBatchExport, out: *mut OiioBatchStats);
+    pub fn oiio_batch_export_destroy(batch: *mut OiioBatchExport);
 }
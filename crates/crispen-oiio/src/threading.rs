@@ -0,0 +1,20 @@
+//! Process-wide OIIO thread budget.
+//!
+//! OIIO and OpenEXR keep their own thread pools, which otherwise size
+//! themselves to every hardware thread and compete with Bevy's task pools
+//! and rayon. Pin them to a fixed core budget on shared render nodes.
+
+use crate::sys;
+
+/// Set the thread budget for OIIO decode, `ImageBufAlgo` work and OpenEXR
+/// decompression. `0` uses every hardware thread.
+pub fn set_threads(threads: u32) {
+    // SAFETY: plain value call with no pointer arguments.
+    unsafe { sys::oiio_set_threads(threads.min(i32::MAX as u32) as i32) };
+}
+
+/// Current global OIIO thread budget (`0` means all hardware threads).
+pub fn threads() -> u32 {
+    // SAFETY: plain call with no arguments.
+    unsafe { sys::oiio_get_threads() }.max(0) as u32
+}
@@ -0,0 +1,209 @@
+//! Batch thumbnail generation for bin and browser views.
+//!
+//! [`generate_thumbnails`] decodes a list of files on a native thread pool
+//! at the smallest resolution that still covers the requested edge size
+//! and returns 8-bit RGBA proxies, optionally passed through a display
+//! transform first.
+
+use std::ffi::{CString, c_int, c_void};
+use std::panic::{AssertUnwindSafe, catch_unwind};
+use std::path::Path;
+use std::ptr::NonNull;
+use std::sync::{Mutex, PoisonError};
+
+use crate::error::{OiioError, ffi_error};
+use crate::sys;
+
+/// Float RGBA transform applied to each thumbnail before quantization,
+/// e.g. a closure over an OCIO display processor. Called concurrently from
+/// the pool threads with packed pixels and the thumbnail size. An `Err`
+/// fails only that thumbnail.
+pub type OiioThumbnailTransform<'a> =
+    &'a (dyn Fn(&mut [[f32; 4]], u32, u32) -> Result<(), String> + Sync);
+
+/// Settings for [`generate_thumbnails`].
+#[derive(Clone, Copy)]
+pub struct OiioThumbnailOptions<'a> {
+    /// Longest edge of the produced thumbnails, in pixels.
+    pub max_edge: u32,
+    /// Decode threads; `0` uses one per hardware thread.
+    pub threads: u32,
+    pub transform: Option<OiioThumbnailTransform<'a>>,
+}
+
+impl Default for OiioThumbnailOptions<'_> {
+    fn default() -> Self {
+        Self {
+            max_edge: 256,
+            threads: 0,
+            transform: None,
+        }
+    }
+}
+
+/// An 8-bit RGBA thumbnail.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct OiioThumbnail {
+    pub width: u32,
+    pub height: u32,
+    pub pixels: Vec<[u8; 4]>,
+}
+
+struct ThumbnailContext<'a> {
+    transform: OiioThumbnailTransform<'a>,
+    // Messages of failed transforms by path index; the native side only
+    // learns that the transform failed.
+    transform_errors: Mutex<Vec<Option<String>>>,
+}
+
+impl ThumbnailContext<'_> {
+    fn record_transform_error(&self, index: usize, message: String) {
+        let mut errors = self
+            .transform_errors
+            .lock()
+            .unwrap_or_else(PoisonError::into_inner);
+        if let Some(slot) = errors.get_mut(index) {
+            *slot = Some(message);
+        }
+    }
+}
+
+unsafe extern "C" fn transform_trampoline(
+    user_data: *mut c_void,
+    index: c_int,
+    rgba: *mut f32,
+    width: c_int,
+    height: c_int,
+) -> c_int {
+    let (Ok(index), Ok(w), Ok(h)) = (
+        usize::try_from(index),
+        u32::try_from(width),
+        u32::try_from(height),
+    ) else {
+        return 0;
+    };
+    // SAFETY: `user_data` is the `ThumbnailContext` owned by
+    // `generate_thumbnails`, which outlives the blocking native call, and
+    // `rgba` holds `width * height` packed RGBA pixels owned by this call.
+    let (context, pixels) = unsafe {
+        (
+            &*user_data.cast::<ThumbnailContext<'_>>(),
+            std::slice::from_raw_parts_mut(rgba.cast::<[f32; 4]>(), w as usize * h as usize),
+        )
+    };
+    // A panic must not unwind into the native thread pool.
+    match catch_unwind(AssertUnwindSafe(|| (context.transform)(pixels, w, h))) {
+        Ok(Ok(())) => 1,
+        Ok(Err(message)) => {
+            context.record_transform_error(index, message);
+            0
+        }
+        Err(_) => {
+            context.record_transform_error(index, "transform panicked".to_string());
+            0
+        }
+    }
+}
+
+struct Batch {
+    ptr: NonNull<sys::OiioThumbnailBatch>,
+}
+
+impl Drop for Batch {
+    fn drop(&mut self) {
+        // SAFETY: pointer came from FFI constructor and is owned by this wrapper.
+        unsafe { sys::oiio_thumbnail_batch_destroy(self.ptr.as_ptr()) };
+    }
+}
+
+/// Generate thumbnails for `paths`, blocking until all are done.
+///
+/// Returns one result per path, in order; a file that fails to decode or
+/// whose transform fails does not affect the others.
+pub fn generate_thumbnails<P: AsRef<Path>>(
+    paths: &[P],
+    options: &OiioThumbnailOptions<'_>,
+) -> Result<Vec<Result<OiioThumbnail, OiioError>>, OiioError> {
+    if options.max_edge == 0 {
+        return Err(OiioError::InvalidArgument("max_edge must be positive"));
+    }
+    let c_paths = paths
+        .iter()
+        .map(|p| CString::new(p.as_ref().to_string_lossy().as_bytes()))
+        .collect::<Result<Vec<_>, _>>()?;
+    let ptrs: Vec<_> = c_paths.iter().map(|p| p.as_ptr()).collect();
+    let count =
+        i32::try_from(ptrs.len()).map_err(|_| OiioError::InvalidArgument("too many paths"))?;
+
+    let context = options.transform.map(|transform| ThumbnailContext {
+        transform,
+        transform_errors: Mutex::new(vec![None; paths.len()]),
+    });
+    let (callback, user_data) = match context.as_ref() {
+        Some(context) => (
+            Some(transform_trampoline as sys::OiioThumbnailTransform),
+            std::ptr::from_ref(context).cast_mut().cast::<c_void>(),
+        ),
+        None => (None, std::ptr::null_mut()),
+    };
+
+    // SAFETY: `ptrs` holds `count` NUL-terminated strings kept alive by
+    // `c_paths`, and `context` outlives the call, which blocks until every
+    // callback has returned.
+    let raw = unsafe {
+        sys::oiio_thumbnails_generate(
+            ptrs.as_ptr(),
+            count,
+            options.max_edge.min(i32::MAX as u32) as i32,
+            options.threads.min(i32::MAX as u32) as i32,
+            callback,
+            user_data,
+        )
+    };
+    let batch = NonNull::new(raw)
+        .map(|ptr| Batch { ptr })
+        .ok_or_else(ffi_error)?;
+
+    let mut transform_errors = context
+        .map(|context| {
+            context
+                .transform_errors
+                .into_inner()
+                .unwrap_or_else(PoisonError::into_inner)
+        })
+        .unwrap_or_default();
+    Ok((0..count)
+        .map(|index| {
+            let mut item = sys::OiioThumbnail {
+                width: 0,
+                height: 0,
+                pixels: std::ptr::null(),
+            };
+            // SAFETY: `batch` is valid and `item` is a valid out-parameter.
+            let ok = unsafe { sys::oiio_thumbnail_batch_get(batch.ptr.as_ptr(), index, &mut item) };
+            if ok == 0 || item.pixels.is_null() {
+                return match transform_errors
+                    .get_mut(index as usize)
+                    .and_then(Option::take)
+                {
+                    Some(message) => Err(OiioError::Transform(message)),
+                    None => Err(ffi_error()),
+                };
+            }
+            let (width, height) = (item.width.max(0) as u32, item.height.max(0) as u32);
+            // SAFETY: the batch owns `width * height` packed RGBA8 pixels at
+            // `item.pixels`, valid until `batch` is dropped.
+            let pixels = unsafe {
+                std::slice::from_raw_parts(
+                    item.pixels.cast::<[u8; 4]>(),
+                    width as usize * height as usize,
+                )
+            };
+            Ok(OiioThumbnail {
+                width,
+                height,
+                pixels: pixels.to_vec(),
+            })
+        })
+        .collect())
+}
@@ -0,0 +1,929 @@
+// The mapped OiioRawImage reads are unsafe.
+#![allow(unsafe_code)]
+
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::time::{Duration, Instant};
+
+use crispen_core::image::BitDepth;
+use crispen_oiio::{
+    OiioError, OiioExportJob, OiioExportOptions, OiioFrameStatus, OiioImageInput, OiioImageOutput,
+    OiioImageSequence, OiioOutputOptions, OiioPlayDirection, OiioRawImage, OiioSequenceOptions,
+    OiioThumbnailOptions, batch_export, generate_thumbnails,
+};
+
+/// Scratch directory removed again when dropped.
+struct TempDir(PathBuf);
+
+impl TempDir {
+    fn new(name: &str) -> Self {
+        let dir = std::env::temp_dir().join(format!("crispen-oiio-{name}-{}", std::process::id()));
+        std::fs::create_dir_all(&dir).expect("temp dir should be creatable");
+        Self(dir)
+    }
+
+    fn path(&self, file: &str) -> PathBuf {
+        self.0.join(file)
+    }
+}
+
+impl Drop for TempDir {
+    fn drop(&mut self) {
+        let _ = std::fs::remove_dir_all(&self.0);
+    }
+}
+
+/// Deterministic RGBA test pattern in [0, 1] with distinct channels.
+fn test_pattern(width: u32, height: u32) -> Vec<[f32; 4]> {
+    (0..height)
+        .flat_map(|y| {
+            (0..width).map(move |x| {
+                let u = x as f32 / width as f32;
+                let v = y as f32 / height as f32;
+                [u, v, 1.0 - u * v, 0.25 + 0.5 * u]
+            })
+        })
+        .collect()
+}
+
+fn write_image(path: &Path, width: u32, height: u32, options: &OiioOutputOptions) {
+    let mut out =
+        OiioImageOutput::create(path, width, height, options).expect("output should open");
+    out.write_image(&test_pattern(width, height))
+        .expect("write should succeed");
+    out.close().expect("close should succeed");
+}
+
+fn uncompressed(bit_depth: BitDepth, write_alpha: bool) -> OiioOutputOptions {
+    OiioOutputOptions {
+        bit_depth,
+        compression: Some("none".to_string()),
+        write_alpha,
+        ..Default::default()
+    }
+}
+
+fn assert_close4(actual: &[[f32; 4]], expected: &[[f32; 4]], tol: f32) {
+    assert_eq!(actual.len(), expected.len(), "pixel count mismatch");
+    for (i, (a, e)) in actual.iter().zip(expected).enumerate() {
+        for c in 0..4 {
+            let diff = (a[c] - e[c]).abs();
+            assert!(
+                diff <= tol,
+                "pixel {} channel {} mismatch: got {}, expected {}, diff {} > {}",
+                i,
+                c,
+                a[c],
+                e[c],
+                diff,
+                tol
+            );
+        }
+    }
+}
+
+/// Check the mapped reader decodes `path` like the regular decoder.
+fn assert_raw_matches_decoder(path: &Path, tol: f32) {
+    let raw = OiioRawImage::open(path).expect("file should take the raw path");
+    let input = OiioImageInput::open(path).expect("decoder should open the file");
+    assert_eq!((raw.width(), raw.height()), (input.width(), input.height()));
+
+    let expected = input.read_rgba_f32().expect("decode should succeed");
+    // Bands that do not divide the height exercise the partial last band.
+    // SAFETY: the test owns the file and leaves it alone while mapped.
+    let actual = unsafe { raw.read_rgba_f32(5) }.expect("raw conversion should succeed");
+    assert_close4(&actual, &expected, tol);
+}
+
+fn exr_attribute(out: &mut Vec<u8>, name: &str, kind: &str, value: &[u8]) {
+    out.extend_from_slice(name.as_bytes());
+    out.push(0);
+    out.extend_from_slice(kind.as_bytes());
+    out.push(0);
+    out.extend_from_slice(&(value.len() as u32).to_le_bytes());
+    out.extend_from_slice(value);
+}
+
+fn le_words(values: &[i32]) -> Vec<u8> {
+    values.iter().flat_map(|v| v.to_le_bytes()).collect()
+}
+
+/// Header of an uncompressed `width` x `height` EXR with FLOAT `channels`
+/// (sorted by name) and any `extra` attributes, up to the offset table.
+fn exr_header(
+    width: u32,
+    height: u32,
+    channels: &[&str],
+    tiled: bool,
+    extra: &[(&str, &str, Vec<u8>)],
+) -> Vec<u8> {
+    let (w, h) = (width as i32, height as i32);
+    let mut chlist = Vec::new();
+    for name in channels {
+        chlist.extend_from_slice(name.as_bytes());
+        chlist.push(0);
+        // FLOAT, pLinear + reserved, x / y sampling.
+        chlist.extend_from_slice(&le_words(&[2, 0, 1, 1]));
+    }
+    chlist.push(0);
+
+    let mut file = Vec::new();
+    file.extend_from_slice(&20000630_u32.to_le_bytes());
+    // Version 2, plus the single-part tiled flag.
+    let version: u32 = if tiled { 2 | 0x200 } else { 2 };
+    file.extend_from_slice(&version.to_le_bytes());
+    exr_attribute(&mut file, "channels", "chlist", &chlist);
+    exr_attribute(&mut file, "compression", "compression", &[0]);
+    let window = le_words(&[0, 0, w - 1, h - 1]);
+    let one = 1.0_f32.to_le_bytes();
+    exr_attribute(&mut file, "dataWindow", "box2i", &window);
+    exr_attribute(&mut file, "displayWindow", "box2i", &window);
+    exr_attribute(&mut file, "lineOrder", "lineOrder", &[0]);
+    exr_attribute(&mut file, "pixelAspectRatio", "float", &one);
+    exr_attribute(&mut file, "screenWindowCenter", "v2f", &[0; 8]);
+    exr_attribute(&mut file, "screenWindowWidth", "float", &one);
+    for (name, kind, value) in extra {
+        exr_attribute(&mut file, name, kind, value);
+    }
+    file.push(0);
+    file
+}
+
+/// Write a `width` x `height` uncompressed scanline EXR with FLOAT channels
+/// `(name, component, offset)`: each sample is that component of the test
+/// pattern plus `offset`, and `extra` attributes are added to the header.
+/// The writer only produces RGB[A], so the file is built by hand.
+fn write_exr_with(
+    path: &Path,
+    width: u32,
+    height: u32,
+    channels: &[(&str, usize, f32)],
+    extra: &[(&str, &str, Vec<u8>)],
+) {
+    // Stored sorted by name, e.g. A before B.
+    let mut channels = channels.to_vec();
+    channels.sort_by(|a, b| a.0.cmp(b.0));
+    let names: Vec<_> = channels.iter().map(|c| c.0).collect();
+    let mut file = exr_header(width, height, &names, false, extra);
+
+    let row_bytes = width as usize * channels.len() * 4;
+    let table_end = file.len() + height as usize * 8;
+    for y in 0..height as usize {
+        let offset = (table_end + y * (8 + row_bytes)) as u64;
+        file.extend_from_slice(&offset.to_le_bytes());
+    }
+    let pixels = test_pattern(width, height);
+    for (y, row) in pixels.chunks(width as usize).enumerate() {
+        file.extend_from_slice(&le_words(&[y as i32, row_bytes as i32]));
+        for &(_, component, offset) in &channels {
+            for p in row {
+                file.extend_from_slice(&(p[component] + offset).to_le_bytes());
+            }
+        }
+    }
+    std::fs::write(path, file).expect("EXR should be writable");
+}
+
+fn write_exr(path: &Path, width: u32, height: u32, channels: &[(&str, usize, f32)]) {
+    write_exr_with(path, width, height, channels, &[]);
+}
+
+/// Write a tiled, MIP-mapped RGBA FLOAT EXR with one tile per level; every
+/// sample of level `l` is `level_value(l)`, so reads show which level was
+/// decoded.
+fn write_mip_exr(path: &Path, width: u32, height: u32, level_value: impl Fn(u32) -> f32) {
+    // Round-down levels down to 1 x 1.
+    let levels = u32::BITS - width.max(height).leading_zeros();
+    let mut tiledesc = Vec::new();
+    tiledesc.extend_from_slice(&width.to_le_bytes());
+    tiledesc.extend_from_slice(&height.to_le_bytes());
+    // MIPMAP_LEVELS, ROUND_DOWN.
+    tiledesc.push(1);
+    let channels = ["A", "B", "G", "R"];
+    let mut file = exr_header(
+        width,
+        height,
+        &channels,
+        true,
+        &[("tiles", "tiledesc", tiledesc)],
+    );
+
+    let level_size = |l: u32| ((width >> l).max(1) as usize, (height >> l).max(1) as usize);
+    let mut offset = file.len() + levels as usize * 8;
+    for l in 0..levels {
+        file.extend_from_slice(&(offset as u64).to_le_bytes());
+        let (w, h) = level_size(l);
+        offset += 20 + w * h * channels.len() * 4;
+    }
+    for l in 0..levels {
+        let (w, h) = level_size(l);
+        let data_bytes = w * h * channels.len() * 4;
+        file.extend_from_slice(&le_words(&[0, 0, l as i32, l as i32, data_bytes as i32]));
+        for _ in 0..h * channels.len() * w {
+            file.extend_from_slice(&level_value(l).to_le_bytes());
+        }
+    }
+    std::fs::write(path, file).expect("EXR should be writable");
+}
+
+const WIDTH: u32 = 37;
+const HEIGHT: u32 = 23;
+
+#[test]
+fn raw_exr_matches_decoder() {
+    let dir = TempDir::new("raw-exr");
+    for (name, depth) in [("f16.exr", BitDepth::F16), ("f32.exr", BitDepth::F32)] {
+        let path = dir.path(name);
+        write_image(&path, WIDTH, HEIGHT, &uncompressed(depth, true));
+        assert_raw_matches_decoder(&path, 0.0);
+    }
+
+    let path = dir.path("ya.exr");
+    write_exr(&path, WIDTH, HEIGHT, &[("Y", 0, 0.0), ("A", 3, 0.0)]);
+    assert_raw_matches_decoder(&path, 0.0);
+}
+
+#[test]
+fn raw_strip_tiff_matches_decoder() {
+    let dir = TempDir::new("raw-tiff");
+    for (name, depth) in [
+        ("u8.tif", BitDepth::U8),
+        ("u16.tif", BitDepth::U16),
+        ("f16.tif", BitDepth::F16),
+        ("f32.tif", BitDepth::F32),
+    ] {
+        let path = dir.path(name);
+        write_image(&path, WIDTH, HEIGHT, &uncompressed(depth, true));
+        // Integer samples may be normalized with a division or a multiply.
+        assert_raw_matches_decoder(&path, 1e-6);
+    }
+}
+
+#[test]
+fn raw_dpx_matches_decoder() {
+    let dir = TempDir::new("raw-dpx");
+    // 10-bit is only mapped as filled RGB.
+    for (name, depth, alpha) in [
+        ("u10.dpx", BitDepth::U10, false),
+        ("u16.dpx", BitDepth::U16, true),
+    ] {
+        let path = dir.path(name);
+        write_image(&path, WIDTH, HEIGHT, &uncompressed(depth, alpha));
+        // The decoder widens 10-bit codes to 16 bits by bit replication
+        // before normalizing; that stays well under one 10-bit code.
+        assert_raw_matches_decoder(&path, 1e-4);
+    }
+}
+
+#[test]
+fn raw_rejects_compressed_and_tiled_files() {
+    let dir = TempDir::new("raw-reject");
+    let cases = [
+        (
+            "zip.exr",
+            OiioOutputOptions {
+                compression: Some("zip".to_string()),
+                ..Default::default()
+            },
+        ),
+        (
+            "tiled.exr",
+            OiioOutputOptions {
+                tile_size: Some((16, 16)),
+                ..uncompressed(BitDepth::F16, true)
+            },
+        ),
+        (
+            "zip.tif",
+            OiioOutputOptions {
+                bit_depth: BitDepth::U16,
+                compression: Some("zip".to_string()),
+                ..Default::default()
+            },
+        ),
+        (
+            "tiled.tif",
+            OiioOutputOptions {
+                tile_size: Some((16, 16)),
+                ..uncompressed(BitDepth::U16, true)
+            },
+        ),
+    ];
+    for (name, options) in cases {
+        let path = dir.path(name);
+        write_image(&path, WIDTH, HEIGHT, &options);
+        assert!(
+            OiioRawImage::open(&path).is_err(),
+            "{name} should need the regular decoder"
+        );
+        // The regular decoder still reads it.
+        assert!(OiioImageInput::open(&path).is_ok());
+    }
+}
+
+/// Write `count` f32 test frames and return export jobs for them.
+fn export_jobs(dir: &TempDir, count: usize) -> Vec<OiioExportJob> {
+    (0..count)
+        .map(|i| {
+            let input = dir.path(&format!("in.{i:04}.exr"));
+            write_image(&input, WIDTH, HEIGHT, &uncompressed(BitDepth::F32, true));
+            OiioExportJob {
+                input,
+                output: dir.path(&format!("out.{i:04}.exr")),
+            }
+        })
+        .collect()
+}
+
+fn read_back(path: &Path) -> Vec<[f32; 4]> {
+    OiioImageInput::open(path)
+        .expect("output should open")
+        .read_rgba_f32()
+        .expect("output should decode")
+}
+
+fn invert(pixels: &mut [[f32; 4]]) {
+    for p in pixels {
+        for c in &mut p[..3] {
+            *c = 1.0 - *c;
+        }
+    }
+}
+
+fn is_cancelled(result: &Result<(), OiioError>) -> bool {
+    matches!(result, Err(OiioError::Oiio(message)) if message == "cancelled")
+}
+
+#[test]
+fn batch_export_writes_transformed_frames() {
+    let dir = TempDir::new("batch");
+    let jobs = export_jobs(&dir, 6);
+    let transform = |_: usize, pixels: &mut [[f32; 4]], w: u32, h: u32| {
+        assert_eq!((w, h), (WIDTH, HEIGHT));
+        invert(pixels);
+        Ok(())
+    };
+    let progress_calls = AtomicUsize::new(0);
+    let progress = |_: usize, ok: bool, _: &_| {
+        assert!(ok);
+        progress_calls.fetch_add(1, Ordering::Relaxed);
+        true
+    };
+    let options = OiioExportOptions {
+        transform_threads: 2,
+        output: uncompressed(BitDepth::F32, true),
+        transform: Some(&transform),
+        progress: Some(&progress),
+        ..Default::default()
+    };
+
+    let report = batch_export(&jobs, &options).expect("batch should run");
+    assert!(report.results.iter().all(Result::is_ok));
+    assert_eq!(progress_calls.load(Ordering::Relaxed), jobs.len());
+    assert_eq!(report.stats.frames_total, 6);
+    assert_eq!(report.stats.frames_written, 6);
+    assert_eq!(report.stats.frames_failed, 0);
+    assert_eq!(report.stats.pixels_written, 6 * u64::from(WIDTH * HEIGHT));
+
+    let mut expected = test_pattern(WIDTH, HEIGHT);
+    invert(&mut expected);
+    for job in &jobs {
+        assert_close4(&read_back(&job.output), &expected, 0.0);
+    }
+}
+
+#[test]
+fn batch_export_without_transform_copies_frames() {
+    let dir = TempDir::new("batch-copy");
+    let jobs = export_jobs(&dir, 3);
+    let options = OiioExportOptions {
+        output: uncompressed(BitDepth::F32, true),
+        ..Default::default()
+    };
+
+    let report = batch_export(&jobs, &options).expect("batch should run");
+    assert!(report.results.iter().all(Result::is_ok));
+    let expected = test_pattern(WIDTH, HEIGHT);
+    for job in &jobs {
+        assert_close4(&read_back(&job.output), &expected, 0.0);
+    }
+}
+
+#[test]
+fn batch_export_reports_failing_transform_for_that_job_only() {
+    let dir = TempDir::new("batch-fail");
+    let jobs = export_jobs(&dir, 5);
+    let transform = |index: usize, pixels: &mut [[f32; 4]], _: u32, _: u32| {
+        if index == 2 {
+            return Err("bad frame".to_string());
+        }
+        invert(pixels);
+        Ok(())
+    };
+    let options = OiioExportOptions {
+        output: uncompressed(BitDepth::F32, true),
+        transform: Some(&transform),
+        ..Default::default()
+    };
+
+    let report = batch_export(&jobs, &options).expect("batch should run");
+    for (i, result) in report.results.iter().enumerate() {
+        if i == 2 {
+            assert!(
+                matches!(result, Err(OiioError::Transform(message)) if message == "bad frame"),
+                "unexpected result: {result:?}"
+            );
+            assert!(!jobs[i].output.exists());
+        } else {
+            assert!(result.is_ok(), "job {i} failed: {result:?}");
+        }
+    }
+    assert_eq!(report.stats.frames_written, 4);
+    assert_eq!(report.stats.frames_failed, 1);
+}
+
+#[test]
+fn batch_export_cancels_remaining_jobs() {
+    let dir = TempDir::new("batch-cancel");
+    let jobs = export_jobs(&dir, 12);
+    let progress = |_: usize, _: bool, _: &_| false;
+    // One thread per stage keeps few frames in flight when the first one
+    // finishes and cancels.
+    let options = OiioExportOptions {
+        decode_threads: 1,
+        transform_threads: 1,
+        encode_threads: 1,
+        queue_depth: 1,
+        output: uncompressed(BitDepth::F32, true),
+        progress: Some(&progress),
+        ..Default::default()
+    };
+
+    let report = batch_export(&jobs, &options).expect("batch should run");
+    let written = report.results.iter().filter(|r| r.is_ok()).count();
+    assert!(written >= 1, "frames in flight should still finish");
+    // Frames are decoded in order, so the cancelled ones are the tail.
+    assert!(report.results[..written].iter().all(Result::is_ok));
+    assert!(
+        report.results[written..].iter().all(is_cancelled),
+        "unexpected results: {:?}",
+        report.results
+    );
+    assert!(written < jobs.len(), "the batch should have been cancelled");
+    assert_eq!(report.stats.frames_written as usize, written);
+    assert_eq!(report.stats.frames_failed as usize, jobs.len() - written);
+}
+
+/// Unprefixed RGBA, a `diffuse` RGBA layer and a `mask` Y/A layer, each
+/// offset so a read from the wrong layer shows.
+const LAYERED_CHANNELS: &[(&str, usize, f32)] = &[
+    ("R", 0, 0.0),
+    ("G", 1, 0.0),
+    ("B", 2, 0.0),
+    ("A", 3, 0.0),
+    ("diffuse.R", 0, 10.0),
+    ("diffuse.G", 1, 10.0),
+    ("diffuse.B", 2, 10.0),
+    ("diffuse.A", 3, 10.0),
+    ("mask.Y", 0, 20.0),
+    ("mask.A", 3, 20.0),
+];
+
+fn offset_pattern(offset: f32, map: impl Fn([f32; 4]) -> [f32; 4]) -> Vec<[f32; 4]> {
+    test_pattern(WIDTH, HEIGHT)
+        .into_iter()
+        .map(|p| map(p.map(|c| c + offset)))
+        .collect()
+}
+
+#[test]
+fn multi_layer_exr_lists_and_finds_layers() {
+    let dir = TempDir::new("layers");
+    let path = dir.path("layers.exr");
+    write_exr(&path, WIDTH, HEIGHT, LAYERED_CHANNELS);
+
+    let input = OiioImageInput::open(&path).expect("layered EXR should open");
+    let subimage = input.subimage(0).expect("subimage 0 should exist");
+    assert_eq!(subimage.channels.len(), LAYERED_CHANNELS.len());
+    assert_eq!(subimage.layers(), ["", "diffuse", "mask"]);
+    for layer in ["", "diffuse", "mask"] {
+        assert_eq!(input.find_layer(layer).expect("layer should exist"), 0);
+    }
+    assert!(input.find_layer("specular").is_err());
+}
+
+#[test]
+fn multi_layer_exr_reads_layers_into_rgba_slots() {
+    let dir = TempDir::new("layer-read");
+    let path = dir.path("layers.exr");
+    write_exr(&path, WIDTH, HEIGHT, LAYERED_CHANNELS);
+
+    // Channels are stored A, B, G, R within each layer, so RGBA layers are
+    // permuted into slot order and Y/A is expanded to Y, Y, Y, A.
+    let cases = [
+        ("", offset_pattern(0.0, |p| p)),
+        ("diffuse", offset_pattern(10.0, |p| p)),
+        ("mask", offset_pattern(20.0, |p| [p[0], p[0], p[0], p[3]])),
+    ];
+    let direct = OiioImageInput::open(&path).expect("layered EXR should open");
+    let cached = OiioImageInput::open_cached(&path).expect("layered EXR should open cached");
+    for input in [&direct, &cached] {
+        for (layer, expected) in &cases {
+            let (width, height, pixels) = input
+                .read_layer_rgba_f32(0, layer)
+                .expect("layer should decode");
+            assert_eq!((width, height), (WIDTH, HEIGHT));
+            assert_close4(&pixels, expected, 0.0);
+        }
+    }
+}
+
+#[test]
+fn batch_export_fails_truncated_raw_frames_on_their_own() {
+    let dir = TempDir::new("batch-truncated");
+    let jobs = export_jobs(&dir, 3);
+    // Cut into the pixel data of a frame the raw path would take.
+    let bytes = std::fs::read(&jobs[1].input).expect("frame should be readable");
+    std::fs::write(&jobs[1].input, &bytes[..bytes.len() / 2]).expect("frame should be writable");
+    let options = OiioExportOptions {
+        output: uncompressed(BitDepth::F32, true),
+        ..Default::default()
+    };
+
+    let report = batch_export(&jobs, &options).expect("batch should run");
+    assert!(report.results[0].is_ok());
+    assert!(report.results[1].is_err());
+    assert!(report.results[2].is_ok());
+}
+
+fn write_pixels(path: &Path, width: u32, height: u32, pixels: &[[f32; 4]]) {
+    let options = uncompressed(BitDepth::F32, true);
+    let mut out =
+        OiioImageOutput::create(path, width, height, &options).expect("output should open");
+    out.write_image(pixels).expect("write should succeed");
+    out.close().expect("close should succeed");
+}
+
+#[test]
+fn thumbnails_prefer_a_large_enough_embedded_thumbnail() {
+    let dir = TempDir::new("thumb-embedded");
+    let path = dir.path("preview.exr");
+    let color = [200, 40, 90, 255];
+    let mut preview = Vec::new();
+    preview.extend_from_slice(&16_u32.to_le_bytes());
+    preview.extend_from_slice(&10_u32.to_le_bytes());
+    for _ in 0..16 * 10 {
+        preview.extend_from_slice(&color);
+    }
+    write_exr_with(
+        &path,
+        WIDTH,
+        HEIGHT,
+        &[("R", 0, 0.0), ("G", 1, 0.0), ("B", 2, 0.0), ("A", 3, 0.0)],
+        &[("preview", "preview", preview)],
+    );
+
+    let options = OiioThumbnailOptions {
+        max_edge: 8,
+        ..Default::default()
+    };
+    let thumbs = generate_thumbnails(&[&path], &options).expect("batch should run");
+    let thumb = thumbs[0].as_ref().expect("thumbnail should decode");
+    // The preview is 16 x 10, which fits 8 x 5 like the image itself.
+    assert_eq!((thumb.width, thumb.height), (8, 5));
+    assert!(thumb.pixels.iter().all(|&p| p == color));
+}
+
+#[test]
+fn thumbnails_decode_the_covering_mip_level() {
+    let dir = TempDir::new("thumb-mip");
+    let path = dir.path("mip.exr");
+    write_mip_exr(&path, 64, 32, |level| 0.1 * (level + 1) as f32);
+
+    let options = OiioThumbnailOptions {
+        max_edge: 16,
+        ..Default::default()
+    };
+    let thumbs = generate_thumbnails(&[&path], &options).expect("batch should run");
+    let thumb = thumbs[0].as_ref().expect("thumbnail should decode");
+    // 16 x 8 is exactly level 2, filled with 0.3.
+    assert_eq!((thumb.width, thumb.height), (16, 8));
+    let level_2 = (0.3_f32 * 255.0 + 0.5) as u8;
+    assert!(thumb.pixels.iter().all(|&p| p == [level_2; 4]));
+}
+
+#[test]
+fn thumbnails_box_filter_single_level_images() {
+    let dir = TempDir::new("thumb-box");
+    let path = dir.path("checker.exr");
+    // A one-pixel checker, which a 2x box reduction averages to gray.
+    let (width, height) = (32, 16);
+    let pixels: Vec<[f32; 4]> = (0..height)
+        .flat_map(|y| (0..width).map(move |x| [((x + y) % 2) as f32, 0.0, 0.0, 1.0]))
+        .collect();
+    write_pixels(&path, width, height, &pixels);
+
+    let options = OiioThumbnailOptions {
+        max_edge: 16,
+        ..Default::default()
+    };
+    let thumbs = generate_thumbnails(&[&path], &options).expect("batch should run");
+    let thumb = thumbs[0].as_ref().expect("thumbnail should decode");
+    assert_eq!((thumb.width, thumb.height), (16, 8));
+    for p in &thumb.pixels {
+        assert!(p[0].abs_diff(128) <= 1, "expected gray, got {p:?}");
+        assert_eq!((p[1], p[2], p[3]), (0, 0, 255));
+    }
+}
+
+#[test]
+fn thumbnails_fail_unreadable_files_on_their_own() {
+    let dir = TempDir::new("thumb-unreadable");
+    let good = dir.path("good.exr");
+    let bad = dir.path("bad.exr");
+    write_image(&good, WIDTH, HEIGHT, &uncompressed(BitDepth::F32, true));
+    std::fs::write(&bad, b"not an image").expect("file should be writable");
+    let missing = dir.path("missing.exr");
+
+    let thumbs = generate_thumbnails(&[&good, &bad, &missing, &good], &Default::default())
+        .expect("batch should run");
+    assert_eq!(thumbs.len(), 4);
+    assert!(thumbs[0].is_ok());
+    assert!(matches!(thumbs[1], Err(OiioError::Oiio(_))));
+    assert!(matches!(thumbs[2], Err(OiioError::Oiio(_))));
+    assert_eq!(thumbs[3].as_ref().ok(), thumbs[0].as_ref().ok());
+}
+
+#[test]
+fn thumbnails_report_failing_transform_for_that_file_only() {
+    let dir = TempDir::new("thumb-transform");
+    let wide = dir.path("wide.exr");
+    let square = dir.path("square.exr");
+    write_image(&wide, 32, 16, &uncompressed(BitDepth::F32, true));
+    write_image(&square, 16, 16, &uncompressed(BitDepth::F32, true));
+
+    let transform = |pixels: &mut [[f32; 4]], _w: u32, h: u32| {
+        if h == 8 {
+            return Err("square thumbnails are not allowed".to_string());
+        }
+        pixels.fill([1.0, 0.0, 0.0, 1.0]);
+        Ok(())
+    };
+    let options = OiioThumbnailOptions {
+        max_edge: 8,
+        transform: Some(&transform),
+        ..Default::default()
+    };
+    let thumbs = generate_thumbnails(&[&wide, &square], &options).expect("batch should run");
+    let thumb = thumbs[0].as_ref().expect("wide thumbnail should pass");
+    assert_eq!((thumb.width, thumb.height), (8, 4));
+    assert!(thumb.pixels.iter().all(|&p| p == [255, 0, 0, 255]));
+    match &thumbs[1] {
+        Err(OiioError::Transform(message)) => {
+            assert_eq!(message, "square thumbnails are not allowed");
+        }
+        other => panic!("expected a transform error, got {other:?}"),
+    }
+}
+
+// Generous enough for a loaded CI machine; frames are tiny.
+const FRAME_TIMEOUT: Duration = Duration::from_secs(10);
+
+/// Write frames `frames` of `frame.####.exr` into `dir`, each filled with
+/// its frame number in red, and return the sequence pattern.
+fn write_sequence(dir: &TempDir, frames: std::ops::RangeInclusive<i32>) -> String {
+    for frame in frames {
+        let pixels = vec![[frame as f32, 0.0, 0.0, 1.0]; 8 * 4];
+        write_pixels(&dir.path(&format!("frame.{frame:04}.exr")), 8, 4, &pixels);
+    }
+    dir.path("frame.####.exr").to_string_lossy().into_owned()
+}
+
+fn sequence(
+    pattern: &str,
+    frames: std::ops::RangeInclusive<i32>,
+    ring_size: u32,
+) -> OiioImageSequence {
+    let options = OiioSequenceOptions {
+        ring_size,
+        threads: 2,
+        ..Default::default()
+    };
+    OiioImageSequence::new(pattern, frames, options).expect("sequence should start")
+}
+
+fn assert_frame(seq: &OiioImageSequence, frame: i32) {
+    let decoded = seq
+        .wait_frame(frame, FRAME_TIMEOUT)
+        .expect("frame should decode")
+        .expect("frame should be in the window");
+    assert_eq!(decoded.frame(), frame);
+    assert_eq!((decoded.width(), decoded.height()), (8, 4));
+    assert!(decoded.pixels().iter().all(|p| p[0] == frame as f32));
+}
+
+#[test]
+fn sequence_prefetches_ahead_of_the_playhead() {
+    let dir = TempDir::new("seq-prefetch");
+    let pattern = write_sequence(&dir, 1..=8);
+    let seq = sequence(&pattern, 1..=8, 4);
+
+    // Forward from frame 1, the ring holds 1..=4.
+    for frame in 1..=4 {
+        assert_frame(&seq, frame);
+    }
+    let frame = seq.try_frame(2).expect("poll should succeed");
+    assert_eq!(frame.map(|f| f.frame()), Some(2));
+}
+
+#[test]
+fn sequence_retargets_when_the_playhead_moves() {
+    let dir = TempDir::new("seq-retarget");
+    let pattern = write_sequence(&dir, 1..=20);
+    let seq = sequence(&pattern, 1..=20, 4);
+    assert_frame(&seq, 1);
+
+    seq.set_playhead(15, OiioPlayDirection::Forward);
+    assert_frame(&seq, 15);
+    assert_frame(&seq, 18);
+
+    // Reverse playback reads ahead towards lower frames.
+    seq.set_playhead(10, OiioPlayDirection::Reverse);
+    assert_frame(&seq, 10);
+    assert_frame(&seq, 7);
+    // 10..=7 took over every slot, including the one frame 18 was in.
+    assert_eq!(seq.status(18), OiioFrameStatus::Absent);
+}
+
+#[test]
+fn sequence_wait_returns_early_outside_the_window() {
+    let dir = TempDir::new("seq-window");
+    let pattern = write_sequence(&dir, 1..=20);
+    let seq = sequence(&pattern, 1..=20, 4);
+
+    let start = Instant::now();
+    let frame = seq
+        .wait_frame(15, FRAME_TIMEOUT)
+        .expect("wait should succeed");
+    assert!(frame.is_none());
+    assert!(
+        start.elapsed() < FRAME_TIMEOUT / 2,
+        "waited {:?}",
+        start.elapsed()
+    );
+    assert_eq!(seq.status(15), OiioFrameStatus::Absent);
+}
+
+#[test]
+fn sequence_pins_frames_until_released() {
+    let dir = TempDir::new("seq-pin");
+    let pattern = write_sequence(&dir, 1..=10);
+    // Two slots: the playhead frame and one ahead.
+    let seq = sequence(&pattern, 1..=10, 2);
+    let pinned = seq
+        .wait_frame(1, FRAME_TIMEOUT)
+        .expect("frame should decode")
+        .expect("frame should be in the window");
+
+    // Frame 5 takes the unpinned slot; frame 6 has none left while 1 is
+    // pinned, so waiting for it times out.
+    seq.set_playhead(5, OiioPlayDirection::Forward);
+    assert_frame(&seq, 5);
+    let timeout = Duration::from_millis(200);
+    let start = Instant::now();
+    let frame = seq.wait_frame(6, timeout).expect("wait should succeed");
+    assert!(frame.is_none());
+    assert!(
+        start.elapsed() >= timeout,
+        "returned after {:?}",
+        start.elapsed()
+    );
+    assert_eq!(seq.status(6), OiioFrameStatus::Absent);
+
+    // The pinned buffer is untouched while frames around it change.
+    assert_eq!(seq.status(1), OiioFrameStatus::Ready);
+    assert!(pinned.pixels().iter().all(|p| p[0] == 1.0));
+
+    drop(pinned);
+    assert_frame(&seq, 6);
+    assert_eq!(seq.status(1), OiioFrameStatus::Absent);
+}
+
+#[test]
+fn sequence_reports_missing_and_corrupt_frames() {
+    let dir = TempDir::new("seq-failed");
+    let pattern = write_sequence(&dir, 1..=4);
+    std::fs::remove_file(dir.path("frame.0002.exr")).expect("frame should be removable");
+    std::fs::write(dir.path("frame.0003.exr"), b"not an image").expect("file should be writable");
+    let seq = sequence(&pattern, 1..=4, 4);
+
+    for frame in [2, 3] {
+        let result = seq.wait_frame(frame, FRAME_TIMEOUT);
+        assert!(
+            matches!(result, Err(OiioError::Oiio(_))),
+            "frame {frame} should fail"
+        );
+        assert_eq!(seq.status(frame), OiioFrameStatus::Failed);
+    }
+    // Failed frames do not hold up their neighbours.
+    assert_frame(&seq, 1);
+    assert_frame(&seq, 4);
+}
+
+#[test]
+fn read_rgba_f32_expands_gray_and_gray_alpha() {
+    let dir = TempDir::new("gray");
+    let pattern = test_pattern(WIDTH, HEIGHT);
+
+    let path = dir.path("y.exr");
+    write_exr(&path, WIDTH, HEIGHT, &[("Y", 0, 0.0)]);
+    let input = OiioImageInput::open(&path).expect("gray file should open");
+    assert_eq!(input.nchannels(), 1);
+    let expected: Vec<_> = pattern.iter().map(|p| [p[0], p[0], p[0], 1.0]).collect();
+    assert_close4(
+        &input.read_rgba_f32().expect("decode should succeed"),
+        &expected,
+        0.0,
+    );
+
+    let path = dir.path("ya.exr");
+    write_exr(&path, WIDTH, HEIGHT, &[("Y", 0, 0.0), ("A", 3, 0.0)]);
+    let input = OiioImageInput::open(&path).expect("gray+alpha file should open");
+    assert_eq!(input.nchannels(), 2);
+    let expected: Vec<_> = pattern.iter().map(|p| [p[0], p[0], p[0], p[3]]).collect();
+    assert_close4(
+        &input.read_rgba_f32().expect("decode should succeed"),
+        &expected,
+        0.0,
+    );
+}
+
+#[test]
+fn read_rgba_f32_fit_decodes_the_covering_mip_level() {
+    let dir = TempDir::new("fit-mip");
+    let path = dir.path("mip.exr");
+    // Levels 64 x 32, 32 x 16, 16 x 8, ... filled with 0.1, 0.2, 0.3, ...
+    write_mip_exr(&path, 64, 32, |level| 0.1 * (level + 1) as f32);
+    let input = OiioImageInput::open(&path).expect("MIP file should open");
+
+    for (bound, size, value) in [
+        // Full size, also for bounds the image already fits.
+        ((0, 0), (64, 32), 0.1),
+        ((100, 100), (64, 32), 0.1),
+        // Exactly level 2.
+        ((16, 16), (16, 8), 0.3),
+        // Between levels: level 1 is read and downscaled.
+        ((20, 20), (20, 10), 0.2),
+        ((40, 10), (20, 10), 0.2),
+    ] {
+        assert_eq!(
+            input
+                .fit_size(bound.0, bound.1)
+                .expect("fit should succeed"),
+            size
+        );
+        let (w, h, pixels) = input
+            .read_rgba_f32_fit(bound.0, bound.1)
+            .expect("fit read should succeed");
+        assert_eq!((w, h), size, "bound {bound:?}");
+        let expected = vec![[value; 4]; (w * h) as usize];
+        assert_close4(&pixels, &expected, 1e-5);
+    }
+}
+
+/// Decode IEEE binary16 bits; the test patterns hold no subnormals.
+fn half_to_f32(bits: u16) -> f32 {
+    let sign = u32::from(bits >> 15) << 31;
+    let exp = u32::from((bits >> 10) & 0x1f);
+    let mant = u32::from(bits & 0x3ff);
+    match exp {
+        0 => {
+            assert_eq!(mant, 0, "unexpected subnormal half");
+            f32::from_bits(sign)
+        }
+        0x1f => f32::from_bits(sign | 0x7f80_0000 | (mant << 13)),
+        _ => f32::from_bits(sign | ((exp + 127 - 15) << 23) | (mant << 13)),
+    }
+}
+
+#[test]
+fn read_rgba_f16_round_trips_within_half_precision() {
+    let dir = TempDir::new("f16");
+    for (name, depth) in [("f16.exr", BitDepth::F16), ("f32.exr", BitDepth::F32)] {
+        let path = dir.path(name);
+        write_image(&path, WIDTH, HEIGHT, &uncompressed(depth, true));
+        let input = OiioImageInput::open(&path).expect("file should open");
+
+        let halves = input.read_rgba_f16().expect("half decode should succeed");
+        let actual: Vec<_> = halves.iter().map(|p| p.map(half_to_f32)).collect();
+        let expected = input.read_rgba_f32().expect("float decode should succeed");
+        // Half samples are exact; floats round to 11 significant bits, and
+        // the pattern stays within [0, 1].
+        let tol = if depth == BitDepth::F16 {
+            0.0
+        } else {
+            1.0 / 2048.0
+        };
+        assert_close4(&actual, &expected, tol);
+    }
+}